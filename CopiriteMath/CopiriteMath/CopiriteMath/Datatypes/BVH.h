@@ -0,0 +1,632 @@
+#pragma once
+#include "Box.h"
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <vector>
+
+
+
+// A node of a STBVH with up to 4 children, their bounds are stored as lanes so a single pass tests all of them.
+// Used slots are always first, unused slots have bounds at infinity that nothing hits.
+// @note - 128 bytes for 3D floats, two cache lines.
+// @template Size - How many dimensions the bounds have.
+// @template Type - The datatype the bounds use.
+template <uint Size, typename Type>
+struct alignas(64) STBVHNode
+{
+	// The value of Child for an unused slot.
+	static constexpr uint32 Empty{ ~0u };
+
+	// The bounds of each child.
+	STBoxPacket<Size, Type, 4> Bounds;
+
+	// The node index of each child, or the first entry in STBVH::GetPrimitives() for a leaf.
+	uint32 Child[4];
+
+	// How many primitives each leaf has, 0 for a child that is a node.
+	uint32 Count[4];
+};
+
+
+
+// A bounding volume hierarchy over primitives given by their bounds, for ray and overlap queries.
+// Built top down with binned surface area heuristic splits, each node collapses up to 3 splits into 4 children.
+// Subtrees are built across SThreadPool::Get() once they are large enough, only the order of the nodes depends on which thread builds them.
+// @note - Primitives are referred to by their index in the array the hierarchy was built from, the hierarchy does not store them.
+// @template Size - How many dimensions the primitives have.
+// @template Type - The datatype the primitives use, float or double.
+template <uint Size, typename Type>
+struct STBVH
+{
+public:
+	// The value returned by the queries when nothing was hit.
+	static constexpr uint32 None{ ~0u };
+
+	// How many bins each axis is divided into when searching for a split.
+	static constexpr uint Bins{ 16 };
+
+	// Subtrees with fewer primitives than this are always built on the thread that reached them.
+	static constexpr uint ParallelThreshold{ 4096 };
+
+	// The node type of this hierarchy.
+	typedef STBVHNode<Size, Type> SNode;
+
+
+private:
+	/// Properties
+
+	// Every node, the root is the first and every child comes after its parent.
+	std::vector<SNode> Nodes;
+
+	// The primitive indices ordered so each leaf's primitives are contiguous.
+	std::vector<uint32> Primitives;
+
+	// The bounds of every node, kept between refits so they don't allocate.
+	std::vector<STBox<Size, Type>> NodeBounds;
+
+	// The bounds of every primitive.
+	STBox<Size, Type> Bounds;
+
+	// The deepest level of the tree, the root is level 1.
+	uint Depth;
+
+
+	// A range of primitives that is becoming a child of a node.
+	struct SRange
+	{
+		// The first entry in Primitives.
+		uint Begin;
+
+		// One past the last entry in Primitives.
+		uint End;
+
+		// The bounds of the primitives.
+		STBox<Size, Type> Bounds;
+
+		// The bounds of the primitives' centers, used to place them into bins.
+		STBox<Size, Type> CenterBounds;
+
+		// Set once the range has been found to be cheaper as a leaf.
+		bool Leaf;
+	};
+
+	// The state shared by every thread during a build.
+	struct SBuildContext
+	{
+		// The bounds of each primitive.
+		const STBox<Size, Type>* Boxes;
+
+		// The center of each primitive.
+		std::vector<STVector<Size, Type>> Centers;
+
+		// The most primitives a leaf may hold before it is always split.
+		uint MaxLeafSize;
+
+		// Whether large subtrees are built across SThreadPool::Get().
+		bool Parallel;
+
+		// How many nodes have been allocated.
+		std::atomic<uint> NodeCount;
+
+		// The deepest level reached.
+		std::atomic<uint> Depth;
+	};
+
+
+	/// Functions
+
+	// Calculates the bounds and center bounds of a range.
+	INLINE void ComputeBounds(const SBuildContext& Context, SRange& Range) const;
+
+	// Splits a range in two with the surface area heuristic.
+	// @param Left - Set to the first half.
+	// @param Right - Set to the second half.
+	// @return - False if the range is cheaper as a leaf, the halves are left unchanged.
+	INLINE bool Split(const SBuildContext& Context, const SRange& Range, SRange& Left, SRange& Right);
+
+	// Builds a node and every node below it.
+	// @param Index - The node to build, already allocated.
+	// @param Range - The primitives the node contains.
+	// @param Level - The depth of the node, the root is level 1.
+	// @note - Not INLINE, it recurses.
+	void BuildNode(SBuildContext& Context, uint Index, SRange Range, uint Level);
+
+	// Updates the bounds of every node from the bounds of their primitives.
+	// @param GetBounds - Takes a primitive index and returns its bounds.
+	template <typename Function>
+	INLINE void RefitNodes(Function GetBounds);
+
+
+public:
+	/// Constructors
+
+	// Constructor, Default. Initializes an empty hierarchy.
+	INLINE STBVH();
+
+	// Constructor, Builds a hierarchy over primitives.
+	// @param Boxes - The bounds of each primitive.
+	// @param Count - How many primitives there are.
+	INLINE STBVH(const STBox<Size, Type>* Boxes, uint Count);
+
+
+
+	/// Functions
+
+	// Builds the hierarchy over primitives, replacing any previous build.
+	// @param Boxes - The bounds of each primitive.
+	// @param Count - How many primitives there are.
+	// @param MaxLeafSize - Ranges with more primitives than this are always split, the heuristic decides when larger leaves are worth it.
+	// @param Parallel - Builds large subtrees across SThreadPool::Get(), false builds on the calling thread alone.
+	INLINE void Build(const STBox<Size, Type>* Boxes, uint Count, uint MaxLeafSize = 4, bool Parallel = true);
+
+	// Builds the hierarchy over points, replacing any previous build.
+	// @param Points - The position of each point.
+	// @param Count - How many points there are.
+	// @param MaxLeafSize - Ranges with more points than this are always split, the heuristic decides when larger leaves are worth it.
+	// @param Parallel - Builds large subtrees across SThreadPool::Get(), false builds on the calling thread alone.
+	INLINE void Build(const STVector<Size, Type>* Points, uint Count, uint MaxLeafSize = 4, bool Parallel = true);
+
+	// Updates the bounds of every node after the primitives have moved, without changing the tree.
+	// @note - Much cheaper than a rebuild, but queries slow down as the primitives move away from where they were built.
+	// @param Boxes - The new bounds of each primitive, the same count the hierarchy was built with.
+	INLINE void Refit(const STBox<Size, Type>* Boxes);
+
+	// Updates the bounds of every node after the points have moved, without changing the tree.
+	// @param Points - The new position of each point, the same count the hierarchy was built with.
+	INLINE void Refit(const STVector<Size, Type>* Points);
+
+	// Finds the closest primitive hit by a ray.
+	// @param Origin - Where the ray starts.
+	// @param Direction - The direction of the ray, it does not have to be normalized.
+	// @param Distance - How far along the ray to search in multiples of the direction's length, set to the distance of the closest hit.
+	// @param TestPrimitive - Takes a primitive index and the current Distance, returns the distance along the ray it is hit at. Misses return Distance or more.
+	// @return - The index of the closest primitive that was hit, None if nothing was hit.
+	template <typename Function>
+	INLINE uint32 IntersectRay(const STVector<Size, Type>& Origin, const STVector<Size, Type>& Direction, Type& Distance, Function&& TestPrimitive) const;
+
+	// Visits every primitive in a leaf whose bounds overlap a box.
+	// @note - Primitives are visited because their leaf overlaps, they may not overlap the box themselves.
+	// @param Box - The box to search.
+	// @param Visit - Called with the index of each primitive.
+	template <typename Function>
+	INLINE void Query(const STBox<Size, Type>& Box, Function&& Visit) const;
+
+	// Visits every primitive in a leaf whose bounds contain a point.
+	// @note - Primitives are visited because their leaf contains the point, they may not contain it themselves.
+	// @param Point - The point to search.
+	// @param Visit - Called with the index of each primitive.
+	template <typename Function>
+	INLINE void Query(const STVector<Size, Type>& Point, Function&& Visit) const;
+
+	// Returns true if the hierarchy has no primitives.
+	INLINE bool IsEmpty() const { return Primitives.empty(); }
+
+	// Returns the bounds of every primitive.
+	INLINE const STBox<Size, Type>& GetBounds() const { return Bounds; }
+
+	// Returns every node, the root is the first.
+	INLINE const std::vector<SNode>& GetNodes() const { return Nodes; }
+
+	// Returns the primitive indices ordered so each leaf's primitives are contiguous.
+	INLINE const std::vector<uint32>& GetPrimitives() const { return Primitives; }
+
+	// Returns the deepest level of the tree, the root is level 1.
+	INLINE uint GetDepth() const { return Depth; }
+};
+
+
+
+// A 3D floating point bounding volume hierarchy.
+typedef STBVH<3, float> SBVH3;
+
+// A 3D double type bounding volume hierarchy.
+typedef STBVH<3, double> SBVH3d;
+
+
+
+template <uint Size, typename Type>
+INLINE STBVH<Size, Type>::STBVH()
+	:Depth{ 0 }
+{
+	ASSERT(std::is_floating_point<Type>::value, "Bounding volume hierarchies need a floating point type.");
+}
+
+
+template <uint Size, typename Type>
+INLINE STBVH<Size, Type>::STBVH(const STBox<Size, Type>* Boxes, uint Count)
+	:STBVH{}
+{
+	Build(Boxes, Count);
+}
+
+
+template <uint Size, typename Type>
+INLINE void STBVH<Size, Type>::Build(const STBox<Size, Type>* Boxes, uint Count, uint MaxLeafSize, bool Parallel)
+{
+	Nodes.clear();
+	Primitives.resize(Count);
+	Bounds = STBox<Size, Type>{};
+	Depth = 0;
+	if (Count == 0)
+	{
+		NodeBounds.clear();
+		return;
+	}
+
+	SBuildContext Context;
+	Context.Boxes = Boxes;
+	Context.Centers.resize(Count);
+	Context.MaxLeafSize = std::max(MaxLeafSize, 1u);
+	Context.Parallel = Parallel;
+	Context.NodeCount = 1;
+	Context.Depth = 0;
+	for (uint i = 0; i < Count; ++i)
+	{
+		Primitives[i] = i;
+		Context.Centers[i] = Boxes[i].GetCenter();
+	}
+
+	// Every node but the root has at least 2 children, so there are never more nodes than primitives.
+	Nodes.resize(Count);
+	SRange Root{ 0, Count, {}, {}, false };
+	ComputeBounds(Context, Root);
+	BuildNode(Context, 0, Root, 1);
+
+	Nodes.resize(Context.NodeCount);
+	Nodes.shrink_to_fit();
+	NodeBounds.resize(Nodes.size());
+	Bounds = Root.Bounds;
+	Depth = Context.Depth;
+}
+
+
+template <uint Size, typename Type>
+INLINE void STBVH<Size, Type>::Build(const STVector<Size, Type>* Points, uint Count, uint MaxLeafSize, bool Parallel)
+{
+	std::vector<STBox<Size, Type>> Boxes(Count);
+	for (uint i = 0; i < Count; ++i) Boxes[i] = STBox<Size, Type>{ Points[i] };
+	Build(Boxes.data(), Count, MaxLeafSize, Parallel);
+}
+
+
+template <uint Size, typename Type>
+INLINE void STBVH<Size, Type>::ComputeBounds(const SBuildContext& Context, SRange& Range) const
+{
+	Range.Bounds = STBox<Size, Type>{};
+	Range.CenterBounds = STBox<Size, Type>{};
+	Range.Leaf = false;
+	for (uint i = Range.Begin; i < Range.End; ++i)
+	{
+		Range.Bounds += Context.Boxes[Primitives[i]];
+		Range.CenterBounds += Context.Centers[Primitives[i]];
+	}
+}
+
+
+template <uint Size, typename Type>
+INLINE bool STBVH<Size, Type>::Split(const SBuildContext& Context, const SRange& Range, SRange& Left, SRange& Right)
+{
+	const uint Count{ Range.End - Range.Begin };
+	if (Count <= 1) return false;
+
+	// The cost of a split is the chance of entering each half times its primitives, relative to the parent.
+	// Entering a node costs about as much as testing one primitive.
+	const Type LeafCost{ (Type)Count };
+	Type BestCost{ std::numeric_limits<Type>::max() };
+	uint BestAxis{ 0 };
+	uint BestBin{ 0 };
+	const STVector<Size, Type> CenterMin{ Range.CenterBounds.GetMin() };
+	const STVector<Size, Type> CenterSize{ Range.CenterBounds.GetSize() };
+	const Type InvArea{ (Type)1 / std::max(Range.Bounds.SurfaceArea(), std::numeric_limits<Type>::min()) };
+
+	// Every axis is binned in the same pass, so each primitive is only read once.
+	// Small ranges use fewer bins, most would be empty and sweeping them costs more than binning.
+	const uint BinCount{ std::min(Count, Bins) };
+	STVector<Size, Type> Scale;
+	for (uint Axis = 0; Axis < Size; ++Axis) Scale[Axis] = (CenterSize[Axis] > (Type)0) ? (Type)BinCount / CenterSize[Axis] : (Type)0;
+	STBox<Size, Type> BinBounds[Size][Bins];
+	uint BinCounts[Size][Bins]{};
+	for (uint i = Range.Begin; i < Range.End; ++i)
+	{
+		const uint Primitive{ Primitives[i] };
+		const STVector<Size, Type> Bin{ (Context.Centers[Primitive] - CenterMin) * Scale };
+		for (uint Axis = 0; Axis < Size; ++Axis)
+		{
+			const uint Index{ std::min((uint)Bin[Axis], BinCount - 1) };
+			BinBounds[Axis][Index] += Context.Boxes[Primitive];
+			++BinCounts[Axis][Index];
+		}
+	}
+
+	for (uint Axis = 0; Axis < Size; ++Axis)
+	{
+		if (CenterSize[Axis] <= (Type)0) continue;
+
+		// Sweeps from the right storing the cost of each right half, then from the left to find the cheapest plane.
+		Type RightCosts[Bins];
+		STBox<Size, Type> Accumulated;
+		uint AccumulatedCount{ 0 };
+		for (uint Bin = BinCount - 1; Bin > 0; --Bin)
+		{
+			Accumulated += BinBounds[Axis][Bin];
+			AccumulatedCount += BinCounts[Axis][Bin];
+			RightCosts[Bin] = Accumulated.SurfaceArea() * (Type)AccumulatedCount;
+		}
+		Accumulated = STBox<Size, Type>{};
+		AccumulatedCount = 0;
+		for (uint Bin = 1; Bin < BinCount; ++Bin)
+		{
+			Accumulated += BinBounds[Axis][Bin - 1];
+			AccumulatedCount += BinCounts[Axis][Bin - 1];
+			const Type Cost{ (Type)1 + ((Accumulated.SurfaceArea() * (Type)AccumulatedCount) + RightCosts[Bin]) * InvArea };
+			if (AccumulatedCount > 0 && AccumulatedCount < Count && Cost < BestCost)
+			{
+				BestCost = Cost;
+				BestAxis = Axis;
+				BestBin = Bin;
+			}
+		}
+	}
+
+	uint Middle;
+	if (BestCost < std::numeric_limits<Type>::max())
+	{
+		if (BestCost >= LeafCost && Count <= Context.MaxLeafSize) return false;
+		Middle = (uint)(std::partition(Primitives.begin() + Range.Begin, Primitives.begin() + Range.End, [&](uint Primitive)
+			{
+				return std::min((uint)((Context.Centers[Primitive][BestAxis] - CenterMin[BestAxis]) * Scale[BestAxis]), BinCount - 1) < BestBin;
+			}) - Primitives.begin());
+	}
+	else
+	{
+		// Every center is in the same place, only splitting the range in half keeps large leaves from forming.
+		if (Count <= Context.MaxLeafSize) return false;
+		Middle = Range.Begin + (Count / 2);
+	}
+
+	Left.Begin = Range.Begin;
+	Left.End = Middle;
+	Right.Begin = Middle;
+	Right.End = Range.End;
+	ComputeBounds(Context, Left);
+	ComputeBounds(Context, Right);
+	return true;
+}
+
+
+template <uint Size, typename Type>
+void STBVH<Size, Type>::BuildNode(SBuildContext& Context, uint Index, SRange Range, uint Level)
+{
+	uint Deepest{ Context.Depth.load(std::memory_order_relaxed) };
+	while (Level > Deepest && !Context.Depth.compare_exchange_weak(Deepest, Level, std::memory_order_relaxed)) {}
+
+	// Keeps splitting the child with the largest surface area until there are 4 or none are worth splitting.
+	SRange Children[4]{ Range };
+	uint ChildCount{ 1 };
+	while (ChildCount < 4)
+	{
+		int Largest{ -1 };
+		for (uint i = 0; i < ChildCount; ++i)
+		{
+			if (Children[i].Leaf) continue;
+			if (Largest < 0 || Children[i].Bounds.SurfaceArea() > Children[Largest].Bounds.SurfaceArea()) Largest = (int)i;
+		}
+		if (Largest < 0) break;
+
+		SRange Left, Right;
+		if (Split(Context, Children[Largest], Left, Right))
+		{
+			Children[Largest] = Left;
+			Children[ChildCount++] = Right;
+		}
+		else
+		{
+			Children[Largest].Leaf = true;
+		}
+	}
+
+	SNode& Node{ Nodes[Index] };
+	STBox<Size, Type> ChildBounds[4];
+	SRange Subtrees[4];
+	uint SubtreeIndices[4];
+	uint SubtreeCount{ 0 };
+	bool Parallel{ false };
+	for (uint i = 0; i < 4; ++i)
+	{
+		if (i >= ChildCount)
+		{
+			Node.Child[i] = SNode::Empty;
+			Node.Count[i] = 0;
+			continue;
+		}
+
+		SRange& Child{ Children[i] };
+		const uint Count{ Child.End - Child.Begin };
+		ChildBounds[i] = Child.Bounds;
+
+		// Children small enough to be leaves are not split again, checking them costs more than the few nodes it saves.
+		if (Child.Leaf || Count <= Context.MaxLeafSize)
+		{
+			Node.Child[i] = Child.Begin;
+			Node.Count[i] = Count;
+			continue;
+		}
+
+		const uint ChildIndex{ Context.NodeCount.fetch_add(1, std::memory_order_relaxed) };
+		Node.Child[i] = ChildIndex;
+		Node.Count[i] = 0;
+		Subtrees[SubtreeCount] = Child;
+		SubtreeIndices[SubtreeCount++] = ChildIndex;
+		Parallel |= Context.Parallel && Count >= ParallelThreshold;
+	}
+	Node.Bounds = STBoxPacket<Size, Type, 4>{ ChildBounds, ChildCount };
+
+	// The subtrees never share primitives or nodes, so each can be stolen by another thread of the pool.
+	auto BuildSubtrees = [&](uint Begin, uint End)
+	{
+		for (uint i = Begin; i < End; ++i) BuildNode(Context, SubtreeIndices[i], Subtrees[i], Level + 1);
+	};
+	if (Parallel) ParallelFor(SubtreeCount, BuildSubtrees);
+	else BuildSubtrees(0, SubtreeCount);
+}
+
+
+template <uint Size, typename Type>
+INLINE void STBVH<Size, Type>::Refit(const STBox<Size, Type>* Boxes)
+{
+	RefitNodes([Boxes](uint Primitive) { return Boxes[Primitive]; });
+}
+
+
+template <uint Size, typename Type>
+INLINE void STBVH<Size, Type>::Refit(const STVector<Size, Type>* Points)
+{
+	RefitNodes([Points](uint Primitive) { return STBox<Size, Type>{ Points[Primitive] }; });
+}
+
+
+template <uint Size, typename Type>
+template <typename Function>
+INLINE void STBVH<Size, Type>::RefitNodes(Function GetBounds)
+{
+	// Children always come after their parent, so walking backwards finishes every child before its parent.
+	for (uint i = (uint)Nodes.size(); i-- > 0;)
+	{
+		SNode& Node{ Nodes[i] };
+		STBox<Size, Type> ChildBounds[4];
+		STBox<Size, Type> Total;
+		uint ChildCount{ 0 };
+		for (; ChildCount < 4 && Node.Child[ChildCount] != SNode::Empty; ++ChildCount)
+		{
+			STBox<Size, Type>& Child{ ChildBounds[ChildCount] };
+			if (Node.Count[ChildCount] == 0) Child = NodeBounds[Node.Child[ChildCount]];
+			else
+			{
+				const uint First{ Node.Child[ChildCount] };
+				for (uint j = First; j < First + Node.Count[ChildCount]; ++j) Child += GetBounds(Primitives[j]);
+			}
+			Total += Child;
+		}
+		Node.Bounds = STBoxPacket<Size, Type, 4>{ ChildBounds, ChildCount };
+		NodeBounds[i] = Total;
+	}
+	if (!Nodes.empty()) Bounds = NodeBounds[0];
+}
+
+
+template <uint Size, typename Type>
+template <typename Function>
+INLINE uint32 STBVH<Size, Type>::IntersectRay(const STVector<Size, Type>& Origin, const STVector<Size, Type>& Direction, Type& Distance, Function&& TestPrimitive) const
+{
+	// An entry on the traversal stack, a node or a leaf and how far along the ray it is entered.
+	struct SEntry
+	{
+		uint32 Child;
+		uint32 Count;
+		Type Distance;
+	};
+
+	uint32 Closest{ None };
+	if (Nodes.empty()) return Closest;
+
+	STVector<Size, Type> InvDirection;
+	for (uint i = 0; i < Size; ++i) InvDirection[i] = (Type)1 / Direction[i];
+
+	// Each node pushes at most 3 more entries than it pops.
+	SEntry LocalStack[128];
+	std::vector<SEntry> HeapStack;
+	SEntry* Stack{ LocalStack };
+	if ((Depth * 3) + 1 > 128)
+	{
+		HeapStack.resize((Depth * 3) + 1);
+		Stack = HeapStack.data();
+	}
+
+	uint StackSize{ 1 };
+	Stack[0] = SEntry{ 0, 0, (Type)0 };
+	while (StackSize > 0)
+	{
+		const SEntry Entry{ Stack[--StackSize] };
+		if (Entry.Distance > Distance) continue;
+
+		if (Entry.Count > 0)
+		{
+			for (uint i = Entry.Child; i < Entry.Child + Entry.Count; ++i)
+			{
+				const Type Hit{ TestPrimitive(Primitives[i], Distance) };
+				if (Hit < Distance)
+				{
+					Distance = Hit;
+					Closest = Primitives[i];
+				}
+			}
+			continue;
+		}
+
+		const SNode& Node{ Nodes[Entry.Child] };
+		typename STBoxPacket<Size, Type, 4>::SLanes Lanes;
+		uint Mask{ Node.Bounds.IntersectRay(Origin, InvDirection, Distance, Lanes) };
+		alignas(alignof(decltype(Lanes))) Type Distances[4];
+		Lanes.Store(Distances);
+
+		// Pushes the hit children furthest first, so the nearest is visited next.
+		SEntry Hits[4];
+		uint HitCount{ 0 };
+		while (Mask != 0)
+		{
+			const uint Slot{ (uint)std::countr_zero(Mask) };
+			Mask &= Mask - 1;
+			SEntry Hit{ Node.Child[Slot], Node.Count[Slot], Distances[Slot] };
+			uint j{ HitCount++ };
+			for (; j > 0 && Hits[j - 1].Distance < Hit.Distance; --j) Hits[j] = Hits[j - 1];
+			Hits[j] = Hit;
+		}
+		for (uint i = 0; i < HitCount; ++i) Stack[StackSize++] = Hits[i];
+	}
+	return Closest;
+}
+
+
+template <uint Size, typename Type>
+template <typename Function>
+INLINE void STBVH<Size, Type>::Query(const STBox<Size, Type>& Box, Function&& Visit) const
+{
+	if (Nodes.empty()) return;
+
+	// Each node pushes at most 3 more nodes than it pops.
+	uint32 LocalStack[128];
+	std::vector<uint32> HeapStack;
+	uint32* Stack{ LocalStack };
+	if ((Depth * 3) + 1 > 128)
+	{
+		HeapStack.resize((Depth * 3) + 1);
+		Stack = HeapStack.data();
+	}
+
+	uint StackSize{ 1 };
+	Stack[0] = 0;
+	while (StackSize > 0)
+	{
+		const SNode& Node{ Nodes[Stack[--StackSize]] };
+		uint Mask{ Node.Bounds.Overlaps(Box) };
+		while (Mask != 0)
+		{
+			const uint Slot{ (uint)std::countr_zero(Mask) };
+			Mask &= Mask - 1;
+			if (Node.Count[Slot] == 0) Stack[StackSize++] = Node.Child[Slot];
+			else
+			{
+				for (uint i = Node.Child[Slot]; i < Node.Child[Slot] + Node.Count[Slot]; ++i) Visit(Primitives[i]);
+			}
+		}
+	}
+}
+
+
+template <uint Size, typename Type>
+template <typename Function>
+INLINE void STBVH<Size, Type>::Query(const STVector<Size, Type>& Point, Function&& Visit) const
+{
+	Query(STBox<Size, Type>{ Point }, Visit);
+}
@@ -0,0 +1,547 @@
+#pragma once
+#include "Vector.h"
+#include <limits>
+
+
+template <uint Size, typename Type, uint Count>
+struct STRayPacket;
+
+
+
+// Represents an axis aligned bounding box as its lowest and highest corners.
+// A default constructed box is empty, its corners are inverted so merging anything into it gives that thing's bounds.
+// @note - Ray tests take the inverse of the ray's direction, computed once per ray and shared by every box it is tested against.
+// @template Size - How many dimensions this box has.
+// @template Type - The datatype this box should use.
+template <uint Size, typename Type>
+struct STBox
+{
+private:
+	/// Properties
+
+	// The lowest corner of the box.
+	STVector<Size, Type> Min;
+
+	// The highest corner of the box.
+	STVector<Size, Type> Max;
+
+
+public:
+	/// Constructors
+
+	// Constructor, Default. Initializes an empty box.
+	INLINE constexpr STBox();
+
+	// Constructor, Initializes the box with its corners.
+	// @param InMin - The lowest corner.
+	// @param InMax - The highest corner.
+	INLINE constexpr STBox(const STVector<Size, Type>& InMin, const STVector<Size, Type>& InMax);
+
+	// Constructor, Initializes a box containing only a single point.
+	// @param Point - The point the box contains.
+	INLINE constexpr explicit STBox(const STVector<Size, Type>& Point);
+
+	// Creates the smallest box containing an array of points.
+	// @param Points - The points to contain.
+	// @param Count - How many points there are.
+	// @return - The resulting box, empty if there are no points.
+	static INLINE STBox<Size, Type> FromPoints(const STVector<Size, Type>* Points, uint Count);
+
+	// Creates a box from its center and half of its size.
+	// @param Center - The center of the box.
+	// @param Extent - The distance from the center to the highest corner.
+	// @return - The resulting box.
+	static INLINE constexpr STBox<Size, Type> FromCenterExtent(const STVector<Size, Type>& Center, const STVector<Size, Type>& Extent);
+
+
+
+	/// Operators
+
+	// Operator, Returns the smallest box containing this box and another box.
+	INLINE constexpr STBox<Size, Type> operator+(const STBox<Size, Type>& Other) const { return Merge(Other); }
+
+	// Operator, Returns the smallest box containing this box and a point.
+	INLINE constexpr STBox<Size, Type> operator+(const STVector<Size, Type>& Point) const { return Merge(Point); }
+
+	// Operator, Grows this box to contain another box.
+	INLINE constexpr STBox<Size, Type>& operator+=(const STBox<Size, Type>& Other) { Min = Min.Min(Other.Min); Max = Max.Max(Other.Max); return *this; }
+
+	// Operator, Grows this box to contain a point.
+	INLINE constexpr STBox<Size, Type>& operator+=(const STVector<Size, Type>& Point) { Min = Min.Min(Point); Max = Max.Max(Point); return *this; }
+
+	// Operator, Returns true if both boxes have the same corners.
+	INLINE constexpr bool operator==(const STBox<Size, Type>& Other) const { return Min == Other.Min && Max == Other.Max; }
+
+	// Operator, Returns true if the boxes have different corners.
+	INLINE constexpr bool operator!=(const STBox<Size, Type>& Other) const { return !(*this == Other); }
+
+
+
+	/// Functions
+
+	// Returns the lowest corner of the box.
+	INLINE constexpr const STVector<Size, Type>& GetMin() const { return Min; }
+
+	// Returns the highest corner of the box.
+	INLINE constexpr const STVector<Size, Type>& GetMax() const { return Max; }
+
+	// Returns the center of the box.
+	INLINE constexpr STVector<Size, Type> GetCenter() const { return (Min + Max) * (Type)0.5f; }
+
+	// Returns the distance from the center to the highest corner.
+	INLINE constexpr STVector<Size, Type> GetExtent() const { return (Max - Min) * (Type)0.5f; }
+
+	// Returns the length of the box along each axis.
+	INLINE constexpr STVector<Size, Type> GetSize() const { return Max - Min; }
+
+	// Returns true if the box contains at least one point, a box containing a single point is valid.
+	INLINE constexpr bool IsValid() const { return Min <= Max; }
+
+	// Returns the area of the box's surface, the perimeter of a 2D box.
+	// @note - Used as the cost of a node when building bounding volume hierarchies, an empty box returns 0.
+	INLINE constexpr Type SurfaceArea() const;
+
+	// Returns the volume of the box, the area of a 2D box.
+	INLINE constexpr Type Volume() const;
+
+	// Returns the smallest box containing this box and another box.
+	INLINE constexpr STBox<Size, Type> Merge(const STBox<Size, Type>& Other) const { return STBox<Size, Type>{ Min.Min(Other.Min), Max.Max(Other.Max) }; }
+
+	// Returns the smallest box containing this box and a point.
+	INLINE constexpr STBox<Size, Type> Merge(const STVector<Size, Type>& Point) const { return STBox<Size, Type>{ Min.Min(Point), Max.Max(Point) }; }
+
+	// Returns the part of this box that is also inside another box, the result is not valid if they do not overlap.
+	INLINE constexpr STBox<Size, Type> Intersection(const STBox<Size, Type>& Other) const { return STBox<Size, Type>{ Min.Max(Other.Min), Max.Min(Other.Max) }; }
+
+	// Returns a copy of this box grown by an amount on every side.
+	INLINE constexpr STBox<Size, Type> Expand(Type Amount) const { return STBox<Size, Type>{ Min - Amount, Max + Amount }; }
+
+	// Returns true if this box and another box share any point, boxes that only touch overlap.
+	INLINE constexpr bool Overlaps(const STBox<Size, Type>& Other) const { return Min <= Other.Max && Other.Min <= Max; }
+
+	// Returns true if a point is inside the box or on its surface.
+	INLINE constexpr bool Contains(const STVector<Size, Type>& Point) const { return Min <= Point && Point <= Max; }
+
+	// Returns true if another box is completely inside this box.
+	INLINE constexpr bool Contains(const STBox<Size, Type>& Other) const { return Min <= Other.Min && Other.Max <= Max; }
+
+	// Returns the point inside the box that is closest to a point.
+	INLINE constexpr STVector<Size, Type> ClosestPoint(const STVector<Size, Type>& Point) const { return Point.Max(Min).Min(Max); }
+
+	// Returns the squared distance from a point to the box, 0 if the point is inside.
+	INLINE constexpr Type DistanceSquared(const STVector<Size, Type>& Point) const;
+
+	// Tests a ray against the box with the slab method, without branching on the ray's direction.
+	// @note - The box must be valid, the inverted corners of an empty box are hit by every ray.
+	// @note - Axis' the ray is parallel to have an infinite inverse direction, they only reject the ray when its origin is outside the slab,
+	// starting on either of its planes counts as inside.
+	// @param Origin - Where the ray starts.
+	// @param InvDirection - 1 divided by each component of the ray's direction.
+	// @param MaxDistance - How far along the ray to test, in multiples of the direction's length.
+	// @param Distance - Set to how far along the ray it enters the box, 0 if it starts inside. Only written on a hit.
+	// @return - True if the ray hits the box between 0 and MaxDistance.
+	INLINE bool IntersectRay(const STVector<Size, Type>& Origin, const STVector<Size, Type>& InvDirection, Type MaxDistance, Type& Distance) const;
+
+	// Tests a ray against the box with the slab method, without branching on the ray's direction.
+	// @param Origin - Where the ray starts.
+	// @param InvDirection - 1 divided by each component of the ray's direction.
+	// @param MaxDistance - How far along the ray to test, in multiples of the direction's length.
+	// @return - True if the ray hits the box between 0 and MaxDistance.
+	INLINE bool IntersectRay(const STVector<Size, Type>& Origin, const STVector<Size, Type>& InvDirection, Type MaxDistance = std::numeric_limits<Type>::max()) const;
+
+	// Tests a packet of rays against the box in one pass.
+	// @param Rays - The rays to test.
+	// @param Distances - Set to how far along each ray it enters the box, only meaningful for the rays that hit.
+	// @return - A bit mask with a bit set for each ray that hit, the lowest bit is the first ray.
+	template <uint Count>
+	INLINE uint IntersectRays(const STRayPacket<Size, Type, Count>& Rays, TLanes<Type, Count>& Distances) const;
+
+	// Tests a packet of rays against the box in one pass.
+	// @param Rays - The rays to test.
+	// @return - A bit mask with a bit set for each ray that hit, the lowest bit is the first ray.
+	template <uint Count>
+	INLINE uint IntersectRays(const STRayPacket<Size, Type, Count>& Rays) const;
+
+	// Returns true if this box is almost equal to another box.
+	INLINE constexpr bool nearlyEqual(const STBox<Size, Type>& Other, const Type& Threshold = MICRO_NUMBER) const { return Min.nearlyEqual(Other.Min, Threshold) && Max.nearlyEqual(Other.Max, Threshold); }
+
+	// Prints out the corners of the box.
+	INLINE void Print() const { Min.Print(); Max.Print(); }
+};
+
+
+
+// A 2D floating point box.
+typedef STBox<2, float> SBox2;
+
+// A 2D double type box.
+typedef STBox<2, double> SBox2d;
+
+// A 2D integer box.
+typedef STBox<2, int> SBox2i;
+
+// A 3D floating point box.
+typedef STBox<3, float> SBox3;
+
+// A 3D double type box.
+typedef STBox<3, double> SBox3d;
+
+// A 3D integer box.
+typedef STBox<3, int> SBox3i;
+
+
+
+// A group of rays stored as a structure of lanes, tested against a single box in one pass.
+// @template Size - How many dimensions the rays have.
+// @template Type - The datatype the rays use.
+// @template Count - How many rays are in the packet.
+template <uint Size, typename Type, uint Count = TNativeLanes<Type>::Count>
+struct STRayPacket
+{
+	// The lanes of the packet.
+	typedef TLanes<Type, Count> SLanes;
+
+	// Where each ray starts, one set of lanes per axis.
+	SLanes Origin[Size];
+
+	// 1 divided by each component of each ray's direction, one set of lanes per axis.
+	SLanes InvDirection[Size];
+
+	// How far along each ray to test, in multiples of its direction's length.
+	SLanes MaxDistance;
+
+
+	// Constructor, Default. The lanes are left uninitialized.
+	INLINE STRayPacket() = default;
+
+	// Constructor, Gathers rays into the packet and inverts their directions.
+	// @param Origins - Where each ray starts.
+	// @param Directions - The direction of each ray, they do not have to be normalized.
+	// @param InCount - How many rays there are, at most Count. Unused lanes get rays that miss everything.
+	// @param InMaxDistance - How far along every ray to test.
+	INLINE STRayPacket(const STVector<Size, Type>* Origins, const STVector<Size, Type>* Directions, uint InCount, Type InMaxDistance = std::numeric_limits<Type>::max());
+};
+
+
+
+// A group of boxes stored as a structure of lanes, tested against a single ray or box in one pass.
+// @template Size - How many dimensions the boxes have.
+// @template Type - The datatype the boxes use.
+// @template Count - How many boxes are in the packet.
+template <uint Size, typename Type, uint Count = TNativeLanes<Type>::Count>
+struct STBoxPacket
+{
+	// The lanes of the packet.
+	typedef TLanes<Type, Count> SLanes;
+
+	// The lowest corner of each box, one set of lanes per axis.
+	SLanes Min[Size];
+
+	// The highest corner of each box, one set of lanes per axis.
+	SLanes Max[Size];
+
+
+	// Constructor, Default. The lanes are left uninitialized.
+	INLINE STBoxPacket() = default;
+
+	// Constructor, Gathers boxes into the packet.
+	// @param Boxes - The boxes to gather.
+	// @param InCount - How many boxes there are, at most Count. Unused lanes get boxes at infinity that nothing hits.
+	INLINE STBoxPacket(const STBox<Size, Type>* Boxes, uint InCount);
+
+	// Returns a box from the packet.
+	// @param Index - Which lane to read.
+	INLINE STBox<Size, Type> GetBox(uint Index) const;
+
+	// Tests a ray against every box in the packet.
+	// @param Origin - Where the ray starts.
+	// @param InvDirection - 1 divided by each component of the ray's direction.
+	// @param MaxDistance - How far along the ray to test, in multiples of the direction's length.
+	// @param Distances - Set to how far along the ray it enters each box, only meaningful for the boxes that were hit.
+	// @return - A bit mask with a bit set for each box that was hit, the lowest bit is the first box.
+	INLINE uint IntersectRay(const STVector<Size, Type>& Origin, const STVector<Size, Type>& InvDirection, Type MaxDistance, SLanes& Distances) const;
+
+	// Tests a ray against every box in the packet.
+	// @param Origin - Where the ray starts.
+	// @param InvDirection - 1 divided by each component of the ray's direction.
+	// @param MaxDistance - How far along the ray to test, in multiples of the direction's length.
+	// @return - A bit mask with a bit set for each box that was hit, the lowest bit is the first box.
+	INLINE uint IntersectRay(const STVector<Size, Type>& Origin, const STVector<Size, Type>& InvDirection, Type MaxDistance = std::numeric_limits<Type>::max()) const;
+
+	// Tests a box against every box in the packet.
+	// @return - A bit mask with a bit set for each box that overlaps, the lowest bit is the first box.
+	INLINE uint Overlaps(const STBox<Size, Type>& Box) const;
+
+	// Tests which boxes in the packet contain a point.
+	// @return - A bit mask with a bit set for each box containing the point, the lowest bit is the first box.
+	INLINE uint Contains(const STVector<Size, Type>& Point) const;
+};
+
+
+
+template <uint Size, typename Type>
+INLINE constexpr STBox<Size, Type>::STBox()
+	:Min{ std::numeric_limits<Type>::max() }, Max{ std::numeric_limits<Type>::lowest() }
+{}
+
+
+template <uint Size, typename Type>
+INLINE constexpr STBox<Size, Type>::STBox(const STVector<Size, Type>& InMin, const STVector<Size, Type>& InMax)
+	:Min{ InMin }, Max{ InMax }
+{}
+
+
+template <uint Size, typename Type>
+INLINE constexpr STBox<Size, Type>::STBox(const STVector<Size, Type>& Point)
+	:Min{ Point }, Max{ Point }
+{}
+
+
+template <uint Size, typename Type>
+INLINE STBox<Size, Type> STBox<Size, Type>::FromPoints(const STVector<Size, Type>* Points, uint Count)
+{
+	STBox<Size, Type> Result;
+	for (uint i = 0; i < Count; ++i)
+	{
+		Result.Min = Result.Min.Min(Points[i]);
+		Result.Max = Result.Max.Max(Points[i]);
+	}
+	return Result;
+}
+
+
+template <uint Size, typename Type>
+INLINE constexpr STBox<Size, Type> STBox<Size, Type>::FromCenterExtent(const STVector<Size, Type>& Center, const STVector<Size, Type>& Extent)
+{
+	return STBox<Size, Type>{ Center - Extent, Center + Extent };
+}
+
+
+template <uint Size, typename Type>
+INLINE constexpr Type STBox<Size, Type>::SurfaceArea() const
+{
+	if (!IsValid()) return (Type)0;
+
+	// Every pair of opposite faces is the product of the other axis' lengths.
+	const STVector<Size, Type> Lengths{ GetSize() };
+	Type Result{ 0 };
+	for (uint i = 0; i < Size; ++i)
+	{
+		Type Face{ 1 };
+		for (uint j = 0; j < Size; ++j)
+		{
+			if (j != i) Face *= Lengths[j];
+		}
+		Result += Face;
+	}
+	return Result * (Type)2;
+}
+
+
+template <uint Size, typename Type>
+INLINE constexpr Type STBox<Size, Type>::Volume() const
+{
+	if (!IsValid()) return (Type)0;
+	const STVector<Size, Type> Lengths{ GetSize() };
+	Type Result{ 1 };
+	for (uint i = 0; i < Size; ++i) Result *= Lengths[i];
+	return Result;
+}
+
+
+template <uint Size, typename Type>
+INLINE constexpr Type STBox<Size, Type>::DistanceSquared(const STVector<Size, Type>& Point) const
+{
+	const STVector<Size, Type> Offset{ Point - ClosestPoint(Point) };
+	return Offset ^ Offset;
+}
+
+
+template <uint Size, typename Type>
+INLINE bool STBox<Size, Type>::IntersectRay(const STVector<Size, Type>& Origin, const STVector<Size, Type>& InvDirection, Type MaxDistance, Type& Distance) const
+{
+	ASSERT(std::is_floating_point<Type>::value, "Ray tests need a floating point box.");
+
+	// A ray parallel to a slab that starts on one of its planes gives NaN, 0 * infinity, for that plane. The ray is inside
+	// the slab, so NaN becomes -infinity for the near distance and infinity for the far one, either plane leaves the
+	// running distances unchanged.
+	constexpr Type Infinity{ std::numeric_limits<Type>::infinity() };
+	Type Near{ 0 };
+	Type Far{ MaxDistance };
+	for (uint i = 0; i < Size; ++i)
+	{
+		const Type T1{ (Min[i] - Origin[i]) * InvDirection[i] };
+		const Type T2{ (Max[i] - Origin[i]) * InvDirection[i] };
+		const Type Near1{ (T1 > -Infinity) ? T1 : -Infinity };
+		const Type Near2{ (T2 > -Infinity) ? T2 : -Infinity };
+		const Type Far1{ (T1 < Infinity) ? T1 : Infinity };
+		const Type Far2{ (T2 < Infinity) ? T2 : Infinity };
+		const Type SlabNear{ (Near1 < Near2) ? Near1 : Near2 };
+		const Type SlabFar{ (Far1 > Far2) ? Far1 : Far2 };
+		Near = (SlabNear > Near) ? SlabNear : Near;
+		Far = (SlabFar < Far) ? SlabFar : Far;
+	}
+	if (Near > Far) return false;
+	Distance = Near;
+	return true;
+}
+
+
+template <uint Size, typename Type>
+INLINE bool STBox<Size, Type>::IntersectRay(const STVector<Size, Type>& Origin, const STVector<Size, Type>& InvDirection, Type MaxDistance) const
+{
+	Type Distance;
+	return IntersectRay(Origin, InvDirection, MaxDistance, Distance);
+}
+
+
+template <uint Size, typename Type>
+template <uint Count>
+INLINE uint STBox<Size, Type>::IntersectRays(const STRayPacket<Size, Type, Count>& Rays, TLanes<Type, Count>& Distances) const
+{
+	ASSERT(std::is_floating_point<Type>::value, "Ray tests need a floating point box.");
+	typedef TLanes<Type, Count> SLanes;
+
+	// Lane Min and Max return their second input when either is NaN, so clamping to infinity first maps NaN the same way
+	// IntersectRay() does.
+	const SLanes Infinity{ std::numeric_limits<Type>::infinity() };
+	const SLanes NegInfinity{ -std::numeric_limits<Type>::infinity() };
+	SLanes Near{ (Type)0 };
+	SLanes Far{ Rays.MaxDistance };
+	for (uint j = 0; j < Size; ++j)
+	{
+		const SLanes T1{ (SLanes{ Min[j] } - Rays.Origin[j]) * Rays.InvDirection[j] };
+		const SLanes T2{ (SLanes{ Max[j] } - Rays.Origin[j]) * Rays.InvDirection[j] };
+		Near = T1.Max(NegInfinity).Min(T2.Max(NegInfinity)).Max(Near);
+		Far = T1.Min(Infinity).Max(T2.Min(Infinity)).Min(Far);
+	}
+	Distances = Near;
+	return (Near <= Far).MoveMask();
+}
+
+
+template <uint Size, typename Type>
+template <uint Count>
+INLINE uint STBox<Size, Type>::IntersectRays(const STRayPacket<Size, Type, Count>& Rays) const
+{
+	TLanes<Type, Count> Distances;
+	return IntersectRays(Rays, Distances);
+}
+
+
+
+template <uint Size, typename Type, uint Count>
+INLINE STRayPacket<Size, Type, Count>::STRayPacket(const STVector<Size, Type>* Origins, const STVector<Size, Type>* Directions, uint InCount, Type InMaxDistance)
+{
+	ASSERT(std::is_floating_point<Type>::value, "Ray packets need a floating point type.");
+
+	// Unused lanes end before they start, so they miss even the boxes whose slabs they are parallel to.
+	alignas(alignof(SLanes)) Type MaxDistances1D[Count];
+	for (uint i = 0; i < Count; ++i) MaxDistances1D[i] = (i < InCount) ? InMaxDistance : (Type)-1;
+	MaxDistance = SLanes::Load(MaxDistances1D);
+
+	// Unused lanes start at infinity and point away from everything.
+	for (uint j = 0; j < Size; ++j)
+	{
+		alignas(alignof(SLanes)) Type Origins1D[Count];
+		alignas(alignof(SLanes)) Type InvDirections1D[Count];
+		for (uint i = 0; i < Count; ++i)
+		{
+			Origins1D[i] = (i < InCount) ? Origins[i][j] : std::numeric_limits<Type>::infinity();
+			InvDirections1D[i] = (i < InCount) ? (Type)1 / Directions[i][j] : (Type)1;
+		}
+		Origin[j] = SLanes::Load(Origins1D);
+		InvDirection[j] = SLanes::Load(InvDirections1D);
+	}
+}
+
+
+
+template <uint Size, typename Type, uint Count>
+INLINE STBoxPacket<Size, Type, Count>::STBoxPacket(const STBox<Size, Type>* Boxes, uint InCount)
+{
+	constexpr Type Unused{ std::numeric_limits<Type>::has_infinity ? std::numeric_limits<Type>::infinity() : std::numeric_limits<Type>::max() };
+	for (uint j = 0; j < Size; ++j)
+	{
+		alignas(alignof(SLanes)) Type Min1D[Count];
+		alignas(alignof(SLanes)) Type Max1D[Count];
+		for (uint i = 0; i < Count; ++i)
+		{
+			Min1D[i] = (i < InCount) ? Boxes[i].GetMin()[j] : Unused;
+			Max1D[i] = (i < InCount) ? Boxes[i].GetMax()[j] : Unused;
+		}
+		Min[j] = SLanes::Load(Min1D);
+		Max[j] = SLanes::Load(Max1D);
+	}
+}
+
+
+template <uint Size, typename Type, uint Count>
+INLINE STBox<Size, Type> STBoxPacket<Size, Type, Count>::GetBox(uint Index) const
+{
+	STVector<Size, Type> BoxMin, BoxMax;
+	for (uint j = 0; j < Size; ++j)
+	{
+		BoxMin[j] = Min[j][Index];
+		BoxMax[j] = Max[j][Index];
+	}
+	return STBox<Size, Type>{ BoxMin, BoxMax };
+}
+
+
+template <uint Size, typename Type, uint Count>
+INLINE uint STBoxPacket<Size, Type, Count>::IntersectRay(const STVector<Size, Type>& Origin, const STVector<Size, Type>& InvDirection, Type MaxDistance, SLanes& Distances) const
+{
+	ASSERT(std::is_floating_point<Type>::value, "Ray tests need a floating point box.");
+
+	// The same slab test as STBox::IntersectRays(), with each lane holding a different box.
+	const SLanes Infinity{ std::numeric_limits<Type>::infinity() };
+	const SLanes NegInfinity{ -std::numeric_limits<Type>::infinity() };
+	SLanes Near{ (Type)0 };
+	SLanes Far{ MaxDistance };
+	for (uint j = 0; j < Size; ++j)
+	{
+		const SLanes O{ Origin[j] };
+		const SLanes Inv{ InvDirection[j] };
+		const SLanes T1{ (Min[j] - O) * Inv };
+		const SLanes T2{ (Max[j] - O) * Inv };
+		Near = T1.Max(NegInfinity).Min(T2.Max(NegInfinity)).Max(Near);
+		Far = T1.Min(Infinity).Max(T2.Min(Infinity)).Min(Far);
+	}
+	Distances = Near;
+
+	// Unused lanes are boxes at infinity, a ray heading towards them only reaches them at an infinite distance.
+	return ((Near <= Far) & (Near < Infinity)).MoveMask();
+}
+
+
+template <uint Size, typename Type, uint Count>
+INLINE uint STBoxPacket<Size, Type, Count>::IntersectRay(const STVector<Size, Type>& Origin, const STVector<Size, Type>& InvDirection, Type MaxDistance) const
+{
+	SLanes Distances;
+	return IntersectRay(Origin, InvDirection, MaxDistance, Distances);
+}
+
+
+template <uint Size, typename Type, uint Count>
+INLINE uint STBoxPacket<Size, Type, Count>::Overlaps(const STBox<Size, Type>& Box) const
+{
+	SLanes Result{ (Min[0] <= SLanes{ Box.GetMax()[0] }) & (SLanes{ Box.GetMin()[0] } <= Max[0]) };
+	for (uint j = 1; j < Size; ++j)
+	{
+		Result = Result & (Min[j] <= SLanes{ Box.GetMax()[j] }) & (SLanes{ Box.GetMin()[j] } <= Max[j]);
+	}
+	return Result.MoveMask();
+}
+
+
+template <uint Size, typename Type, uint Count>
+INLINE uint STBoxPacket<Size, Type, Count>::Contains(const STVector<Size, Type>& Point) const
+{
+	SLanes Result{ (Min[0] <= SLanes{ Point[0] }) & (SLanes{ Point[0] } <= Max[0]) };
+	for (uint j = 1; j < Size; ++j)
+	{
+		Result = Result & (Min[j] <= SLanes{ Point[j] }) & (SLanes{ Point[j] } <= Max[j]);
+	}
+	return Result.MoveMask();
+}
@@ -0,0 +1,646 @@
+#pragma once
+#include "Box.h"
+#include "../Math/SIMD.h"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+
+// Both broadphases keep their state between frames and only redo the work for bodies that moved.
+// Their storage grows to fit the largest frame seen and is reused after that, Reserve() sizes it up front
+// so no frame allocates. Pairs are written to a buffer the caller owns.
+// @note - The spatial hash can still outgrow its reservation when bodies cover more cells than expected, STSpatialHash::DidGrow() reports it.
+
+
+
+// Two bodies whose boxes overlap, the lower index is always first.
+struct SBroadphasePair
+{
+	// The lower index of the two bodies.
+	uint32 A;
+
+	// The higher index of the two bodies.
+	uint32 B;
+};
+
+
+
+// A broadphase that sorts the bodies by the lowest point of their box on one axis and sweeps along it.
+// Each body is only tested against the bodies that start before its box ends on that axis.
+// Bodies move little between frames so the order is nearly sorted, and an insertion sort brings it up to date in close to linear time.
+// The sweep tests TNativeLanes bodies against each body at a time.
+// @template Type - The datatype the boxes use, float or double.
+template <typename Type>
+struct STSweepAndPrune
+{
+	ASSERT(std::is_floating_point<Type>::value, "Sweep and prune pads its arrays with NaN, which needs a floating point type.");
+
+public:
+	// How many bodies the sweep tests together.
+	static constexpr uint Lanes{ TNativeLanes<Type>::Count };
+
+	// The lanes used by the sweep.
+	typedef TLanes<Type, Lanes> SLanes;
+
+	// An insertion sort that moves more than this many bodies per body falls back to a full sort.
+	static constexpr uint MaxShiftsPerBody{ 8 };
+
+
+private:
+	/// Properties
+
+	// The bodies in sorted order.
+	std::vector<uint32> Order;
+
+	// The lowest point of each body on the sweep axis, in sorted order.
+	std::vector<Type> Keys;
+
+	// The lowest and highest corners of each body, in sorted order and one array per axis so the sweep reads them in sequence.
+	// Followed by Lanes of NaN, which fail every test, so the sweep can read whole lanes past the last body.
+	std::vector<Type> Mins[3], Maxs[3];
+
+	// How many bodies there are.
+	uint Count;
+
+	// The axis the bodies are sorted along.
+	uint Axis;
+
+
+	/// Functions
+
+	// Sorts the bodies along an axis from scratch.
+	// @param Boxes - The box of each body.
+	INLINE void Sort(const STBox<3, Type>* Boxes);
+
+
+public:
+	/// Constructors
+
+	// Constructor, Default. Initializes a broadphase with no bodies.
+	INLINE STSweepAndPrune() :Count{ 0 }, Axis{ 0 } {}
+
+
+
+	/// Functions
+
+	// Allocates space for a number of bodies so updates with up to that many do not allocate.
+	// @param Bodies - How many bodies to make space for.
+	INLINE void Reserve(uint Bodies);
+
+	// Moves the bodies to new boxes. When the body count is the same as the last update the previous order is re-sorted
+	// with an insertion sort, otherwise the bodies are sorted from scratch along the axis their centers spread furthest on.
+	// @param Boxes - The box of each body.
+	// @param InCount - How many bodies there are.
+	// @return - How many bodies the insertion sort moved past another, a measure of how far the order was from sorted.
+	INLINE uint Update(const STBox<3, Type>* Boxes, uint InCount);
+
+	// Finds every pair of bodies whose boxes overlap, boxes that only touch overlap.
+	// @param Pairs - Receives the pairs, in no particular order.
+	// @param Capacity - How many pairs Pairs has space for.
+	// @return - How many pairs overlap, if more than Capacity only the first Capacity were written.
+	INLINE uint FindPairs(SBroadphasePair* Pairs, uint Capacity) const;
+
+	// Returns how many bodies there are.
+	INLINE uint Num() const { return Count; }
+
+	// Returns the axis the bodies are sorted along.
+	INLINE uint GetAxis() const { return Axis; }
+};
+
+
+
+// A broadphase that registers each body in every cell of a uniform grid its box touches, and tests the bodies sharing a cell.
+// Cells are found by their SVector3i coordinates in an open addressing hash table, so the grid is unbounded and only
+// occupied cells take space. A body that stays within the same cells costs nothing to update.
+// @note - The cell size should be around the size of a typical body, a box spanning many cells is registered in each of them.
+// @template Type - The datatype the boxes use.
+template <typename Type>
+struct STSpatialHash
+{
+public:
+	// The index of no node or body.
+	static constexpr uint32 None{ ~0u };
+
+	// Cell coordinates are clamped to this many cells either side of the origin, so far away or NaN points still have a cell
+	// and the loops over a body's cells cannot overflow.
+	static constexpr int MaxCell{ 1 << 30 };
+
+
+private:
+	// One body's registration in one cell, a node of both the cell's list of bodies and the body's list of cells.
+	struct SNode
+	{
+		// The cell.
+		SVector3i Cell;
+
+		// The body.
+		uint32 Body;
+
+		// The previous and next nodes in the cell's list.
+		uint32 Prev, Next;
+
+		// The body's next node, or the next free node once released.
+		uint32 NextOfBody;
+	};
+
+	// A slot of the cell table.
+	struct SSlot
+	{
+		// The cell's coordinates.
+		SVector3i Cell;
+
+		// The first node in the cell's list, None if the slot is empty.
+		uint32 Head;
+	};
+
+	// The cells a body's box touches, from the lowest to the highest inclusive.
+	struct SCellRange
+	{
+		// The lowest cell.
+		SVector3i Lo;
+
+		// The highest cell.
+		SVector3i Hi;
+	};
+
+
+	/// Properties
+
+	// The size of every cell along each axis, and its inverse.
+	Type CellSize, InvCellSize;
+
+	// The box of each body.
+	std::vector<STBox<3, Type>> Boxes;
+
+	// The cells each body is registered in.
+	std::vector<SCellRange> Ranges;
+
+	// Each body's first node.
+	std::vector<uint32> FirstNodes;
+
+	// Every node, used or free.
+	std::vector<SNode> Nodes;
+
+	// The first free node.
+	uint32 FreeNode;
+
+	// The cell table, its size is a power of two.
+	std::vector<SSlot> Slots;
+
+	// How many slots hold a cell.
+	uint Occupied;
+
+	// Did the last update have to grow any of the storage.
+	bool Grown;
+
+
+	/// Functions
+
+	// Returns the cell a point is in, clamped to MaxCell.
+	INLINE SVector3i GetCell(const STVector<3, Type>& Point) const;
+
+	// Returns the slot a cell would be in if nothing collided with it.
+	INLINE uint GetHome(const SVector3i& Cell) const;
+
+	// Returns the slot holding a cell, or the empty slot it would go in.
+	INLINE uint FindSlot(const SVector3i& Cell) const;
+
+	// Rebuilds the cell table with a number of slots.
+	// @param Capacity - The new number of slots, a power of two.
+	INLINE void Rehash(uint Capacity);
+
+	// Registers a body in every cell of its range.
+	INLINE void Insert(uint32 Body);
+
+	// Removes a body from every cell it is registered in.
+	INLINE void Remove(uint32 Body);
+
+	// Empties a slot, moving later cells of its probe run back so lookups never stop early.
+	INLINE void EraseSlot(uint Slot);
+
+
+public:
+	/// Constructors
+
+	// Constructor, Initializes an empty grid.
+	// @param InCellSize - The size of every cell along each axis.
+	INLINE explicit STSpatialHash(Type InCellSize);
+
+
+
+	/// Functions
+
+	// Allocates space so updates do not allocate until a frame needs more.
+	// @param Bodies - How many bodies to make space for.
+	// @param CellsPerBody - How many cells a body's box touches on average.
+	INLINE void Reserve(uint Bodies, uint CellsPerBody = 2);
+
+	// Moves the bodies to new boxes. Bodies past the previous count are added and bodies past the new count are removed.
+	// @note - Bodies moving into more cells than Reserve() made space for grow the storage during the update, see DidGrow().
+	// @param InBoxes - The box of each body.
+	// @param Count - How many bodies there are.
+	// @return - How many bodies changed cells.
+	INLINE uint Update(const STBox<3, Type>* InBoxes, uint Count);
+
+	// Finds every pair of bodies whose boxes overlap, boxes that only touch overlap.
+	// @note - A pair sharing several cells is only reported by the cell holding the lowest corner of their overlap.
+	// @param Pairs - Receives the pairs, in no particular order.
+	// @param Capacity - How many pairs Pairs has space for.
+	// @return - How many pairs overlap, if more than Capacity only the first Capacity were written.
+	INLINE uint FindPairs(SBroadphasePair* Pairs, uint Capacity) const;
+
+	// Returns how many bodies there are.
+	INLINE uint Num() const { return (uint)Boxes.size(); }
+
+	// Returns how many cells have at least one body in them.
+	INLINE uint NumCells() const { return Occupied; }
+
+	// Returns whether the last Update() had to allocate, a frame that should not allocate needs a larger Reserve().
+	INLINE bool DidGrow() const { return Grown; }
+
+	// Returns the size of every cell along each axis.
+	INLINE Type GetCellSize() const { return CellSize; }
+};
+
+
+
+// A float sweep and prune broadphase.
+typedef STSweepAndPrune<float> SSweepAndPrune;
+
+// A double type sweep and prune broadphase.
+typedef STSweepAndPrune<double> SSweepAndPruned;
+
+// A float spatial hash broadphase.
+typedef STSpatialHash<float> SSpatialHash;
+
+// A double type spatial hash broadphase.
+typedef STSpatialHash<double> SSpatialHashd;
+
+
+
+namespace TBroadphase
+{
+	// Writes a pair to a buffer if there is space, the lower index first.
+	// @param Pairs - The buffer.
+	// @param Capacity - How many pairs the buffer has space for.
+	// @param Found - How many pairs have been found so far, incremented.
+	INLINE void Emit(SBroadphasePair* Pairs, uint Capacity, uint& Found, uint32 First, uint32 Second)
+	{
+		if (Found < Capacity) Pairs[Found] = (First < Second) ? SBroadphasePair{ First, Second } : SBroadphasePair{ Second, First };
+		++Found;
+	}
+}
+
+
+
+template <typename Type>
+INLINE void STSweepAndPrune<Type>::Reserve(uint Bodies)
+{
+	Order.reserve(Bodies);
+	Keys.reserve(Bodies);
+	for (uint j = 0; j < 3; ++j)
+	{
+		Mins[j].reserve((size_t)Bodies + Lanes);
+		Maxs[j].reserve((size_t)Bodies + Lanes);
+	}
+}
+
+
+template <typename Type>
+INLINE void STSweepAndPrune<Type>::Sort(const STBox<3, Type>* Boxes)
+{
+	std::sort(Order.begin(), Order.end(), [Boxes, this](uint32 A, uint32 B) { return Boxes[A].GetMin()[Axis] < Boxes[B].GetMin()[Axis]; });
+	for (uint i = 0; i < Count; ++i)
+	{
+		Keys[i] = Boxes[Order[i]].GetMin()[Axis];
+	}
+}
+
+
+template <typename Type>
+INLINE uint STSweepAndPrune<Type>::Update(const STBox<3, Type>* Boxes, uint InCount)
+{
+	uint Shifts{ 0 };
+	if (InCount != Count)
+	{
+		Count = InCount;
+		Order.resize(Count);
+		Keys.resize(Count);
+		for (uint j = 0; j < 3; ++j)
+		{
+			Mins[j].assign((size_t)Count + Lanes, std::numeric_limits<Type>::quiet_NaN());
+			Maxs[j].assign((size_t)Count + Lanes, std::numeric_limits<Type>::quiet_NaN());
+		}
+
+		// The axis the centers vary the most on separates the bodies best.
+		STVector<3, Type> Mean{ (Type)0 }, MeanSquared{ (Type)0 };
+		for (uint i = 0; i < Count; ++i)
+		{
+			const STVector<3, Type> Center{ Boxes[i].GetMin() + Boxes[i].GetMax() };
+			Mean += Center;
+			MeanSquared += Center * Center;
+			Order[i] = i;
+		}
+		const STVector<3, Type> Variance{ MeanSquared * (Type)Count - Mean * Mean };
+		Axis = (Variance[0] >= Variance[1]) ? ((Variance[0] >= Variance[2]) ? 0 : 2) : ((Variance[1] >= Variance[2]) ? 1 : 2);
+		Sort(Boxes);
+	}
+	else
+	{
+		for (uint i = 0; i < Count; ++i)
+		{
+			Keys[i] = Boxes[Order[i]].GetMin()[Axis];
+		}
+
+		// Nearly sorted keys only move a few places, a body that teleported could make this quadratic so it gives up past a limit.
+		const uint64 MaxShifts{ (uint64)Count * MaxShiftsPerBody };
+		for (uint i = 1; i < Count; ++i)
+		{
+			const Type Key{ Keys[i] };
+			const uint32 Body{ Order[i] };
+			uint j{ i };
+			for (; j > 0 && Key < Keys[j - 1]; --j)
+			{
+				Keys[j] = Keys[j - 1];
+				Order[j] = Order[j - 1];
+			}
+			Keys[j] = Key;
+			Order[j] = Body;
+			Shifts += i - j;
+			if (Shifts > MaxShifts)
+			{
+				Sort(Boxes);
+				break;
+			}
+		}
+	}
+
+	for (uint i = 0; i < Count; ++i)
+	{
+		const STBox<3, Type>& Box{ Boxes[Order[i]] };
+		for (uint j = 0; j < 3; ++j)
+		{
+			Mins[j][i] = Box.GetMin()[j];
+			Maxs[j][i] = Box.GetMax()[j];
+		}
+	}
+	return Shifts;
+}
+
+
+template <typename Type>
+INLINE uint STSweepAndPrune<Type>::FindPairs(SBroadphasePair* Pairs, uint Capacity) const
+{
+	const uint AxisY{ (Axis == 2) ? 0 : Axis + 1 }, AxisZ{ (AxisY == 2) ? 0 : AxisY + 1 };
+	const Type* MinX{ Mins[Axis].data() };
+	const Type* MinY{ Mins[AxisY].data() };
+	const Type* MinZ{ Mins[AxisZ].data() };
+	const Type* MaxY{ Maxs[AxisY].data() };
+	const Type* MaxZ{ Maxs[AxisZ].data() };
+	constexpr uint AllLanes{ (1u << Lanes) - 1 };
+
+	uint Found{ 0 };
+	for (uint i = 0; i < Count; ++i)
+	{
+		const SLanes EndX{ Maxs[Axis][i] };
+		const SLanes LoY{ MinY[i] }, HiY{ MaxY[i] }, LoZ{ MinZ[i] }, HiZ{ MaxZ[i] };
+		for (uint j = i + 1;; j += Lanes)
+		{
+			// The bodies are sorted, so once one starts past the end of this body every later one does too.
+			const uint InRange{ (SLanes::LoadUnaligned(MinX + j) <= EndX).MoveMask() };
+			const SLanes OverlapY{ (SLanes::LoadUnaligned(MinY + j) <= HiY) & (LoY <= SLanes::LoadUnaligned(MaxY + j)) };
+			const SLanes OverlapZ{ (SLanes::LoadUnaligned(MinZ + j) <= HiZ) & (LoZ <= SLanes::LoadUnaligned(MaxZ + j)) };
+			for (uint Bits = InRange & (OverlapY & OverlapZ).MoveMask(); Bits != 0; Bits &= Bits - 1)
+			{
+				TBroadphase::Emit(Pairs, Capacity, Found, Order[i], Order[j + (uint)std::countr_zero(Bits)]);
+			}
+			if (InRange != AllLanes) break;
+		}
+	}
+	return Found;
+}
+
+
+
+template <typename Type>
+INLINE STSpatialHash<Type>::STSpatialHash(Type InCellSize)
+	:CellSize{ InCellSize }, InvCellSize{ (Type)1 / InCellSize }, FreeNode{ None }, Occupied{ 0 }, Grown{ false }
+{
+	Rehash(64);
+}
+
+
+template <typename Type>
+INLINE SVector3i STSpatialHash<Type>::GetCell(const STVector<3, Type>& Point) const
+{
+	// Clamped before the cast, which is undefined for values an int cannot hold. NaN fails the first test and goes to the bottom.
+	SVector3i Cell;
+	for (uint i = 0; i < 3; ++i)
+	{
+		const Type Floor{ std::floor(Point[i] * InvCellSize) };
+		Cell[i] = (Floor > (Type)-MaxCell) ? ((Floor < (Type)MaxCell) ? (int)Floor : MaxCell) : -MaxCell;
+	}
+	return Cell;
+}
+
+
+template <typename Type>
+INLINE uint STSpatialHash<Type>::GetHome(const SVector3i& Cell) const
+{
+	// Multiplied by large odd constants so neighbouring cells spread across the table, then the high bits are folded into the low ones.
+	uint32 Hash{ ((uint32)Cell[0] * 0x9E3779B1u) ^ ((uint32)Cell[1] * 0x85EBCA77u) ^ ((uint32)Cell[2] * 0xC2B2AE3Du) };
+	Hash = (Hash ^ (Hash >> 15)) * 0x2C1B3C6Du;
+	return (uint)(Hash ^ (Hash >> 16)) & ((uint)Slots.size() - 1);
+}
+
+
+template <typename Type>
+INLINE uint STSpatialHash<Type>::FindSlot(const SVector3i& Cell) const
+{
+	const uint Mask{ (uint)Slots.size() - 1 };
+	uint Slot{ GetHome(Cell) };
+	while (Slots[Slot].Head != None && !(Slots[Slot].Cell == Cell))
+	{
+		Slot = (Slot + 1) & Mask;
+	}
+	return Slot;
+}
+
+
+template <typename Type>
+INLINE void STSpatialHash<Type>::Rehash(uint Capacity)
+{
+	std::vector<SSlot> Old{ std::move(Slots) };
+	Slots.assign(Capacity, SSlot{ SVector3i{ 0 }, None });
+	for (const SSlot& Slot : Old)
+	{
+		if (Slot.Head != None) Slots[FindSlot(Slot.Cell)] = Slot;
+	}
+}
+
+
+template <typename Type>
+INLINE void STSpatialHash<Type>::Insert(uint32 Body)
+{
+	const SCellRange& Range{ Ranges[Body] };
+	for (int z = Range.Lo[2]; z <= Range.Hi[2]; ++z)
+	{
+		for (int y = Range.Lo[1]; y <= Range.Hi[1]; ++y)
+		{
+			for (int x = Range.Lo[0]; x <= Range.Hi[0]; ++x)
+			{
+				const SVector3i Cell{ x, y, z };
+				uint Slot{ FindSlot(Cell) };
+				if (Slots[Slot].Head == None)
+				{
+					// Kept at most half full so probe runs stay short.
+					if ((Occupied + 1) * 2 > (uint)Slots.size())
+					{
+						Rehash((uint)Slots.size() * 2);
+						Slot = FindSlot(Cell);
+					}
+					Slots[Slot].Cell = Cell;
+					++Occupied;
+				}
+
+				uint32 Node{ FreeNode };
+				if (Node != None)
+				{
+					FreeNode = Nodes[Node].NextOfBody;
+				}
+				else
+				{
+					Node = (uint32)Nodes.size();
+					Nodes.emplace_back();
+				}
+
+				const uint32 Head{ Slots[Slot].Head };
+				Nodes[Node] = SNode{ Cell, Body, None, Head, FirstNodes[Body] };
+				if (Head != None) Nodes[Head].Prev = Node;
+				Slots[Slot].Head = Node;
+				FirstNodes[Body] = Node;
+			}
+		}
+	}
+}
+
+
+template <typename Type>
+INLINE void STSpatialHash<Type>::Remove(uint32 Body)
+{
+	uint32 Node{ FirstNodes[Body] };
+	while (Node != None)
+	{
+		const SNode& Removed{ Nodes[Node] };
+		const uint32 NextOfBody{ Removed.NextOfBody };
+		if (Removed.Next != None) Nodes[Removed.Next].Prev = Removed.Prev;
+		if (Removed.Prev != None)
+		{
+			Nodes[Removed.Prev].Next = Removed.Next;
+		}
+		else
+		{
+			const uint Slot{ FindSlot(Removed.Cell) };
+			Slots[Slot].Head = Removed.Next;
+			if (Removed.Next == None) EraseSlot(Slot);
+		}
+
+		Nodes[Node].NextOfBody = FreeNode;
+		FreeNode = Node;
+		Node = NextOfBody;
+	}
+	FirstNodes[Body] = None;
+}
+
+
+template <typename Type>
+INLINE void STSpatialHash<Type>::EraseSlot(uint Slot)
+{
+	const uint Mask{ (uint)Slots.size() - 1 };
+	uint Hole{ Slot };
+	for (uint Next = (Hole + 1) & Mask; Slots[Next].Head != None; Next = (Next + 1) & Mask)
+	{
+		// A cell can fill the hole if the hole is between its home and where it is now.
+		const uint Home{ GetHome(Slots[Next].Cell) };
+		if (((Next - Home) & Mask) >= ((Next - Hole) & Mask))
+		{
+			Slots[Hole] = Slots[Next];
+			Hole = Next;
+		}
+	}
+	Slots[Hole].Head = None;
+	--Occupied;
+}
+
+
+template <typename Type>
+INLINE void STSpatialHash<Type>::Reserve(uint Bodies, uint CellsPerBody)
+{
+	Boxes.reserve(Bodies);
+	Ranges.reserve(Bodies);
+	FirstNodes.reserve(Bodies);
+	Nodes.reserve((size_t)Bodies * CellsPerBody);
+
+	uint Capacity{ (uint)Slots.size() };
+	while (Capacity < Bodies * CellsPerBody * 2) Capacity *= 2;
+	if (Capacity != (uint)Slots.size()) Rehash(Capacity);
+}
+
+
+template <typename Type>
+INLINE uint STSpatialHash<Type>::Update(const STBox<3, Type>* InBoxes, uint Count)
+{
+	const size_t Capacities[5]{ Boxes.capacity(), Ranges.capacity(), FirstNodes.capacity(), Nodes.capacity(), Slots.size() };
+	const uint OldCount{ (uint)Boxes.size() };
+	for (uint i = Count; i < OldCount; ++i)
+	{
+		Remove(i);
+	}
+	Boxes.resize(Count);
+	Ranges.resize(Count);
+	FirstNodes.resize(Count, None);
+
+	uint Moved{ 0 };
+	for (uint i = 0; i < Count; ++i)
+	{
+		Boxes[i] = InBoxes[i];
+		const SCellRange Range{ GetCell(InBoxes[i].GetMin()), GetCell(InBoxes[i].GetMax()) };
+		if (i < OldCount && Range.Lo == Ranges[i].Lo && Range.Hi == Ranges[i].Hi) continue;
+
+		if (i < OldCount) Remove(i);
+		Ranges[i] = Range;
+		Insert(i);
+		++Moved;
+	}
+
+	Grown = Capacities[0] != Boxes.capacity() || Capacities[1] != Ranges.capacity() || Capacities[2] != FirstNodes.capacity() || Capacities[3] != Nodes.capacity() || Capacities[4] != Slots.size();
+	return Moved;
+}
+
+
+template <typename Type>
+INLINE uint STSpatialHash<Type>::FindPairs(SBroadphasePair* Pairs, uint Capacity) const
+{
+	uint Found{ 0 };
+	for (const SSlot& Slot : Slots)
+	{
+		for (uint32 A = Slot.Head; A != None; A = Nodes[A].Next)
+		{
+			const STBox<3, Type>& BoxA{ Boxes[Nodes[A].Body] };
+			for (uint32 B = Nodes[A].Next; B != None; B = Nodes[B].Next)
+			{
+				const STBox<3, Type>& BoxB{ Boxes[Nodes[B].Body] };
+				if (!BoxA.Overlaps(BoxB)) continue;
+
+				// Both bodies are in the cell holding the lowest corner of their overlap, only that cell reports them.
+				if (GetCell(BoxA.GetMin().Max(BoxB.GetMin())) == Slot.Cell)
+				{
+					TBroadphase::Emit(Pairs, Capacity, Found, Nodes[A].Body, Nodes[B].Body);
+				}
+			}
+		}
+	}
+	return Found;
+}
@@ -0,0 +1,418 @@
+#pragma once
+#include "Vector.h"
+#include "VectorArray.h"
+#include "Box.h"
+#include "Matrix.h"
+#include "../Math/SIMD.h"
+#include <bit>
+
+
+// Where a sphere or box is relative to a plane or frustum.
+enum class ECullResult : uint8
+{
+	Outside,		// Entirely behind a plane, nothing of it can be seen.
+	Intersecting,	// Crosses at least one plane.
+	Inside			// Entirely in front of every plane.
+};
+
+
+
+// Represents a plane as its normal and offset, stored together in a 4D vector so N . P + W is the signed distance of a point P.
+// Points with a positive distance are in front of the plane, the planes of a frustum face inwards.
+// @note - The distances are only in world units if the normal is unit length, see Normalize().
+// @template Type - The datatype this plane should use.
+template <typename Type>
+struct STPlane
+{
+private:
+	/// Properties
+
+	// The normal in x, y and z and the offset in w.
+	STVector<4, Type> Data;
+
+
+public:
+	/// Constructors
+
+	// Constructor, Default. Initializes a plane with a zero normal, which every point is on.
+	INLINE constexpr STPlane() :Data{ (Type)0 } {}
+
+	// Constructor, Initializes the plane from its normal and offset stored in a 4D vector.
+	// @param InData - The normal in x, y and z and the offset in w.
+	INLINE constexpr explicit STPlane(const STVector<4, Type>& InData) :Data{ InData } {}
+
+	// Constructor, Initializes the plane from its normal and offset.
+	// @param Normal - The direction the plane faces.
+	// @param Offset - The signed distance of the origin from the plane.
+	INLINE constexpr STPlane(const STVector<3, Type>& Normal, Type Offset) :Data{ Normal, Offset } {}
+
+	// Creates a plane facing a direction through a point.
+	// @param Normal - The direction the plane faces.
+	// @param Point - Any point on the plane.
+	// @return - The resulting plane.
+	static INLINE constexpr STPlane<Type> FromPoint(const STVector<3, Type>& Normal, const STVector<3, Type>& Point) { return STPlane<Type>{ Normal, -(Normal ^ Point) }; }
+
+
+
+	/// Functions
+
+	// Returns the normal in x, y and z and the offset in w.
+	INLINE constexpr const STVector<4, Type>& GetData() const { return Data; }
+
+	// Returns the direction the plane faces.
+	INLINE constexpr STVector<3, Type> GetNormal() const { return STVector<3, Type>{ Data[0], Data[1], Data[2] }; }
+
+	// Returns the signed distance of the origin from the plane.
+	INLINE constexpr Type GetOffset() const { return Data[3]; }
+
+	// Returns a copy of this plane scaled so its normal is unit length, the same plane with distances in world units.
+	INLINE STPlane<Type> Normalize() const { return STPlane<Type>{ Data * ((Type)1 / GetNormal().Length()) }; }
+
+	// Returns the signed distance of a point from the plane, positive in front of it.
+	// Each product is rounded before it is added, so STFrustum's batched functions get the same distance under FMA contraction.
+	// @param Point - The point to measure.
+	INLINE constexpr Type SignedDistance(const STVector<3, Type>& Point) const
+	{
+		using TMath::Unfused;
+		return ((Unfused(Data[0] * Point[0]) + Unfused(Data[1] * Point[1])) + Unfused(Data[2] * Point[2])) + Data[3];
+	}
+
+	// Returns which side of the plane a sphere is on.
+	// @param Center - The center of the sphere.
+	// @param Radius - The radius of the sphere.
+	// @return - Inside if the sphere is entirely in front of the plane.
+	INLINE constexpr ECullResult Classify(const STVector<3, Type>& Center, Type Radius) const;
+
+	// Returns which side of the plane a box is on.
+	// @param Box - The box to classify, an empty box is always outside.
+	// @return - Inside if the box is entirely in front of the plane.
+	INLINE constexpr ECullResult Classify(const STBox<3, Type>& Box) const;
+};
+
+
+
+// Represents the volume a camera can see as six inward facing planes, in the order left, right, bottom, top, near and far.
+// The batched culling functions classify TNativeLanes spheres or boxes at a time, 8 floats with AVX and AVX2,
+// and write the indices of the ones that are not outside as a packed list with TCompact::CompressIndices().
+// @note - The batched and single functions do the same operations in the same order, and every product that is added goes through
+//	TMath::Unfused(), so they agree whatever -ffp-contract or /fp: setting the code is built with.
+// @template Type - The datatype this frustum should use.
+template <typename Type>
+struct STFrustum
+{
+public:
+	// How many planes bound a frustum.
+	static constexpr uint PlaneCount{ 6 };
+
+	// How many spheres or boxes the batched functions classify together.
+	static constexpr uint Lanes{ STVectorArray<3, Type>::Lanes };
+
+	// The lanes used by the batched functions.
+	typedef TLanes<Type, Lanes> SLanes;
+
+
+private:
+	/// Properties
+
+	// The planes, facing inwards.
+	STPlane<Type> Planes[PlaneCount];
+
+
+	/// Functions
+
+	// Classifies every element in groups of Lanes and packs the indices of the ones that are not outside.
+	// @param Count - How many elements there are.
+	// @param Visible - Receives the indices of the elements that are not outside.
+	// @param Results - Receives the result of every element, can be nullptr.
+	// @param Func - Takes the index of the first element of a group and sets bit masks of the elements that are outside and inside.
+	// @return - How many indices were written to Visible.
+	template <typename Function>
+	INLINE uint Cull(uint Count, uint32* Visible, ECullResult* Results, Function Func) const;
+
+
+public:
+	/// Constructors
+
+	// Constructor, Default. Initializes a frustum of zero planes, which contains every point.
+	INLINE constexpr STFrustum() = default;
+
+	// Constructor, Initializes the frustum with its planes.
+	// @param InPlanes - The left, right, bottom, top, near and far planes, facing inwards.
+	INLINE constexpr explicit STFrustum(const STPlane<Type> (&InPlanes)[PlaneCount]);
+
+	// Creates the frustum of a view projection matrix, the planes are normalized.
+	// @param ViewProjection - Transforms world space row vectors to clip space.
+	// @param ZeroToOneDepth - True if clip space depth runs from 0 to w like Direct3D and Vulkan, false if it runs from -w to w like OpenGL.
+	// @return - The resulting frustum.
+	static INLINE STFrustum<Type> FromMatrix(const STMatrix<4, 4, Type>& ViewProjection, bool ZeroToOneDepth = true);
+
+
+
+	/// Functions
+
+	// Returns one of the planes.
+	// @param Index - 0 to 5 for the left, right, bottom, top, near and far planes.
+	INLINE constexpr const STPlane<Type>& GetPlane(uint Index) const { return Planes[Index]; }
+
+	// Returns where a sphere is relative to the frustum.
+	// @param Center - The center of the sphere.
+	// @param Radius - The radius of the sphere.
+	INLINE constexpr ECullResult Classify(const STVector<3, Type>& Center, Type Radius) const;
+
+	// Returns where a box is relative to the frustum.
+	// @param Box - The box to classify, an empty box is always outside.
+	INLINE constexpr ECullResult Classify(const STBox<3, Type>& Box) const;
+
+	// Classifies an array of spheres and writes the indices of the ones that are not outside, in order.
+	// @param Centers - The center of each sphere.
+	// @param Radii - The radius of each sphere, Centers.Num() of them.
+	// @param Visible - Receives the indices of the spheres that are not outside, must have space for Centers.Num() indices.
+	// @param Results - Receives the result of every sphere if not nullptr.
+	// @return - How many indices were written to Visible.
+	INLINE uint CullSpheres(const STVectorArray<3, Type>& Centers, const Type* Radii, uint32* Visible, ECullResult* Results = nullptr) const;
+
+	// Classifies an array of boxes and writes the indices of the ones that are not outside, in order.
+	// @param Mins - The lowest corner of each box.
+	// @param Maxs - The highest corner of each box, must be the same length as Mins.
+	// @param Visible - Receives the indices of the boxes that are not outside, must have space for Mins.Num() indices.
+	// @param Results - Receives the result of every box if not nullptr.
+	// @return - How many indices were written to Visible, 0 without writing anything if Maxs is not the same length as Mins.
+	INLINE uint CullBoxes(const STVectorArray<3, Type>& Mins, const STVectorArray<3, Type>& Maxs, uint32* Visible, ECullResult* Results = nullptr) const;
+};
+
+
+
+// A float plane.
+typedef STPlane<float> SPlane;
+
+// A double type plane.
+typedef STPlane<double> SPlaned;
+
+// A float frustum.
+typedef STFrustum<float> SFrustum;
+
+// A double type frustum.
+typedef STFrustum<double> SFrustumd;
+
+
+
+template <typename Type>
+INLINE constexpr ECullResult STPlane<Type>::Classify(const STVector<3, Type>& Center, Type Radius) const
+{
+	const Type Distance{ SignedDistance(Center) };
+	if (Distance < -Radius) return ECullResult::Outside;
+	return (Distance >= Radius) ? ECullResult::Inside : ECullResult::Intersecting;
+}
+
+
+template <typename Type>
+INLINE constexpr ECullResult STPlane<Type>::Classify(const STBox<3, Type>& Box) const
+{
+	if (!Box.IsValid()) return ECullResult::Outside;
+
+	// How far the box reaches along the normal from its center. Worked out per axis rather than with the vector operators,
+	// whose NaN policy would change the center and extent of a box with infinite bounds and stop it matching CullBoxes().
+	STVector<3, Type> Center, Extent;
+	for (uint j = 0; j < 3; ++j)
+	{
+		Center[j] = (Box.GetMin()[j] + Box.GetMax()[j]) * (Type)0.5f;
+		Extent[j] = (Box.GetMax()[j] - Box.GetMin()[j]) * (Type)0.5f;
+	}
+	using TMath::Unfused;
+	const Type Radius{ (Unfused(TMath::Abs(Data[0]) * Extent[0]) + Unfused(TMath::Abs(Data[1]) * Extent[1])) + Unfused(TMath::Abs(Data[2]) * Extent[2]) };
+	const Type Distance{ SignedDistance(Center) };
+	if (Distance < -Radius) return ECullResult::Outside;
+	return (Distance >= Radius) ? ECullResult::Inside : ECullResult::Intersecting;
+}
+
+
+
+template <typename Type>
+INLINE constexpr STFrustum<Type>::STFrustum(const STPlane<Type> (&InPlanes)[PlaneCount])
+{
+	for (uint i = 0; i < PlaneCount; ++i)
+	{
+		Planes[i] = InPlanes[i];
+	}
+}
+
+
+template <typename Type>
+INLINE STFrustum<Type> STFrustum<Type>::FromMatrix(const STMatrix<4, 4, Type>& ViewProjection, bool ZeroToOneDepth)
+{
+	// Row vectors give clip space x, y, z and w as dot products with the matrix' columns, each plane is a bound like x >= -w.
+	STVector<4, Type> Columns[4];
+	for (uint j = 0; j < 4; ++j)
+	{
+		Columns[j] = STVector<4, Type>{ ViewProjection[0][j], ViewProjection[1][j], ViewProjection[2][j], ViewProjection[3][j] };
+	}
+
+	STFrustum<Type> Result;
+	Result.Planes[0] = STPlane<Type>{ Columns[3] + Columns[0] }.Normalize();
+	Result.Planes[1] = STPlane<Type>{ Columns[3] - Columns[0] }.Normalize();
+	Result.Planes[2] = STPlane<Type>{ Columns[3] + Columns[1] }.Normalize();
+	Result.Planes[3] = STPlane<Type>{ Columns[3] - Columns[1] }.Normalize();
+	Result.Planes[4] = STPlane<Type>{ ZeroToOneDepth ? Columns[2] : Columns[3] + Columns[2] }.Normalize();
+	Result.Planes[5] = STPlane<Type>{ Columns[3] - Columns[2] }.Normalize();
+	return Result;
+}
+
+
+template <typename Type>
+INLINE constexpr ECullResult STFrustum<Type>::Classify(const STVector<3, Type>& Center, Type Radius) const
+{
+	ECullResult Result{ ECullResult::Inside };
+	for (uint i = 0; i < PlaneCount; ++i)
+	{
+		const ECullResult Side{ Planes[i].Classify(Center, Radius) };
+		if (Side == ECullResult::Outside) return Side;
+		if (Side == ECullResult::Intersecting) Result = Side;
+	}
+	return Result;
+}
+
+
+template <typename Type>
+INLINE constexpr ECullResult STFrustum<Type>::Classify(const STBox<3, Type>& Box) const
+{
+	ECullResult Result{ ECullResult::Inside };
+	for (uint i = 0; i < PlaneCount; ++i)
+	{
+		const ECullResult Side{ Planes[i].Classify(Box) };
+		if (Side == ECullResult::Outside) return Side;
+		if (Side == ECullResult::Intersecting) Result = Side;
+	}
+	return Result;
+}
+
+
+template <typename Type>
+template <typename Function>
+INLINE uint STFrustum<Type>::Cull(uint Count, uint32* Visible, ECullResult* Results, Function Func) const
+{
+	uint Written{ 0 };
+	for (uint Begin = 0; Begin < Count; Begin += Lanes)
+	{
+		uint Outside, Inside;
+		Func(Begin, Outside, Inside);
+
+		// The last group reads the arrays' padding, its lanes past the end are dropped.
+		const uint Valid{ (Count - Begin >= Lanes) ? Lanes : Count - Begin };
+		const uint Kept{ ~Outside & ((1u << Valid) - 1) };
+		if (Valid == Lanes)
+		{
+			Written += TCompact::CompressIndices<Lanes>(Kept, Begin, Visible + Written);
+		}
+		else
+		{
+			// CompressIndices() may write a whole group, which would not fit at the end of Visible.
+			for (uint Bits = Kept; Bits != 0; Bits &= Bits - 1)
+			{
+				Visible[Written++] = Begin + (uint)std::countr_zero(Bits);
+			}
+		}
+
+		if (Results)
+		{
+			for (uint i = 0; i < Valid; ++i)
+			{
+				Results[Begin + i] = ((Outside >> i) & 1) ? ECullResult::Outside : (((Inside >> i) & 1) ? ECullResult::Inside : ECullResult::Intersecting);
+			}
+		}
+	}
+	return Written;
+}
+
+
+template <typename Type>
+INLINE uint STFrustum<Type>::CullSpheres(const STVectorArray<3, Type>& Centers, const Type* Radii, uint32* Visible, ECullResult* Results) const
+{
+	const uint Count{ Centers.Num() };
+	SLanes Normals[PlaneCount][3], Offsets[PlaneCount];
+	for (uint i = 0; i < PlaneCount; ++i)
+	{
+		for (uint j = 0; j < 3; ++j)
+		{
+			Normals[i][j] = SLanes{ Planes[i].GetData()[j] };
+		}
+		Offsets[i] = SLanes{ Planes[i].GetOffset() };
+	}
+
+	return Cull(Count, Visible, Results, [&](uint Begin, uint& OutsideMask, uint& InsideMask)
+		{
+			const SLanes X{ SLanes::Load(Centers.GetAxis(0) + Begin) };
+			const SLanes Y{ SLanes::Load(Centers.GetAxis(1) + Begin) };
+			const SLanes Z{ SLanes::Load(Centers.GetAxis(2) + Begin) };
+			SLanes Radius;
+			if (Count - Begin >= Lanes)
+			{
+				Radius = SLanes::LoadUnaligned(Radii + Begin);
+			}
+			else
+			{
+				// Radii has no padding, so the last group is copied out.
+				alignas(alignof(SLanes)) Type Tail[Lanes]{};
+				for (uint i = 0; i < Count - Begin; ++i) Tail[i] = Radii[Begin + i];
+				Radius = SLanes::Load(Tail);
+			}
+
+			// Written the same way as STPlane::Classify(), as the condition for each result.
+			using TMath::Unfused;
+			const SLanes NegativeRadius{ -Radius };
+			SLanes Outside{ (Type)0 }, Inside{ Radius == Radius };
+			for (uint i = 0; i < PlaneCount; ++i)
+			{
+				const SLanes Distance{ ((Unfused(Normals[i][0] * X) + Unfused(Normals[i][1] * Y)) + Unfused(Normals[i][2] * Z)) + Offsets[i] };
+				Outside = Outside | (Distance < NegativeRadius);
+				Inside = Inside & (Distance >= Radius);
+			}
+			OutsideMask = Outside.MoveMask();
+			InsideMask = Inside.MoveMask() & ~OutsideMask;
+		});
+}
+
+
+template <typename Type>
+INLINE uint STFrustum<Type>::CullBoxes(const STVectorArray<3, Type>& Mins, const STVectorArray<3, Type>& Maxs, uint32* Visible, ECullResult* Results) const
+{
+	SLanes Normals[PlaneCount][3], AbsNormals[PlaneCount][3], Offsets[PlaneCount];
+	for (uint i = 0; i < PlaneCount; ++i)
+	{
+		for (uint j = 0; j < 3; ++j)
+		{
+			Normals[i][j] = SLanes{ Planes[i].GetData()[j] };
+			AbsNormals[i][j] = SLanes{ TMath::Abs(Planes[i].GetData()[j]) };
+		}
+		Offsets[i] = SLanes{ Planes[i].GetOffset() };
+	}
+
+	if (Mins.Num() != Maxs.Num()) return 0;
+
+	const SLanes Half{ (Type)0.5f };
+	return Cull(Mins.Num(), Visible, Results, [&](uint Begin, uint& OutsideMask, uint& InsideMask)
+		{
+			SLanes Min[3], Max[3], Center[3], Extent[3];
+			for (uint j = 0; j < 3; ++j)
+			{
+				Min[j] = SLanes::Load(Mins.GetAxis(j) + Begin);
+				Max[j] = SLanes::Load(Maxs.GetAxis(j) + Begin);
+				Center[j] = (Min[j] + Max[j]) * Half;
+				Extent[j] = (Max[j] - Min[j]) * Half;
+			}
+
+			// Empty boxes are outside, the same per axis test as STBox::IsValid(), which is false for NaN.
+			const SLanes Valid{ (Min[0] <= Max[0]) & (Min[1] <= Max[1]) & (Min[2] <= Max[2]) };
+
+			using TMath::Unfused;
+			SLanes Outside{ (Type)0 }, Inside{ Valid };
+			for (uint i = 0; i < PlaneCount; ++i)
+			{
+				const SLanes Radius{ (Unfused(AbsNormals[i][0] * Extent[0]) + Unfused(AbsNormals[i][1] * Extent[1])) + Unfused(AbsNormals[i][2] * Extent[2]) };
+				const SLanes Distance{ ((Unfused(Normals[i][0] * Center[0]) + Unfused(Normals[i][1] * Center[1])) + Unfused(Normals[i][2] * Center[2])) + Offsets[i] };
+				Outside = Outside | (Distance < -Radius);
+				Inside = Inside & (Distance >= Radius);
+			}
+			OutsideMask = Outside.MoveMask() | (~Valid.MoveMask() & ((1u << Lanes) - 1));
+			InsideMask = Inside.MoveMask() & ~OutsideMask;
+		});
+}
@@ -0,0 +1,431 @@
+#pragma once
+#include "Box.h"
+#include "../Math/Reduce.h"
+#include "../Memory/Arena.h"
+#include <algorithm>
+#include <vector>
+
+
+
+// A k-d tree over points for nearest neighbour and radius queries.
+// The points are reordered so every range's median splits it in half, each half is the child below it. There are no
+// node pointers, a node is a range of the point array and its children are found by halving the range.
+// Ranges of LeafSize points or fewer are leaves and are searched linearly.
+// @note - Points are referred to by their index in the array the tree was built from.
+// @template Size - How many dimensions the points have.
+// @template Type - The datatype the points use, float or double.
+template <uint Size, typename Type>
+struct STKDTree
+{
+public:
+	// The index returned by the queries when no point was found.
+	static constexpr uint32 None{ ~0u };
+
+	// Ranges with this many points or fewer are not split.
+	static constexpr uint LeafSize{ 8 };
+
+	// Ranges with fewer points than this are always built on the thread that reached them.
+	static constexpr uint ParallelThreshold{ 16384 };
+
+
+private:
+	/// Properties
+
+	// The points in tree order.
+	std::vector<STVector<Size, Type>> Points;
+
+	// The index each point had in the array the tree was built from, in tree order.
+	std::vector<uint32> Indices;
+
+	// The axis each range is split on, stored at the position of the range's median.
+	std::vector<uint8> Axes;
+
+	// The bounds of every point.
+	STBox<Size, Type> Bounds;
+
+
+	// A range of the tree still to be searched.
+	struct SEntry
+	{
+		// The first point.
+		uint Begin;
+
+		// One past the last point.
+		uint End;
+
+		// The squared distance from the query to the range's side of the parent's split, no point in the range is closer.
+		Type DistanceSquared;
+	};
+
+	// The deepest a search can go, the ranges halve at every level so this covers every count a uint can hold.
+	static constexpr uint MaxStack{ 64 };
+
+
+	/// Functions
+
+	// A point and its index, kept together while building so both move with a single swap.
+	struct SItem
+	{
+		// The point.
+		STVector<Size, Type> Point;
+
+		// The index of the point in the array the tree was built from.
+		uint32 Index;
+	};
+
+	// Splits a range at its median and builds both halves.
+	// @note - Not INLINE, it recurses.
+	// @param Items - Every point being built, in tree order once the build finishes.
+	// @param Begin - The first point in the range.
+	// @param End - One past the last point in the range.
+	// @param Parallel - Whether large halves are built across SThreadPool::Get().
+	void BuildRange(SItem* Items, uint Begin, uint End, bool Parallel);
+
+	// Visits every range that could hold a point within a distance of a query, closest ranges first.
+	// @param Point - The query point.
+	// @param MaxDistanceSquared - Called to get the current squared search distance, ranges further away are skipped.
+	// @param Visit - Called with the tree position and squared distance of each point in a visited range.
+	template <typename DistanceFunction, typename Function>
+	INLINE void Search(const STVector<Size, Type>& Point, DistanceFunction MaxDistanceSquared, Function Visit) const;
+
+	// Runs a function for every query, split across SThreadPool::Get().
+	// @param Count - How many queries there are.
+	// @param Parallel - Whether to use the pool, false runs every query on the calling thread.
+	// @param Function - Called with the index of each query.
+	template <typename Function>
+	static INLINE void ForEachQuery(uint Count, bool Parallel, Function Func);
+
+
+public:
+	/// Constructors
+
+	// Constructor, Default. Initializes an empty tree.
+	INLINE STKDTree();
+
+	// Constructor, Builds a tree over points.
+	// @param InPoints - The points.
+	// @param Count - How many points there are.
+	INLINE STKDTree(const STVector<Size, Type>* InPoints, uint Count);
+
+
+
+	/// Functions
+
+	// Builds the tree over points, replacing any previous build.
+	// @param InPoints - The points, they are copied into the tree.
+	// @param Count - How many points there are.
+	// @param Parallel - Builds large ranges across SThreadPool::Get(), false builds on the calling thread alone.
+	INLINE void Build(const STVector<Size, Type>* InPoints, uint Count, bool Parallel = true);
+
+	// Finds the closest point to a query.
+	// @param Point - The query point.
+	// @param DistanceSquared - Set to the squared distance to the closest point, only written when a point is found.
+	// @param MaxDistance - Points further away than this are ignored.
+	// @return - The index of the closest point, None if the tree is empty or nothing is within MaxDistance.
+	INLINE uint32 Nearest(const STVector<Size, Type>& Point, Type& DistanceSquared, Type MaxDistance = std::numeric_limits<Type>::max()) const;
+
+	// Finds the closest point to a query.
+	// @param Point - The query point.
+	// @return - The index of the closest point, None if the tree is empty.
+	INLINE uint32 Nearest(const STVector<Size, Type>& Point) const;
+
+	// Finds the K closest points to a query, sorted from closest to furthest.
+	// @note - Each candidate is insertion sorted into the results, intended for K up to a few dozen.
+	// @param Point - The query point.
+	// @param K - How many points to find.
+	// @param OutIndices - Where to store the index of each point found, must have space for K.
+	// @param OutDistancesSquared - Where to store the squared distance of each point found, must have space for K.
+	// @param MaxDistance - Points further away than this are ignored.
+	// @return - How many points were found, less than K if the tree has fewer points within MaxDistance.
+	INLINE uint KNearest(const STVector<Size, Type>& Point, uint K, uint32* OutIndices, Type* OutDistancesSquared, Type MaxDistance = std::numeric_limits<Type>::max()) const;
+
+	// Visits every point within a distance of a query, in no particular order.
+	// @param Point - The query point.
+	// @param Radius - How far from the query to search, points exactly this far away are included.
+	// @param Visit - Called with the index and squared distance of each point found.
+	template <typename Function>
+	INLINE void Radius(const STVector<Size, Type>& Point, Type Radius, Function&& Visit) const;
+
+	// Finds every point within a distance of a query, in no particular order.
+	// @param Point - The query point.
+	// @param Radius - How far from the query to search, points exactly this far away are included.
+	// @param OutIndices - Cleared and filled with the index of each point found.
+	INLINE void Radius(const STVector<Size, Type>& Point, Type Radius, std::vector<uint32>& OutIndices) const;
+
+	// Finds the K closest points to many queries, split across SThreadPool::Get().
+	// @param Queries - The query points.
+	// @param Count - How many queries there are.
+	// @param K - How many points to find for each query.
+	// @param OutIndices - K results per query one after another, missing results are None.
+	// @param OutDistancesSquared - K results per query one after another, missing results are the largest Type. May be nullptr.
+	// @param Parallel - Whether to use the pool, false runs every query on the calling thread.
+	INLINE void KNearest(const STVector<Size, Type>* Queries, uint Count, uint K, uint32* OutIndices, Type* OutDistancesSquared, bool Parallel = true) const;
+
+	// Finds every point within a distance of many queries, split across SThreadPool::Get().
+	// @param Queries - The query points.
+	// @param Count - How many queries there are.
+	// @param Radius - How far from each query to search.
+	// @param OutIndices - Resized to Count, each entry is filled with the points found for that query.
+	// @param Parallel - Whether to use the pool, false runs every query on the calling thread.
+	INLINE void Radius(const STVector<Size, Type>* Queries, uint Count, Type Radius, std::vector<std::vector<uint32>>& OutIndices, bool Parallel = true) const;
+
+	// Returns how many points are in the tree.
+	INLINE uint Num() const { return (uint)Points.size(); }
+
+	// Returns true if the tree has no points.
+	INLINE bool IsEmpty() const { return Points.empty(); }
+
+	// Returns the bounds of every point.
+	INLINE const STBox<Size, Type>& GetBounds() const { return Bounds; }
+};
+
+
+
+// A 2D floating point k-d tree.
+typedef STKDTree<2, float> SKDTree2;
+
+// A 2D double type k-d tree.
+typedef STKDTree<2, double> SKDTree2d;
+
+// A 3D floating point k-d tree.
+typedef STKDTree<3, float> SKDTree3;
+
+// A 3D double type k-d tree.
+typedef STKDTree<3, double> SKDTree3d;
+
+// A 4D floating point k-d tree.
+typedef STKDTree<4, float> SKDTree4;
+
+// A 4D double type k-d tree.
+typedef STKDTree<4, double> SKDTree4d;
+
+
+
+template <uint Size, typename Type>
+INLINE STKDTree<Size, Type>::STKDTree()
+{
+	ASSERT(std::is_floating_point<Type>::value, "K-d trees need a floating point type.");
+	ASSERT(Size <= 255, "The split axis is stored in a byte.");
+}
+
+
+template <uint Size, typename Type>
+INLINE STKDTree<Size, Type>::STKDTree(const STVector<Size, Type>* InPoints, uint Count)
+	:STKDTree{}
+{
+	Build(InPoints, Count);
+}
+
+
+template <uint Size, typename Type>
+INLINE void STKDTree<Size, Type>::Build(const STVector<Size, Type>* InPoints, uint Count, bool Parallel)
+{
+	std::vector<SItem> Items(Count);
+	for (uint i = 0; i < Count; ++i) Items[i] = SItem{ InPoints[i], i };
+	Axes.assign(Count, 0);
+	Bounds = TReduce::Bounds(InPoints, Count, true);
+
+	BuildRange(Items.data(), 0, Count, Parallel);
+
+	// The queries only read the points until one is accepted, so the indices are kept apart from them.
+	Points.resize(Count);
+	Indices.resize(Count);
+	for (uint i = 0; i < Count; ++i)
+	{
+		Points[i] = Items[i].Point;
+		Indices[i] = Items[i].Index;
+	}
+}
+
+
+template <uint Size, typename Type>
+void STKDTree<Size, Type>::BuildRange(SItem* Items, uint Begin, uint End, bool Parallel)
+{
+	if (End - Begin <= LeafSize) return;
+
+	// Splitting the widest axis keeps the ranges close to cubes, which prunes better than cycling through the axis'.
+	STBox<Size, Type> RangeBounds;
+	for (uint i = Begin; i < End; ++i) RangeBounds += Items[i].Point;
+	const STVector<Size, Type> Extent{ RangeBounds.GetSize() };
+	uint8 Axis{ 0 };
+	for (uint i = 1; i < Size; ++i)
+	{
+		if (Extent[i] > Extent[Axis]) Axis = (uint8)i;
+	}
+
+	const uint Middle{ Begin + ((End - Begin) / 2) };
+	std::nth_element(Items + Begin, Items + Middle, Items + End, [Axis](const SItem& A, const SItem& B) { return A.Point[Axis] < B.Point[Axis]; });
+	Axes[Middle] = Axis;
+
+	// The halves never overlap, so one can be stolen by another thread of the pool while this one builds the other.
+	const uint Halves[3]{ Begin, Middle, End };
+	auto BuildHalves = [&](uint First, uint Last)
+	{
+		for (uint i = First; i < Last; ++i) BuildRange(Items, Halves[i] + i, Halves[i + 1], Parallel);
+	};
+	if (Parallel && End - Begin >= ParallelThreshold) ParallelFor(2, BuildHalves);
+	else BuildHalves(0, 2);
+}
+
+
+template <uint Size, typename Type>
+template <typename DistanceFunction, typename Function>
+INLINE void STKDTree<Size, Type>::Search(const STVector<Size, Type>& Point, DistanceFunction MaxDistanceSquared, Function Visit) const
+{
+	if (Points.empty()) return;
+
+	SEntry Stack[MaxStack];
+	uint StackSize{ 1 };
+	Stack[0] = SEntry{ 0, (uint)Points.size(), (Type)0 };
+	while (StackSize > 0)
+	{
+		const SEntry Entry{ Stack[--StackSize] };
+		if (Entry.DistanceSquared > MaxDistanceSquared()) continue;
+
+		if (Entry.End - Entry.Begin <= LeafSize)
+		{
+			for (uint i = Entry.Begin; i < Entry.End; ++i)
+			{
+				const STVector<Size, Type> Offset{ Points[i] - Point };
+				Visit(i, Offset ^ Offset);
+			}
+			continue;
+		}
+
+		const uint Middle{ Entry.Begin + ((Entry.End - Entry.Begin) / 2) };
+		const uint Axis{ Axes[Middle] };
+		const STVector<Size, Type> Offset{ Points[Middle] - Point };
+		Visit(Middle, Offset ^ Offset);
+
+		// The far side is pushed first so the side holding the query is searched next.
+		const Type Split{ Points[Middle][Axis] - Point[Axis] };
+		const SEntry Low{ Entry.Begin, Middle, (Split < (Type)0) ? std::max(Entry.DistanceSquared, Split * Split) : Entry.DistanceSquared };
+		const SEntry High{ Middle + 1, Entry.End, (Split > (Type)0) ? std::max(Entry.DistanceSquared, Split * Split) : Entry.DistanceSquared };
+		if (Split > (Type)0)
+		{
+			Stack[StackSize++] = High;
+			Stack[StackSize++] = Low;
+		}
+		else
+		{
+			Stack[StackSize++] = Low;
+			Stack[StackSize++] = High;
+		}
+	}
+}
+
+
+template <uint Size, typename Type>
+INLINE uint32 STKDTree<Size, Type>::Nearest(const STVector<Size, Type>& Point, Type& DistanceSquared, Type MaxDistance) const
+{
+	uint32 Closest{ None };
+	Type ClosestDistance{ (MaxDistance < std::numeric_limits<Type>::max()) ? MaxDistance * MaxDistance : std::numeric_limits<Type>::max() };
+	Search(Point, [&ClosestDistance]() { return ClosestDistance; }, [&](uint Position, Type Distance)
+		{
+			if (Distance > ClosestDistance || (Distance == ClosestDistance && Closest != None)) return;
+			ClosestDistance = Distance;
+			Closest = Indices[Position];
+		});
+	if (Closest != None) DistanceSquared = ClosestDistance;
+	return Closest;
+}
+
+
+template <uint Size, typename Type>
+INLINE uint32 STKDTree<Size, Type>::Nearest(const STVector<Size, Type>& Point) const
+{
+	Type DistanceSquared;
+	return Nearest(Point, DistanceSquared);
+}
+
+
+template <uint Size, typename Type>
+INLINE uint STKDTree<Size, Type>::KNearest(const STVector<Size, Type>& Point, uint K, uint32* OutIndices, Type* OutDistancesSquared, Type MaxDistance) const
+{
+	if (K == 0) return 0;
+
+	// The results are kept sorted, so the furthest is always the last and is the search distance once K are found.
+	uint Found{ 0 };
+	const Type Limit{ (MaxDistance < std::numeric_limits<Type>::max()) ? MaxDistance * MaxDistance : std::numeric_limits<Type>::max() };
+	Search(Point, [&]() { return (Found == K) ? OutDistancesSquared[K - 1] : Limit; }, [&](uint Position, Type Distance)
+		{
+			if (Distance > Limit || (Found == K && Distance >= OutDistancesSquared[K - 1])) return;
+			uint i{ (Found < K) ? Found++ : K - 1 };
+			for (; i > 0 && OutDistancesSquared[i - 1] > Distance; --i)
+			{
+				OutDistancesSquared[i] = OutDistancesSquared[i - 1];
+				OutIndices[i] = OutIndices[i - 1];
+			}
+			OutDistancesSquared[i] = Distance;
+			OutIndices[i] = Indices[Position];
+		});
+	return Found;
+}
+
+
+template <uint Size, typename Type>
+template <typename Function>
+INLINE void STKDTree<Size, Type>::Radius(const STVector<Size, Type>& Point, Type Radius, Function&& Visit) const
+{
+	const Type RadiusSquared{ Radius * Radius };
+	Search(Point, [RadiusSquared]() { return RadiusSquared; }, [&](uint Position, Type Distance)
+		{
+			if (Distance <= RadiusSquared) Visit(Indices[Position], Distance);
+		});
+}
+
+
+template <uint Size, typename Type>
+INLINE void STKDTree<Size, Type>::Radius(const STVector<Size, Type>& Point, Type Radius, std::vector<uint32>& OutIndices) const
+{
+	OutIndices.clear();
+	this->Radius(Point, Radius, [&OutIndices](uint32 Index, Type) { OutIndices.push_back(Index); });
+}
+
+
+template <uint Size, typename Type>
+template <typename Function>
+INLINE void STKDTree<Size, Type>::ForEachQuery(uint Count, bool Parallel, Function Func)
+{
+	auto Work = [&Func](uint Begin, uint End)
+	{
+		for (uint i = Begin; i < End; ++i) Func(i);
+	};
+
+	// Queries are split into small pieces so threads that get cheap queries steal more of them. The pool's threads live
+	// as long as the program, so their arenas are reused by every batch instead of being allocated again.
+	if (Parallel) ParallelFor(Count, Work, 64);
+	else Work(0, Count);
+}
+
+
+template <uint Size, typename Type>
+INLINE void STKDTree<Size, Type>::KNearest(const STVector<Size, Type>* Queries, uint Count, uint K, uint32* OutIndices, Type* OutDistancesSquared, bool Parallel) const
+{
+	ForEachQuery(Count, Parallel, [&](uint Query)
+		{
+			uint32* QueryIndices{ OutIndices + ((size_t)Query * K) };
+			Type LocalDistances[64];
+			SArenaScope Scope;
+			Type* QueryDistances{ OutDistancesSquared ? OutDistancesSquared + ((size_t)Query * K) : LocalDistances };
+			if (!OutDistancesSquared && K > 64)
+			{
+				QueryDistances = Scope.GetArena().Allocate<Type>(K);
+			}
+
+			const uint Found{ KNearest(Queries[Query], K, QueryIndices, QueryDistances) };
+			for (uint i = Found; i < K; ++i)
+			{
+				QueryIndices[i] = None;
+				QueryDistances[i] = std::numeric_limits<Type>::max();
+			}
+		});
+}
+
+
+template <uint Size, typename Type>
+INLINE void STKDTree<Size, Type>::Radius(const STVector<Size, Type>* Queries, uint Count, Type Radius, std::vector<std::vector<uint32>>& OutIndices, bool Parallel) const
+{
+	OutIndices.resize(Count);
+	ForEachQuery(Count, Parallel, [&](uint Query) { this->Radius(Queries[Query], Radius, OutIndices[Query]); });
+}
@@ -0,0 +1,541 @@
+#pragma once
+#include "Vector.h"
+#include "VectorArray.h"
+
+
+
+// Represents a linear or affine transformation as rows of vectors.
+// Vectors are treated as rows and multiplied from the left, the translation of an affine matrix is stored in its last row.
+// @template Rows - How many rows this matrix has.
+// @template Cols - How many columns this matrix has.
+// @template Type - The datatype this matrix should use.
+template <uint Rows, uint Cols, typename Type>
+struct STMatrix
+{
+private:
+	/// Properties
+
+	// Stores all rows of this matrix.
+	// @note - Rows with 4 floats or doubles are SIMD aligned, so each row is a single register.
+	STVector<Cols, Type> Data[Rows];
+
+	// The SIMD backend for this matrix's rows.
+	typedef TVectorSIMD<Cols, Type> SIMD;
+
+
+	/// Functions
+
+	// Transforms a batch of 3D vectors stored one after another.
+	// @template IsPoint - Should the translation be applied.
+	template <bool IsPoint>
+	INLINE void TransformBatch(const STVector<3, Type>* In, STVector<3, Type>* Out, uint Count) const;
+
+	// Transforms a batch of 3D vectors stored as a structure of arrays, long arrays are split across SThreadPool::Get().
+	// @template IsPoint - Should the translation be applied.
+	template <bool IsPoint>
+	INLINE void TransformBatch(const STVectorArray<3, Type>& In, STVectorArray<3, Type>& Out) const;
+
+
+public:
+	/// Constructors
+
+	// Constructor, Default. All components are zero.
+	INLINE STMatrix();
+
+	// Constructor, Initializes all matrix components with the inputted value.
+	// @param Value - The value used to initialize all components with.
+	INLINE STMatrix(Type Value);
+
+	// Constructor, Initiates a matrix with 3 rows.
+	// @param R0 - The first row.
+	// @param R1 - The second row.
+	// @param R2 - The third row.
+	INLINE STMatrix(const STVector<Cols, Type>& R0, const STVector<Cols, Type>& R1, const STVector<Cols, Type>& R2);
+
+	// Constructor, Initiates a matrix with 4 rows.
+	// @param R0 - The first row.
+	// @param R1 - The second row.
+	// @param R2 - The third row.
+	// @param R3 - The fourth row, the translation of an affine matrix.
+	INLINE STMatrix(const STVector<Cols, Type>& R0, const STVector<Cols, Type>& R1, const STVector<Cols, Type>& R2, const STVector<Cols, Type>& R3);
+
+	// Creates an identity matrix.
+	static INLINE STMatrix<Rows, Cols, Type> Identity();
+
+
+
+	/// Operators
+
+	// Operator, Returns the row at the given index.
+	INLINE STVector<Cols, Type>& operator[](const uint& Index) { return Data[Index]; }
+
+	// Operator, Returns the row at the given index.
+	INLINE const STVector<Cols, Type>& operator[](const uint& Index) const { return Data[Index]; }
+
+	// Operator, Returns the result of multiplying this matrix by another matrix, this transformation is applied first.
+	// @template Cols2 - The amount of columns the other matrix has.
+	template <uint Cols2>
+	INLINE STMatrix<Rows, Cols2, Type> operator*(const STMatrix<Cols, Cols2, Type>& Other) const;
+
+	// Operator, Multiplies this matrix by another matrix.
+	INLINE STMatrix<Rows, Cols, Type>& operator*=(const STMatrix<Cols, Cols, Type>& Other);
+
+	// Operator, Returns the result of multiplying every component of this matrix by a value.
+	INLINE STMatrix<Rows, Cols, Type> operator*(const Type& Value) const;
+
+	// Operator, Returns the result of an addition between this matrix and another matrix.
+	INLINE STMatrix<Rows, Cols, Type> operator+(const STMatrix<Rows, Cols, Type>& Other) const;
+
+	// Operator, Returns the result of a subtraction between this matrix and another matrix.
+	INLINE STMatrix<Rows, Cols, Type> operator-(const STMatrix<Rows, Cols, Type>& Other) const;
+
+	// Operator, Returns the result of transforming a row vector by a matrix.
+	INLINE friend STVector<Cols, Type> operator*(const STVector<Rows, Type>& Vector, const STMatrix<Rows, Cols, Type>& Matrix) { return Matrix.TransformVector(Vector); }
+
+
+
+	/// Functions
+
+	// Returns this matrix with its rows and columns swapped.
+	INLINE STMatrix<Cols, Rows, Type> Transpose() const;
+
+	// Calculates the inverse of an affine matrix, the last row is the translation and the last column is (0, 0, 0, 1).
+	// 3x3 matrices are treated as a linear transformation without translation.
+	// @note - Much cheaper than a general inverse, the result is undefined for matrices with a projection.
+	// @param Location - Where the inverse is calculated, reported if the matrix is singular.
+	// @return - The inverted matrix, or identity if the matrix is singular and the NaN policy sanitizes.
+	INLINE STMatrix<Rows, Cols, Type> InverseAffine(const std::source_location& Location = std::source_location::current()) const;
+
+	// Transforms a row vector by this matrix.
+	// @param Vector - The vector to transform.
+	// @return - The transformed vector.
+	INLINE STVector<Cols, Type> TransformVector(const STVector<Rows, Type>& Vector) const;
+
+	// Transforms a 3D point by this matrix, including the translation in the fourth row.
+	// @param Point - The point to transform.
+	// @return - The transformed point.
+	INLINE STVector<3, Type> TransformPoint(const STVector<3, Type>& Point) const;
+
+	// Transforms a 3D direction by this matrix, the translation is ignored.
+	// @param Direction - The direction to transform.
+	// @return - The transformed direction.
+	INLINE STVector<3, Type> TransformDirection(const STVector<3, Type>& Direction) const;
+
+	// Transforms an array of 3D points by this matrix, including the translation in the fourth row.
+	// Long arrays are split across SThreadPool::Get().
+	// @param In - The points to transform.
+	// @param Out - Where to store the transformed points, may be the same as In.
+	// @param Count - How many points to transform.
+	INLINE void TransformPoints(const STVector<3, Type>* In, STVector<3, Type>* Out, uint Count) const;
+
+	// Transforms an array of 3D points by this matrix, including the translation in the fourth row.
+	// Long arrays are split across SThreadPool::Get().
+	// @param In - The points to transform.
+	// @param Out - Where to store the transformed points, may be the same as In. Resized to the number of points.
+	INLINE void TransformPoints(const STVectorArray<3, Type>& In, STVectorArray<3, Type>& Out) const;
+
+	// Transforms an array of 3D directions by this matrix, the translation is ignored.
+	// Long arrays are split across SThreadPool::Get().
+	// @param In - The directions to transform.
+	// @param Out - Where to store the transformed directions, may be the same as In.
+	// @param Count - How many directions to transform.
+	INLINE void TransformDirections(const STVector<3, Type>* In, STVector<3, Type>* Out, uint Count) const;
+
+	// Transforms an array of 3D directions by this matrix, the translation is ignored.
+	// Long arrays are split across SThreadPool::Get().
+	// @param In - The directions to transform.
+	// @param Out - Where to store the transformed directions, may be the same as In. Resized to the number of directions.
+	INLINE void TransformDirections(const STVectorArray<3, Type>& In, STVectorArray<3, Type>& Out) const;
+
+	// Returns true if this matrix is almost equal to another matrix.
+	// @param Other - The matrix to compare with.
+	// @param Threshold - The range in which each of the other matrix's components can be in.
+	// @return - Returns true if every component of the other matrix is within range of this matrix.
+	INLINE bool nearlyEqual(const STMatrix<Rows, Cols, Type>& Other, const Type& Threshold = MICRO_NUMBER) const;
+
+	// Prints out the matrix, one row per line.
+	INLINE void Print() const;
+};
+
+
+
+// A floating point matrix with 3 rows and 3 columns.
+typedef STMatrix<3, 3, float> SMatrix3;
+
+// A floating point matrix with 4 rows and 4 columns.
+typedef STMatrix<4, 4, float> SMatrix4;
+
+// A double type matrix with 3 rows and 3 columns.
+typedef STMatrix<3, 3, double> SMatrix3d;
+
+// A double type matrix with 4 rows and 4 columns.
+typedef STMatrix<4, 4, double> SMatrix4d;
+
+
+
+template <uint Rows, uint Cols, typename Type>
+STMatrix<Rows, Cols, Type>::STMatrix()
+{}
+
+
+template <uint Rows, uint Cols, typename Type>
+STMatrix<Rows, Cols, Type>::STMatrix(Type Value)
+{
+	for (uint i = 0; i < Rows; ++i)
+	{
+		Data[i] = STVector<Cols, Type>{ Value };
+	}
+}
+
+
+template <uint Rows, uint Cols, typename Type>
+STMatrix<Rows, Cols, Type>::STMatrix(const STVector<Cols, Type>& R0, const STVector<Cols, Type>& R1, const STVector<Cols, Type>& R2)
+{
+	ASSERT(Rows == 3, "Error: Illigal use of constructor. Does the matrix have the correct amount of rows?");
+	Data[0] = R0;
+	Data[1] = R1;
+	Data[2] = R2;
+}
+
+
+template <uint Rows, uint Cols, typename Type>
+STMatrix<Rows, Cols, Type>::STMatrix(const STVector<Cols, Type>& R0, const STVector<Cols, Type>& R1, const STVector<Cols, Type>& R2, const STVector<Cols, Type>& R3)
+{
+	ASSERT(Rows == 4, "Error: Illigal use of constructor. Does the matrix have the correct amount of rows?");
+	Data[0] = R0;
+	Data[1] = R1;
+	Data[2] = R2;
+	Data[3] = R3;
+}
+
+
+template <uint Rows, uint Cols, typename Type>
+INLINE STMatrix<Rows, Cols, Type> STMatrix<Rows, Cols, Type>::Identity()
+{
+	STMatrix<Rows, Cols, Type> Result;
+	for (uint i = 0; i < Rows && i < Cols; ++i)
+	{
+		Result[i][i] = (Type)1.0f;
+	}
+	return Result;
+}
+
+
+template <uint Rows, uint Cols, typename Type>
+template <uint Cols2>
+INLINE STMatrix<Rows, Cols2, Type> STMatrix<Rows, Cols, Type>::operator*(const STMatrix<Cols, Cols2, Type>& Other) const
+{
+	typedef TVectorSIMD<Cols2, Type> SIMD2;
+	STMatrix<Rows, Cols2, Type> Result;
+	if constexpr (SIMD2::Enabled)
+	{
+		// Each result row is a sum of the other matrix's rows scaled by this row's components.
+		typename SIMD2::Register B[Cols];
+		for (uint k = 0; k < Cols; ++k) B[k] = SIMD2::Load(Other[k].GetData());
+
+		for (uint i = 0; i < Rows; ++i)
+		{
+			typename SIMD2::Register Row{ SIMD2::Mul(SIMD2::Set(Data[i][0]), B[0]) };
+			for (uint k = 1; k < Cols; ++k)
+			{
+				Row = SIMD2::Add(Row, SIMD2::Mul(SIMD2::Set(Data[i][k]), B[k]));
+			}
+			SIMD2::Store(Result[i].GetData(), Row);
+		}
+	}
+	else
+	{
+		for (uint i = 0; i < Rows; ++i)
+		{
+			for (uint j = 0; j < Cols2; ++j)
+			{
+				Type Sum{ (Type)0.0f };
+				for (uint k = 0; k < Cols; ++k)
+				{
+					Sum += Data[i][k] * Other[k][j];
+				}
+				Result[i][j] = Sum;
+			}
+		}
+	}
+	return Result;
+}
+
+
+template <uint Rows, uint Cols, typename Type>
+INLINE STMatrix<Rows, Cols, Type>& STMatrix<Rows, Cols, Type>::operator*=(const STMatrix<Cols, Cols, Type>& Other)
+{
+	*this = *this * Other;
+	return *this;
+}
+
+
+template <uint Rows, uint Cols, typename Type>
+INLINE STMatrix<Rows, Cols, Type> STMatrix<Rows, Cols, Type>::operator*(const Type& Value) const
+{
+	STMatrix<Rows, Cols, Type> Result;
+	for (uint i = 0; i < Rows; ++i)
+	{
+		Result[i] = Data[i] * Value;
+	}
+	return Result;
+}
+
+
+template <uint Rows, uint Cols, typename Type>
+INLINE STMatrix<Rows, Cols, Type> STMatrix<Rows, Cols, Type>::operator+(const STMatrix<Rows, Cols, Type>& Other) const
+{
+	STMatrix<Rows, Cols, Type> Result;
+	for (uint i = 0; i < Rows; ++i)
+	{
+		Result[i] = Data[i] + Other[i];
+	}
+	return Result;
+}
+
+
+template <uint Rows, uint Cols, typename Type>
+INLINE STMatrix<Rows, Cols, Type> STMatrix<Rows, Cols, Type>::operator-(const STMatrix<Rows, Cols, Type>& Other) const
+{
+	STMatrix<Rows, Cols, Type> Result;
+	for (uint i = 0; i < Rows; ++i)
+	{
+		Result[i] = Data[i] - Other[i];
+	}
+	return Result;
+}
+
+
+template <uint Rows, uint Cols, typename Type>
+INLINE STMatrix<Cols, Rows, Type> STMatrix<Rows, Cols, Type>::Transpose() const
+{
+	STMatrix<Cols, Rows, Type> Result;
+	if constexpr (Rows == 4 && Cols == 4 && SIMD::Enabled)
+	{
+		typename SIMD::Register R0{ SIMD::Load(Data[0].GetData()) };
+		typename SIMD::Register R1{ SIMD::Load(Data[1].GetData()) };
+		typename SIMD::Register R2{ SIMD::Load(Data[2].GetData()) };
+		typename SIMD::Register R3{ SIMD::Load(Data[3].GetData()) };
+		SIMD::Transpose(R0, R1, R2, R3);
+		SIMD::Store(Result[0].GetData(), R0);
+		SIMD::Store(Result[1].GetData(), R1);
+		SIMD::Store(Result[2].GetData(), R2);
+		SIMD::Store(Result[3].GetData(), R3);
+	}
+	else
+	{
+		for (uint i = 0; i < Rows; ++i)
+		{
+			for (uint j = 0; j < Cols; ++j)
+			{
+				Result[j][i] = Data[i][j];
+			}
+		}
+	}
+	return Result;
+}
+
+
+template <uint Rows, uint Cols, typename Type>
+INLINE STMatrix<Rows, Cols, Type> STMatrix<Rows, Cols, Type>::InverseAffine(const std::source_location& Location) const
+{
+	ASSERT(Rows == Cols && (Rows == 3 || Rows == 4), "Only 3x3 and 4x4 matrices can be inverted as affine transformations.");
+
+	// The rows of the adjugate's transpose are the cross products of the other two rows.
+	STMatrix<Rows, Cols, Type> Cofactors;
+	Cofactors[0] = Data[1] | Data[2];
+	Cofactors[1] = Data[2] | Data[0];
+	Cofactors[2] = Data[0] | Data[1];
+
+	const Type Determinant{ Data[0] ^ Cofactors[0] };
+	const Type InvDeterminant{ (Type)1.0f / Determinant };
+	SInstrumentation::CountOperation(EMathOperation::MatrixInverse);
+	if constexpr (SNaNPolicy::Enabled)
+	{
+		if (!TMath::IsFinite(InvDeterminant) && SNaNPolicy::OnNaN("Matrix inverse", EMathOperation::MatrixInverse, Location)) return Identity();
+	}
+
+	STMatrix<Rows, Cols, Type> Result{ Cofactors.Transpose() };
+	Result[0] *= InvDeterminant;
+	Result[1] *= InvDeterminant;
+	Result[2] *= InvDeterminant;
+	if constexpr (Rows == 4)
+	{
+		// The inverse translation is the original translation moved back through the inverted linear part.
+		Result[3] = -((Result[0] * Data[3][0]) + (Result[1] * Data[3][1]) + (Result[2] * Data[3][2]));
+		Result[3][3] = (Type)1.0f;
+	}
+	return Result;
+}
+
+
+template <uint Rows, uint Cols, typename Type>
+INLINE STVector<Cols, Type> STMatrix<Rows, Cols, Type>::TransformVector(const STVector<Rows, Type>& Vector) const
+{
+	STVector<Cols, Type> Result{ Data[0] * Vector[0] };
+	for (uint i = 1; i < Rows; ++i)
+	{
+		Result += Data[i] * Vector[i];
+	}
+	return Result;
+}
+
+
+template <uint Rows, uint Cols, typename Type>
+INLINE STVector<3, Type> STMatrix<Rows, Cols, Type>::TransformPoint(const STVector<3, Type>& Point) const
+{
+	STVector<3, Type> Result;
+	TransformBatch<true>(&Point, &Result, 1);
+	return Result;
+}
+
+
+template <uint Rows, uint Cols, typename Type>
+INLINE STVector<3, Type> STMatrix<Rows, Cols, Type>::TransformDirection(const STVector<3, Type>& Direction) const
+{
+	STVector<3, Type> Result;
+	TransformBatch<false>(&Direction, &Result, 1);
+	return Result;
+}
+
+
+template <uint Rows, uint Cols, typename Type>
+INLINE void STMatrix<Rows, Cols, Type>::TransformPoints(const STVector<3, Type>* In, STVector<3, Type>* Out, uint Count) const
+{
+	constexpr uint Granularity{ 64 / std::gcd((uint)sizeof(STVector<3, Type>), 64u) };
+	ParallelFor(Count, [this, In, Out](uint Begin, uint End) { TransformBatch<true>(In + Begin, Out + Begin, End - Begin); }, VectorGrain, Granularity);
+}
+
+
+template <uint Rows, uint Cols, typename Type>
+INLINE void STMatrix<Rows, Cols, Type>::TransformPoints(const STVectorArray<3, Type>& In, STVectorArray<3, Type>& Out) const
+{
+	TransformBatch<true>(In, Out);
+}
+
+
+template <uint Rows, uint Cols, typename Type>
+INLINE void STMatrix<Rows, Cols, Type>::TransformDirections(const STVector<3, Type>* In, STVector<3, Type>* Out, uint Count) const
+{
+	constexpr uint Granularity{ 64 / std::gcd((uint)sizeof(STVector<3, Type>), 64u) };
+	ParallelFor(Count, [this, In, Out](uint Begin, uint End) { TransformBatch<false>(In + Begin, Out + Begin, End - Begin); }, VectorGrain, Granularity);
+}
+
+
+template <uint Rows, uint Cols, typename Type>
+INLINE void STMatrix<Rows, Cols, Type>::TransformDirections(const STVectorArray<3, Type>& In, STVectorArray<3, Type>& Out) const
+{
+	TransformBatch<false>(In, Out);
+}
+
+
+template <uint Rows, uint Cols, typename Type>
+template <bool IsPoint>
+INLINE void STMatrix<Rows, Cols, Type>::TransformBatch(const STVector<3, Type>* In, STVector<3, Type>* Out, uint Count) const
+{
+	ASSERT(Rows >= 3 && Cols >= 3, "Matrix must have 3 or more rows and columns to transform 3D vectors.");
+	ASSERT(!IsPoint || Rows == 4, "Matrix must have a fourth row to translate points.");
+
+	typedef TVectorSIMD<3, Type> SIMD3;
+	// Only float has a 3D backend, both backends then share the same register type.
+	if constexpr (SIMD::Enabled && SIMD3::Enabled)
+	{
+		const typename SIMD::Register M0{ SIMD::Load(Data[0].GetData()) };
+		const typename SIMD::Register M1{ SIMD::Load(Data[1].GetData()) };
+		const typename SIMD::Register M2{ SIMD::Load(Data[2].GetData()) };
+		typename SIMD::Register M3{ SIMD::Set((Type)0.0f) };
+		if constexpr (IsPoint) M3 = SIMD::Load(Data[3].GetData());
+
+		for (uint i = 0; i < Count; ++i)
+		{
+			const typename SIMD::Register V{ SIMD3::Load(In[i].GetData()) };
+			typename SIMD::Register R{ SIMD::Add(SIMD::Mul(SIMD::template Splat<0>(V), M0), SIMD::Mul(SIMD::template Splat<1>(V), M1)) };
+			R = SIMD::Add(R, SIMD::Mul(SIMD::template Splat<2>(V), M2));
+			if constexpr (IsPoint) R = SIMD::Add(R, M3);
+			SIMD3::Store(Out[i].GetData(), R);
+		}
+	}
+	else
+	{
+		for (uint i = 0; i < Count; ++i)
+		{
+			const STVector<3, Type> V{ In[i] };
+			for (uint j = 0; j < 3; ++j)
+			{
+				Type Sum{ (V[0] * Data[0][j]) + (V[1] * Data[1][j]) + (V[2] * Data[2][j]) };
+				if constexpr (IsPoint) Sum += Data[3][j];
+				Out[i][j] = Sum;
+			}
+		}
+	}
+}
+
+
+template <uint Rows, uint Cols, typename Type>
+template <bool IsPoint>
+INLINE void STMatrix<Rows, Cols, Type>::TransformBatch(const STVectorArray<3, Type>& In, STVectorArray<3, Type>& Out) const
+{
+	ASSERT(Rows >= 3 && Cols >= 3, "Matrix must have 3 or more rows and columns to transform 3D vectors.");
+	ASSERT(!IsPoint || Rows == 4, "Matrix must have a fourth row to translate points.");
+
+	typedef typename STVectorArray<3, Type>::SLanes SLanes;
+	if (&Out != &In) Out.Resize(In.Num());
+
+	// Every matrix component is broadcast once, the loop only streams the axes through them.
+	SLanes M[4][3];
+	for (uint j = 0; j < 3; ++j)
+	{
+		M[0][j] = SLanes{ Data[0][j] };
+		M[1][j] = SLanes{ Data[1][j] };
+		M[2][j] = SLanes{ Data[2][j] };
+		M[3][j] = SLanes{ (Type)0.0f };
+		if constexpr (IsPoint) M[3][j] = SLanes{ Data[3][j] };
+	}
+
+	const Type* InX{ In.GetAxis(EAxis::X) };
+	const Type* InY{ In.GetAxis(EAxis::Y) };
+	const Type* InZ{ In.GetAxis(EAxis::Z) };
+	Type* OutX{ Out.GetAxis(EAxis::X) };
+	Type* OutY{ Out.GetAxis(EAxis::Y) };
+	Type* OutZ{ Out.GetAxis(EAxis::Z) };
+
+	// Every piece starts on a cache line of each axis, like STVectorArray's own batched functions.
+	constexpr uint Granularity{ ((64 / sizeof(Type)) > SLanes::Lanes) ? (uint)(64 / sizeof(Type)) : SLanes::Lanes };
+	ParallelFor(In.Num(), [&](uint Begin, uint End)
+		{
+			for (uint i = Begin; i < End; i += SLanes::Lanes)
+			{
+				const SLanes X{ SLanes::Load(InX + i) };
+				const SLanes Y{ SLanes::Load(InY + i) };
+				const SLanes Z{ SLanes::Load(InZ + i) };
+				const SLanes RX{ X.MulAdd(M[0][0], Y.MulAdd(M[1][0], Z.MulAdd(M[2][0], M[3][0]))) };
+				const SLanes RY{ X.MulAdd(M[0][1], Y.MulAdd(M[1][1], Z.MulAdd(M[2][1], M[3][1]))) };
+				const SLanes RZ{ X.MulAdd(M[0][2], Y.MulAdd(M[1][2], Z.MulAdd(M[2][2], M[3][2]))) };
+				RX.Store(OutX + i);
+				RY.Store(OutY + i);
+				RZ.Store(OutZ + i);
+			}
+		}, STVectorArray<3, Type>::ParallelGrain, Granularity);
+}
+
+
+template <uint Rows, uint Cols, typename Type>
+INLINE bool STMatrix<Rows, Cols, Type>::nearlyEqual(const STMatrix<Rows, Cols, Type>& Other, const Type& Threshold) const
+{
+	for (uint i = 0; i < Rows; ++i)
+	{
+		if (!Data[i].nearlyEqual(Other[i], Threshold)) return false;
+	}
+	return true;
+}
+
+
+template <uint Rows, uint Cols, typename Type>
+INLINE void STMatrix<Rows, Cols, Type>::Print() const
+{
+	for (uint i = 0; i < Rows; ++i)
+	{
+		Data[i].Print();
+		printf("\n");
+	}
+}
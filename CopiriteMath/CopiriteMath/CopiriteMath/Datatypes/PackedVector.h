@@ -0,0 +1,991 @@
+#pragma once
+#include "Vector.h"
+#include "../Math/SIMD.h"
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+
+
+// A 16-bit IEEE 754 half precision float, for storage only, all math is done after converting to float.
+// @note - 11 bits of precision, a relative error of at most 2^-11 (4.9e-4) in the normal range of 6.1e-5 to 65504.
+// Larger values become infinity, smaller values become denormals or zero, NaN stays NaN.
+struct SHalf
+{
+public:
+	/// Properties
+
+	// The bit pattern of the half.
+	uint16 Bits;
+
+
+	/// Constructors
+
+	// Constructor, Default. The value is left uninitialized.
+	INLINE SHalf() = default;
+
+	// Constructor, Converts a float to the nearest half, ties to even.
+	INLINE explicit SHalf(float Value) :Bits{ FromFloat(Value) } {}
+
+
+	/// Operators
+
+	// Operator, Converts this half to a float, every half is exactly representable.
+	INLINE operator float() const { return ToFloat(Bits); }
+
+
+	/// Functions
+
+	// Returns the bit pattern of the half nearest a float, ties to even.
+	static INLINE uint16 FromFloat(float Value);
+
+	// Returns the float a half's bit pattern represents.
+	static INLINE float ToFloat(uint16 Bits);
+
+	// Converts an array of floats to halves.
+	// @param In - The floats.
+	// @param Out - Receives Count halves.
+	// @param Count - How many floats there are.
+	static INLINE void Encode(const float* In, SHalf* Out, uint Count);
+
+	// Converts an array of halves to floats.
+	// @param In - The halves.
+	// @param Out - Receives Count floats.
+	// @param Count - How many halves there are.
+	static INLINE void Decode(const SHalf* In, float* Out, uint Count);
+};
+
+
+
+// A vector stored as halves, half the size of a float vector.
+// @note - Each component has the error of SHalf, a relative error of at most 4.9e-4.
+// @template Size - How many dimensions the vector has.
+template <uint Size>
+struct STHalfVector
+{
+public:
+	/// Properties
+
+	// The components.
+	SHalf Data[Size];
+
+
+	/// Constructors
+
+	// Constructor, Default. The components are left uninitialized.
+	INLINE STHalfVector() = default;
+
+	// Constructor, Converts a float vector.
+	INLINE explicit STHalfVector(const STVector<Size, float>& Vector);
+
+
+	/// Functions
+
+	// Converts this vector back to floats.
+	INLINE STVector<Size, float> ToVector() const;
+
+	// Converts an array of float vectors.
+	// @param In - The vectors to convert.
+	// @param Out - Receives Count vectors.
+	// @param Count - How many vectors there are.
+	static INLINE void Encode(const STVector<Size, float>* In, STHalfVector<Size>* Out, uint Count);
+
+	// Converts an array of vectors back to floats.
+	// @param In - The vectors to convert.
+	// @param Out - Receives Count vectors.
+	// @param Count - How many vectors there are.
+	static INLINE void Decode(const STHalfVector<Size>* In, STVector<Size, float>* Out, uint Count);
+};
+
+
+
+// A vector stored as normalized integers, spreading [-1, 1] across a signed type or [0, 1] across an unsigned type.
+// Values outside the range are clamped, NaN is clamped to the top of the range.
+// @note - The error is at most half a step, 1 / (2 * the largest Storage value), 1.5e-5 for int16 and 2e-3 for uint8.
+// @template Size - How many dimensions the vector has.
+// @template Storage - The integer type of each component, int8, int16, uint8 or uint16.
+template <uint Size, typename Storage>
+struct STNormVector
+{
+public:
+	// Is [-1, 1] stored rather than [0, 1].
+	static constexpr bool Signed{ std::is_signed<Storage>::value };
+
+	// The integer 1 is stored as.
+	static constexpr float Scale{ (float)std::numeric_limits<Storage>::max() };
+
+	// The lowest value that can be stored.
+	static constexpr float Low{ Signed ? -1.0f : 0.0f };
+
+
+	/// Properties
+
+	// The components.
+	Storage Data[Size];
+
+
+	/// Constructors
+
+	// Constructor, Default. The components are left uninitialized.
+	INLINE STNormVector() = default;
+
+	// Constructor, Converts a float vector.
+	INLINE explicit STNormVector(const STVector<Size, float>& Vector);
+
+
+	/// Functions
+
+	// Returns the integer nearest a value in the stored range, ties to even.
+	static INLINE Storage EncodeComponent(float Value);
+
+	// Returns the value an integer stands for.
+	static INLINE float DecodeComponent(Storage Value);
+
+	// Loads a register of integers converted to floats, not yet scaled.
+	// @param Codes - The integers, one for each lane.
+	static INLINE TLanes<float, TNativeLanes<float>::Count> LoadWidened(const Storage* Codes);
+
+	// Stores a register of floats narrowed to integers.
+	// @param Values - Whole numbers already clamped to the range of Storage, one for each lane.
+	// @param Codes - Receives one integer for each lane.
+	static INLINE void StoreNarrowed(const TLanes<float, TNativeLanes<float>::Count>& Values, Storage* Codes);
+
+	// Converts this vector back to floats.
+	INLINE STVector<Size, float> ToVector() const;
+
+	// Converts an array of float vectors.
+	// @param In - The vectors to convert.
+	// @param Out - Receives Count vectors.
+	// @param Count - How many vectors there are.
+	static INLINE void Encode(const STVector<Size, float>* In, STNormVector<Size, Storage>* Out, uint Count);
+
+	// Converts an array of vectors back to floats.
+	// @param In - The vectors to convert.
+	// @param Out - Receives Count vectors.
+	// @param Count - How many vectors there are.
+	static INLINE void Decode(const STNormVector<Size, Storage>* In, STVector<Size, float>* Out, uint Count);
+};
+
+
+
+// A unit vector folded onto an octahedron and stored as 2 normalized integers.
+// @note - The decoded vector is unit length, its direction is within 0.006 degrees for int16 and 1.6 degrees for int8.
+// @template Storage - The integer type of each of the 2 components, int8 or int16.
+template <typename Storage>
+struct STOctahedralVector
+{
+public:
+	/// Properties
+
+	// The position on the unfolded octahedron.
+	STNormVector<2, Storage> Data;
+
+
+	/// Constructors
+
+	// Constructor, Default. The components are left uninitialized.
+	INLINE STOctahedralVector() = default;
+
+	// Constructor, Converts a unit vector.
+	// @param Vector - The vector to convert, does not need to be unit length but must not be vector0.
+	INLINE explicit STOctahedralVector(const STVector<3, float>& Vector);
+
+
+	/// Functions
+
+	// Converts this vector back to a unit vector.
+	INLINE STVector<3, float> ToVector() const;
+
+	// Converts an array of unit vectors.
+	// @param In - The vectors to convert, do not need to be unit length but must not be vector0.
+	// @param Out - Receives Count vectors.
+	// @param Count - How many vectors there are.
+	static INLINE void Encode(const STVector<3, float>* In, STOctahedralVector<Storage>* Out, uint Count);
+
+	// Converts an array of vectors back to unit vectors.
+	// @param In - The vectors to convert.
+	// @param Out - Receives Count vectors.
+	// @param Count - How many vectors there are.
+	static INLINE void Decode(const STOctahedralVector<Storage>* In, STVector<3, float>* Out, uint Count);
+
+	// Folds a direction onto the octahedron, X and Y are set to the position and Z is discarded.
+	template <typename Value>
+	static INLINE void Fold(Value& X, Value& Y, const Value& Z);
+
+	// Unfolds a position on the octahedron into a direction, which still needs to be normalized.
+	template <typename Value>
+	static INLINE void Unfold(Value& X, Value& Y, Value& Z);
+
+	// Interleaves two registers into the order the positions are stored in.
+	// @param X - The first component of each position.
+	// @param Y - The second component of each position.
+	// @param Interleaved - Receives the first half of the positions in [0] and the second half in [1].
+	static INLINE void Interleave(const TLanes<float, TNativeLanes<float>::Count>& X, const TLanes<float, TNativeLanes<float>::Count>& Y, TLanes<float, TNativeLanes<float>::Count>* Interleaved);
+};
+
+
+
+// A 4D vector packed into 32 bits, 10 bits for each of X, Y and Z and 2 bits for W.
+// The unsigned form stores [0, 1], the signed form stores [-1, 1] in two's complement, matching the graphics APIs.
+// Values outside the range are clamped, NaN is clamped to the top of the range.
+// @note - The error of X, Y and Z is at most half a step, 4.9e-4 unsigned and 9.8e-4 signed. W is 0 to 1 in thirds, or -1, 0 and 1.
+// @template Signed - Is [-1, 1] stored rather than [0, 1].
+template <bool Signed>
+struct STPacked1010102
+{
+public:
+	/// Properties
+
+	// X in the lowest 10 bits, then Y, then Z and W in the highest 2 bits.
+	uint32 Bits;
+
+
+	/// Constructors
+
+	// Constructor, Default. The value is left uninitialized.
+	INLINE STPacked1010102() = default;
+
+	// Constructor, Converts a float vector.
+	INLINE explicit STPacked1010102(const STVector<4, float>& Vector);
+
+
+	/// Functions
+
+	// Converts this vector back to floats.
+	INLINE STVector<4, float> ToVector() const;
+
+	// Converts an array of float vectors.
+	// @param In - The vectors to convert.
+	// @param Out - Receives Count vectors.
+	// @param Count - How many vectors there are.
+	static INLINE void Encode(const STVector<4, float>* In, STPacked1010102<Signed>* Out, uint Count);
+
+	// Converts an array of vectors back to floats.
+	// @param In - The vectors to convert.
+	// @param Out - Receives Count vectors.
+	// @param Count - How many vectors there are.
+	static INLINE void Decode(const STPacked1010102<Signed>* In, STVector<4, float>* Out, uint Count);
+
+	// Packs a register of whole vectors, its fields already scaled, rounded and clamped.
+	// @param Fields - The fields of a quarter of the lanes' vectors, X, Y, Z and W for each.
+	// @param Out - Receives a quarter of the lanes' vectors.
+	static INLINE void PackRegister(const TLanes<float, TNativeLanes<float>::Count>& Fields, STPacked1010102<Signed>* Out);
+
+	// Unpacks a register of whole vectors, the fields are not yet scaled.
+	// @param In - A quarter of the lanes' vectors.
+	// @return - The fields of each vector, X, Y, Z and W.
+	static INLINE TLanes<float, TNativeLanes<float>::Count> UnpackRegister(const STPacked1010102<Signed>* In);
+
+	// The integer 1 is stored as in each field.
+	static constexpr float Scales[4]{ Signed ? 511.0f : 1023.0f, Signed ? 511.0f : 1023.0f, Signed ? 511.0f : 1023.0f, Signed ? 1.0f : 3.0f };
+};
+
+
+
+// A 2D vector stored as halves.
+typedef STHalfVector<2> SHalfVector2;
+
+// A 3D vector stored as halves.
+typedef STHalfVector<3> SHalfVector3;
+
+// A 4D vector stored as halves.
+typedef STHalfVector<4> SHalfVector4;
+
+// A 3D vector in [-1, 1] stored as 16-bit integers, for normals.
+typedef STNormVector<3, int16> SSNorm16Vector3;
+
+// A 4D vector in [-1, 1] stored as 16-bit integers, for tangents with a handedness.
+typedef STNormVector<4, int16> SSNorm16Vector4;
+
+// A 3D vector in [-1, 1] stored as 8-bit integers, for normals.
+typedef STNormVector<3, int8> SSNorm8Vector3;
+
+// A 4D vector in [0, 1] stored as 8-bit integers, for colors and weights.
+typedef STNormVector<4, uint8> SUNorm8Vector4;
+
+// A unit vector in 32 bits.
+typedef STOctahedralVector<int16> SOctahedral32;
+
+// A unit vector in 16 bits.
+typedef STOctahedralVector<int8> SOctahedral16;
+
+// A 4D vector in [0, 1] packed into 32 bits.
+typedef STPacked1010102<false> SUNorm1010102;
+
+// A 4D vector in [-1, 1] packed into 32 bits.
+typedef STPacked1010102<true> SSNorm1010102;
+
+
+
+INLINE uint16 SHalf::FromFloat(float Value)
+{
+#if defined(COPIRITE_F16C)
+	return (uint16)_mm_extract_epi16(_mm_cvtps_ph(_mm_set_ss(Value), _MM_FROUND_TO_NEAREST_INT), 0);
+#else
+	uint32 Float;
+	memcpy(&Float, &Value, sizeof(float));
+	const uint32 Sign{ Float & 0x80000000u };
+	Float ^= Sign;
+
+	uint32 Result;
+	if (Float >= 0x47800000u)
+	{
+		// Too large for a half, or already infinity or NaN.
+		Result = (Float > 0x7F800000u) ? 0x7E00u : 0x7C00u;
+	}
+	else if (Float < 0x38800000u)
+	{
+		// A half denormal, adding 0.5 lines the half's mantissa up with the bottom of the float's and rounds it.
+		float Denormal;
+		memcpy(&Denormal, &Float, sizeof(float));
+		Denormal += 0.5f;
+		memcpy(&Result, &Denormal, sizeof(float));
+		Result -= 0x3F000000u;
+	}
+	else
+	{
+		// Rebias the exponent and round the 13 dropped mantissa bits to nearest, ties to even.
+		Result = (Float + 0xC8000FFFu + ((Float >> 13) & 1u)) >> 13;
+	}
+	return (uint16)(Result | (Sign >> 16));
+#endif
+}
+
+
+INLINE float SHalf::ToFloat(uint16 Bits)
+{
+#if defined(COPIRITE_F16C)
+	return _mm_cvtss_f32(_mm_cvtph_ps(_mm_cvtsi32_si128(Bits)));
+#else
+	uint32 Result{ (uint32)(Bits & 0x7FFFu) << 13 };
+	const uint32 Exponent{ Result & 0x0F800000u };
+	Result += 0x38000000u;
+	if (Exponent == 0x0F800000u)
+	{
+		// Infinity or NaN.
+		Result += 0x38000000u;
+	}
+	else if (Exponent == 0)
+	{
+		// A denormal, renormalized by letting the float hardware subtract the implicit bit.
+		Result += 0x00800000u;
+		float Denormal;
+		memcpy(&Denormal, &Result, sizeof(float));
+		Denormal -= 6.103515625e-05f;
+		memcpy(&Result, &Denormal, sizeof(float));
+	}
+	Result |= (uint32)(Bits & 0x8000u) << 16;
+
+	float Value;
+	memcpy(&Value, &Result, sizeof(float));
+	return Value;
+#endif
+}
+
+
+INLINE void SHalf::Encode(const float* In, SHalf* Out, uint Count)
+{
+	uint i{ 0 };
+#if defined(COPIRITE_F16C) && defined(COPIRITE_AVX512)
+	for (; i + 16 <= Count; i += 16)
+	{
+		_mm256_storeu_si256((__m256i*)(Out + i), _mm512_cvtps_ph(_mm512_loadu_ps(In + i), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC));
+	}
+#endif
+#if defined(COPIRITE_F16C)
+	for (; i + 8 <= Count; i += 8)
+	{
+		_mm_storeu_si128((__m128i*)(Out + i), _mm256_cvtps_ph(_mm256_loadu_ps(In + i), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC));
+	}
+#endif
+	for (; i < Count; ++i)
+	{
+		Out[i].Bits = FromFloat(In[i]);
+	}
+}
+
+
+INLINE void SHalf::Decode(const SHalf* In, float* Out, uint Count)
+{
+	uint i{ 0 };
+#if defined(COPIRITE_F16C) && defined(COPIRITE_AVX512)
+	for (; i + 16 <= Count; i += 16)
+	{
+		_mm512_storeu_ps(Out + i, _mm512_cvtph_ps(_mm256_loadu_si256((const __m256i*)(In + i))));
+	}
+#endif
+#if defined(COPIRITE_F16C)
+	for (; i + 8 <= Count; i += 8)
+	{
+		_mm256_storeu_ps(Out + i, _mm256_cvtph_ps(_mm_loadu_si128((const __m128i*)(In + i))));
+	}
+#endif
+	for (; i < Count; ++i)
+	{
+		Out[i] = ToFloat(In[i].Bits);
+	}
+}
+
+
+template <uint Size>
+INLINE STHalfVector<Size>::STHalfVector(const STVector<Size, float>& Vector)
+{
+	for (uint i = 0; i < Size; ++i)
+	{
+		Data[i] = SHalf{ Vector[i] };
+	}
+}
+
+
+template <uint Size>
+INLINE STVector<Size, float> STHalfVector<Size>::ToVector() const
+{
+	STVector<Size, float> Result;
+	for (uint i = 0; i < Size; ++i)
+	{
+		Result[i] = Data[i];
+	}
+	return Result;
+}
+
+
+template <uint Size>
+INLINE void STHalfVector<Size>::Encode(const STVector<Size, float>* In, STHalfVector<Size>* Out, uint Count)
+{
+	// Packed vectors are one stream of components, so any size converts a full register at a time.
+	if constexpr (sizeof(STVector<Size, float>) == sizeof(float) * Size)
+	{
+		if (Count > 0) SHalf::Encode(In[0].GetData(), (SHalf*)Out, Count * Size);
+	}
+	else
+	{
+		for (uint i = 0; i < Count; ++i) Out[i] = STHalfVector<Size>{ In[i] };
+	}
+}
+
+
+template <uint Size>
+INLINE void STHalfVector<Size>::Decode(const STHalfVector<Size>* In, STVector<Size, float>* Out, uint Count)
+{
+	if constexpr (sizeof(STVector<Size, float>) == sizeof(float) * Size)
+	{
+		if (Count > 0) SHalf::Decode((const SHalf*)In, Out[0].GetData(), Count * Size);
+	}
+	else
+	{
+		for (uint i = 0; i < Count; ++i) Out[i] = In[i].ToVector();
+	}
+}
+
+
+template <uint Size, typename Storage>
+INLINE STNormVector<Size, Storage>::STNormVector(const STVector<Size, float>& Vector)
+{
+	for (uint i = 0; i < Size; ++i)
+	{
+		Data[i] = EncodeComponent(Vector[i]);
+	}
+}
+
+
+template <uint Size, typename Storage>
+INLINE Storage STNormVector<Size, Storage>::EncodeComponent(float Value)
+{
+	// Written in the same order as the lanes' Min and Max, so NaN clamps to the top in both.
+	const float Clamped{ (Value < 1.0f) ? Value : 1.0f };
+	return (Storage)(int32)std::nearbyint(((Clamped > Low) ? Clamped : Low) * Scale);
+}
+
+
+template <uint Size, typename Storage>
+INLINE float STNormVector<Size, Storage>::DecodeComponent(Storage Value)
+{
+	// The lowest signed integer is one step past -1.
+	const float Result{ (float)Value * (1.0f / Scale) };
+	if constexpr (Signed) return (Result > -1.0f) ? Result : -1.0f;
+	else return Result;
+}
+
+
+template <uint Size, typename Storage>
+INLINE TLanes<float, TNativeLanes<float>::Count> STNormVector<Size, Storage>::LoadWidened(const Storage* Codes)
+{
+	// Picked by the same switches as TNativeLanes, so each branch matches the register width.
+#if defined(COPIRITE_AVX512)
+	__m512i Integers;
+	if constexpr (sizeof(Storage) == 2) Integers = Signed ? _mm512_cvtepi16_epi32(_mm256_loadu_si256((const __m256i*)Codes)) : _mm512_cvtepu16_epi32(_mm256_loadu_si256((const __m256i*)Codes));
+	else Integers = Signed ? _mm512_cvtepi8_epi32(_mm_loadu_si128((const __m128i*)Codes)) : _mm512_cvtepu8_epi32(_mm_loadu_si128((const __m128i*)Codes));
+	return _mm512_cvtepi32_ps(Integers);
+#elif defined(COPIRITE_AVX2)
+	__m256i Integers;
+	if constexpr (sizeof(Storage) == 2) Integers = Signed ? _mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i*)Codes)) : _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i*)Codes));
+	else Integers = Signed ? _mm256_cvtepi8_epi32(_mm_loadl_epi64((const __m128i*)Codes)) : _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)Codes));
+	return _mm256_cvtepi32_ps(Integers);
+#elif defined(COPIRITE_SSE41) && !defined(COPIRITE_AVX)
+	__m128i Integers;
+	if constexpr (sizeof(Storage) == 2) Integers = Signed ? _mm_cvtepi16_epi32(_mm_loadl_epi64((const __m128i*)Codes)) : _mm_cvtepu16_epi32(_mm_loadl_epi64((const __m128i*)Codes));
+	else
+	{
+		int32 Packed;
+		memcpy(&Packed, Codes, sizeof(int32));
+		Integers = Signed ? _mm_cvtepi8_epi32(_mm_cvtsi32_si128(Packed)) : _mm_cvtepu8_epi32(_mm_cvtsi32_si128(Packed));
+	}
+	return _mm_cvtepi32_ps(Integers);
+#else
+	constexpr uint Lanes{ TNativeLanes<float>::Count };
+	alignas(64) float Widened[Lanes];
+	for (uint k = 0; k < Lanes; ++k) Widened[k] = (float)Codes[k];
+	return TLanes<float, Lanes>::Load(Widened);
+#endif
+}
+
+
+template <uint Size, typename Storage>
+INLINE void STNormVector<Size, Storage>::StoreNarrowed(const TLanes<float, TNativeLanes<float>::Count>& Values, Storage* Codes)
+{
+	// The values are already in range, so the saturating packs never saturate and the truncating narrows never truncate.
+#if defined(COPIRITE_AVX512)
+	const __m512i Integers{ _mm512_cvtps_epi32(Values.Get()) };
+	if constexpr (sizeof(Storage) == 2) _mm256_storeu_si256((__m256i*)Codes, _mm512_cvtepi32_epi16(Integers));
+	else _mm_storeu_si128((__m128i*)Codes, _mm512_cvtepi32_epi8(Integers));
+#elif defined(COPIRITE_AVX2)
+	const __m256i Integers{ _mm256_cvtps_epi32(Values.Get()) };
+	const __m128i Low{ _mm256_castsi256_si128(Integers) }, High{ _mm256_extracti128_si256(Integers, 1) };
+	if constexpr (sizeof(Storage) == 2) _mm_storeu_si128((__m128i*)Codes, Signed ? _mm_packs_epi32(Low, High) : _mm_packus_epi32(Low, High));
+	else
+	{
+		const __m128i Words{ _mm_packs_epi32(Low, High) };
+		_mm_storel_epi64((__m128i*)Codes, Signed ? _mm_packs_epi16(Words, Words) : _mm_packus_epi16(Words, Words));
+	}
+#elif defined(COPIRITE_SSE41) && !defined(COPIRITE_AVX)
+	const __m128i Integers{ _mm_cvtps_epi32(Values.Get()) };
+	if constexpr (sizeof(Storage) == 2) _mm_storel_epi64((__m128i*)Codes, Signed ? _mm_packs_epi32(Integers, Integers) : _mm_packus_epi32(Integers, Integers));
+	else
+	{
+		const __m128i Words{ _mm_packs_epi32(Integers, Integers) };
+		_mm_storeu_si32(Codes, Signed ? _mm_packs_epi16(Words, Words) : _mm_packus_epi16(Words, Words));
+	}
+#else
+	constexpr uint Lanes{ TNativeLanes<float>::Count };
+	alignas(64) float Narrowed[Lanes];
+	Values.Store(Narrowed);
+	for (uint k = 0; k < Lanes; ++k) Codes[k] = (Storage)(int32)Narrowed[k];
+#endif
+}
+
+
+template <uint Size, typename Storage>
+INLINE STVector<Size, float> STNormVector<Size, Storage>::ToVector() const
+{
+	STVector<Size, float> Result;
+	for (uint i = 0; i < Size; ++i)
+	{
+		Result[i] = DecodeComponent(Data[i]);
+	}
+	return Result;
+}
+
+
+template <uint Size, typename Storage>
+INLINE void STNormVector<Size, Storage>::Encode(const STVector<Size, float>* In, STNormVector<Size, Storage>* Out, uint Count)
+{
+	if constexpr (sizeof(STVector<Size, float>) == sizeof(float) * Size)
+	{
+		typedef TLanes<float, TNativeLanes<float>::Count> SLanes;
+		constexpr uint Lanes{ TNativeLanes<float>::Count };
+		if (Count == 0) return;
+
+		const float* Values{ In[0].GetData() };
+		// Addressed through the array rather than Out[0].Data, which the compiler treats as only Size codes long.
+		Storage* Codes{ (Storage*)Out };
+		const uint Total{ Count * Size };
+		const SLanes High{ 1.0f }, Bottom{ Low }, Multiplier{ Scale };
+		uint i{ 0 };
+		for (; i + Lanes <= Total; i += Lanes)
+		{
+			StoreNarrowed((SLanes::LoadUnaligned(Values + i).Min(High).Max(Bottom) * Multiplier).Round(), Codes + i);
+		}
+		for (; i < Total; ++i) Codes[i] = EncodeComponent(Values[i]);
+	}
+	else
+	{
+		for (uint i = 0; i < Count; ++i) Out[i] = STNormVector<Size, Storage>{ In[i] };
+	}
+}
+
+
+template <uint Size, typename Storage>
+INLINE void STNormVector<Size, Storage>::Decode(const STNormVector<Size, Storage>* In, STVector<Size, float>* Out, uint Count)
+{
+	if constexpr (sizeof(STVector<Size, float>) == sizeof(float) * Size)
+	{
+		typedef TLanes<float, TNativeLanes<float>::Count> SLanes;
+		constexpr uint Lanes{ TNativeLanes<float>::Count };
+		if (Count == 0) return;
+
+		const Storage* Codes{ (const Storage*)In };
+		float* Values{ Out[0].GetData() };
+		const uint Total{ Count * Size };
+		const SLanes Bottom{ -1.0f }, Multiplier{ 1.0f / Scale };
+		uint i{ 0 };
+		for (; i + Lanes <= Total; i += Lanes)
+		{
+			SLanes Result{ LoadWidened(Codes + i) * Multiplier };
+			if constexpr (Signed) Result = Result.Max(Bottom);
+			Result.StoreUnaligned(Values + i);
+		}
+		for (; i < Total; ++i) Values[i] = DecodeComponent(Codes[i]);
+	}
+	else
+	{
+		for (uint i = 0; i < Count; ++i) Out[i] = In[i].ToVector();
+	}
+}
+
+
+template <typename Storage>
+template <typename Value>
+INLINE void STOctahedralVector<Storage>::Fold(Value& X, Value& Y, const Value& Z)
+{
+	// Projects onto the octahedron |x| + |y| + |z| = 1, the lower half is folded over the diagonals onto the corners.
+	if constexpr (std::is_same<Value, float>::value)
+	{
+		const float InvSum{ 1.0f / (TMath::Abs(X) + TMath::Abs(Y) + TMath::Abs(Z)) };
+		const float PX{ X * InvSum }, PY{ Y * InvSum };
+		if (Z < 0.0f)
+		{
+			X = (1.0f - TMath::Abs(PY)) * ((PX >= 0.0f) ? 1.0f : -1.0f);
+			Y = (1.0f - TMath::Abs(PX)) * ((PY >= 0.0f) ? 1.0f : -1.0f);
+		}
+		else
+		{
+			X = PX;
+			Y = PY;
+		}
+	}
+	else
+	{
+		const Value One{ 1.0f }, Zero{ 0.0f };
+		const Value InvSum{ One / (X.Abs() + Y.Abs() + Z.Abs()) };
+		const Value PX{ X * InvSum }, PY{ Y * InvSum };
+		const Value Lower{ Z < Zero };
+		X = Lower.Select((One - PY.Abs()) * (PX >= Zero).Select(One, -One), PX);
+		Y = Lower.Select((One - PX.Abs()) * (PY >= Zero).Select(One, -One), PY);
+	}
+}
+
+
+template <typename Storage>
+template <typename Value>
+INLINE void STOctahedralVector<Storage>::Unfold(Value& X, Value& Y, Value& Z)
+{
+	if constexpr (std::is_same<Value, float>::value)
+	{
+		Z = 1.0f - TMath::Abs(X) - TMath::Abs(Y);
+		const float Fold{ (Z < 0.0f) ? -Z : 0.0f };
+		X += (X >= 0.0f) ? -Fold : Fold;
+		Y += (Y >= 0.0f) ? -Fold : Fold;
+	}
+	else
+	{
+		const Value One{ 1.0f }, Zero{ 0.0f };
+		Z = One - X.Abs() - Y.Abs();
+		const Value Fold{ (-Z).Max(Zero) };
+		X = X + (X >= Zero).Select(-Fold, Fold);
+		Y = Y + (Y >= Zero).Select(-Fold, Fold);
+	}
+}
+
+
+template <typename Storage>
+INLINE void STOctahedralVector<Storage>::Interleave(const TLanes<float, TNativeLanes<float>::Count>& X, const TLanes<float, TNativeLanes<float>::Count>& Y, TLanes<float, TNativeLanes<float>::Count>* Interleaved)
+{
+	// The unpacks interleave within each 128-bit block, the wider registers then put the blocks back in order.
+#if defined(COPIRITE_AVX512)
+	const __m512 Low{ _mm512_unpacklo_ps(X.Get(), Y.Get()) }, High{ _mm512_unpackhi_ps(X.Get(), Y.Get()) };
+	Interleaved[0] = _mm512_permutex2var_ps(Low, _mm512_setr_epi32(0, 1, 2, 3, 16, 17, 18, 19, 4, 5, 6, 7, 20, 21, 22, 23), High);
+	Interleaved[1] = _mm512_permutex2var_ps(Low, _mm512_setr_epi32(8, 9, 10, 11, 24, 25, 26, 27, 12, 13, 14, 15, 28, 29, 30, 31), High);
+#elif defined(COPIRITE_AVX)
+	const __m256 Low{ _mm256_unpacklo_ps(X.Get(), Y.Get()) }, High{ _mm256_unpackhi_ps(X.Get(), Y.Get()) };
+	Interleaved[0] = _mm256_permute2f128_ps(Low, High, 0x20);
+	Interleaved[1] = _mm256_permute2f128_ps(Low, High, 0x31);
+#elif defined(COPIRITE_SSE2)
+	Interleaved[0] = _mm_unpacklo_ps(X.Get(), Y.Get());
+	Interleaved[1] = _mm_unpackhi_ps(X.Get(), Y.Get());
+#else
+	typedef TLanes<float, TNativeLanes<float>::Count> SLanes;
+	constexpr uint Lanes{ TNativeLanes<float>::Count };
+	alignas(64) float Axis[2][Lanes];
+	alignas(64) float Positions[Lanes * 2];
+	X.Store(Axis[0]);
+	Y.Store(Axis[1]);
+	for (uint l = 0; l < Lanes; ++l)
+	{
+		Positions[l * 2] = Axis[0][l];
+		Positions[(l * 2) + 1] = Axis[1][l];
+	}
+	Interleaved[0] = SLanes::Load(Positions);
+	Interleaved[1] = SLanes::Load(Positions + Lanes);
+#endif
+}
+
+
+template <typename Storage>
+INLINE STOctahedralVector<Storage>::STOctahedralVector(const STVector<3, float>& Vector)
+{
+	float X{ Vector[0] }, Y{ Vector[1] };
+	Fold(X, Y, Vector[2]);
+	Data.Data[0] = STNormVector<2, Storage>::EncodeComponent(X);
+	Data.Data[1] = STNormVector<2, Storage>::EncodeComponent(Y);
+}
+
+
+template <typename Storage>
+INLINE STVector<3, float> STOctahedralVector<Storage>::ToVector() const
+{
+	float X{ STNormVector<2, Storage>::DecodeComponent(Data.Data[0]) }, Y{ STNormVector<2, Storage>::DecodeComponent(Data.Data[1]) }, Z;
+	Unfold(X, Y, Z);
+	const float InvLength{ TMath::InvSqrt((X * X) + (Y * Y) + (Z * Z)) };
+	return STVector<3, float>{ X * InvLength, Y * InvLength, Z * InvLength };
+}
+
+
+template <typename Storage>
+INLINE void STOctahedralVector<Storage>::Encode(const STVector<3, float>* In, STOctahedralVector<Storage>* Out, uint Count)
+{
+	typedef TLanes<float, TNativeLanes<float>::Count> SLanes;
+	constexpr uint Lanes{ TNativeLanes<float>::Count };
+	typedef STNormVector<2, Storage> SNorm;
+	const SLanes High{ 1.0f }, Bottom{ SNorm::Low }, Multiplier{ SNorm::Scale };
+
+	// Each lane of vectors is transposed on the stack so every axis fills a register.
+	uint i{ 0 };
+	for (; i + Lanes <= Count; i += Lanes)
+	{
+		alignas(64) float Axis[3][Lanes];
+		for (uint l = 0; l < Lanes; ++l)
+		{
+			for (uint j = 0; j < 3; ++j) Axis[j][l] = In[i + l][j];
+		}
+
+		SLanes X{ SLanes::Load(Axis[0]) }, Y{ SLanes::Load(Axis[1]) };
+		Fold(X, Y, SLanes::Load(Axis[2]));
+		SLanes Positions[2];
+		Interleave((X.Min(High).Max(Bottom) * Multiplier).Round(), (Y.Min(High).Max(Bottom) * Multiplier).Round(), Positions);
+		SNorm::StoreNarrowed(Positions[0], Out[i].Data.Data);
+		SNorm::StoreNarrowed(Positions[1], Out[i].Data.Data + Lanes);
+	}
+	for (; i < Count; ++i)
+	{
+		Out[i] = STOctahedralVector<Storage>{ In[i] };
+	}
+}
+
+
+template <typename Storage>
+INLINE void STOctahedralVector<Storage>::Decode(const STOctahedralVector<Storage>* In, STVector<3, float>* Out, uint Count)
+{
+	typedef TLanes<float, TNativeLanes<float>::Count> SLanes;
+	constexpr uint Lanes{ TNativeLanes<float>::Count };
+	const SLanes Bottom{ -1.0f }, Multiplier{ 1.0f / STNormVector<2, Storage>::Scale }, One{ 1.0f };
+
+	uint i{ 0 };
+	for (; i + Lanes <= Count; i += Lanes)
+	{
+		// The positions are widened as one stream and then split into an X and a Y register.
+		alignas(64) float Positions[Lanes * 2];
+		alignas(64) float Axis[3][Lanes];
+		const Storage* Codes{ In[i].Data.Data };
+		STNormVector<2, Storage>::LoadWidened(Codes).Store(Positions);
+		STNormVector<2, Storage>::LoadWidened(Codes + Lanes).Store(Positions + Lanes);
+		for (uint l = 0; l < Lanes; ++l)
+		{
+			Axis[0][l] = Positions[l * 2];
+			Axis[1][l] = Positions[(l * 2) + 1];
+		}
+
+		SLanes X{ (SLanes::Load(Axis[0]) * Multiplier).Max(Bottom) }, Y{ (SLanes::Load(Axis[1]) * Multiplier).Max(Bottom) }, Z;
+		Unfold(X, Y, Z);
+		const SLanes InvLength{ One / Z.MulAdd(Z, Y.MulAdd(Y, X * X)).Sqrt() };
+		(X * InvLength).Store(Axis[0]);
+		(Y * InvLength).Store(Axis[1]);
+		(Z * InvLength).Store(Axis[2]);
+		for (uint l = 0; l < Lanes; ++l)
+		{
+			for (uint j = 0; j < 3; ++j) Out[i + l][j] = Axis[j][l];
+		}
+	}
+	for (; i < Count; ++i)
+	{
+		Out[i] = In[i].ToVector();
+	}
+}
+
+
+template <bool Signed>
+INLINE STPacked1010102<Signed>::STPacked1010102(const STVector<4, float>& Vector)
+{
+	constexpr float Low{ Signed ? -1.0f : 0.0f };
+	Bits = 0;
+	for (uint i = 0; i < 4; ++i)
+	{
+		const float Clamped{ (Vector[i] < 1.0f) ? Vector[i] : 1.0f };
+		const int32 Field{ (int32)std::nearbyint(((Clamped > Low) ? Clamped : Low) * Scales[i]) };
+		Bits |= ((uint32)Field & ((i < 3) ? 0x3FFu : 0x3u)) << (i * 10);
+	}
+}
+
+
+template <bool Signed>
+INLINE STVector<4, float> STPacked1010102<Signed>::ToVector() const
+{
+	STVector<4, float> Result;
+	for (uint i = 0; i < 4; ++i)
+	{
+		// Shifting the field to the top and back extends its sign.
+		const uint Width{ (i < 3) ? 10u : 2u };
+		float Value;
+		if constexpr (Signed) Value = (float)((int32)(Bits << (32 - (i * 10) - Width)) >> (32 - Width));
+		else Value = (float)((Bits >> (i * 10)) & ((1u << Width) - 1u));
+		Value *= 1.0f / Scales[i];
+		Result[i] = (Signed && Value < -1.0f) ? -1.0f : Value;
+	}
+	return Result;
+}
+
+
+template <bool Signed>
+INLINE void STPacked1010102<Signed>::Encode(const STVector<4, float>* In, STPacked1010102<Signed>* Out, uint Count)
+{
+	typedef TLanes<float, TNativeLanes<float>::Count> SLanes;
+	constexpr uint Lanes{ TNativeLanes<float>::Count };
+	if constexpr (sizeof(STVector<4, float>) == sizeof(float) * 4 && Lanes % 4 == 0)
+	{
+		// A register holds whole vectors, so the scale of each field repeats every 4 lanes.
+		alignas(64) float Pattern[Lanes];
+		for (uint k = 0; k < Lanes; ++k) Pattern[k] = Scales[k % 4];
+		const SLanes High{ 1.0f }, Bottom{ Signed ? -1.0f : 0.0f }, Multiplier{ SLanes::Load(Pattern) };
+		constexpr uint PerRegister{ Lanes / 4 };
+
+		const float* Values{ In[0].GetData() };
+		uint i{ 0 };
+		for (; i + PerRegister <= Count; i += PerRegister)
+		{
+			PackRegister((SLanes::LoadUnaligned(Values + (i * 4)).Min(High).Max(Bottom) * Multiplier).Round(), Out + i);
+		}
+		for (; i < Count; ++i) Out[i] = STPacked1010102<Signed>{ In[i] };
+	}
+	else
+	{
+		for (uint i = 0; i < Count; ++i) Out[i] = STPacked1010102<Signed>{ In[i] };
+	}
+}
+
+
+template <bool Signed>
+INLINE void STPacked1010102<Signed>::Decode(const STPacked1010102<Signed>* In, STVector<4, float>* Out, uint Count)
+{
+	typedef TLanes<float, TNativeLanes<float>::Count> SLanes;
+	constexpr uint Lanes{ TNativeLanes<float>::Count };
+	if constexpr (sizeof(STVector<4, float>) == sizeof(float) * 4 && Lanes % 4 == 0)
+	{
+		alignas(64) float Pattern[Lanes];
+		for (uint k = 0; k < Lanes; ++k) Pattern[k] = 1.0f / Scales[k % 4];
+		const SLanes Bottom{ -1.0f }, Multiplier{ SLanes::Load(Pattern) };
+		constexpr uint PerRegister{ Lanes / 4 };
+
+		float* Values{ Out[0].GetData() };
+		uint i{ 0 };
+		for (; i + PerRegister <= Count; i += PerRegister)
+		{
+			SLanes Result{ UnpackRegister(In + i) * Multiplier };
+			if constexpr (Signed) Result = Result.Max(Bottom);
+			Result.StoreUnaligned(Values + (i * 4));
+		}
+		for (; i < Count; ++i) Out[i] = In[i].ToVector();
+	}
+	else
+	{
+		for (uint i = 0; i < Count; ++i) Out[i] = In[i].ToVector();
+	}
+}
+
+
+template <bool Signed>
+INLINE void STPacked1010102<Signed>::PackRegister(const TLanes<float, TNativeLanes<float>::Count>& Fields, STPacked1010102<Signed>* Out)
+{
+	// Each field is masked and shifted into place in its own lane, then the 4 lanes of each vector are or'd together.
+#if defined(COPIRITE_AVX512)
+	__m512i Integers{ _mm512_and_si512(_mm512_cvtps_epi32(Fields.Get()), _mm512_setr_epi32(0x3FF, 0x3FF, 0x3FF, 0x3, 0x3FF, 0x3FF, 0x3FF, 0x3, 0x3FF, 0x3FF, 0x3FF, 0x3, 0x3FF, 0x3FF, 0x3FF, 0x3)) };
+	Integers = _mm512_sllv_epi32(Integers, _mm512_setr_epi32(0, 10, 20, 30, 0, 10, 20, 30, 0, 10, 20, 30, 0, 10, 20, 30));
+	Integers = _mm512_or_si512(Integers, _mm512_shuffle_epi32(Integers, (_MM_PERM_ENUM)0x4E));
+	Integers = _mm512_or_si512(Integers, _mm512_shuffle_epi32(Integers, (_MM_PERM_ENUM)0xB1));
+	_mm_storeu_si128((__m128i*)Out, _mm512_castsi512_si128(_mm512_permutexvar_epi32(_mm512_setr_epi32(0, 4, 8, 12, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0), Integers)));
+#elif defined(COPIRITE_AVX2)
+	__m256i Integers{ _mm256_and_si256(_mm256_cvtps_epi32(Fields.Get()), _mm256_setr_epi32(0x3FF, 0x3FF, 0x3FF, 0x3, 0x3FF, 0x3FF, 0x3FF, 0x3)) };
+	Integers = _mm256_sllv_epi32(Integers, _mm256_setr_epi32(0, 10, 20, 30, 0, 10, 20, 30));
+	Integers = _mm256_or_si256(Integers, _mm256_shuffle_epi32(Integers, 0x4E));
+	Integers = _mm256_or_si256(Integers, _mm256_shuffle_epi32(Integers, 0xB1));
+	_mm_storel_epi64((__m128i*)Out, _mm256_castsi256_si128(_mm256_permutevar8x32_epi32(Integers, _mm256_setr_epi32(0, 4, 0, 0, 0, 0, 0, 0))));
+#elif defined(COPIRITE_SSE41) && !defined(COPIRITE_AVX)
+	// SSE4.1 has no per lane shift, multiplying by a power of 2 is the same.
+	__m128i Integers{ _mm_and_si128(_mm_cvtps_epi32(Fields.Get()), _mm_setr_epi32(0x3FF, 0x3FF, 0x3FF, 0x3)) };
+	Integers = _mm_mullo_epi32(Integers, _mm_setr_epi32(1, 1 << 10, 1 << 20, 1 << 30));
+	Integers = _mm_or_si128(Integers, _mm_shuffle_epi32(Integers, 0x4E));
+	Integers = _mm_or_si128(Integers, _mm_shuffle_epi32(Integers, 0xB1));
+	Out->Bits = (uint32)_mm_cvtsi128_si32(Integers);
+#else
+	constexpr uint Lanes{ TNativeLanes<float>::Count };
+	alignas(64) float Rounded[Lanes];
+	Fields.Store(Rounded);
+	for (uint v = 0; v < Lanes / 4; ++v)
+	{
+		const float* Field{ Rounded + (v * 4) };
+		Out[v].Bits = ((uint32)(int32)Field[0] & 0x3FFu) | (((uint32)(int32)Field[1] & 0x3FFu) << 10) | (((uint32)(int32)Field[2] & 0x3FFu) << 20) | ((uint32)(int32)Field[3] << 30);
+	}
+#endif
+}
+
+
+template <bool Signed>
+INLINE TLanes<float, TNativeLanes<float>::Count> STPacked1010102<Signed>::UnpackRegister(const STPacked1010102<Signed>* In)
+{
+	// Each vector is broadcast to 4 lanes, every lane shifts its field to the top and back down, extending the sign when signed.
+#if defined(COPIRITE_AVX512)
+	__m512i Integers{ _mm512_permutexvar_epi32(_mm512_setr_epi32(0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3), _mm512_castsi128_si512(_mm_loadu_si128((const __m128i*)In))) };
+	Integers = _mm512_sllv_epi32(Integers, _mm512_setr_epi32(22, 12, 2, 0, 22, 12, 2, 0, 22, 12, 2, 0, 22, 12, 2, 0));
+	const __m512i Down{ _mm512_setr_epi32(22, 22, 22, 30, 22, 22, 22, 30, 22, 22, 22, 30, 22, 22, 22, 30) };
+	return _mm512_cvtepi32_ps(Signed ? _mm512_srav_epi32(Integers, Down) : _mm512_srlv_epi32(Integers, Down));
+#elif defined(COPIRITE_AVX2)
+	__m256i Integers{ _mm256_permutevar8x32_epi32(_mm256_castsi128_si256(_mm_loadl_epi64((const __m128i*)In)), _mm256_setr_epi32(0, 0, 0, 0, 1, 1, 1, 1)) };
+	Integers = _mm256_sllv_epi32(Integers, _mm256_setr_epi32(22, 12, 2, 0, 22, 12, 2, 0));
+	const __m256i Down{ _mm256_setr_epi32(22, 22, 22, 30, 22, 22, 22, 30) };
+	return _mm256_cvtepi32_ps(Signed ? _mm256_srav_epi32(Integers, Down) : _mm256_srlv_epi32(Integers, Down));
+#elif defined(COPIRITE_SSE41) && !defined(COPIRITE_AVX)
+	const __m128i Integers{ _mm_mullo_epi32(_mm_set1_epi32((int32)In->Bits), _mm_setr_epi32(1 << 22, 1 << 12, 1 << 2, 1)) };
+	const __m128i Fields{ Signed ? _mm_blend_epi16(_mm_srai_epi32(Integers, 22), _mm_srai_epi32(Integers, 30), 0xC0) : _mm_blend_epi16(_mm_srli_epi32(Integers, 22), _mm_srli_epi32(Integers, 30), 0xC0) };
+	return _mm_cvtepi32_ps(Fields);
+#else
+	constexpr uint Lanes{ TNativeLanes<float>::Count };
+	alignas(64) float Fields[Lanes];
+	for (uint v = 0; v < Lanes / 4; ++v)
+	{
+		const uint32 Packed{ In[v].Bits };
+		if constexpr (Signed)
+		{
+			Fields[(v * 4) + 0] = (float)((int32)(Packed << 22) >> 22);
+			Fields[(v * 4) + 1] = (float)((int32)(Packed << 12) >> 22);
+			Fields[(v * 4) + 2] = (float)((int32)(Packed << 2) >> 22);
+			Fields[(v * 4) + 3] = (float)((int32)Packed >> 30);
+		}
+		else
+		{
+			Fields[(v * 4) + 0] = (float)(Packed & 0x3FFu);
+			Fields[(v * 4) + 1] = (float)((Packed >> 10) & 0x3FFu);
+			Fields[(v * 4) + 2] = (float)((Packed >> 20) & 0x3FFu);
+			Fields[(v * 4) + 3] = (float)(Packed >> 30);
+		}
+	}
+	return TLanes<float, Lanes>::Load(Fields);
+#endif
+}
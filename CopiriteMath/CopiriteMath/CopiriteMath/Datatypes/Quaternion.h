@@ -0,0 +1,569 @@
+#pragma once
+#include "Vector.h"
+#include "VectorArray.h"
+#include "Matrix.h"
+
+
+
+// Represents a rotation as a unit quaternion, stored as the X, Y, Z and W components of a vector.
+// Rotations are combined in the order they are applied, A * B rotates by A and then by B, matching STMatrix.
+// @note - Euler angles in degrees are only used by FromEuler() and ToEuler(), every other function works on the quaternion directly.
+// @template Type - The datatype this quaternion should use.
+template <typename Type>
+struct STQuaternion
+{
+private:
+	/// Properties
+
+	// Stores the X, Y and Z imaginary components followed by the W real component.
+	STVector<4, Type> Data;
+
+	// The SIMD backend for this quaternion's components.
+	typedef TVectorSIMD<4, Type> SIMD;
+
+
+	/// Functions
+
+	// Calculates the Hamilton product of two quaternions, the rotation B followed by the rotation A.
+	static INLINE STQuaternion<Type> Hamilton(const STQuaternion<Type>& A, const STQuaternion<Type>& B);
+
+	// Rotates a batch of 3D vectors stored one after another.
+	// @template Inverse - Should the inverse rotation be applied.
+	template <bool Inverse>
+	INLINE void RotateBatch(const STVector<3, Type>* In, STVector<3, Type>* Out, uint Count) const;
+
+	// Rotates a batch of 3D vectors stored as a structure of arrays, long arrays are split across SThreadPool::Get().
+	// @template Inverse - Should the inverse rotation be applied.
+	template <bool Inverse>
+	INLINE void RotateBatch(const STVectorArray<3, Type>& In, STVectorArray<3, Type>& Out) const;
+
+
+public:
+	/// Constructors
+
+	// Constructor, Default. Initializes the identity rotation.
+	INLINE STQuaternion();
+
+	// Constructor, Initializes the quaternion with each component.
+	// @param InX - The value used to initialize the X component.
+	// @param InY - The value used to initialize the Y component.
+	// @param InZ - The value used to initialize the Z component.
+	// @param InW - The value used to initialize the W component.
+	INLINE VECTORCALL STQuaternion(Type InX, Type InY, Type InZ, Type InW);
+
+	// Constructor, Initializes the quaternion with the components of a vector.
+	// @param Vector - The X, Y, Z and W components.
+	INLINE explicit STQuaternion(const STVector<4, Type>& Vector);
+
+	// Creates a rotation around an axis.
+	// @param Axis - The normalized axis to rotate around.
+	// @param Radians - The angle to rotate by.
+	// @return - The resulting rotation.
+	static INLINE STQuaternion<Type> FromAxisAngle(const STVector<3, Type>& Axis, Type Radians);
+
+	// Creates a rotation from euler angles in degrees, the same layout STVector::Rotation() returns.
+	// The roll around X is applied first, then the pitch around Y and last the yaw around Z.
+	// @param Degrees - The pitch in X, the yaw in Y and the roll in Z.
+	// @return - The resulting rotation.
+	static INLINE STQuaternion<Type> FromEuler(const STVector<3, Type>& Degrees);
+
+	// Creates a rotation from the upper 3x3 part of a rotation matrix.
+	// @param Matrix - A matrix without scale or shear.
+	// @return - The resulting rotation.
+	template <uint Rows, uint Cols>
+	static INLINE STQuaternion<Type> FromMatrix(const STMatrix<Rows, Cols, Type>& Matrix);
+
+
+
+	/// Operators
+
+	// Operator, Returns the component at the given index.
+	INLINE Type& operator[](const uint& Index) { return Data[Index]; }
+
+	// Operator, Returns the component at the given index.
+	INLINE Type operator[](const uint& Index) const { return Data[Index]; }
+
+	// Operator, Returns the rotation of this quaternion followed by the rotation of another quaternion.
+	INLINE STQuaternion<Type> operator*(const STQuaternion<Type>& Other) const;
+
+	// Operator, Follows the rotation of this quaternion by the rotation of another quaternion.
+	INLINE STQuaternion<Type>& operator*=(const STQuaternion<Type>& Other);
+
+	// Operator, Returns the negated quaternion, it represents the same rotation.
+	INLINE STQuaternion<Type> operator-() const;
+
+
+
+	/// Functions
+
+	// Returns the X, Y, Z and W components as a vector.
+	INLINE const STVector<4, Type>& GetVector() const { return Data; }
+
+	// Calculates the dot product between this quaternion and another quaternion.
+	INLINE Type DotProduct(const STQuaternion<Type>& Other) const;
+
+	// Returns the conjugate of this quaternion, the inverse rotation of a unit quaternion.
+	INLINE STQuaternion<Type> Conjugate() const;
+
+	// Returns the inverse of this quaternion, works for quaternions that are not unit length.
+	INLINE STQuaternion<Type> Inverse() const;
+
+	// Normalizes this quaternion to unit length.
+	// @param Tolerance - Quaternions with a squared length at or below this are set to the identity.
+	INLINE void Normalize(Type Tolerance = (Type)MICRO_NUMBER);
+
+	// Returns a normalized copy of this quaternion.
+	INLINE STQuaternion<Type> GetNormalized(Type Tolerance = (Type)MICRO_NUMBER) const;
+
+	// Converts this quaternion to a rotation matrix.
+	// @template Size - 3 for a 3x3 matrix or 4 for an affine 4x4 matrix without translation.
+	template <uint Size = 4>
+	INLINE STMatrix<Size, Size, Type> ToMatrix() const;
+
+	// Converts this quaternion to euler angles in degrees, the same layout STVector::Rotation() returns.
+	// @return - The pitch in X, the yaw in Y and the roll in Z.
+	INLINE STVector<3, Type> ToEuler() const;
+
+	// Rotates a vector by this quaternion.
+	// @param Vector - The vector to rotate.
+	// @return - The rotated vector.
+	INLINE STVector<3, Type> RotateVector(const STVector<3, Type>& Vector) const;
+
+	// Rotates a vector by the inverse of this quaternion.
+	// @param Vector - The vector to rotate.
+	// @return - The rotated vector.
+	INLINE STVector<3, Type> UnrotateVector(const STVector<3, Type>& Vector) const;
+
+	// Rotates an array of vectors by this quaternion, long arrays are split across SThreadPool::Get().
+	// @param In - The vectors to rotate.
+	// @param Out - Where to store the rotated vectors, may be the same as In.
+	// @param Count - How many vectors to rotate.
+	INLINE void RotateVectors(const STVector<3, Type>* In, STVector<3, Type>* Out, uint Count) const;
+
+	// Rotates an array of vectors by this quaternion, long arrays are split across SThreadPool::Get().
+	// @param In - The vectors to rotate.
+	// @param Out - Where to store the rotated vectors, may be the same as In. Resized to the number of vectors.
+	INLINE void RotateVectors(const STVectorArray<3, Type>& In, STVectorArray<3, Type>& Out) const;
+
+	// Rotates an array of vectors by the inverse of this quaternion, long arrays are split across SThreadPool::Get().
+	// @param In - The vectors to rotate.
+	// @param Out - Where to store the rotated vectors, may be the same as In.
+	// @param Count - How many vectors to rotate.
+	INLINE void UnrotateVectors(const STVector<3, Type>* In, STVector<3, Type>* Out, uint Count) const;
+
+	// Rotates an array of vectors by the inverse of this quaternion, long arrays are split across SThreadPool::Get().
+	// @param In - The vectors to rotate.
+	// @param Out - Where to store the rotated vectors, may be the same as In. Resized to the number of vectors.
+	INLINE void UnrotateVectors(const STVectorArray<3, Type>& In, STVectorArray<3, Type>& Out) const;
+
+	// Interpolates linearly between two rotations and normalizes the result, taking the shortest path.
+	// @note - Cheaper than Slerp(), the angular speed is not constant but the error stays below 1 degree for rotations up to 90 degrees apart.
+	// @param A - The rotation at Alpha 0.
+	// @param B - The rotation at Alpha 1.
+	// @param Alpha - How far to interpolate.
+	// @return - The interpolated rotation.
+	static INLINE STQuaternion<Type> Nlerp(const STQuaternion<Type>& A, const STQuaternion<Type>& B, Type Alpha);
+
+	// Interpolates between two rotations with a constant angular speed, taking the shortest path.
+	// @note - Float quaternions use TMath::FastATan2 and TMath::FastSin for the weights.
+	// @param A - The rotation at Alpha 0.
+	// @param B - The rotation at Alpha 1.
+	// @param Alpha - How far to interpolate.
+	// @return - The interpolated rotation.
+	static INLINE STQuaternion<Type> Slerp(const STQuaternion<Type>& A, const STQuaternion<Type>& B, Type Alpha);
+
+	// Returns true if this quaternion is almost equal to another quaternion.
+	// @note - A quaternion and its negation are the same rotation but are not considered equal.
+	INLINE bool nearlyEqual(const STQuaternion<Type>& Other, const Type& Threshold = MICRO_NUMBER) const { return Data.nearlyEqual(Other.Data, Threshold); }
+
+	// Prints out the quaternion.
+	INLINE void Print() const { Data.Print(); }
+};
+
+
+
+// A floating point quaternion.
+typedef STQuaternion<float> SQuaternion;
+
+// A double type quaternion.
+typedef STQuaternion<double> SQuaterniond;
+
+
+
+template <typename Type>
+STQuaternion<Type>::STQuaternion()
+	:Data{ (Type)0.0f, (Type)0.0f, (Type)0.0f, (Type)1.0f }
+{}
+
+
+template <typename Type>
+VECTORCALL STQuaternion<Type>::STQuaternion(Type InX, Type InY, Type InZ, Type InW)
+	:Data{ InX, InY, InZ, InW }
+{}
+
+
+template <typename Type>
+STQuaternion<Type>::STQuaternion(const STVector<4, Type>& Vector)
+	:Data{ Vector }
+{}
+
+
+template <typename Type>
+INLINE STQuaternion<Type> STQuaternion<Type>::FromAxisAngle(const STVector<3, Type>& Axis, Type Radians)
+{
+	const Type Sin{ TMath::Sin(Radians * (Type)0.5f) };
+	return STQuaternion<Type>{ Axis[EAxis::X] * Sin, Axis[EAxis::Y] * Sin, Axis[EAxis::Z] * Sin, TMath::Cos(Radians * (Type)0.5f) };
+}
+
+
+template <typename Type>
+INLINE STQuaternion<Type> STQuaternion<Type>::FromEuler(const STVector<3, Type>& Degrees)
+{
+	// Positive pitch lifts the X axis towards Z, which is a negative rotation around Y.
+	const STQuaternion<Type> Roll{ FromAxisAngle(STVector<3, Type>{ (Type)1.0f, (Type)0.0f, (Type)0.0f }, (Type)TO_RADIANS(Degrees[EAxis::Z])) };
+	const STQuaternion<Type> Pitch{ FromAxisAngle(STVector<3, Type>{ (Type)0.0f, (Type)1.0f, (Type)0.0f }, (Type)-TO_RADIANS(Degrees[EAxis::X])) };
+	const STQuaternion<Type> Yaw{ FromAxisAngle(STVector<3, Type>{ (Type)0.0f, (Type)0.0f, (Type)1.0f }, (Type)TO_RADIANS(Degrees[EAxis::Y])) };
+	return Roll * Pitch * Yaw;
+}
+
+
+template <typename Type>
+template <uint Rows, uint Cols>
+INLINE STQuaternion<Type> STQuaternion<Type>::FromMatrix(const STMatrix<Rows, Cols, Type>& Matrix)
+{
+	ASSERT(Rows >= 3 && Cols >= 3, "Matrix must have 3 or more rows and columns to contain a rotation.");
+	const Type M00{ Matrix[0][0] }, M01{ Matrix[0][1] }, M02{ Matrix[0][2] };
+	const Type M10{ Matrix[1][0] }, M11{ Matrix[1][1] }, M12{ Matrix[1][2] };
+	const Type M20{ Matrix[2][0] }, M21{ Matrix[2][1] }, M22{ Matrix[2][2] };
+
+	// Solves for the largest component first so the division is always well conditioned.
+	STQuaternion<Type> Result;
+	const Type Trace{ M00 + M11 + M22 };
+	if (Trace > (Type)0.0f)
+	{
+		const Type S{ (Type)0.5f * TMath::InvSqrt(Trace + (Type)1.0f) };
+		Result = STQuaternion<Type>{ (M12 - M21) * S, (M20 - M02) * S, (M01 - M10) * S, (Type)0.25f / S };
+	}
+	else if (M00 > M11 && M00 > M22)
+	{
+		const Type S{ (Type)2.0f * TMath::Sqrt((Type)1.0f + M00 - M11 - M22) };
+		const Type InvS{ (Type)1.0f / S };
+		Result = STQuaternion<Type>{ (Type)0.25f * S, (M01 + M10) * InvS, (M02 + M20) * InvS, (M12 - M21) * InvS };
+	}
+	else if (M11 > M22)
+	{
+		const Type S{ (Type)2.0f * TMath::Sqrt((Type)1.0f + M11 - M00 - M22) };
+		const Type InvS{ (Type)1.0f / S };
+		Result = STQuaternion<Type>{ (M01 + M10) * InvS, (Type)0.25f * S, (M12 + M21) * InvS, (M20 - M02) * InvS };
+	}
+	else
+	{
+		const Type S{ (Type)2.0f * TMath::Sqrt((Type)1.0f + M22 - M00 - M11) };
+		const Type InvS{ (Type)1.0f / S };
+		Result = STQuaternion<Type>{ (M02 + M20) * InvS, (M12 + M21) * InvS, (Type)0.25f * S, (M01 - M10) * InvS };
+	}
+	Result.Normalize();
+	return Result;
+}
+
+
+template <typename Type>
+INLINE STQuaternion<Type> STQuaternion<Type>::Hamilton(const STQuaternion<Type>& A, const STQuaternion<Type>& B)
+{
+	STQuaternion<Type> Result;
+	if constexpr (SIMD::Enabled && std::is_same<Type, float>::value)
+	{
+		const typename SIMD::Register QA{ SIMD::Load(A.Data.GetData()) };
+		const typename SIMD::Register QB{ SIMD::Load(B.Data.GetData()) };
+
+		// Each of A's components scales a shuffled copy of B, the signs follow the quaternion multiplication table.
+		typename SIMD::Register R{ SIMD::Mul(SIMD::template Splat<3>(QA), QB) };
+		R = SIMD::Add(R, SIMD::Mul(SIMD::template Splat<0>(QA), SIMD::Xor(SIMD::template Swizzle<3, 2, 1, 0>(QB), SIMD::Set(0.0f, -0.0f, 0.0f, -0.0f))));
+		R = SIMD::Add(R, SIMD::Mul(SIMD::template Splat<1>(QA), SIMD::Xor(SIMD::template Swizzle<2, 3, 0, 1>(QB), SIMD::Set(0.0f, 0.0f, -0.0f, -0.0f))));
+		R = SIMD::Add(R, SIMD::Mul(SIMD::template Splat<2>(QA), SIMD::Xor(SIMD::template Swizzle<1, 0, 3, 2>(QB), SIMD::Set(-0.0f, 0.0f, 0.0f, -0.0f))));
+		SIMD::Store(Result.Data.GetData(), R);
+	}
+	else
+	{
+		const Type AX{ A[EAxis::X] }, AY{ A[EAxis::Y] }, AZ{ A[EAxis::Z] }, AW{ A[EAxis::W] };
+		const Type BX{ B[EAxis::X] }, BY{ B[EAxis::Y] }, BZ{ B[EAxis::Z] }, BW{ B[EAxis::W] };
+		Result[EAxis::X] = (AW * BX) + (AX * BW) + (AY * BZ) - (AZ * BY);
+		Result[EAxis::Y] = (AW * BY) - (AX * BZ) + (AY * BW) + (AZ * BX);
+		Result[EAxis::Z] = (AW * BZ) + (AX * BY) - (AY * BX) + (AZ * BW);
+		Result[EAxis::W] = (AW * BW) - (AX * BX) - (AY * BY) - (AZ * BZ);
+	}
+	return Result;
+}
+
+
+template <typename Type>
+INLINE STQuaternion<Type> STQuaternion<Type>::operator*(const STQuaternion<Type>& Other) const
+{
+	return Hamilton(Other, *this);
+}
+
+
+template <typename Type>
+INLINE STQuaternion<Type>& STQuaternion<Type>::operator*=(const STQuaternion<Type>& Other)
+{
+	*this = Hamilton(Other, *this);
+	return *this;
+}
+
+
+template <typename Type>
+INLINE STQuaternion<Type> STQuaternion<Type>::operator-() const
+{
+	return STQuaternion<Type>{ -Data };
+}
+
+
+template <typename Type>
+INLINE Type STQuaternion<Type>::DotProduct(const STQuaternion<Type>& Other) const
+{
+	return Data ^ Other.Data;
+}
+
+
+template <typename Type>
+INLINE STQuaternion<Type> STQuaternion<Type>::Conjugate() const
+{
+	return STQuaternion<Type>{ -Data[EAxis::X], -Data[EAxis::Y], -Data[EAxis::Z], Data[EAxis::W] };
+}
+
+
+template <typename Type>
+INLINE STQuaternion<Type> STQuaternion<Type>::Inverse() const
+{
+	return STQuaternion<Type>{ Conjugate().Data / (Data ^ Data) };
+}
+
+
+template <typename Type>
+INLINE void STQuaternion<Type>::Normalize(Type Tolerance)
+{
+	const Type SquareSum{ Data ^ Data };
+	if (SquareSum > Tolerance)
+	{
+		Data *= TMath::InvSqrt(SquareSum);
+	}
+	else
+	{
+		*this = STQuaternion<Type>{};
+	}
+}
+
+
+template <typename Type>
+INLINE STQuaternion<Type> STQuaternion<Type>::GetNormalized(Type Tolerance) const
+{
+	STQuaternion<Type> Result{ *this };
+	Result.Normalize(Tolerance);
+	return Result;
+}
+
+
+template <typename Type>
+template <uint Size>
+INLINE STMatrix<Size, Size, Type> STQuaternion<Type>::ToMatrix() const
+{
+	ASSERT(Size == 3 || Size == 4, "Quaternions can only be converted to 3x3 or 4x4 matrices.");
+	const Type X{ Data[EAxis::X] }, Y{ Data[EAxis::Y] }, Z{ Data[EAxis::Z] }, W{ Data[EAxis::W] };
+	const Type X2{ X + X }, Y2{ Y + Y }, Z2{ Z + Z };
+	const Type XX{ X * X2 }, YY{ Y * Y2 }, ZZ{ Z * Z2 };
+	const Type XY{ X * Y2 }, XZ{ X * Z2 }, YZ{ Y * Z2 };
+	const Type WX{ W * X2 }, WY{ W * Y2 }, WZ{ W * Z2 };
+
+	// Each row is the image of a basis vector, as vectors are multiplied from the left.
+	STMatrix<Size, Size, Type> Result{ STMatrix<Size, Size, Type>::Identity() };
+	Result[0][0] = (Type)1.0f - (YY + ZZ);
+	Result[0][1] = XY + WZ;
+	Result[0][2] = XZ - WY;
+	Result[1][0] = XY - WZ;
+	Result[1][1] = (Type)1.0f - (XX + ZZ);
+	Result[1][2] = YZ + WX;
+	Result[2][0] = XZ + WY;
+	Result[2][1] = YZ - WX;
+	Result[2][2] = (Type)1.0f - (XX + YY);
+	return Result;
+}
+
+
+template <typename Type>
+INLINE STVector<3, Type> STQuaternion<Type>::ToEuler() const
+{
+	const STVector<3, Type> Forward{ RotateVector(STVector<3, Type>{ (Type)1.0f, (Type)0.0f, (Type)0.0f }) };
+	const STVector<3, Type> Right{ RotateVector(STVector<3, Type>{ (Type)0.0f, (Type)1.0f, (Type)0.0f }) };
+	const STVector<3, Type> Up{ RotateVector(STVector<3, Type>{ (Type)0.0f, (Type)0.0f, (Type)1.0f }) };
+
+	STVector<3, Type> Result;
+	Result[EAxis::X] = (Type)TO_DEGREES(TMath::ATan2(Forward[EAxis::Z], TMath::Sqrt((Forward[EAxis::X] * Forward[EAxis::X]) + (Forward[EAxis::Y] * Forward[EAxis::Y]))));
+	Result[EAxis::Y] = (Type)TO_DEGREES(TMath::ATan2(Forward[EAxis::Y], Forward[EAxis::X]));
+	Result[EAxis::Z] = (Type)TO_DEGREES(TMath::ATan2(Right[EAxis::Z], Up[EAxis::Z]));
+	return Result;
+}
+
+
+template <typename Type>
+INLINE STVector<3, Type> STQuaternion<Type>::RotateVector(const STVector<3, Type>& Vector) const
+{
+	STVector<3, Type> Result;
+	RotateBatch<false>(&Vector, &Result, 1);
+	return Result;
+}
+
+
+template <typename Type>
+INLINE STVector<3, Type> STQuaternion<Type>::UnrotateVector(const STVector<3, Type>& Vector) const
+{
+	STVector<3, Type> Result;
+	RotateBatch<true>(&Vector, &Result, 1);
+	return Result;
+}
+
+
+template <typename Type>
+INLINE void STQuaternion<Type>::RotateVectors(const STVector<3, Type>* In, STVector<3, Type>* Out, uint Count) const
+{
+	constexpr uint Granularity{ 64 / std::gcd((uint)sizeof(STVector<3, Type>), 64u) };
+	ParallelFor(Count, [this, In, Out](uint Begin, uint End) { RotateBatch<false>(In + Begin, Out + Begin, End - Begin); }, VectorGrain, Granularity);
+}
+
+
+template <typename Type>
+INLINE void STQuaternion<Type>::RotateVectors(const STVectorArray<3, Type>& In, STVectorArray<3, Type>& Out) const
+{
+	RotateBatch<false>(In, Out);
+}
+
+
+template <typename Type>
+INLINE void STQuaternion<Type>::UnrotateVectors(const STVector<3, Type>* In, STVector<3, Type>* Out, uint Count) const
+{
+	constexpr uint Granularity{ 64 / std::gcd((uint)sizeof(STVector<3, Type>), 64u) };
+	ParallelFor(Count, [this, In, Out](uint Begin, uint End) { RotateBatch<true>(In + Begin, Out + Begin, End - Begin); }, VectorGrain, Granularity);
+}
+
+
+template <typename Type>
+INLINE void STQuaternion<Type>::UnrotateVectors(const STVectorArray<3, Type>& In, STVectorArray<3, Type>& Out) const
+{
+	RotateBatch<true>(In, Out);
+}
+
+
+// Every rotation uses V' = V + W * T + Q x T where T = 2 * (Q x V), which needs two cross products instead of two quaternion products.
+template <typename Type>
+template <bool Inverse>
+INLINE void STQuaternion<Type>::RotateBatch(const STVector<3, Type>* In, STVector<3, Type>* Out, uint Count) const
+{
+	const STQuaternion<Type> Q{ Inverse ? Conjugate() : *this };
+
+	typedef TVectorSIMD<3, Type> SIMD3;
+	if constexpr (SIMD::Enabled && SIMD3::Enabled)
+	{
+		// The W lane of the loaded vectors is zero, so it stays zero through both cross products.
+		const typename SIMD::Register QV{ SIMD::Load(Q.Data.GetData()) };
+		const typename SIMD::Register QW{ SIMD::template Splat<3>(QV) };
+		for (uint i = 0; i < Count; ++i)
+		{
+			const typename SIMD::Register V{ SIMD3::Load(In[i].GetData()) };
+			typename SIMD::Register T{ SIMD::Cross(QV, V) };
+			T = SIMD::Add(T, T);
+			const typename SIMD::Register R{ SIMD::Add(SIMD::Add(V, SIMD::Mul(QW, T)), SIMD::Cross(QV, T)) };
+			SIMD3::Store(Out[i].GetData(), R);
+		}
+	}
+	else
+	{
+		const STVector<3, Type> QV{ Q[EAxis::X], Q[EAxis::Y], Q[EAxis::Z] };
+		const Type QW{ Q[EAxis::W] };
+		for (uint i = 0; i < Count; ++i)
+		{
+			const STVector<3, Type> V{ In[i] };
+			const STVector<3, Type> T{ (QV | V) * (Type)2.0f };
+			Out[i] = V + (T * QW) + (QV | T);
+		}
+	}
+}
+
+
+template <typename Type>
+template <bool Inverse>
+INLINE void STQuaternion<Type>::RotateBatch(const STVectorArray<3, Type>& In, STVectorArray<3, Type>& Out) const
+{
+	typedef typename STVectorArray<3, Type>::SLanes SLanes;
+	if (&Out != &In) Out.Resize(In.Num());
+
+	const STQuaternion<Type> Q{ Inverse ? Conjugate() : *this };
+	const SLanes QX{ Q[EAxis::X] };
+	const SLanes QY{ Q[EAxis::Y] };
+	const SLanes QZ{ Q[EAxis::Z] };
+	const SLanes QW{ Q[EAxis::W] };
+	const SLanes Two{ (Type)2.0f };
+
+	const Type* InX{ In.GetAxis(EAxis::X) };
+	const Type* InY{ In.GetAxis(EAxis::Y) };
+	const Type* InZ{ In.GetAxis(EAxis::Z) };
+	Type* OutX{ Out.GetAxis(EAxis::X) };
+	Type* OutY{ Out.GetAxis(EAxis::Y) };
+	Type* OutZ{ Out.GetAxis(EAxis::Z) };
+
+	// Every piece starts on a cache line of each axis, like STVectorArray's own batched functions.
+	constexpr uint Granularity{ ((64 / sizeof(Type)) > SLanes::Lanes) ? (uint)(64 / sizeof(Type)) : SLanes::Lanes };
+	ParallelFor(In.Num(), [&](uint Begin, uint End)
+		{
+			for (uint i = Begin; i < End; i += SLanes::Lanes)
+			{
+				const SLanes X{ SLanes::Load(InX + i) };
+				const SLanes Y{ SLanes::Load(InY + i) };
+				const SLanes Z{ SLanes::Load(InZ + i) };
+				const SLanes TX{ Two * ((QY * Z) - (QZ * Y)) };
+				const SLanes TY{ Two * ((QZ * X) - (QX * Z)) };
+				const SLanes TZ{ Two * ((QX * Y) - (QY * X)) };
+				QW.MulAdd(TX, X + ((QY * TZ) - (QZ * TY))).Store(OutX + i);
+				QW.MulAdd(TY, Y + ((QZ * TX) - (QX * TZ))).Store(OutY + i);
+				QW.MulAdd(TZ, Z + ((QX * TY) - (QY * TX))).Store(OutZ + i);
+			}
+		}, STVectorArray<3, Type>::ParallelGrain, Granularity);
+}
+
+
+template <typename Type>
+INLINE STQuaternion<Type> STQuaternion<Type>::Nlerp(const STQuaternion<Type>& A, const STQuaternion<Type>& B, Type Alpha)
+{
+	// Flipping B when the rotations are more than 180 degrees apart takes the shorter path.
+	const Type BScale{ ((A.Data ^ B.Data) < (Type)0.0f) ? -Alpha : Alpha };
+	STQuaternion<Type> Result{ (A.Data * ((Type)1.0f - Alpha)) + (B.Data * BScale) };
+	Result.Normalize();
+	return Result;
+}
+
+
+template <typename Type>
+INLINE STQuaternion<Type> STQuaternion<Type>::Slerp(const STQuaternion<Type>& A, const STQuaternion<Type>& B, Type Alpha)
+{
+	const Type Dot{ A.Data ^ B.Data };
+	const Type AbsDot{ TMath::Abs(Dot) };
+
+	// Nearly identical rotations divide by a tiny sine, linear interpolation is exact enough there.
+	if (AbsDot > (Type)0.9995f) return Nlerp(A, B, Alpha);
+
+	Type WeightA, WeightB;
+	if constexpr (std::is_same<Type, float>::value)
+	{
+		const float Angle{ TMath::FastATan2(TMath::Sqrt(1.0f - (AbsDot * AbsDot)), AbsDot) };
+		const float InvSin{ TMath::FastInvSqrt(1.0f - (AbsDot * AbsDot)) };
+		WeightA = TMath::FastSin((1.0f - Alpha) * Angle) * InvSin;
+		WeightB = TMath::FastSin(Alpha * Angle) * InvSin;
+	}
+	else
+	{
+		const Type Angle{ TMath::ATan2(TMath::Sqrt((Type)1.0f - (AbsDot * AbsDot)), AbsDot) };
+		const Type InvSin{ TMath::InvSqrt((Type)1.0f - (AbsDot * AbsDot)) };
+		WeightA = TMath::Sin(((Type)1.0f - Alpha) * Angle) * InvSin;
+		WeightB = TMath::Sin(Alpha * Angle) * InvSin;
+	}
+	if (Dot < (Type)0.0f) WeightB = -WeightB;
+	return STQuaternion<Type>{ (A.Data * WeightA) + (B.Data * WeightB) };
+}
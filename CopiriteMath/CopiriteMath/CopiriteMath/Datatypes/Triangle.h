@@ -0,0 +1,661 @@
+#pragma once
+#include "Vector.h"
+#include "../Parallel/ThreadPool.h"
+#include <bit>
+#include <limits>
+#include <numeric>
+#include <vector>
+
+
+// Every ray triangle test here is the watertight test of Woop, Benthin and Wald. Each ray picks the axis its direction is
+// longest on and shears space so the ray runs down it, the triangle is then tested in 2D with edge functions.
+// An edge shared by two triangles gives each the same edge function with opposite signs, and points exactly on an edge
+// count as inside, so a ray can never slip between two triangles that share an edge.
+// The lane and scalar tests do the same operations in the same order, so they give bit identical results.
+// @note - Both rely on multiplies and adds not being fused into FMAs, a fused edge function is no longer exactly the negation of its
+//	neighbour's and leaves holes along shared edges. Every product that is added goes through TMath::Unfused(), so the tests stay
+//	watertight whatever -ffp-contract or /fp: setting the code that includes them is built with.
+// @note - None of the tests go through STVector operators, so no NaN checks are made on the hot path.
+
+
+
+// Where a ray hit a triangle.
+// @template Type - The datatype the ray and triangle use.
+template <typename Type>
+struct STTriangleHit
+{
+	// The triangle index of a miss.
+	static constexpr uint32 None{ ~0u };
+
+	// How far along the ray the hit is, in multiples of the direction's length.
+	Type Distance;
+
+	// The barycentric weight of the triangle's second vertex.
+	Type U;
+
+	// The barycentric weight of the triangle's third vertex, the first vertex's weight is 1 - U - V.
+	Type V;
+
+	// Which triangle was hit, None if nothing was.
+	uint32 Triangle;
+
+
+	// Returns a hit record of nothing hit yet, closest hit tests only accept hits nearer than its distance.
+	// @param MaxDistance - How far along the ray to test.
+	static INLINE STTriangleHit Miss(Type MaxDistance = std::numeric_limits<Type>::max()) { return STTriangleHit{ MaxDistance, (Type)0, (Type)0, None }; }
+
+	// Returns true if a triangle was hit.
+	INLINE bool IsHit() const { return Triangle != None; }
+};
+
+
+
+// A ray prepared for the watertight triangle test, the setup is shared by every triangle it is tested against.
+// @template Type - The datatype the ray uses.
+template <typename Type>
+struct STTriangleRay
+{
+	ASSERT(std::is_floating_point<Type>::value, "Triangle tests need a floating point type.");
+
+	// Where the ray starts.
+	STVector<3, Type> Origin;
+
+	// The axes the triangle is projected on, Kz is the axis the direction is longest on.
+	uint Kx, Ky, Kz;
+
+	// The shear that lines the direction up with Kz, and 1 / its Kz component.
+	Type Sx, Sy, Sz;
+
+
+	// Constructor, Default. The ray is left uninitialized.
+	INLINE STTriangleRay() = default;
+
+	// Constructor, Prepares a ray.
+	// @param InOrigin - Where the ray starts.
+	// @param Direction - The direction of the ray, it does not have to be normalized.
+	INLINE STTriangleRay(const STVector<3, Type>& InOrigin, const STVector<3, Type>& Direction);
+
+	// Tests the ray against a triangle, hits from either side count.
+	// @param A, B, C - The triangle's vertices.
+	// @param MaxDistance - How far along the ray to test, in multiples of the direction's length.
+	// @param Distance - Set to how far along the ray the hit is. Only meaningful on a hit.
+	// @param U, V - Set to the barycentric weights of B and C. Only meaningful on a hit.
+	// @return - True if the ray hits the triangle between 0 and MaxDistance.
+	INLINE bool Intersect(const STVector<3, Type>& A, const STVector<3, Type>& B, const STVector<3, Type>& C, Type MaxDistance, Type& Distance, Type& U, Type& V) const;
+
+	// Tests the ray against a triangle and keeps the hit if it is the closest so far.
+	// @param A, B, C - The triangle's vertices.
+	// @param Triangle - The index stored in the hit record.
+	// @param Hit - The closest hit so far, only hits nearer than its distance replace it.
+	// @return - True if the hit record was replaced.
+	INLINE bool Intersect(const STVector<3, Type>& A, const STVector<3, Type>& B, const STVector<3, Type>& C, uint32 Triangle, STTriangleHit<Type>& Hit) const;
+};
+
+
+
+// Closest hits of a packet of rays, one lane per ray.
+// @template Type - The datatype the rays use.
+// @template Count - How many rays are in the packet.
+template <typename Type, uint Count = TNativeLanes<Type>::Count>
+struct STTriangleHitPacket
+{
+	// The lanes of the packet.
+	typedef TLanes<Type, Count> SLanes;
+
+	// How far along each ray its hit is, the max distance while nothing has been hit.
+	SLanes Distance;
+
+	// The barycentric weight of each hit triangle's second vertex.
+	SLanes U;
+
+	// The barycentric weight of each hit triangle's third vertex.
+	SLanes V;
+
+	// Which triangle each ray hit, STTriangleHit::None if nothing was.
+	uint32 Triangle[Count];
+
+
+	// Constructor, Default. The hits are left uninitialized.
+	INLINE STTriangleHitPacket() = default;
+
+	// Constructor, Starts every ray with nothing hit.
+	// @param MaxDistance - How far along every ray to test.
+	INLINE explicit STTriangleHitPacket(Type MaxDistance);
+
+	// Returns the hit record of one ray.
+	// @param Index - Which lane to read.
+	INLINE STTriangleHit<Type> GetHit(uint Index) const { return STTriangleHit<Type>{ Distance[Index], U[Index], V[Index], Triangle[Index] }; }
+};
+
+
+
+// A group of rays stored as a structure of lanes, tested against a single triangle in one pass.
+// Suited to coherent rays such as a camera's or a lightmap texel's, which mostly hit the same triangles.
+// @template Type - The datatype the rays use.
+// @template Count - How many rays are in the packet.
+template <typename Type, uint Count = TNativeLanes<Type>::Count>
+struct STTriangleRayPacket
+{
+	// The lanes of the packet.
+	typedef TLanes<Type, Count> SLanes;
+
+	// Where each ray starts, one set of lanes per axis.
+	SLanes Origin[3];
+
+	// Masks of the rays whose projected x, y and z axes are the first axis.
+	SLanes PickFirst[3];
+
+	// Masks of the rays whose projected x, y and z axes are the second axis, the rest use the third.
+	SLanes PickSecond[3];
+
+	// Each ray's shear and 1 / its direction's component on its longest axis.
+	SLanes Sx, Sy, Sz;
+
+
+	// Constructor, Default. The lanes are left uninitialized.
+	INLINE STTriangleRayPacket() = default;
+
+	// Constructor, Gathers and prepares rays.
+	// @param Origins - Where each ray starts.
+	// @param Directions - The direction of each ray, they do not have to be normalized.
+	// @param InCount - How many rays there are, at most Count. Unused lanes get rays that miss everything.
+	INLINE STTriangleRayPacket(const STVector<3, Type>* Origins, const STVector<3, Type>* Directions, uint InCount);
+
+	// Moves a vertex to every ray's origin and picks each ray's projected axes from it.
+	// @param Vertex - The vertex to move.
+	// @param Projected - Set to the vertex's projected x, y and z for each ray.
+	INLINE void Project(const STVector<3, Type>& Vertex, SLanes (&Projected)[3]) const;
+
+	// Tests every ray against a triangle, hits from either side count.
+	// @param A, B, C - The triangle's vertices.
+	// @param MaxDistance - How far along each ray to test.
+	// @param Distances - Set to how far along each ray its hit is, only meaningful for the rays that hit.
+	// @param U, V - Set to the barycentric weights of B and C, only meaningful for the rays that hit.
+	// @return - A bit mask with a bit set for each ray that hit, the lowest bit is the first ray.
+	INLINE uint IntersectTriangle(const STVector<3, Type>& A, const STVector<3, Type>& B, const STVector<3, Type>& C, const SLanes& MaxDistance, SLanes& Distances, SLanes& U, SLanes& V) const;
+
+	// Tests every ray against a triangle and keeps the hits that are the closest so far.
+	// @param A, B, C - The triangle's vertices.
+	// @param Triangle - The index stored in the hit records.
+	// @param Hits - The closest hits so far, only hits nearer than their distances replace them.
+	// @return - A bit mask with a bit set for each ray whose hit was replaced.
+	INLINE uint IntersectTriangle(const STVector<3, Type>& A, const STVector<3, Type>& B, const STVector<3, Type>& C, uint32 Triangle, STTriangleHitPacket<Type, Count>& Hits) const;
+};
+
+
+
+// A group of triangles stored as a structure of lanes, tested against a single ray in one pass.
+// @template Type - The datatype the triangles use.
+// @template Count - How many triangles are in the packet.
+template <typename Type, uint Count = TNativeLanes<Type>::Count>
+struct STTrianglePacket
+{
+	// The lanes of the packet.
+	typedef TLanes<Type, Count> SLanes;
+
+	// The first vertex of each triangle, one set of lanes per axis.
+	SLanes A[3];
+
+	// The second vertex of each triangle, one set of lanes per axis.
+	SLanes B[3];
+
+	// The third vertex of each triangle, one set of lanes per axis.
+	SLanes C[3];
+
+
+	// Constructor, Default. The lanes are left uninitialized.
+	INLINE STTrianglePacket() = default;
+
+	// Constructor, Gathers triangles into the packet.
+	// @param Vertices - Three vertices for each triangle.
+	// @param InCount - How many triangles there are, at most Count. Unused lanes get degenerate triangles that nothing hits.
+	INLINE STTrianglePacket(const STVector<3, Type>* Vertices, uint InCount);
+
+	// Constructor, Gathers indexed triangles into the packet.
+	// @param Vertices - The vertices the indices refer to.
+	// @param Indices - Three vertex indices for each triangle.
+	// @param InCount - How many triangles there are, at most Count. Unused lanes get degenerate triangles that nothing hits.
+	INLINE STTrianglePacket(const STVector<3, Type>* Vertices, const uint32* Indices, uint InCount);
+
+	// Tests a ray against every triangle in the packet, hits from either side count.
+	// @param Ray - The ray to test.
+	// @param MaxDistance - How far along the ray to test.
+	// @param Distances - Set to how far along the ray each triangle is hit, only meaningful for the triangles that were hit.
+	// @param U, V - Set to the barycentric weights of each triangle's B and C, only meaningful for the triangles that were hit.
+	// @return - A bit mask with a bit set for each triangle that was hit, the lowest bit is the first triangle.
+	INLINE uint IntersectRay(const STTriangleRay<Type>& Ray, Type MaxDistance, SLanes& Distances, SLanes& U, SLanes& V) const;
+
+	// Tests a ray against every triangle in the packet and keeps the closest hit if it is the closest so far.
+	// @param Ray - The ray to test.
+	// @param FirstTriangle - The index of the packet's first triangle, the others follow it.
+	// @param Hit - The closest hit so far, only hits nearer than its distance replace it. Ties go to the lowest index.
+	// @return - True if the hit record was replaced.
+	INLINE bool IntersectRay(const STTriangleRay<Type>& Ray, uint32 FirstTriangle, STTriangleHit<Type>& Hit) const;
+};
+
+
+
+// A triangle mesh stored as packets of triangles, for intersecting streams of rays.
+// @template Type - The datatype the mesh uses.
+// @template Count - How many triangles are in each packet.
+template <typename Type, uint Count = TNativeLanes<Type>::Count>
+struct STTriangleMesh
+{
+private:
+	/// Properties
+
+	// The triangles, Count to a packet, the last packet is padded with degenerate triangles.
+	std::vector<STTrianglePacket<Type, Count>> Packets;
+
+	// How many triangles there are.
+	uint TriangleCount;
+
+
+public:
+	/// Constructors
+
+	// Constructor, Default. Initializes an empty mesh.
+	INLINE STTriangleMesh() : TriangleCount{ 0 } {}
+
+	// Constructor, Packs a triangle list.
+	// @param Vertices - Three vertices for each triangle.
+	// @param InCount - How many triangles there are.
+	INLINE STTriangleMesh(const STVector<3, Type>* Vertices, uint InCount) { Build(Vertices, InCount); }
+
+	// Constructor, Packs an indexed triangle list.
+	// @param Vertices - The vertices the indices refer to.
+	// @param Indices - Three vertex indices for each triangle.
+	// @param InCount - How many triangles there are.
+	INLINE STTriangleMesh(const STVector<3, Type>* Vertices, const uint32* Indices, uint InCount) { Build(Vertices, Indices, InCount); }
+
+
+	/// Functions
+
+	// Replaces the mesh with a triangle list.
+	// @param Vertices - Three vertices for each triangle.
+	// @param InCount - How many triangles there are.
+	INLINE void Build(const STVector<3, Type>* Vertices, uint InCount);
+
+	// Replaces the mesh with an indexed triangle list.
+	// @param Vertices - The vertices the indices refer to.
+	// @param Indices - Three vertex indices for each triangle.
+	// @param InCount - How many triangles there are.
+	INLINE void Build(const STVector<3, Type>* Vertices, const uint32* Indices, uint InCount);
+
+	// Finds the closest triangle a ray hits.
+	// @param Origin - Where the ray starts.
+	// @param Direction - The direction of the ray, it does not have to be normalized.
+	// @param MaxDistance - How far along the ray to test, in multiples of the direction's length.
+	// @return - The closest hit, its triangle is STTriangleHit::None if nothing was hit.
+	INLINE STTriangleHit<Type> IntersectRay(const STVector<3, Type>& Origin, const STVector<3, Type>& Direction, Type MaxDistance = std::numeric_limits<Type>::max()) const;
+
+	// Finds the closest triangle each ray of a stream hits, split across SThreadPool::Get().
+	// @param Origins - Where each ray starts.
+	// @param Directions - The direction of each ray, they do not have to be normalized.
+	// @param RayCount - How many rays there are.
+	// @param Hits - Receives RayCount hit records, the triangle is STTriangleHit::None for the rays that hit nothing.
+	// @param MaxDistance - How far along every ray to test, in multiples of its direction's length.
+	INLINE void IntersectRays(const STVector<3, Type>* Origins, const STVector<3, Type>* Directions, uint RayCount, STTriangleHit<Type>* Hits, Type MaxDistance = std::numeric_limits<Type>::max()) const;
+
+	// Returns how many triangles there are.
+	INLINE uint Num() const { return TriangleCount; }
+
+	// Returns the packets of triangles.
+	INLINE const std::vector<STTrianglePacket<Type, Count>>& GetPackets() const { return Packets; }
+};
+
+
+
+// A float hit record.
+typedef STTriangleHit<float> STriangleHit;
+
+// A double type hit record.
+typedef STTriangleHit<double> STriangleHitd;
+
+// A float ray prepared for triangle tests.
+typedef STTriangleRay<float> STriangleRay;
+
+// A double type ray prepared for triangle tests.
+typedef STTriangleRay<double> STriangleRayd;
+
+// A float triangle mesh.
+typedef STTriangleMesh<float> STriangleMesh;
+
+// A double type triangle mesh.
+typedef STTriangleMesh<double> STriangleMeshd;
+
+
+
+namespace TTriangle
+{
+	// The watertight test on lanes, with the vertices already relative to the ray's origin and in its projected axes.
+	// @param A, B, C - The vertices' projected x, y and z.
+	// @param Sx, Sy, Sz - The ray's shear.
+	// @param MaxDistance - How far along the ray to test.
+	// @param Distances, U, V - Set to the hit distance and barycentric weights of B and C.
+	// @return - A mask of the lanes that hit.
+	template <typename Type, uint Count>
+	INLINE TLanes<Type, Count> Intersect(const TLanes<Type, Count> (&A)[3], const TLanes<Type, Count> (&B)[3], const TLanes<Type, Count> (&C)[3], const TLanes<Type, Count>& Sx, const TLanes<Type, Count>& Sy,
+		const TLanes<Type, Count>& Sz, const TLanes<Type, Count>& MaxDistance, TLanes<Type, Count>& Distances, TLanes<Type, Count>& U, TLanes<Type, Count>& V)
+	{
+		typedef TLanes<Type, Count> SLanes;
+		using TMath::Unfused;
+		const SLanes Zero{ (Type)0 };
+
+		const SLanes Ax{ A[0] - Unfused(Sx * A[2]) }, Ay{ A[1] - Unfused(Sy * A[2]) };
+		const SLanes Bx{ B[0] - Unfused(Sx * B[2]) }, By{ B[1] - Unfused(Sy * B[2]) };
+		const SLanes Cx{ C[0] - Unfused(Sx * C[2]) }, Cy{ C[1] - Unfused(Sy * C[2]) };
+		const SLanes EdgeA{ Unfused(Cx * By) - Unfused(Cy * Bx) };
+		const SLanes EdgeB{ Unfused(Ax * Cy) - Unfused(Ay * Cx) };
+		const SLanes EdgeC{ Unfused(Bx * Ay) - Unfused(By * Ax) };
+
+		// Written as the conditions for a hit, so NaN from unused lanes or degenerate rays always misses.
+		const SLanes Inside{ ((EdgeA >= Zero) & (EdgeB >= Zero) & (EdgeC >= Zero)) | ((EdgeA <= Zero) & (EdgeB <= Zero) & (EdgeC <= Zero)) };
+		const SLanes Determinant{ (EdgeA + EdgeB) + EdgeC };
+		const SLanes T{ (Unfused(EdgeA * (Sz * A[2])) + Unfused(EdgeB * (Sz * B[2]))) + Unfused(EdgeC * (Sz * C[2])) };
+
+		// The range test is made with the signs flipped to a positive determinant, so either winding hits.
+		const SLanes Sign{ Determinant & SLanes{ (Type)-0.0 } };
+		const SLanes AbsDeterminant{ Determinant ^ Sign }, AbsT{ T ^ Sign };
+		const SLanes Hit{ Inside & (AbsDeterminant > Zero) & (AbsT >= Zero) & (AbsT <= (MaxDistance * AbsDeterminant)) };
+
+		const SLanes InvDeterminant{ SLanes{ (Type)1 } / Determinant };
+		Distances = T * InvDeterminant;
+		U = EdgeB * InvDeterminant;
+		V = EdgeC * InvDeterminant;
+		return Hit;
+	}
+}
+
+
+
+template <typename Type>
+INLINE STTriangleRay<Type>::STTriangleRay(const STVector<3, Type>& InOrigin, const STVector<3, Type>& Direction)
+	:Origin{ InOrigin }
+{
+	const Type X{ TMath::Abs(Direction[0]) }, Y{ TMath::Abs(Direction[1]) }, Z{ TMath::Abs(Direction[2]) };
+	Kz = (X > Y) ? ((X > Z) ? 0 : 2) : ((Y > Z) ? 1 : 2);
+	Kx = (Kz == 2) ? 0 : Kz + 1;
+	Ky = (Kx == 2) ? 0 : Kx + 1;
+
+	// Swapping the other two axes keeps the winding the same when the ray points down its axis.
+	if (Direction[Kz] < (Type)0)
+	{
+		const uint Swap{ Kx };
+		Kx = Ky;
+		Ky = Swap;
+	}
+	Sx = Direction[Kx] / Direction[Kz];
+	Sy = Direction[Ky] / Direction[Kz];
+	Sz = (Type)1 / Direction[Kz];
+}
+
+
+template <typename Type>
+INLINE bool STTriangleRay<Type>::Intersect(const STVector<3, Type>& A, const STVector<3, Type>& B, const STVector<3, Type>& C, Type MaxDistance, Type& Distance, Type& U, Type& V) const
+{
+	// The same operations in the same order as TTriangle::Intersect().
+	using TMath::Unfused;
+	const Type Az{ A[Kz] - Origin[Kz] }, Bz{ B[Kz] - Origin[Kz] }, Cz{ C[Kz] - Origin[Kz] };
+	const Type Ax{ (A[Kx] - Origin[Kx]) - Unfused(Sx * Az) }, Ay{ (A[Ky] - Origin[Ky]) - Unfused(Sy * Az) };
+	const Type Bx{ (B[Kx] - Origin[Kx]) - Unfused(Sx * Bz) }, By{ (B[Ky] - Origin[Ky]) - Unfused(Sy * Bz) };
+	const Type Cx{ (C[Kx] - Origin[Kx]) - Unfused(Sx * Cz) }, Cy{ (C[Ky] - Origin[Ky]) - Unfused(Sy * Cz) };
+	const Type EdgeA{ Unfused(Cx * By) - Unfused(Cy * Bx) };
+	const Type EdgeB{ Unfused(Ax * Cy) - Unfused(Ay * Cx) };
+	const Type EdgeC{ Unfused(Bx * Ay) - Unfused(By * Ax) };
+
+	const bool Inside{ (EdgeA >= (Type)0 && EdgeB >= (Type)0 && EdgeC >= (Type)0) || (EdgeA <= (Type)0 && EdgeB <= (Type)0 && EdgeC <= (Type)0) };
+	const Type Determinant{ (EdgeA + EdgeB) + EdgeC };
+	const Type T{ (Unfused(EdgeA * (Sz * Az)) + Unfused(EdgeB * (Sz * Bz))) + Unfused(EdgeC * (Sz * Cz)) };
+
+	const bool Negative{ std::signbit(Determinant) };
+	const Type AbsDeterminant{ Negative ? -Determinant : Determinant }, AbsT{ Negative ? -T : T };
+	if (!(Inside && AbsDeterminant > (Type)0 && AbsT >= (Type)0 && AbsT <= (MaxDistance * AbsDeterminant))) return false;
+
+	const Type InvDeterminant{ (Type)1 / Determinant };
+	Distance = T * InvDeterminant;
+	U = EdgeB * InvDeterminant;
+	V = EdgeC * InvDeterminant;
+	return true;
+}
+
+
+template <typename Type>
+INLINE bool STTriangleRay<Type>::Intersect(const STVector<3, Type>& A, const STVector<3, Type>& B, const STVector<3, Type>& C, uint32 Triangle, STTriangleHit<Type>& Hit) const
+{
+	Type Distance, U, V;
+	if (!Intersect(A, B, C, Hit.Distance, Distance, U, V) || !(Distance < Hit.Distance)) return false;
+	Hit = STTriangleHit<Type>{ Distance, U, V, Triangle };
+	return true;
+}
+
+
+
+template <typename Type, uint Count>
+INLINE STTriangleHitPacket<Type, Count>::STTriangleHitPacket(Type MaxDistance)
+	:Distance{ MaxDistance }, U{ (Type)0 }, V{ (Type)0 }
+{
+	for (uint i = 0; i < Count; ++i)
+	{
+		Triangle[i] = STTriangleHit<Type>::None;
+	}
+}
+
+
+
+template <typename Type, uint Count>
+INLINE STTriangleRayPacket<Type, Count>::STTriangleRayPacket(const STVector<3, Type>* Origins, const STVector<3, Type>* Directions, uint InCount)
+{
+	// Unused lanes start at NaN, which fails every hit condition.
+	alignas(alignof(SLanes)) Type Origins1D[3][Count];
+	alignas(alignof(SLanes)) Type Axes1D[3][Count];
+	alignas(alignof(SLanes)) Type Shear1D[3][Count];
+	for (uint i = 0; i < Count; ++i)
+	{
+		const STTriangleRay<Type> Ray{ (i < InCount) ? STTriangleRay<Type>{ Origins[i], Directions[i] } : STTriangleRay<Type>{ STVector<3, Type>{ std::numeric_limits<Type>::quiet_NaN() }, STVector<3, Type>{ (Type)0, (Type)0, (Type)1 } } };
+		const uint Axes[3]{ Ray.Kx, Ray.Ky, Ray.Kz };
+		for (uint j = 0; j < 3; ++j)
+		{
+			Origins1D[j][i] = Ray.Origin[j];
+			Axes1D[j][i] = (Type)Axes[j];
+		}
+		Shear1D[0][i] = Ray.Sx;
+		Shear1D[1][i] = Ray.Sy;
+		Shear1D[2][i] = Ray.Sz;
+	}
+	for (uint j = 0; j < 3; ++j)
+	{
+		Origin[j] = SLanes::Load(Origins1D[j]);
+		const SLanes Axis{ SLanes::Load(Axes1D[j]) };
+		PickFirst[j] = (Axis == SLanes{ (Type)0 });
+		PickSecond[j] = (Axis == SLanes{ (Type)1 });
+	}
+	Sx = SLanes::Load(Shear1D[0]);
+	Sy = SLanes::Load(Shear1D[1]);
+	Sz = SLanes::Load(Shear1D[2]);
+}
+
+
+template <typename Type, uint Count>
+INLINE void STTriangleRayPacket<Type, Count>::Project(const STVector<3, Type>& Vertex, SLanes (&Projected)[3]) const
+{
+	// Every ray has its own projected axes, so each is picked per lane.
+	const SLanes Relative[3]{ SLanes{ Vertex[0] } - Origin[0], SLanes{ Vertex[1] } - Origin[1], SLanes{ Vertex[2] } - Origin[2] };
+	for (uint j = 0; j < 3; ++j)
+	{
+		Projected[j] = PickFirst[j].Select(Relative[0], PickSecond[j].Select(Relative[1], Relative[2]));
+	}
+}
+
+
+template <typename Type, uint Count>
+INLINE uint STTriangleRayPacket<Type, Count>::IntersectTriangle(const STVector<3, Type>& A, const STVector<3, Type>& B, const STVector<3, Type>& C, const SLanes& MaxDistance, SLanes& Distances, SLanes& U, SLanes& V) const
+{
+	SLanes ProjectedA[3], ProjectedB[3], ProjectedC[3];
+	Project(A, ProjectedA);
+	Project(B, ProjectedB);
+	Project(C, ProjectedC);
+	return TTriangle::Intersect(ProjectedA, ProjectedB, ProjectedC, Sx, Sy, Sz, MaxDistance, Distances, U, V).MoveMask();
+}
+
+
+template <typename Type, uint Count>
+INLINE uint STTriangleRayPacket<Type, Count>::IntersectTriangle(const STVector<3, Type>& A, const STVector<3, Type>& B, const STVector<3, Type>& C, uint32 Triangle, STTriangleHitPacket<Type, Count>& Hits) const
+{
+	SLanes ProjectedA[3], ProjectedB[3], ProjectedC[3];
+	Project(A, ProjectedA);
+	Project(B, ProjectedB);
+	Project(C, ProjectedC);
+	SLanes Distances, U, V;
+	const SLanes Hit{ TTriangle::Intersect(ProjectedA, ProjectedB, ProjectedC, Sx, Sy, Sz, Hits.Distance, Distances, U, V) };
+	const SLanes Closer{ Hit & (Distances < Hits.Distance) };
+	const uint Mask{ Closer.MoveMask() };
+	if (Mask == 0) return 0;
+
+	Hits.Distance = Closer.Select(Distances, Hits.Distance);
+	Hits.U = Closer.Select(U, Hits.U);
+	Hits.V = Closer.Select(V, Hits.V);
+	for (uint Bits = Mask; Bits != 0; Bits &= Bits - 1)
+	{
+		Hits.Triangle[std::countr_zero(Bits)] = Triangle;
+	}
+	return Mask;
+}
+
+
+
+template <typename Type, uint Count>
+INLINE STTrianglePacket<Type, Count>::STTrianglePacket(const STVector<3, Type>* Vertices, uint InCount)
+{
+	// Unused lanes get three vertices at the origin, whose determinant is always 0.
+	for (uint j = 0; j < 3; ++j)
+	{
+		alignas(alignof(SLanes)) Type A1D[Count];
+		alignas(alignof(SLanes)) Type B1D[Count];
+		alignas(alignof(SLanes)) Type C1D[Count];
+		for (uint i = 0; i < Count; ++i)
+		{
+			A1D[i] = (i < InCount) ? Vertices[(3 * i) + 0][j] : (Type)0;
+			B1D[i] = (i < InCount) ? Vertices[(3 * i) + 1][j] : (Type)0;
+			C1D[i] = (i < InCount) ? Vertices[(3 * i) + 2][j] : (Type)0;
+		}
+		A[j] = SLanes::Load(A1D);
+		B[j] = SLanes::Load(B1D);
+		C[j] = SLanes::Load(C1D);
+	}
+}
+
+
+template <typename Type, uint Count>
+INLINE STTrianglePacket<Type, Count>::STTrianglePacket(const STVector<3, Type>* Vertices, const uint32* Indices, uint InCount)
+{
+	for (uint j = 0; j < 3; ++j)
+	{
+		alignas(alignof(SLanes)) Type A1D[Count];
+		alignas(alignof(SLanes)) Type B1D[Count];
+		alignas(alignof(SLanes)) Type C1D[Count];
+		for (uint i = 0; i < Count; ++i)
+		{
+			A1D[i] = (i < InCount) ? Vertices[Indices[(3 * i) + 0]][j] : (Type)0;
+			B1D[i] = (i < InCount) ? Vertices[Indices[(3 * i) + 1]][j] : (Type)0;
+			C1D[i] = (i < InCount) ? Vertices[Indices[(3 * i) + 2]][j] : (Type)0;
+		}
+		A[j] = SLanes::Load(A1D);
+		B[j] = SLanes::Load(B1D);
+		C[j] = SLanes::Load(C1D);
+	}
+}
+
+
+template <typename Type, uint Count>
+INLINE uint STTrianglePacket<Type, Count>::IntersectRay(const STTriangleRay<Type>& Ray, Type MaxDistance, SLanes& Distances, SLanes& U, SLanes& V) const
+{
+	// Every triangle shares the ray's projected axes, so they are picked once for the whole packet.
+	const uint Axes[3]{ Ray.Kx, Ray.Ky, Ray.Kz };
+	SLanes ProjectedA[3], ProjectedB[3], ProjectedC[3];
+	for (uint j = 0; j < 3; ++j)
+	{
+		const SLanes O{ Ray.Origin[Axes[j]] };
+		ProjectedA[j] = A[Axes[j]] - O;
+		ProjectedB[j] = B[Axes[j]] - O;
+		ProjectedC[j] = C[Axes[j]] - O;
+	}
+	return TTriangle::Intersect(ProjectedA, ProjectedB, ProjectedC, SLanes{ Ray.Sx }, SLanes{ Ray.Sy }, SLanes{ Ray.Sz }, SLanes{ MaxDistance }, Distances, U, V).MoveMask();
+}
+
+
+template <typename Type, uint Count>
+INLINE bool STTrianglePacket<Type, Count>::IntersectRay(const STTriangleRay<Type>& Ray, uint32 FirstTriangle, STTriangleHit<Type>& Hit) const
+{
+	SLanes Distances, U, V;
+	uint Mask{ IntersectRay(Ray, Hit.Distance, Distances, U, V) };
+	if (Mask == 0) return false;
+	Mask &= (Distances < SLanes{ Hit.Distance }).MoveMask();
+	if (Mask == 0) return false;
+
+	// The nearest lane that hit, the lowest one wins a tie like it would testing the triangles in order.
+	uint Lane{ (uint)std::countr_zero(Mask) };
+	for (uint Bits = Mask & (Mask - 1); Bits != 0; Bits &= Bits - 1)
+	{
+		const uint Other{ (uint)std::countr_zero(Bits) };
+		if (Distances[Other] < Distances[Lane]) Lane = Other;
+	}
+	Hit = STTriangleHit<Type>{ Distances[Lane], U[Lane], V[Lane], FirstTriangle + Lane };
+	return true;
+}
+
+
+
+template <typename Type, uint Count>
+INLINE void STTriangleMesh<Type, Count>::Build(const STVector<3, Type>* Vertices, uint InCount)
+{
+	TriangleCount = InCount;
+	Packets.clear();
+	Packets.reserve((InCount + Count - 1) / Count);
+	for (uint i = 0; i < InCount; i += Count)
+	{
+		Packets.emplace_back(Vertices + (3 * (size_t)i), (InCount - i < Count) ? InCount - i : Count);
+	}
+}
+
+
+template <typename Type, uint Count>
+INLINE void STTriangleMesh<Type, Count>::Build(const STVector<3, Type>* Vertices, const uint32* Indices, uint InCount)
+{
+	TriangleCount = InCount;
+	Packets.clear();
+	Packets.reserve((InCount + Count - 1) / Count);
+	for (uint i = 0; i < InCount; i += Count)
+	{
+		Packets.emplace_back(Vertices, Indices + (3 * (size_t)i), (InCount - i < Count) ? InCount - i : Count);
+	}
+}
+
+
+template <typename Type, uint Count>
+INLINE STTriangleHit<Type> STTriangleMesh<Type, Count>::IntersectRay(const STVector<3, Type>& Origin, const STVector<3, Type>& Direction, Type MaxDistance) const
+{
+	const STTriangleRay<Type> Ray{ Origin, Direction };
+	STTriangleHit<Type> Hit{ STTriangleHit<Type>::Miss(MaxDistance) };
+	for (uint i = 0; i < (uint)Packets.size(); ++i)
+	{
+		Packets[i].IntersectRay(Ray, i * Count, Hit);
+	}
+	return Hit;
+}
+
+
+template <typename Type, uint Count>
+INLINE void STTriangleMesh<Type, Count>::IntersectRays(const STVector<3, Type>* Origins, const STVector<3, Type>* Directions, uint RayCount, STTriangleHit<Type>* Hits, Type MaxDistance) const
+{
+	// Pieces start on cache line boundaries of the hit records so no two threads write to the same line.
+	constexpr uint Granularity{ 64 / std::gcd((uint)sizeof(STTriangleHit<Type>), 64u) };
+	const uint MinGrain{ (TriangleCount > 0) ? 1 + (65536 / TriangleCount) : RayCount };
+	ParallelFor(RayCount, [this, Origins, Directions, Hits, MaxDistance](uint Begin, uint End)
+		{
+			for (uint i = Begin; i < End; ++i)
+			{
+				Hits[i] = IntersectRay(Origins[i], Directions[i], MaxDistance);
+			}
+		}, MinGrain, Granularity);
+}
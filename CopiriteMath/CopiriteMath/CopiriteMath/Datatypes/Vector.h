@@ -1,5 +1,14 @@
 #pragma once
 #include "../GlobalValues.h"
+#include "../Debug/NaNPolicy.h"
+#include "../Math/TMath.h"
+#include "VectorSIMD.h"
+#include "../Parallel/ThreadPool.h"
+#include <cstdio>
+#include <limits>
+#include <numeric>
+#include <source_location>
+#include <type_traits>
 
 
 
@@ -15,15 +24,16 @@
 // Used to easily access values in a vector.
 enum EAxis
 {
-	X = 0x1,		// The X axis.
-	Y = 0x2,		// The Y axis.
-	Z = 0x3,		// The Z axis.
-	W = 0x4		// The W axis.
+	X = 0x0,		// The X axis.
+	Y = 0x1,		// The Y axis.
+	Z = 0x2,		// The Z axis.
+	W = 0x3		// The W axis.
 };
 
 
 
 // Represents a point in space in a specifid amount of dimensions.
+// @note - Can be constructed and operated on in constant expressions, the SIMD paths are only taken at runtime.
 // @template Size - How many dimensions this vector should have.
 // @template Type - The datatype this vector should use.
 template <uint Size, typename Type>
@@ -33,62 +43,83 @@ private:
 	/// Properties
 
 	// Stores all elements of this vector.
-	Type Data[Size];
+	// @note - Aligned so vectors that fill a SIMD register can be loaded in a single instruction.
+	alignas(TVectorAlignment<Size, Type>::Value) Type Data[Size];
+
+	// The SIMD backend for this vector type.
+	typedef TVectorSIMD<Size, Type> SIMD;
+
+	// Vectors of other sizes and types access the components directly in mixed operations.
+	template <uint, typename>
+	friend struct STVector;
+
+
+	/// Functions
+
+	// Returns 1 / the length of a vector from its squared length.
+	// @template Fast - Should floats in the normal range use FastInvSqrt.
+	template <bool Fast>
+	static INLINE Type InvLength(Type SquareSum);
+
+	// Normalizes a range of an array of vectors in place, a lane of vectors at a time.
+	// @template Fast - Should floats use FastInvSqrt.
+	template <bool Fast>
+	static INLINE void NormalizeRange(STVector<Size, Type>* Vectors, uint Begin, uint End, Type Tolerance);
 
 
 public:
 	/// Constructors
 
 	// Constructor, Default.
-	INLINE STVector<Size, Type>();
+	INLINE constexpr STVector();
 
 	// Constructor, Initializes all vector components with the inputted value.
 	// @param Value - The value used to initialize all components with.
-	INLINE STVector<Size, Type>(Type Value);
+	INLINE constexpr STVector(Type Value);
 
 	// Constructor, Initiates a vector2 using 2 values.
 	// @param InX - The value used to initialize this vector's X component.
 	// @param InY - The value used to initialize this vector's Y component.
-	INLINE VECTORCALL STVector<Size, Type>(Type InX, Type InY);
+	INLINE constexpr VECTORCALL STVector(Type InX, Type InY);
 
 	// Constructor, Initiates a vector3 using 3 values.
 	// @param InX - The value used to initialize this vector's X component.
 	// @param InY - The value used to initialize this vector's Y component.
 	// @param InZ - The value used to initialize this vector's Z component.
-	INLINE VECTORCALL STVector<Size, Type>(Type InX, Type InY, Type InZ);
+	INLINE constexpr VECTORCALL STVector(Type InX, Type InY, Type InZ);
 
 	// Constructor, Initiates a vector3 using a 2d vector and a value.
 	// @param InV - The vector2 used to initiate this vector's X and Y components.
 	// @param InZ - The value used to initialize this Vector's Z component.
-	INLINE STVector<Size, Type>(STVector<2, Type> InV, Type InZ);
+	INLINE constexpr STVector(STVector<2, Type> InV, Type InZ);
 
 	// Constructor, Initiates a vector4 using 4 values.
 	// @param InX - The value used to initialize this vector's X component.
 	// @param InY - The value used to initialize this vector's Y component.
 	// @param InZ - The value used to initialize this vector's Z component.
 	// @param InW - The value used to initialize this vector's W component.
-	INLINE VECTORCALL STVector<Size, Type>(Type InX, Type InY, Type InZ, Type InW);
+	INLINE constexpr VECTORCALL STVector(Type InX, Type InY, Type InZ, Type InW);
 
 	// Constructor, Initiates a vector4 using 2 vector2s.
 	// @param V1 - The vector2 used to initialize this vector's X and Y components.
 	// @param V2 - The vector2 used to initialize this vector's Z and W components.
-	INLINE STVector<Size, Type>(STVector<2, Type> V1, STVector<2, Type> V2);
+	INLINE constexpr STVector(STVector<2, Type> V1, STVector<2, Type> V2);
 
 	// Constructor, Initiates a vector4 using a 2D vector and 2 values.
 	// @param V - The vector2 used to initialize this vector's X and Y components.
 	// @param InZ - The value used to initialize this vector's Z component.
 	// @param InW - The value used to initialize this vector's W component.
-	INLINE STVector<Size, Type>(STVector<2, Type> V, Type InZ, Type InW);
+	INLINE constexpr STVector(STVector<2, Type> V, Type InZ, Type InW);
 
 	// Constructor, Initiates a vector4 using a 3D vector and a value.
 	// @param V - The vector3 used to initialize this vector's X, Y and Z components.
 	// @param InW - The value used to initialize this vector's W component.
-	INLINE VECTORCALL STVector<Size, Type>(STVector<3, Type> V, Type InW);
+	INLINE constexpr VECTORCALL STVector(STVector<3, Type> V, Type InW);
 
 	// Constructor, Initializes this vector with an array of values.
 	// @note - The array size must be the same size as this vector.
 	// @param Values - The array to initialize all components.
-	INLINE VECTORCALL STVector<Size, Type>(Type Values[Size]);
+	INLINE constexpr VECTORCALL STVector(Type Values[Size]);
 
 	// Constructor, Initializes this vector with the components of another vector.
 	// @template Size2 - The size of the other vector.
@@ -96,7 +127,7 @@ public:
 	// @param Other - The other vector to copy the values from.
 	// @param Flood - The value to give this vector to empty components if the other vector is smaller than this one.
 	template <uint Size2, typename Type2>
-	STVector<Size, Type>(STVector<Size2, Type2> Other, Type Flood = (Type)0.0f);
+	INLINE constexpr STVector(STVector<Size2, Type2> Other, Type Flood = (Type)0.0f);
 
 
 
@@ -104,185 +135,225 @@ public:
 
 	// Operator, Returns teh result of an addition between this vector and another vector.
 	template <uint Size2, typename Type2>
-	INLINE STVector<Size, Type> operator+(const STVector<Size2, Type2>& Other) const;
+	INLINE constexpr STVector<Size, Type> operator+(const STVector<Size2, Type2>& Other) const;
 
 	// Operator, Returns the result of an addition between this vector and a value.
-	INLINE STVector<Size, Type> operator+(const Type& Value) const;
+	INLINE constexpr STVector<Size, Type> operator+(const Type& Value) const;
 
 	// Operator, Returns the result of an addition between a value and this vector.
-	INLINE friend STVector<Size, Type> operator+(const Type& Value, const STVector<Size, Type>& Other)
+	INLINE constexpr friend STVector<Size, Type> operator+(const Type& Value, const STVector<Size, Type>& Other)
 	{
-		Vector<Size, Type> Result;
+		STVector<Size, Type> Result;
+		if constexpr (SIMD::Enabled)
+		{
+			if (!std::is_constant_evaluated())
+			{
+				SIMD::Store(Result.Data, SIMD::Add(SIMD::Set(Value), SIMD::Load(Other.Data)));
+				Result.CheckNaN(EMathOperation::Add);
+				return Result;
+			}
+		}
 		for (uint i = 0; i < Size; ++i)
 		{
 			Result[i] = Value + Other[i];
 		}
-		Result.CheckNaN();
+		Result.CheckNaN(EMathOperation::Add);
 		return Result;
 	}
 
 	// Operator, Sets this vector's values with the result of an addition between this vector and another vector.
 	template <uint Size2, typename Type2>
-	INLINE STVector<Size, Type> operator+=(const STVector<Size2, Type2>& Other);
+	INLINE constexpr STVector<Size, Type>& operator+=(const STVector<Size2, Type2>& Other);
 
 	//Operator, Sets this vector's values with the result of an addition between this vector and a value.
-	INLINE STVector<Size, Type> operator+=(const Type& Value);
+	INLINE constexpr STVector<Size, Type>& operator+=(const Type& Value);
 
 	// Operator, Returns the result of a subtraction between this vector and another vector.
 	template <uint Size2, typename Type2>
-	INLINE STVector<Size, Type> operator-(const STVector<Size2, Type2>& Other) const;
+	INLINE constexpr STVector<Size, Type> operator-(const STVector<Size2, Type2>& Other) const;
 
 	// Operator, Returns the result of a subtraction between this vector and a value.
-	INLINE STVector<Size, Type> operator-(const Type& Value) const;
+	INLINE constexpr STVector<Size, Type> operator-(const Type& Value) const;
 
 	// Operator, Returns the result of a subtraction between a value and this vector.
-	INLINE friend STVector<Size, Type> operator-(const Type& Value, const STVector<Size, Type>& Other)
+	INLINE constexpr friend STVector<Size, Type> operator-(const Type& Value, const STVector<Size, Type>& Other)
 	{
 		STVector<Size, Type> Result;
+		if constexpr (SIMD::Enabled)
+		{
+			if (!std::is_constant_evaluated())
+			{
+				SIMD::Store(Result.Data, SIMD::Sub(SIMD::Set(Value), SIMD::Load(Other.Data)));
+				Result.CheckNaN(EMathOperation::Sub);
+				return Result;
+			}
+		}
 		for (uint i = 0; i < Size; ++i)
 		{
 			Result[i] = Value - Other[i];
 		}
-		Result.CheckNaN();
+		Result.CheckNaN(EMathOperation::Sub);
 		return Result;
 	}
 
 	// Operator, Returns the contents of this vector but negative.
-	INLINE STVector<Size, Type> operator-() const;
+	INLINE constexpr STVector<Size, Type> operator-() const;
 
 	// Operator, Sets this vector's values with the result of a subtraction between this vector and another vector.
 	template <uint Size2, typename Type2>
-	INLINE STVector<Size, Type> operator-=(const STVector<Size2, Type2>& Other);
+	INLINE constexpr STVector<Size, Type>& operator-=(const STVector<Size2, Type2>& Other);
 
 	// Operator, Sets this vector's values with the result of a subtraction between this vector and a value.
-	INLINE STVector<Size, Type> operator-=(const Type& Value);
+	INLINE constexpr STVector<Size, Type>& operator-=(const Type& Value);
 
 	// Operator, Returns the result of a multiplication between this vector and another vector.
 	template <uint Size2, typename Type2>
-	INLINE STVector<Size, Type> operator*(const STVector<Size2, Type2>& Other) const;
+	INLINE constexpr STVector<Size, Type> operator*(const STVector<Size2, Type2>& Other) const;
 
 	// Operator, Returns the result of a multiplication between this vector and a value.
-	INLINE STVector<Size, Type> operator*(const Type& Value) const;
+	INLINE constexpr STVector<Size, Type> operator*(const Type& Value) const;
 
 	// Operator, Returns the result of a multiplication between a value and this vector.
-	INLINE friend STVector<Size, Type> operator*(const Type& Value, const STVector<Size, Element>& Other)
+	INLINE constexpr friend STVector<Size, Type> operator*(const Type& Value, const STVector<Size, Type>& Other)
 	{
 		STVector<Size, Type> Result;
+		if constexpr (SIMD::Enabled)
+		{
+			if (!std::is_constant_evaluated())
+			{
+				SIMD::Store(Result.Data, SIMD::Mul(SIMD::Set(Value), SIMD::Load(Other.Data)));
+				Result.CheckNaN(EMathOperation::Mul);
+				return Result;
+			}
+		}
 		for (uint i = 0; i < Size; ++i)
 		{
 			Result[i] = Value * Other[i];
 		}
-		Result.CheckNaN();
+		Result.CheckNaN(EMathOperation::Mul);
 		return Result;
 	}
 
 	// Operator, Sets this vector's values with the result of a multiplication between this vector and another vector.
 	template <uint Size2, typename Type2>
-	INLINE STVector<Size, Type> operator*=(const STVector<Size2, Type2>& Other);
+	INLINE constexpr STVector<Size, Type>& operator*=(const STVector<Size2, Type2>& Other);
 
 	// Operator, Sets this vector's values with the result of a multiplication between this vector and a value.
-	INLINE STVector<Size, Type> operator*=(const Type& Value);
+	INLINE constexpr STVector<Size, Type>& operator*=(const Type& Value);
 
 	// Operator, Returns the result of a division between this vector and another vector.
 	template <uint Size2, typename Type2>
-	INLINE STVector<Size, Type> operator/(const STVector<Size2, Type2>& Other) const;
+	INLINE constexpr STVector<Size, Type> operator/(const STVector<Size2, Type2>& Other) const;
 
 	// Operator, Returns the result of a division between this vector and a value.
-	INLINE STVector<Size, Type> operator/(const Type& Value) const;
+	INLINE constexpr STVector<Size, Type> operator/(const Type& Value) const;
 
 	// Operator, Returns the result of a division between a value and this vector.
-	INLINE friend STVector<Size, Type> operator/(const Type& Value, const STVector<Size, Type>& Other)
+	INLINE constexpr friend STVector<Size, Type> operator/(const Type& Value, const STVector<Size, Type>& Other)
 	{
 		STVector<Size, Type> Result;
+		if constexpr (SIMD::Enabled)
+		{
+			if (!std::is_constant_evaluated())
+			{
+				SIMD::Store(Result.Data, SIMD::Div(SIMD::Set(Value), SIMD::Load(Other.Data)));
+				Result.CheckNaN(EMathOperation::Div);
+				return Result;
+			}
+		}
 		for (uint i = 0; i < Size; ++i)
 		{
 			Result[i] = Value / Other[i];
 		}
-		Result.CheckNaN();
+		Result.CheckNaN(EMathOperation::Div);
 		return Result;
 	}
 
 	// Operator, Sets this vector's values with the result of a division between this vector and another vector.
 	template <uint Size2, typename Type2>
-	INLINE STVector<Size, Type> operator/=(const STVector<Size2, Type2>& Other);
+	INLINE constexpr STVector<Size, Type>& operator/=(const STVector<Size2, Type2>& Other);
 
 	// Operator, Sets this vector's values with the result of a division between this vector and a value.
-	INLINE STVector<Size, Type> operator/=(const Type& Value);
+	INLINE constexpr STVector<Size, Type>& operator/=(const Type& Value);
 
 	// Operator, Increments all the components of this vector by 1.
-	INLINE STVector<Size, Type> operator++();
+	INLINE constexpr STVector<Size, Type>& operator++();
 
 	// Operator, Decrements all the components of this vector by 1.
-	INLINE STVector<Size, Type> operator--();
+	INLINE constexpr STVector<Size, Type>& operator--();
 
 	// Operator, Assigns all components to a value.
-	INLINE STVector<Size, Type> operator=(const Type& Value);
+	INLINE constexpr STVector<Size, Type>& operator=(const Type& Value);
 
 	// Operator, Calculates the cross product between this vector and another vector.
-	INLINE STVector<Size, Type> operator|(const STVector<Size, Type>& Other) const;
+	INLINE constexpr STVector<Size, Type> operator|(const STVector<Size, Type>& Other) const;
 
 	// Operator, Calculates the dot product between this vector and another vector.
-	INLINE Type operator^(const STVector<Size, Type>& Other) const;
+	INLINE constexpr Type operator^(const STVector<Size, Type>& Other) const;
 
 	// Operator, Tests if each component in this vector is greater than the corosponding component in another vector.
-	INLINE bool operator>(const STVector<Size, Type>& Other) const;
+	INLINE constexpr bool operator>(const STVector<Size, Type>& Other) const;
 
 	// Operator, Tests if all components in this vector is greater than a value.
-	INLINE bool operator>(const Type& Value) const;
+	INLINE constexpr bool operator>(const Type& Value) const;
 
 	// Operator, Tests if each component in this vector is greater than or equal to the corosponding component in another vector.
-	INLINE bool operator>=(const STVector<Size, Type>& Other) const;
+	INLINE constexpr bool operator>=(const STVector<Size, Type>& Other) const;
 
 	// Operator, Tests if all components in this vector is greater than or equal to a value.
-	INLINE bool operator>=(const Type& Value) const;
+	INLINE constexpr bool operator>=(const Type& Value) const;
 
 	// Operator, Tests if each component in this vector is less than the corosponding component in another vector.
-	INLINE bool operator<(const STVector<Size, Type>& Other) const;
+	INLINE constexpr bool operator<(const STVector<Size, Type>& Other) const;
 
 	// Operator, Tests if all components in this vector is less than a vlue.
-	INLINE bool operator<(const Type& Value) const;
+	INLINE constexpr bool operator<(const Type& Value) const;
 
 	// Operator, Tests if each component in this vector is less than or equal to the corosponding component in another vector.
-	INLINE bool operator<=(const STVector<Size, Type>& Other) const;
+	INLINE constexpr bool operator<=(const STVector<Size, Type>& Other) const;
 
 	// Operator, Tests if all components in this vector is less than or equal to a value.
-	INLINE bool operator<=(const Type& Value) const;
+	INLINE constexpr bool operator<=(const Type& Value) const;
 
 	// Operator, Tests if each component in this vector is equal to the corosponding component in another vector.
-	INLINE bool operator==(const STVector<Size, Type>& Other) const;
+	INLINE constexpr bool operator==(const STVector<Size, Type>& Other) const;
 
 	// Operator, Tests if all the components of this vector is equal to a value.
-	INLINE bool operator==(const Type& Value) const;
+	INLINE constexpr bool operator==(const Type& Value) const;
 
 	// Operator, Tests if each component in this vector is not equal to the corosponding component in another vector.
-	INLINE bool operator!=(const STVector<Size, Type>& Other) const;
+	INLINE constexpr bool operator!=(const STVector<Size, Type>& Other) const;
 
 	// Operator, Tests if all the components of this vector is not equal to a value.
-	INLINE bool operator!=(const Type& Value) const;
+	INLINE constexpr bool operator!=(const Type& Value) const;
 
 	// Operator, Returns the vector component value at the given index.
-	INLINE Type& operator[](const uint& Index);
+	INLINE constexpr Type& operator[](const uint& Index);
 
 	// Operator, Returns the vector component value at the given index.
-	INLINE Type operator[](const uint& Index) const;
+	INLINE constexpr Type operator[](const uint& Index) const;
 
 	// Operator, Returns the vector component value at the given axis.
-	INLINE Type& operator[](const EAxis& Axis);
+	INLINE constexpr Type& operator[](const EAxis& Axis);
 
 	// Operator, Returns the vector component value at the given axis.
-	INLINE Type operator[](const EAxis& Axis) const;
+	INLINE constexpr Type operator[](const EAxis& Axis) const;
 
 
 
 	/// Debug
 
-	// Debug diagnostics handle for when a vector contains NaN in any component.
-	// @note - This will set this vector to a vector0 if it contains NaN.
-	INLINE void CheckNaN() const;
+	// Debug diagnostics handle for when a vector contains NaN in any component, also counts the operation for SInstrumentation.
+	// Operators can not take a location, so the results they check report the operator's line in this file with the operation's kind.
+	// Named functions take the caller's location, and calling CheckNaN() on a result reports the line it is called from.
+	// @param Operation - The operation that produced this vector.
+	// @param Location - Where the check is made, reported when NaN is found.
+	// @note - What happens depends on COPIRITE_NAN_POLICY, the Sanitize policy will set this vector to a vector0 if it contains NaN.
+	INLINE constexpr void CheckNaN(EMathOperation Operation = EMathOperation::Check, const std::source_location& Location = std::source_location::current()) const;
 
 	// Check if this vector's components contains NaN.
 	// @return - True if a component contains NaN.
-	INLINE bool ContainsNaN() const;
+	INLINE constexpr bool ContainsNaN() const;
 
 	// Prints out the contents of this vector to the console.
 	INLINE void Print() const;
@@ -306,65 +377,119 @@ public:
 
 	// Converts this vector to a specified type.
 	// @template NewType - The new datatype this vector should be.
+	// @param Location - Where the conversion is made, reported if it produces NaN.
 	template <typename NewType>
-	INLINE STVector<Size, NewType> ToType();
+	INLINE constexpr STVector<Size, NewType> ToType(const std::source_location& Location = std::source_location::current());
 
 	// Converts this vector to a specified type.
 	// @template NewType - The new datatype this vector should be.
+	// @param Location - Where the conversion is made, reported if it produces NaN.
 	template <typename NewType>
-	INLINE STVector<Size, NewType> ToType() const;
+	INLINE constexpr STVector<Size, NewType> ToType(const std::source_location& Location = std::source_location::current()) const;
 
 	// Converts this vector to a floating point vector.
-	INLINE STVector<Size, float> ToFloat();
+	INLINE constexpr STVector<Size, float> ToFloat(const std::source_location& Location = std::source_location::current());
 
 	// Converts this vector to a floating point vector.
-	INLINE STVector<Size, float> ToFloat() const;
+	INLINE constexpr STVector<Size, float> ToFloat(const std::source_location& Location = std::source_location::current()) const;
 
 	// Converts this vector to a double type vector.
-	INLINE STVector<Size, double> ToDouble();
+	INLINE constexpr STVector<Size, double> ToDouble(const std::source_location& Location = std::source_location::current());
 
 	// Converts this vector to a double type vector.
-	INLINE STVector<Size, double> ToDouble() const;
+	INLINE constexpr STVector<Size, double> ToDouble(const std::source_location& Location = std::source_location::current()) const;
 
 	// Converts this vector to an integer vector.
-	INLINE STVector<Size, int32> ToInt();
+	INLINE constexpr STVector<Size, int32> ToInt(const std::source_location& Location = std::source_location::current());
 
 	// Converts this vector to an integer vector.
-	INLINE STVector<Size, int32> ToInt() const;
+	INLINE constexpr STVector<Size, int32> ToInt(const std::source_location& Location = std::source_location::current()) const;
 
 
 
 	/// Functions
 
+	// Returns the components of this vector.
+	INLINE constexpr Type* GetData() { return Data; }
+
+	// Returns the components of this vector.
+	INLINE constexpr const Type* GetData() const { return Data; }
+
 	// Calculates the cross product between this vector and another vector.
 	// @param Other - The inputted vector to calculate against.
 	// @return - The resulting vector.
-	INLINE STVector<3, Type> CrossProduct(const STVector<3, Type>& Other) const;
+	INLINE constexpr STVector<3, Type> CrossProduct(const STVector<3, Type>& Other) const;
 
 	// Calculates the dot product between thsi vector an another vector.
 	// @param Other - The inputted vector to calculate against.
 	// @return - The resulting vector.
-	INLINE float DotProduct(const STVector<Size, Type>& Other) const;
+	INLINE constexpr float DotProduct(const STVector<Size, Type>& Other) const;
 
 	// Creates a vector with the highest values in each dimension between this vector and an inputted vector.
 	// @param Other - The inputted vector to calculate against.
 	// @return - The resulting vector.
-	INLINE STVector<Size, Type> Max(const STVector<Size, Type>& Other) const;
+	INLINE constexpr STVector<Size, Type> Max(const STVector<Size, Type>& Other) const;
 
 	// Creates a vector with the lowest values in each dimension between this vector and an inputted vector.
 	// @param Other - The inputted vector to calculate against.
 	// @return - The resulting vector.
-	INLINE STVector<Size, Type> Min(const STVector<Size, Type>& Other) const;
-
-	// Normalize the vector.
-	// @param Tolerance - The accuracy towards teh normalization.
-	INLINE void Normalize(flaot Tolerance = MICRO_NUMBER);
+	INLINE constexpr STVector<Size, Type> Min(const STVector<Size, Type>& Other) const;
+
+	// Returns the squared length of this vector, cheaper than Length() when only comparing lengths.
+	INLINE constexpr Type LengthSquared() const { return *this ^ *this; }
+
+	// Returns the length of this vector.
+	// @note - Correctly rounded from the squared length, within 1 ULP of the true length.
+	INLINE Type Length() const;
+
+	// Returns an approximation of the length of this vector, the squared length multiplied by FastInvSqrt.
+	// @note - Within 4 ULP (4.8e-7 relative) for floats, doubles and squared lengths outside the normal float range use Length().
+	INLINE Type FastLength() const;
+
+	// Returns a unit length copy of this vector.
+	// @note - The result is within 2.4e-7 (2 ULP) of unit length for floats.
+	// @param Tolerance - Vectors with a squared length at or below this give vector0.
+	// @return - The normalized vector, or vector0 if this vector is too short or not finite.
+	INLINE STVector<Size, Type> SafeNormal(Type Tolerance = (Type)MICRO_NUMBER) const;
+
+	// Returns an approximately unit length copy of this vector, using rsqrt and one Newton-Raphson step.
+	// @note - The result is within 4.8e-7 (4 ULP) of unit length for floats, doubles use SafeNormal().
+	// @param Tolerance - Vectors with a squared length at or below this give vector0.
+	// @return - The normalized vector, or vector0 if this vector is too short or not finite.
+	INLINE STVector<Size, Type> FastSafeNormal(Type Tolerance = (Type)MICRO_NUMBER) const;
+
+	// Normalizes this vector to unit length.
+	// @note - The result is within 2.4e-7 (2 ULP) of unit length for floats. Vectors whose squared length overflows are left unchanged.
+	// @param Tolerance - Vectors with a squared length at or below this are left unchanged.
+	// @return - True if this vector was normalized, false if it was too short or not finite.
+	INLINE bool Normalize(Type Tolerance = (Type)MICRO_NUMBER);
+
+	// Normalizes this vector to approximately unit length, using rsqrt and one Newton-Raphson step.
+	// @note - The result is within 4.8e-7 (4 ULP) of unit length for floats, doubles use Normalize(). Vectors whose squared length overflows are left unchanged.
+	// @param Tolerance - Vectors with a squared length at or below this are left unchanged.
+	// @return - True if this vector was normalized, false if it was too short or not finite.
+	INLINE bool FastNormalize(Type Tolerance = (Type)MICRO_NUMBER);
+
+	// Normalizes an array of vectors in place, split across the thread pool when it is long.
+	// @note - The same error as Normalize(), the last bit can differ as the squares are summed in another order.
+	// Vectors whose squared length overflows are left unchanged.
+	// @param Vectors - The vectors to normalize.
+	// @param Count - How many vectors there are.
+	// @param Tolerance - Vectors with a squared length at or below this are left unchanged.
+	static INLINE void NormalizeArray(STVector<Size, Type>* Vectors, uint Count, Type Tolerance = (Type)MICRO_NUMBER);
+
+	// Normalizes an array of vectors in place to approximately unit length, split across the thread pool when it is long.
+	// @note - The same error as FastNormalize(). Vectors whose squared length is denormal or overflows are left unchanged.
+	// @param Vectors - The vectors to normalize.
+	// @param Count - How many vectors there are.
+	// @param Tolerance - Vectors with a squared length at or below this are left unchanged.
+	static INLINE void FastNormalizeArray(STVector<Size, Type>* Vectors, uint Count, Type Tolerance = (Type)MICRO_NUMBER);
 
 	// Returns true if this vector is almost equal to another vector.
 	// @param Other - The vector to compare with.
 	// @param Threshold - The range in which the other vector can be in.
 	// @return - Returns true if the other vector is within range of this vector.
-	INLINE bool nearlyEqual(const STVector<Size, Type>& Other, const Type& Threshold = MICRO_NUMBER) const;
+	INLINE constexpr bool nearlyEqual(const STVector<Size, Type>& Other, const Type& Threshold = MICRO_NUMBER) const;
 
 	// Checks to see if this vector is close to zero based on a range.
 	// @param Range - The 
@@ -408,6 +533,24 @@ typedef STVector<3, int> SVectori;
 // An integer vector with 4 dimensions.
 typedef STVector<4, int> SVector4i;
 
+// A 2D vector of Q16.16 fixed point numbers, for deterministic math.
+typedef STVector<2, SFixed> SVector2x;
+
+// A 3D vector of Q16.16 fixed point numbers, for deterministic math.
+typedef STVector<3, SFixed> SVector3x;
+
+// A 4D vector of Q16.16 fixed point numbers, for deterministic math.
+typedef STVector<4, SFixed> SVector4x;
+
+// A 2D vector of Q32.32 fixed point numbers, for deterministic math.
+typedef STVector<2, SFixedd> SVector2xd;
+
+// A 3D vector of Q32.32 fixed point numbers, for deterministic math.
+typedef STVector<3, SFixedd> SVector3xd;
+
+// A 4D vector of Q32.32 fixed point numbers, for deterministic math.
+typedef STVector<4, SFixedd> SVector4xd;
+
 // A bool vector with 2 dimensions, used for STVector::Select().
 typedef STVector<2, bool> SVector2Control;
 
@@ -423,17 +566,13 @@ typedef STVector<4, bool> SVector4Control;
 
 
 template <uint Size, typename Type>
-STVector<Size, Type>::STVector()
-{
-	for (uint i = 0; i < Size; ++i)
-	{
-		Data[i] = (Type)0.0f;
-	}
-}
+constexpr STVector<Size, Type>::STVector()
+	:Data{}
+{}
 
 
 template <uint Size, typename Type>
-STVector<Size, Type>::STVector(Type Value)
+constexpr STVector<Size, Type>::STVector(Type Value)
 {
 	for (uint i = 0; i < Size; ++i)
 	{
@@ -443,7 +582,7 @@ STVector<Size, Type>::STVector(Type Value)
 
 
 template <uint Size, typename Type>
-VECTORCALL STVector<Size, Type>::STVector(Type InX, Type InY)
+constexpr VECTORCALL STVector<Size, Type>::STVector(Type InX, Type InY)
 {
 	ASSERT(Size == 2, "Error: Illigal use of constructor. Is the vector the correct size?");
 	Data[0] = InX;
@@ -452,7 +591,7 @@ VECTORCALL STVector<Size, Type>::STVector(Type InX, Type InY)
 
 
 template <uint Size, typename Type>
-VECTORCALL STVector<Size, Type>::STVector(Type InX, Type InY, Type InZ)
+constexpr VECTORCALL STVector<Size, Type>::STVector(Type InX, Type InY, Type InZ)
 {
 	ASSERT(Size == 3, "Error: Illigal use of constructor. Is the vector the correct size?");
 	Data[0] = InX;
@@ -462,7 +601,7 @@ VECTORCALL STVector<Size, Type>::STVector(Type InX, Type InY, Type InZ)
 
 
 template <uint Size, typename Type>
-STVector<Size, Type>::STVector(STVector<2, Type> V, Type InZ)
+constexpr STVector<Size, Type>::STVector(STVector<2, Type> V, Type InZ)
 {
 	ASSERT(Size == 3, "Error: Illigal use of constructor. Is the vector the correct size?");
 	Data[0] = V[0];
@@ -472,7 +611,7 @@ STVector<Size, Type>::STVector(STVector<2, Type> V, Type InZ)
 
 
 template <uint Size, typename Type>
-VECTORCALL STVector<Size, Type>::STVector(Type InX, Type InY, Type InZ, Type InW)
+constexpr VECTORCALL STVector<Size, Type>::STVector(Type InX, Type InY, Type InZ, Type InW)
 {
 	ASSERT(Size == 4, "Error: Illigal use of constructor. Is the vector the correct size?");
 	Data[0] = InX;
@@ -483,7 +622,7 @@ VECTORCALL STVector<Size, Type>::STVector(Type InX, Type InY, Type InZ, Type InW
 
 
 template <uint Size, typename Type>
-STVector<Size, Type>::STVector(STVector<2, Type> V1, STVector<2, Type> V2)
+constexpr STVector<Size, Type>::STVector(STVector<2, Type> V1, STVector<2, Type> V2)
 {
 	ASSERT(Size == 4, "Error: Illigal use of constructor. Is the vector the correct size?");
 	Data[0] = V1[0];
@@ -494,7 +633,7 @@ STVector<Size, Type>::STVector(STVector<2, Type> V1, STVector<2, Type> V2)
 
 
 template <uint Size, typename Type>
-STVector<Size, Type>::STVector(STVector<2, Type> V, Type InZ, Type InW)
+constexpr STVector<Size, Type>::STVector(STVector<2, Type> V, Type InZ, Type InW)
 {
 	ASSERT(Size == 4, "Error: Illigal use of constructor. Is the vector the correct size?");
 	Data[0] = V[0];
@@ -505,25 +644,29 @@ STVector<Size, Type>::STVector(STVector<2, Type> V, Type InZ, Type InW)
 
 
 template <uint Size, typename Type>
-STVector<Size, Type>::STVector(STVector<3, Type> V, Type InW)
+constexpr STVector<Size, Type>::STVector(STVector<3, Type> V, Type InW)
 {
 	ASSERT(Size == 4, "Error: Illigal use of constructor. Is the vector the correct size?");
-	Data[0] = V1[0];
-	Data[1] = V1[1];
-	Data[2] = V1[2];
+	Data[0] = V[0];
+	Data[1] = V[1];
+	Data[2] = V[2];
 	Data[3] = InW;
 }
 
 
 template <uint Size, typename Type>
-VECTORCALL STVector<Size, Type>::STVector(Type Values[Size])
-	:Data{ Values }
-{}
+constexpr VECTORCALL STVector<Size, Type>::STVector(Type Values[Size])
+{
+	for (uint i = 0; i < Size; ++i)
+	{
+		Data[i] = Values[i];
+	}
+}
 
 
 template <uint Size, typename Type>
 template <uint Size2, typename Type2>
-STVector<Size, Type>::STVector(STVector<Size2, Type2> Other, Type Flood)
+constexpr STVector<Size, Type>::STVector(STVector<Size2, Type2> Other, Type Flood)
 {
 	for (uint i = 0; i < Size; ++i)
 	{
@@ -534,296 +677,479 @@ STVector<Size, Type>::STVector(STVector<Size2, Type2> Other, Type Flood)
 
 template <uint Size, typename Type>
 template <uint Size2, typename Type2>
-INLINE STVector<Size, Type> STVector<Size, Type>::operator+(const STVector<Size2, Type2>& Other) const
+INLINE constexpr STVector<Size, Type> STVector<Size, Type>::operator+(const STVector<Size2, Type2>& Other) const
 {
-	uint Count{ (Size < Size2) ? Size : Size2 };
 	STVector<Size, Type> Result;
+	if constexpr (SIMD::Enabled && Size == Size2 && std::is_same<Type, Type2>::value)
+	{
+		if (!std::is_constant_evaluated())
+		{
+			SIMD::Store(Result.Data, SIMD::Add(SIMD::Load(Data), SIMD::Load(Other.Data)));
+			Result.CheckNaN(EMathOperation::Add);
+			return Result;
+		}
+	}
+	uint Count{ (Size < Size2) ? Size : Size2 };
 	for (uint i = 0; i < Count; ++i)
 	{
 		Result[i] = Data[i] + (Type)Other[i];
 	}
-	Result.CheckNaN();
+	Result.CheckNaN(EMathOperation::Add);
 	return Result;
 }
 
 
 template <uint Size, typename Type>
-INLINE STVector<Size, Type> STVector<Size, Type>::operator+(const Type& Value) const
+INLINE constexpr STVector<Size, Type> STVector<Size, Type>::operator+(const Type& Value) const
 {
 	STVector<Size, Type> Result;
+	if constexpr (SIMD::Enabled)
+	{
+		if (!std::is_constant_evaluated())
+		{
+			SIMD::Store(Result.Data, SIMD::Add(SIMD::Load(Data), SIMD::Set(Value)));
+			Result.CheckNaN(EMathOperation::Add);
+			return Result;
+		}
+	}
 	for (uint i = 0; i < Size; ++i)
 	{
 		Result[i] = Data[i] + Value;
 	}
-	Result.CheckNaN();
+	Result.CheckNaN(EMathOperation::Add);
 	return Result;
 }
 
 
 template <uint Size, typename Type>
 template <uint Size2, typename Type2>
-INLINE STVector<Size, Type> STVector<Size, Type>::operator+=(const STVector<Size2, Type2>& Other)
+INLINE constexpr STVector<Size, Type>& STVector<Size, Type>::operator+=(const STVector<Size2, Type2>& Other)
 {
+	if constexpr (SIMD::Enabled && Size == Size2 && std::is_same<Type, Type2>::value)
+	{
+		if (!std::is_constant_evaluated())
+		{
+			SIMD::Store(Data, SIMD::Add(SIMD::Load(Data), SIMD::Load(Other.Data)));
+			CheckNaN(EMathOperation::Add);
+			return *this;
+		}
+	}
 	uint Count{ (Size < Size2) ? Size : Size2 };
 	for (uint i = 0; i < Count; ++i)
 	{
 		Data[i] += (Type)Other[i];
 	}
-	CheckNaN();
+	CheckNaN(EMathOperation::Add);
 	return *this;
 }
 
 
 template <uint Size, typename Type>
-INLINE STVector<Size, Type> STVector<Size, Type>::operator+=(const Type& Value)
+INLINE constexpr STVector<Size, Type>& STVector<Size, Type>::operator+=(const Type& Value)
 {
+	if constexpr (SIMD::Enabled)
+	{
+		if (!std::is_constant_evaluated())
+		{
+			SIMD::Store(Data, SIMD::Add(SIMD::Load(Data), SIMD::Set(Value)));
+			CheckNaN(EMathOperation::Add);
+			return *this;
+		}
+	}
 	for (uint i = 0; i < Size; ++i)
 	{
 		Data[i] += Value;
 	}
-	CheckNaN();
+	CheckNaN(EMathOperation::Add);
 	return *this;
 }
 
 
 template <uint Size, typename Type>
 template <uint Size2, typename Type2>
-INLINE STVector<Size, Type> STVector<Size, Type>::operator-(const STVector<Size2, Type2>& Other) const
+INLINE constexpr STVector<Size, Type> STVector<Size, Type>::operator-(const STVector<Size2, Type2>& Other) const
 {
-	uint Count{ (Size < Size2) ? Size : Size2 };
 	STVector<Size, Type> Result;
+	if constexpr (SIMD::Enabled && Size == Size2 && std::is_same<Type, Type2>::value)
+	{
+		if (!std::is_constant_evaluated())
+		{
+			SIMD::Store(Result.Data, SIMD::Sub(SIMD::Load(Data), SIMD::Load(Other.Data)));
+			Result.CheckNaN(EMathOperation::Sub);
+			return Result;
+		}
+	}
+	uint Count{ (Size < Size2) ? Size : Size2 };
 	for (uint i = 0; i < Count; ++i)
 	{
 		Result[i] = Data[i] - Other[i];
 	}
-	Result.CheckNaN();
+	Result.CheckNaN(EMathOperation::Sub);
 	return Result;
 }
 
 
 template <uint Size, typename Type>
-INLINE STVector<Size, Type> STVector<Size, Type>::operator-(const Type& Value) const
+INLINE constexpr STVector<Size, Type> STVector<Size, Type>::operator-(const Type& Value) const
 {
 	STVector<Size, Type> Result;
+	if constexpr (SIMD::Enabled)
+	{
+		if (!std::is_constant_evaluated())
+		{
+			SIMD::Store(Result.Data, SIMD::Sub(SIMD::Load(Data), SIMD::Set(Value)));
+			Result.CheckNaN(EMathOperation::Sub);
+			return Result;
+		}
+	}
 	for (uint i = 0; i < Size; ++i)
 	{
 		Result[i] = Data[i] - Value;
 	}
-	Result.CheckNaN();
+	Result.CheckNaN(EMathOperation::Sub);
 	return Result;
 }
 
 
 template <uint Size, typename Type>
-INLINE STVector<Size, Type> STVector<Size, Type>::operator-() const
+INLINE constexpr STVector<Size, Type> STVector<Size, Type>::operator-() const
 {
 	STVector<Size, Type> Result;
+	if constexpr (SIMD::Enabled)
+	{
+		if (!std::is_constant_evaluated())
+		{
+			SIMD::Store(Result.Data, SIMD::Negate(SIMD::Load(Data)));
+			Result.CheckNaN(EMathOperation::Negate);
+			return Result;
+		}
+	}
 	for (uint i = 0; i < Size; ++i)
 	{
 		Result[i] = -Data[i];
 	}
-	Result.CheckNaN();
+	Result.CheckNaN(EMathOperation::Negate);
 	return Result;
 }
 
 
 template <uint Size, typename Type>
 template <uint Size2, typename Type2>
-INLINE STVector<Size, Type> STVector<Size, Type>::operator-=(const STVector<Size2, Type2>& Other)
+INLINE constexpr STVector<Size, Type>& STVector<Size, Type>::operator-=(const STVector<Size2, Type2>& Other)
 {
+	if constexpr (SIMD::Enabled && Size == Size2 && std::is_same<Type, Type2>::value)
+	{
+		if (!std::is_constant_evaluated())
+		{
+			SIMD::Store(Data, SIMD::Sub(SIMD::Load(Data), SIMD::Load(Other.Data)));
+			CheckNaN(EMathOperation::Sub);
+			return *this;
+		}
+	}
 	uint Count{ (Size < Size2) ? Size : Size2 };
 	for (uint i = 0; i < Count; ++i)
 	{
 		Data[i] -= Other[i];
 	}
-	CheckNaN();
+	CheckNaN(EMathOperation::Sub);
 	return *this;
 }
 
 
 template <uint Size, typename Type>
-INLINE STVector<Size, Type> STVector<Size, Type>::operator-=(const Type& Value)
+INLINE constexpr STVector<Size, Type>& STVector<Size, Type>::operator-=(const Type& Value)
 {
+	if constexpr (SIMD::Enabled)
+	{
+		if (!std::is_constant_evaluated())
+		{
+			SIMD::Store(Data, SIMD::Sub(SIMD::Load(Data), SIMD::Set(Value)));
+			CheckNaN(EMathOperation::Sub);
+			return *this;
+		}
+	}
 	for (uint i = 0; i < Size; ++i)
 	{
 		Data[i] -= Value;
 	}
-	CheckNaN();
+	CheckNaN(EMathOperation::Sub);
 	return *this;
 }
 
 
 template <uint Size, typename Type>
 template <uint Size2, typename Type2>
-INLINE STVector<Size, Type> STVector<Size, Type>::operator*(const STVector<Size2, Type2>& Other) const
+INLINE constexpr STVector<Size, Type> STVector<Size, Type>::operator*(const STVector<Size2, Type2>& Other) const
 {
-	uint Count{ (Size < Size2) ? Size : Size2 };
 	STVector<Size, Type> Result;
+	if constexpr (SIMD::Enabled && Size == Size2 && std::is_same<Type, Type2>::value)
+	{
+		if (!std::is_constant_evaluated())
+		{
+			SIMD::Store(Result.Data, SIMD::Mul(SIMD::Load(Data), SIMD::Load(Other.Data)));
+			Result.CheckNaN(EMathOperation::Mul);
+			return Result;
+		}
+	}
+	uint Count{ (Size < Size2) ? Size : Size2 };
 	for (uint i = 0; i < Count; ++i)
 	{
 		Result[i] = Data[i] * Other[i];
 	}
-	Result.CheckNaN();
+	Result.CheckNaN(EMathOperation::Mul);
 	return Result;
 }
 
 
 template <uint Size, typename Type>
-INLINE STVector<Size, Type> STVector<Size, Type>::operator*(const Type& Value) const
+INLINE constexpr STVector<Size, Type> STVector<Size, Type>::operator*(const Type& Value) const
 {
 	STVector<Size, Type> Result;
+	if constexpr (SIMD::Enabled)
+	{
+		if (!std::is_constant_evaluated())
+		{
+			SIMD::Store(Result.Data, SIMD::Mul(SIMD::Load(Data), SIMD::Set(Value)));
+			Result.CheckNaN(EMathOperation::Mul);
+			return Result;
+		}
+	}
 	for (uint i = 0; i < Size; ++i)
 	{
 		Result[i] = Data[i] * Value;
 	}
-	Result.CheckNaN();
+	Result.CheckNaN(EMathOperation::Mul);
 	return Result;
 }
 
 
 template <uint Size, typename Type>
 template <uint Size2, typename Type2>
-INLINE STVector<Size, Type> STVector<Size, Type>::operator*=(const STVector<Size2, Type2>& Other)
+INLINE constexpr STVector<Size, Type>& STVector<Size, Type>::operator*=(const STVector<Size2, Type2>& Other)
 {
-	uint Count{ (Size < Size2) ? Size : Size };
+	if constexpr (SIMD::Enabled && Size == Size2 && std::is_same<Type, Type2>::value)
+	{
+		if (!std::is_constant_evaluated())
+		{
+			SIMD::Store(Data, SIMD::Mul(SIMD::Load(Data), SIMD::Load(Other.Data)));
+			CheckNaN(EMathOperation::Mul);
+			return *this;
+		}
+	}
+	uint Count{ (Size < Size2) ? Size : Size2 };
 	for (uint i = 0; i < Count; ++i)
 	{
 		Data[i] *= Other[i];
 	}
-	CheckNaN();
+	CheckNaN(EMathOperation::Mul);
 	return *this;
 }
 
 
 template <uint Size, typename Type>
-INLINE STVector<Size, Type> STVector<Size, Type>::operator*=(const Type& Value)
+INLINE constexpr STVector<Size, Type>& STVector<Size, Type>::operator*=(const Type& Value)
 {
+	if constexpr (SIMD::Enabled)
+	{
+		if (!std::is_constant_evaluated())
+		{
+			SIMD::Store(Data, SIMD::Mul(SIMD::Load(Data), SIMD::Set(Value)));
+			CheckNaN(EMathOperation::Mul);
+			return *this;
+		}
+	}
 	for (uint i = 0; i < Size; ++i)
 	{
 		Data[i] *= Value;
 	}
-	CheckNaN();
+	CheckNaN(EMathOperation::Mul);
 	return *this;
 }
 
 
 template <uint Size, typename Type>
 template <uint Size2, typename Type2>
-INLINE STVector<Size, Type> STVector<Size, Type>::operator/(const STVector<Size2, Type2>& Other) const
+INLINE constexpr STVector<Size, Type> STVector<Size, Type>::operator/(const STVector<Size2, Type2>& Other) const
 {
-	uint Count{ (Size < Size2) ? Size : Size2 };
 	STVector<Size, Type> Result;
+	if constexpr (SIMD::Enabled && Size == Size2 && std::is_same<Type, Type2>::value)
+	{
+		if (!std::is_constant_evaluated())
+		{
+			SIMD::Store(Result.Data, SIMD::Div(SIMD::Load(Data), SIMD::Load(Other.Data)));
+			Result.CheckNaN(EMathOperation::Div);
+			return Result;
+		}
+	}
+	uint Count{ (Size < Size2) ? Size : Size2 };
 	for (uint i = 0; i < Count; ++i)
 	{
 		Result[i] = Data[i] / Other[i];
 	}
-	Result.CheckNaN();
+	Result.CheckNaN(EMathOperation::Div);
 	return Result;
 }
 
 
 template <uint Size, typename Type>
-INLINE STVector<Size, Type> STVector<Size, Type>::operator/(const Type& Value) const
+INLINE constexpr STVector<Size, Type> STVector<Size, Type>::operator/(const Type& Value) const
 {
 	STVector<Size, Type> Result;
-	for (uint i = 0; i < Count; ++i)
+	if constexpr (SIMD::Enabled)
+	{
+		if (!std::is_constant_evaluated())
+		{
+			SIMD::Store(Result.Data, SIMD::Div(SIMD::Load(Data), SIMD::Set(Value)));
+			Result.CheckNaN(EMathOperation::Div);
+			return Result;
+		}
+	}
+	for (uint i = 0; i < Size; ++i)
 	{
 		Result[i] = Data[i] / Value;
 	}
-	Result.CheckNaN();
+	Result.CheckNaN(EMathOperation::Div);
 	return Result;
 }
 
 
 template <uint Size, typename Type>
 template <uint Size2, typename Type2>
-INLINE STVector<Size, Type> STVector<Size, Type>::operator/=(const STVector<Size2, Type2>& Other)
+INLINE constexpr STVector<Size, Type>& STVector<Size, Type>::operator/=(const STVector<Size2, Type2>& Other)
 {
+	if constexpr (SIMD::Enabled && Size == Size2 && std::is_same<Type, Type2>::value)
+	{
+		if (!std::is_constant_evaluated())
+		{
+			SIMD::Store(Data, SIMD::Div(SIMD::Load(Data), SIMD::Load(Other.Data)));
+			CheckNaN(EMathOperation::Div);
+			return *this;
+		}
+	}
 	uint Count{ (Size < Size2) ? Size : Size2 };
 	for (uint i = 0; i < Count; ++i)
 	{
 		Data[i] /= Other[i];
 	}
-	CheckNaN();
+	CheckNaN(EMathOperation::Div);
 	return *this;
 }
 
 
 template <uint Size, typename Type>
-INLINE STVector<Size, Type> STVector<Size, Type>::operator/=(const Type& Value)
+INLINE constexpr STVector<Size, Type>& STVector<Size, Type>::operator/=(const Type& Value)
 {
+	if constexpr (SIMD::Enabled)
+	{
+		if (!std::is_constant_evaluated())
+		{
+			SIMD::Store(Data, SIMD::Div(SIMD::Load(Data), SIMD::Set(Value)));
+			CheckNaN(EMathOperation::Div);
+			return *this;
+		}
+	}
 	for (uint i = 0; i < Size; ++i)
 	{
 		Data[i] /= Value;
 	}
-	CheckNaN();
+	CheckNaN(EMathOperation::Div);
 	return *this;
 }
 
 
 template <uint Size, typename Type>
-INLINE STVector<Size, Type> STVector<Size, Type>::operator++()
+INLINE constexpr STVector<Size, Type>& STVector<Size, Type>::operator++()
 {
 	for (uint i = 0; i < Size; ++i)
 	{
 		++Data[i];
 	}
-	CheckNaN();
+	CheckNaN(EMathOperation::Increment);
 	return *this;
 }
 
 
 template <uint Size, typename Type>
-INLINE STVector<Size, Type> STVector<Size, Type>::operator--()
+INLINE constexpr STVector<Size, Type>& STVector<Size, Type>::operator--()
 {
 	for (uint i = 0; i < Size; ++i)
 	{
 		--Data[i];
 	}
-	CheckNaN();
+	CheckNaN(EMathOperation::Decrement);
 	return *this;
 }
 
 
 template <uint Size, typename Type>
-INLINE STVector<Size, Type> STVector<Size, Type>::operator=(const Type& Value)
+INLINE constexpr STVector<Size, Type>& STVector<Size, Type>::operator=(const Type& Value)
 {
 	for (uint i = 0; i < Size; ++i)
 	{
 		Data[i] = Value;
 	}
-	CheckNaN();
+	CheckNaN(EMathOperation::Assign);
 	return *this;
 }
 
 
 template <uint Size, typename Type>
-INLINE STVector<Size, Type> STVector<Size, Type>::operator|(const STVector<Size, Type>& Other) const
+INLINE constexpr STVector<Size, Type> STVector<Size, Type>::operator|(const STVector<Size, Type>& Other) const
 {
-	STVector<Size, Type> Result{ 0.0f };
-	Result[EAxis::X] = (Data[EAxis::Y] * Other[EAxis::Z) - (Data[EAxis::Z] * Other[EAxis::Y]);
-	Result[EAxis::Y] = (Data[EAxis::Z] * Other[EAxis::X) - (Data[EAxis::X] * Other[EAxis::Z]);
-	Result[EAxis::Z] = (Data[EAxis::X] * Other[EAxis::Y) - (Data[EAxis::Y] * Other[EAxis::X]);
-	Result.CheckNaN();
+	ASSERT(Size >= 3, "Vector must have 3 or more dimenions to calculate the cross product.");
+	STVector<Size, Type> Result{ (Type)0.0f };
+	if constexpr (SIMD::Enabled)
+	{
+		if (!std::is_constant_evaluated())
+		{
+			SIMD::Store(Result.Data, SIMD::Cross(SIMD::Load(Data), SIMD::Load(Other.Data)));
+			Result.CheckNaN(EMathOperation::Cross);
+			return Result;
+		}
+	}
+	Result[EAxis::X] = (Data[EAxis::Y] * Other[EAxis::Z]) - (Data[EAxis::Z] * Other[EAxis::Y]);
+	Result[EAxis::Y] = (Data[EAxis::Z] * Other[EAxis::X]) - (Data[EAxis::X] * Other[EAxis::Z]);
+	Result[EAxis::Z] = (Data[EAxis::X] * Other[EAxis::Y]) - (Data[EAxis::Y] * Other[EAxis::X]);
+	Result.CheckNaN(EMathOperation::Cross);
 	return Result;
 }
 
 
 template <uint Size, typename Type>
-INLINE Type STVector<Size, Type>::operator^(const STVector<Size, Type>& Other) const
+INLINE constexpr Type STVector<Size, Type>::operator^(const STVector<Size, Type>& Other) const
 {
-	Type Result{ 0.0f };
-	for (uint i = 0; i < Size; ++i)
+	Type Result{ (Type)0.0f };
+	if (std::is_constant_evaluated())
+	{
+		for (uint i = 0; i < Size; ++i)
+		{
+			Result += Data[i] * Other[i];
+		}
+		return Result;
+	}
+
+	if constexpr (SIMD::Enabled)
+	{
+		Result = SIMD::Dot(SIMD::Load(Data), SIMD::Load(Other.Data));
+	}
+	else
+	{
+		for (uint i = 0; i < Size; ++i)
+		{
+			Result += Data[i] * Other[i];
+		}
+	}
+	SInstrumentation::CountOperation(EMathOperation::Dot);
+	if constexpr (SNaNPolicy::Enabled)
 	{
-		Result += Data[i] * Other[i];
+		if (!TMath::IsFinite(Result) && SNaNPolicy::OnNaN("Dot product", EMathOperation::Dot)) Result = (Type)0.0f;
 	}
-	if (!TMath::IsFinite(Result)) Result = 0.0f;
 	return Result;
 }
 
 
 template <uint Size, typename Type>
-INLINE bool STVector<Size, Type>::operator>(const STVector<Size, Type>& Other) const
+INLINE constexpr bool STVector<Size, Type>::operator>(const STVector<Size, Type>& Other) const
 {
 	for (uint i = 0; i < Size; ++i)
 	{
@@ -834,7 +1160,7 @@ INLINE bool STVector<Size, Type>::operator>(const STVector<Size, Type>& Other) c
 
 
 template <uint Size, typename Type>
-INLINE bool STVector<Size, Type>::operator>(const Type& Value) const
+INLINE constexpr bool STVector<Size, Type>::operator>(const Type& Value) const
 {
 	for (uint i = 0; i < Size; ++i)
 	{
@@ -845,7 +1171,7 @@ INLINE bool STVector<Size, Type>::operator>(const Type& Value) const
 
 
 template <uint Size, typename Type>
-INLINE bool STVector<Size, Type>::operator>=(const STVector<Size, Type>& Other) const
+INLINE constexpr bool STVector<Size, Type>::operator>=(const STVector<Size, Type>& Other) const
 {
 	for (uint i = 0; i < Size; ++i)
 	{
@@ -856,7 +1182,7 @@ INLINE bool STVector<Size, Type>::operator>=(const STVector<Size, Type>& Other)
 
 
 template <uint Size, typename Type>
-INLINE bool STVector<Size, Type>::operator>=(const Type& Value) const
+INLINE constexpr bool STVector<Size, Type>::operator>=(const Type& Value) const
 {
 	for (uint i = 0; i < Size; ++i)
 	{
@@ -867,7 +1193,7 @@ INLINE bool STVector<Size, Type>::operator>=(const Type& Value) const
 
 
 template <uint Size, typename Type>
-INLINE bool STVector<Size, Type>::operator<(const STVector<Size, Type>& Other) const
+INLINE constexpr bool STVector<Size, Type>::operator<(const STVector<Size, Type>& Other) const
 {
 	for (uint i = 0; i < Size; ++i)
 	{
@@ -878,7 +1204,7 @@ INLINE bool STVector<Size, Type>::operator<(const STVector<Size, Type>& Other) c
 
 
 template <uint Size, typename Type>
-INLINE bool STVector<Size, Type>::operator<(const Type& Value) const
+INLINE constexpr bool STVector<Size, Type>::operator<(const Type& Value) const
 {
 	for (uint i = 0; i < Size; ++i)
 	{
@@ -889,7 +1215,7 @@ INLINE bool STVector<Size, Type>::operator<(const Type& Value) const
 
 
 template <uint Size, typename Type>
-INLINE bool STVector<Size, Type>::operator<=(const STVector<Size, Type>& Other) const
+INLINE constexpr bool STVector<Size, Type>::operator<=(const STVector<Size, Type>& Other) const
 {
 	for (uint i = 0; i < Size; ++i)
 	{
@@ -900,7 +1226,7 @@ INLINE bool STVector<Size, Type>::operator<=(const STVector<Size, Type>& Other)
 
 
 template <uint Size, typename Type>
-INLINE bool STVector<Size, Type>::operator<=(const Type& Other) const
+INLINE constexpr bool STVector<Size, Type>::operator<=(const Type& Value) const
 {
 	for (uint i = 0; i < Size; ++i)
 	{
@@ -911,7 +1237,7 @@ INLINE bool STVector<Size, Type>::operator<=(const Type& Other) const
 
 
 template <uint Size, typename Type>
-INLINE bool STVector<Size, Type>::operator==(const STVector<Size, Type>& Other) const
+INLINE constexpr bool STVector<Size, Type>::operator==(const STVector<Size, Type>& Other) const
 {
 	for (uint i = 0; i < Size; ++i)
 	{
@@ -922,7 +1248,7 @@ INLINE bool STVector<Size, Type>::operator==(const STVector<Size, Type>& Other)
 
 
 template <uint Size, typename Type>
-INLINE bool STVector<Size, Type>::operator==(const Type& Value) const
+INLINE constexpr bool STVector<Size, Type>::operator==(const Type& Value) const
 {
 	for (uint i = 0; i < Size; ++i)
 	{
@@ -933,18 +1259,18 @@ INLINE bool STVector<Size, Type>::operator==(const Type& Value) const
 
 
 template <uint Size, typename Type>
-INLINE bool STVector<Size, Type>::operator!=(const STVector<Size, Type>& Other) const
+INLINE constexpr bool STVector<Size, Type>::operator!=(const STVector<Size, Type>& Other) const
 {
 	for (uint i = 0; i < Size; ++i)
 	{
-		if (Data[i] == Value) return false;
+		if (Data[i] == Other[i]) return false;
 	}
 	return true;
 }
 
 
 template <uint Size, typename Type>
-INLINE bool STVector<Size, Type>::operator!=(const Type& Value) const
+INLINE constexpr bool STVector<Size, Type>::operator!=(const Type& Value) const
 {
 	for (uint i = 0; i < Size; ++i)
 	{
@@ -955,47 +1281,57 @@ INLINE bool STVector<Size, Type>::operator!=(const Type& Value) const
 
 
 template <uint Size, typename Type>
-INLINE Type& STVector<Size, Type>::operator[](const uint& Index)
+INLINE constexpr Type& STVector<Size, Type>::operator[](const uint& Index)
 {
 	return Data[Index];
 }
 
 
 template <uint Size, typename Type>
-INLINE Type STVector<Size, Type>::operator[](const uint& Index) const
+INLINE constexpr Type STVector<Size, Type>::operator[](const uint& Index) const
 {
 	return Data[Index];
 }
 
 
 template <uint Size, typename Type>
-INLINE Type& STVector<Size, Type>::operator[](const EAxis& Axis)
+INLINE constexpr Type& STVector<Size, Type>::operator[](const EAxis& Axis)
 {
 	return Data[Axis];
 }
 
 
 template <uint Size, typename Type>
-INLINE Type STVector<Size, Type>::operator[](const EAxis& Axis) const
+INLINE constexpr Type STVector<Size, Type>::operator[](const EAxis& Axis) const
 {
 	return Data[Axis];
 }
 
 
 template <uint Size, typename Type>
-INLINE void STVector<Size, Type>::CheckNaN() const
+INLINE constexpr void STVector<Size, Type>::CheckNaN(EMathOperation Operation, const std::source_location& Location) const
 {
-	if (ContainsNaN())
+	// Nothing can be counted, printed or aborted during constant evaluation.
+	if (std::is_constant_evaluated()) return;
+
+	SInstrumentation::CountOperation(Operation);
+	if constexpr (SNaNPolicy::Enabled)
 	{
-		printf("Vector contains NaN\n");
-		*const_cast<Vector<Size, Type>*>(this) = Vector<Size, Type>{ 0.0f };
+		if (ContainsNaN() && SNaNPolicy::OnNaN("Vector", Operation, Location))
+		{
+			*const_cast<STVector<Size, Type>*>(this) = STVector<Size, Type>{ (Type)0.0f };
+		}
 	}
 }
 
 
 template <uint Size, typename Type>
-INLINE bool STVector<Size, Type>::ContainsNaN() const
+INLINE constexpr bool STVector<Size, Type>::ContainsNaN() const
 {
+	if constexpr (SIMD::Enabled)
+	{
+		if (!std::is_constant_evaluated()) return !SIMD::AllFinite(SIMD::Load(Data));
+	}
 	for (uint i = 0; i < Size; ++i)
 	{
 		if (!TMath::IsFinite(Data[i])) return true;
@@ -1019,7 +1355,7 @@ INLINE void STVector<Size, Type>::Print() const
 template <uint Size, typename Type>
 INLINE STVector<Size, Type> STVector<Size, Type>::FromXMVector(DirectX::XMVECTOR Vector)
 {
-	STVector<Size, Element> Result;
+	STVector<Size, Type> Result;
 	switch (Size)
 	{
 	default:
@@ -1068,8 +1404,11 @@ template <uint Size, typename Type>
 INLINE STVector<3, float> STVector<Size, Type>::Rotation() const
 {
 	ASSERT(Size >= 3, "Vector must have 3 or more dimenions to do this conversion.");
-	Result[EAxis::Y] = TO_DEGREES(TMath::ATan2(Data[EAxis::Y], Data[EAxis::X]));
-	Result[EAxis::X] = TO_DEGREES(TMath::ATan2(Data[EAxis::Z], TMath::Sqrt((Data[EAxis::X * Data[EAxis::X]) + (Data[EAxis::Y] * Data[EAxis::Y]))));
+	STVector<3, float> Result;
+	const float VX{ (float)Data[EAxis::X] };
+	const float VY{ (float)Data[EAxis::Y] };
+	Result[EAxis::Y] = TO_DEGREES(TMath::FastATan2(VY, VX));
+	Result[EAxis::X] = TO_DEGREES(TMath::FastATan2((float)Data[EAxis::Z], TMath::Sqrt((VX * VX) + (VY * VY))));
 	Result[EAxis::Z] = 0.0f;
 	return Result;
 }
@@ -1077,71 +1416,293 @@ INLINE STVector<3, float> STVector<Size, Type>::Rotation() const
 
 template <uint Size, typename Type>
 template <typename NewType>
-INLINE STVector<Size, NewType> STVector<Size, Type>::ToType()
+INLINE constexpr STVector<Size, NewType> STVector<Size, Type>::ToType(const std::source_location& Location)
 {
-	STVector<Size, Type> Result;
+	STVector<Size, NewType> Result;
 	for (uint i = 0; i < Size; ++i)
 	{
-		Result[i] = (Type)Data[i];
+		Result[i] = (NewType)Data[i];
 	}
-	Result.CheckNaN();
+	Result.CheckNaN(EMathOperation::Convert, Location);
 	return Result;
 }
 
 
 template <uint Size, typename Type>
 template <typename NewType>
-INLINE STVector<Size, NewType> STVector< Size, Type>::ToType() const
+INLINE constexpr STVector<Size, NewType> STVector<Size, Type>::ToType(const std::source_location& Location) const
+{
+	STVector<Size, NewType> Result;
+	for (uint i = 0; i < Size; ++i)
+	{
+		Result[i] = (NewType)Data[i];
+	}
+	Result.CheckNaN(EMathOperation::Convert, Location);
+	return Result;
+}
+
+
+template <uint Size, typename Type>
+INLINE constexpr STVector<Size, float> STVector<Size, Type>::ToFloat(const std::source_location& Location)
+{
+	return ToType<float>(Location);
+}
+
+
+template <uint Size, typename Type>
+INLINE constexpr STVector<Size, float> STVector<Size, Type>::ToFloat(const std::source_location& Location) const
+{
+	return ToType<float>(Location);
+}
+
+
+template <uint Size, typename Type>
+INLINE constexpr STVector<Size, double> STVector<Size, Type>::ToDouble(const std::source_location& Location)
+{
+	return ToType<double>(Location);
+}
+
+
+template <uint Size, typename Type>
+INLINE constexpr STVector<Size, double> STVector<Size, Type>::ToDouble(const std::source_location& Location) const
+{
+	return ToType<double>(Location);
+}
+
+
+template <uint Size, typename Type>
+INLINE constexpr STVector<Size, int32> STVector<Size, Type>::ToInt(const std::source_location& Location)
+{
+	return ToType<int32>(Location);
+}
+
+
+template <uint Size, typename Type>
+INLINE constexpr STVector<Size, int32> STVector<Size, Type>::ToInt(const std::source_location& Location) const
+{
+	return ToType<int32>(Location);
+}
+
+
+template <uint Size, typename Type>
+INLINE constexpr STVector<3, Type> STVector<Size, Type>::CrossProduct(const STVector<3, Type>& Other) const
+{
+	return STVector<3, Type>{ *this } | Other;
+}
+
+
+template <uint Size, typename Type>
+INLINE constexpr float STVector<Size, Type>::DotProduct(const STVector<Size, Type>& Other) const
+{
+	return (float)(*this ^ Other);
+}
+
+
+template <uint Size, typename Type>
+INLINE constexpr STVector<Size, Type> STVector<Size, Type>::Max(const STVector<Size, Type>& Other) const
 {
 	STVector<Size, Type> Result;
+	if constexpr (SIMD::Enabled)
+	{
+		if (!std::is_constant_evaluated())
+		{
+			SIMD::Store(Result.Data, SIMD::Max(SIMD::Load(Data), SIMD::Load(Other.Data)));
+			return Result;
+		}
+	}
 	for (uint i = 0; i < Size; ++i)
 	{
-		Result[i] = (Type)Data[i];
+		Result[i] = (Data[i] > Other[i]) ? Data[i] : Other[i];
 	}
-	Result.CheckNaN();
 	return Result;
 }
 
 
 template <uint Size, typename Type>
-INLINE STVector<Size, float> STVector<Size, Type>::ToFloat()
+INLINE constexpr STVector<Size, Type> STVector<Size, Type>::Min(const STVector<Size, Type>& Other) const
 {
-	return ToType<float>();
+	STVector<Size, Type> Result;
+	if constexpr (SIMD::Enabled)
+	{
+		if (!std::is_constant_evaluated())
+		{
+			SIMD::Store(Result.Data, SIMD::Min(SIMD::Load(Data), SIMD::Load(Other.Data)));
+			return Result;
+		}
+	}
+	for (uint i = 0; i < Size; ++i)
+	{
+		Result[i] = (Data[i] < Other[i]) ? Data[i] : Other[i];
+	}
+	return Result;
+}
+
+
+template <uint Size, typename Type>
+INLINE constexpr bool STVector<Size, Type>::nearlyEqual(const STVector<Size, Type>& Other, const Type& Threshold) const
+{
+	for (uint i = 0; i < Size; ++i)
+	{
+		const Type Difference{ Data[i] - Other[i] };
+		if (((Difference < (Type)0) ? -Difference : Difference) > Threshold) return false;
+	}
+	return true;
+}
+
+
+template <uint Size, typename Type>
+template <bool Fast>
+INLINE Type STVector<Size, Type>::InvLength(Type SquareSum)
+{
+	// rsqrt is only an estimate for normal floats, zero, denormals and infinity take the exact path.
+	if constexpr (Fast && std::is_same<Type, float>::value)
+	{
+		if (LIKELY(SquareSum >= std::numeric_limits<float>::min() && SquareSum <= std::numeric_limits<float>::max())) return TMath::FastInvSqrt(SquareSum);
+	}
+	return TMath::InvSqrt(SquareSum);
+}
+
+
+template <uint Size, typename Type>
+INLINE Type STVector<Size, Type>::Length() const
+{
+	return TMath::Sqrt(LengthSquared());
+}
+
+
+template <uint Size, typename Type>
+INLINE Type STVector<Size, Type>::FastLength() const
+{
+	const Type SquareSum{ LengthSquared() };
+	if constexpr (std::is_same<Type, float>::value)
+	{
+		if (LIKELY(SquareSum >= std::numeric_limits<float>::min() && SquareSum <= std::numeric_limits<float>::max())) return SquareSum * TMath::FastInvSqrt(SquareSum);
+	}
+	return TMath::Sqrt(SquareSum);
 }
 
 
 template <uint Size, typename Type>
-INLINE STVector<Size, float> STVector<Size, Type>::ToFloat() const
+INLINE STVector<Size, Type> STVector<Size, Type>::SafeNormal(Type Tolerance) const
 {
-	return ToType<float>();
+	const Type SquareSum{ LengthSquared() };
+	if (SquareSum > Tolerance && SquareSum <= std::numeric_limits<Type>::max()) return *this * InvLength<false>(SquareSum);
+	return STVector<Size, Type>{ (Type)0 };
 }
 
 
 template <uint Size, typename Type>
-INLINE STVector<Size, double> STVector<Size, Type>::ToDouble()
+INLINE STVector<Size, Type> STVector<Size, Type>::FastSafeNormal(Type Tolerance) const
 {
-	return ToType<double>();
+	const Type SquareSum{ LengthSquared() };
+	if (SquareSum > Tolerance && SquareSum <= std::numeric_limits<Type>::max()) return *this * InvLength<true>(SquareSum);
+	return STVector<Size, Type>{ (Type)0 };
 }
 
 
 template <uint Size, typename Type>
-INLINE STVector<Size, double> STVector<Size, Type>::ToDouble() const
+INLINE bool STVector<Size, Type>::Normalize(Type Tolerance)
 {
-	return ToType<double>();
+	const Type SquareSum{ LengthSquared() };
+	if (!(SquareSum > Tolerance && SquareSum <= std::numeric_limits<Type>::max())) return false;
+	*this *= InvLength<false>(SquareSum);
+	return true;
+}
+
+
+template <uint Size, typename Type>
+INLINE bool STVector<Size, Type>::FastNormalize(Type Tolerance)
+{
+	const Type SquareSum{ LengthSquared() };
+	if (!(SquareSum > Tolerance && SquareSum <= std::numeric_limits<Type>::max())) return false;
+	*this *= InvLength<true>(SquareSum);
+	return true;
+}
+
+
+template <uint Size, typename Type>
+template <bool Fast>
+INLINE void STVector<Size, Type>::NormalizeRange(STVector<Size, Type>* Vectors, uint Begin, uint End, Type Tolerance)
+{
+	typedef TLanes<Type, TNativeLanes<Type>::Count> SLanes;
+	constexpr uint Lanes{ TNativeLanes<Type>::Count };
+	constexpr bool UseEstimate{ Fast && std::is_same<Type, float>::value };
+	const SLanes One{ (Type)1.0f };
+	const SLanes Low{ UseEstimate ? TMath::Max(Tolerance, std::numeric_limits<Type>::min()) : Tolerance };
+	const SLanes High{ std::numeric_limits<Type>::max() };
+
+	// A lane of vectors is Size registers of components. The squared components are summed per vector on the stack,
+	// then each vector's scale is spread back over its components, so no register ever has to be transposed.
+	auto NormalizeLane = [&](Type* Components)
+	{
+		SLanes Values[Size];
+		alignas(64) Type Squares[Size * Lanes];
+		for (uint j = 0; j < Size; ++j)
+		{
+			Values[j] = SLanes::LoadUnaligned(Components + (j * Lanes));
+			(Values[j] * Values[j]).Store(Squares + (j * Lanes));
+		}
+
+		alignas(64) Type Sums[Lanes];
+		for (uint l = 0; l < Lanes; ++l)
+		{
+			Type Sum{ Squares[l * Size] };
+			for (uint j = 1; j < Size; ++j) Sum += Squares[(l * Size) + j];
+			Sums[l] = Sum;
+		}
+
+		// Squared lengths that overflow would scale the vector to zero, those vectors keep a scale of 1 like short ones.
+		const SLanes SquareSum{ SLanes::Load(Sums) };
+		const SLanes InRange{ (SquareSum > Low) & (SquareSum <= High) };
+		if constexpr (UseEstimate) InRange.Select(TMath::FastInvSqrt(SquareSum), One).Store(Sums);
+		else InRange.Select(One / SquareSum.Sqrt(), One).Store(Sums);
+
+		alignas(64) Type Scales[Size * Lanes];
+		for (uint l = 0; l < Lanes; ++l)
+		{
+			for (uint j = 0; j < Size; ++j) Scales[(l * Size) + j] = Sums[l];
+		}
+		for (uint j = 0; j < Size; ++j) (Values[j] * SLanes::Load(Scales + (j * Lanes))).StoreUnaligned(Components + (j * Lanes));
+	};
+
+	uint i{ Begin };
+	if constexpr (sizeof(STVector<Size, Type>) == sizeof(Type) * Size)
+	{
+		for (; i + Lanes <= End; i += Lanes) NormalizeLane(Vectors[i].Data);
+	}
+
+	// The last partial lane and padded vectors are copied through a zeroed lane, so every vector gets the same
+	// tolerance and range checks as the full lanes rather than Normalize()'s.
+	for (; i < End; i += Lanes)
+	{
+		const uint Count{ TMath::Min(End - i, Lanes) };
+		alignas(64) Type Staged[Size * Lanes]{};
+		for (uint l = 0; l < Count; ++l)
+		{
+			for (uint j = 0; j < Size; ++j) Staged[(l * Size) + j] = Vectors[i + l].Data[j];
+		}
+		NormalizeLane(Staged);
+		for (uint l = 0; l < Count; ++l)
+		{
+			for (uint j = 0; j < Size; ++j) Vectors[i + l].Data[j] = Staged[(l * Size) + j];
+		}
+	}
 }
 
 
 template <uint Size, typename Type>
-INLINE STVector<Size, int32> STVector<Size, Type>::ToInt()
+INLINE void STVector<Size, Type>::NormalizeArray(STVector<Size, Type>* Vectors, uint Count, Type Tolerance)
 {
-	return ToType<int32>();
+	constexpr uint Granularity{ 64 / std::gcd((uint)sizeof(STVector<Size, Type>), 64u) };
+	ParallelFor(Count, [Vectors, Tolerance](uint Begin, uint End) { NormalizeRange<false>(Vectors, Begin, End, Tolerance); }, VectorGrain, Granularity);
 }
 
 
 template <uint Size, typename Type>
-INLINE STVector<Size, int32> STVector<Size, Type>::ToInt() const
+INLINE void STVector<Size, Type>::FastNormalizeArray(STVector<Size, Type>* Vectors, uint Count, Type Tolerance)
 {
-	return ToType<int32>();
+	constexpr uint Granularity{ 64 / std::gcd((uint)sizeof(STVector<Size, Type>), 64u) };
+	ParallelFor(Count, [Vectors, Tolerance](uint Begin, uint End) { NormalizeRange<true>(Vectors, Begin, End, Tolerance); }, VectorGrain, Granularity);
 }
 
 
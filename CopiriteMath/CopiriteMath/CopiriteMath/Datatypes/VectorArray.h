@@ -0,0 +1,831 @@
+#pragma once
+#include "Vector.h"
+#include "../Math/SIMD.h"
+#include "../Memory/Arena.h"
+#include "../Parallel/ThreadPool.h"
+#include <cassert>
+#include <new>
+
+
+
+// A reference to a single vector inside a STVectorArray.
+// Reads and writes go straight to the array's storage, no copy of the vector is made.
+// @template Size - How many dimensions the vector has.
+// @template Type - The datatype the vector uses.
+template <uint Size, typename Type>
+struct STVectorArrayRef
+{
+private:
+	/// Properties
+
+	// The array's axis storage.
+	Type* const* Axis;
+
+	// The index of the referenced vector.
+	uint Index;
+
+
+public:
+	/// Constructors
+
+	// Constructor, Initializes a reference to a vector in an array.
+	// @param InAxis - The array's axis storage.
+	// @param InIndex - The index of the referenced vector.
+	INLINE STVectorArrayRef(Type* const* InAxis, uint InIndex)
+		:Axis{ InAxis }, Index{ InIndex }
+	{}
+
+
+
+	/// Operators
+
+	// Operator, Returns the referenced vector's component at the given index.
+	INLINE Type& operator[](const uint& Component) { return Axis[Component][Index]; }
+
+	// Operator, Returns the referenced vector's component at the given index.
+	INLINE Type operator[](const uint& Component) const { return Axis[Component][Index]; }
+
+	// Operator, Copies the referenced vector out of the array.
+	INLINE operator STVector<Size, Type>() const;
+
+	// Operator, Writes a vector into the referenced array slot.
+	INLINE STVectorArrayRef<Size, Type>& operator=(const STVector<Size, Type>& Vector);
+
+	// Operator, Copies the values of another referenced vector into this referenced array slot.
+	INLINE STVectorArrayRef<Size, Type>& operator=(const STVectorArrayRef<Size, Type>& Other);
+};
+
+
+
+// Stores an array of vectors as a structure of arrays, each axis is contiguous in memory.
+// The batched functions operate on TNativeLanes vectors at a time, long arrays are split across SThreadPool::Get().
+// @note - Each axis is 64-byte aligned and padded to a multiple of the lane count, the padding is never exposed.
+// Arrays given an arena take their storage from it instead of the heap, for scratch arrays that live for a frame.
+// @template Size - How many dimensions each vector has.
+// @template Type - The datatype each vector uses.
+template <uint Size, typename Type>
+struct STVectorArray
+{
+public:
+	// The alignment of each axis in bytes.
+	static constexpr uint Alignment{ 64 };
+
+	// How many vectors the batched functions operate on together.
+	static constexpr uint Lanes{ TNativeLanes<Type>::Count };
+
+	// The lanes used by the batched functions.
+	typedef TLanes<Type, Lanes> SLanes;
+
+	// The fewest vectors the batched functions give a thread, shorter arrays are not split.
+	static constexpr uint ParallelGrain{ VectorGrain };
+
+
+private:
+	/// Properties
+
+	// The start of each axis, all axis' share a single allocation.
+	Type* Axis[Size];
+
+	// How many vectors are in this array.
+	uint Count;
+
+	// How many vectors each axis has space for.
+	uint Capacity;
+
+	// The arena the storage is allocated from, nullptr if it is on the heap.
+	SArena* Arena;
+
+	// The capacity is always a multiple of this so every axis stays aligned and whole lanes can be processed.
+	static constexpr uint Granularity{ ((Alignment / sizeof(Type)) > Lanes) ? (Alignment / sizeof(Type)) : Lanes };
+
+
+	/// Functions
+
+	// Normalizes every vector in this array.
+	// @template Fast - Should floats use FastInvSqrt.
+	template <bool Fast>
+	INLINE void NormalizeLanes(Type Tolerance);
+
+	// Replaces the storage of this array with a new allocation, keeping the existing vectors.
+	// @param NewCapacity - How many vectors each axis should have space for.
+	INLINE void Reallocate(uint NewCapacity);
+
+	// Frees the storage of this array if it is on the heap.
+	INLINE void Free();
+
+	// Runs a function over whole lanes of every axis of this array and another array.
+	// @param Other - The other array, must be the same length as this array.
+	// @param Function - Takes the lanes of both arrays and returns the new lanes of this array.
+	template <typename Function>
+	INLINE void Apply(const STVectorArray<Size, Type>& Other, Function Func);
+
+	// Runs a function over whole lanes of every axis of this array and a single vector.
+	// @param Vector - The vector applied to every element.
+	// @param Function - Takes the lanes of this array and the vector's component and returns the new lanes of this array.
+	template <typename Function>
+	INLINE void Apply(const STVector<Size, Type>& Vector, Function Func);
+
+
+public:
+	/// Constructors
+
+	// Constructor, Default.
+	INLINE STVectorArray();
+
+	// Constructor, Initializes the array with an amount of vector0s.
+	// @param InCount - How many vectors the array should contain.
+	INLINE explicit STVectorArray(uint InCount);
+
+	// Constructor, Initializes the array with an amount of vector0s, allocating from an arena now and whenever it grows.
+	// @param InCount - How many vectors the array should contain.
+	// @param InArena - The arena to allocate from, the array must not be used after the arena is reset past it.
+	INLINE STVectorArray(uint InCount, SArena& InArena);
+
+	// Constructor, Initializes the array by transposing an array of vectors.
+	// @param Vectors - The vectors to copy.
+	// @param InCount - How many vectors to copy.
+	INLINE STVectorArray(const STVector<Size, Type>* Vectors, uint InCount);
+
+	// Constructor, Copy.
+	INLINE STVectorArray(const STVectorArray<Size, Type>& Other);
+
+	// Constructor, Move.
+	INLINE STVectorArray(STVectorArray<Size, Type>&& Other) noexcept;
+
+	// Destructor.
+	INLINE ~STVectorArray();
+
+
+
+	/// Operators
+
+	// Operator, Copy assignment.
+	INLINE STVectorArray<Size, Type>& operator=(const STVectorArray<Size, Type>& Other);
+
+	// Operator, Move assignment.
+	INLINE STVectorArray<Size, Type>& operator=(STVectorArray<Size, Type>&& Other) noexcept;
+
+	// Operator, Returns a reference to the vector at the given index.
+	INLINE STVectorArrayRef<Size, Type> operator[](const uint& Index);
+
+	// Operator, Returns a copy of the vector at the given index.
+	INLINE STVector<Size, Type> operator[](const uint& Index) const;
+
+	// Operator, Adds each vector in another array to the corosponding vector in this array.
+	INLINE STVectorArray<Size, Type>& operator+=(const STVectorArray<Size, Type>& Other);
+
+	// Operator, Adds a vector to every vector in this array.
+	INLINE STVectorArray<Size, Type>& operator+=(const STVector<Size, Type>& Vector);
+
+	// Operator, Subtracts each vector in another array from the corosponding vector in this array.
+	INLINE STVectorArray<Size, Type>& operator-=(const STVectorArray<Size, Type>& Other);
+
+	// Operator, Subtracts a vector from every vector in this array.
+	INLINE STVectorArray<Size, Type>& operator-=(const STVector<Size, Type>& Vector);
+
+	// Operator, Multiplies each vector in this array by the corosponding vector in another array.
+	INLINE STVectorArray<Size, Type>& operator*=(const STVectorArray<Size, Type>& Other);
+
+	// Operator, Multiplies every vector in this array by a vector.
+	INLINE STVectorArray<Size, Type>& operator*=(const STVector<Size, Type>& Vector);
+
+	// Operator, Multiplies every vector in this array by a value.
+	INLINE STVectorArray<Size, Type>& operator*=(const Type& Value);
+
+	// Operator, Divides each vector in this array by the corosponding vector in another array.
+	INLINE STVectorArray<Size, Type>& operator/=(const STVectorArray<Size, Type>& Other);
+
+	// Operator, Divides every vector in this array by a value.
+	INLINE STVectorArray<Size, Type>& operator/=(const Type& Value);
+
+
+
+	/// Getters
+
+	// Returns how many vectors are in this array.
+	INLINE uint Num() const { return Count; }
+
+	// Returns how many vectors this array can hold before it needs to reallocate.
+	INLINE uint GetCapacity() const { return Capacity; }
+
+	// Returns the arena this array allocates from, nullptr if it uses the heap.
+	INLINE SArena* GetArena() const { return Arena; }
+
+	// Returns the contiguous values of an axis.
+	// @param Index - The index of the axis.
+	INLINE Type* GetAxis(const uint& Index) { return Axis[Index]; }
+
+	// Returns the contiguous values of an axis.
+	// @param Index - The index of the axis.
+	INLINE const Type* GetAxis(const uint& Index) const { return Axis[Index]; }
+
+
+
+	/// Functions
+
+	// Runs a function over pieces of this array on the thread pool, every piece starts on a cache line of each axis.
+	// @note - Kernels may process whole lanes past the end of the last piece, the padding of each axis covers them.
+	// @param Function - Called with the first and one past the last vector of each piece.
+	template <typename Function>
+	INLINE void ForEachPiece(Function Func) const { ParallelFor(Count, Func, ParallelGrain, Granularity); }
+
+	// Makes sure this array can hold an amount of vectors without reallocating.
+	// @param NewCapacity - How many vectors the array should be able to hold.
+	INLINE void Reserve(uint NewCapacity);
+
+	// Changes how many vectors are in this array, new vectors are vector0s.
+	// @param NewCount - How many vectors the array should contain.
+	INLINE void Resize(uint NewCount);
+
+	// Adds a vector to the end of this array.
+	// @param Vector - The vector to add.
+	// @return - The index of the added vector.
+	INLINE uint Add(const STVector<Size, Type>& Vector);
+
+	// Removes all vectors from this array, the memory is kept.
+	INLINE void Clear() { Count = 0; }
+
+	// Copies the vectors in this array into an array of vectors.
+	// @param Out - The array to copy to, must have space for Num() vectors.
+	INLINE void ToArray(STVector<Size, Type>* Out) const;
+
+	// Calculates the dot product between each vector in this array and the corosponding vector in another array.
+	// @param Other - The other array, must be the same length as this array.
+	// @param Out - Receives Num() dot products.
+	INLINE void DotProduct(const STVectorArray<Size, Type>& Other, Type* Out) const;
+
+	// Calculates the dot product between each vector in this array and a vector.
+	// @param Vector - The inputted vector to calculate against.
+	// @param Out - Receives Num() dot products.
+	INLINE void DotProduct(const STVector<Size, Type>& Vector, Type* Out) const;
+
+	// Calculates the cross product between each vector in this array and the corosponding vector in another array.
+	// @param Other - The other array, must be the same length as this array.
+	// @param Out - Receives the resulting vectors, may be this array or the other array.
+	INLINE void CrossProduct(const STVectorArray<Size, Type>& Other, STVectorArray<Size, Type>& Out) const;
+
+	// Sets each vector in this array to the highest values in each dimension between it and the corosponding vector in another array.
+	// @param Other - The other array, must be the same length as this array.
+	INLINE void Max(const STVectorArray<Size, Type>& Other);
+
+	// Sets each vector in this array to the highest values in each dimension between it and a vector.
+	// @param Vector - The inputted vector to calculate against.
+	INLINE void Max(const STVector<Size, Type>& Vector);
+
+	// Sets each vector in this array to the lowest values in each dimension between it and the corosponding vector in another array.
+	// @param Other - The other array, must be the same length as this array.
+	INLINE void Min(const STVectorArray<Size, Type>& Other);
+
+	// Sets each vector in this array to the lowest values in each dimension between it and a vector.
+	// @param Vector - The inputted vector to calculate against.
+	INLINE void Min(const STVector<Size, Type>& Vector);
+
+	// Normalizes every vector in this array.
+	// @note - The same error as STVector::Normalize(), within 2.4e-7 (2 ULP) of unit length for floats.
+	// Vectors whose squared length overflows are left unchanged.
+	// @param Tolerance - Vectors with a squared length at or below this are left unchanged.
+	INLINE void Normalize(Type Tolerance = (Type)MICRO_NUMBER) { NormalizeLanes<false>(Tolerance); }
+
+	// Normalizes every vector in this array to approximately unit length, using rsqrt and one Newton-Raphson step.
+	// @note - The same error as STVector::FastNormalize(), within 4.8e-7 (4 ULP) of unit length for floats, doubles use Normalize().
+	// Vectors whose squared length is denormal or overflows are left unchanged.
+	// @param Tolerance - Vectors with a squared length at or below this are left unchanged.
+	INLINE void FastNormalize(Type Tolerance = (Type)MICRO_NUMBER) { NormalizeLanes<true>(Tolerance); }
+
+	// Tests if each vector in this array is almost equal to the corosponding vector in another array.
+	// @param Other - The other array, must be the same length as this array.
+	// @param Out - Receives Num() results.
+	// @param Threshold - The range in which the other vector can be in.
+	INLINE void nearlyEqual(const STVectorArray<Size, Type>& Other, bool* Out, const Type& Threshold = (Type)MICRO_NUMBER) const;
+};
+
+
+
+// An array of floating point vectors with 2 dimensions.
+typedef STVectorArray<2, float> SVector2Array;
+
+// An array of floating point vectors with 3 dimensions.
+typedef STVectorArray<3, float> SVector3Array;
+
+// An array of floating point vectors with 3 dimensions.
+typedef STVectorArray<3, float> SVectorArray;
+
+// An array of floating point vectors with 4 dimensions.
+typedef STVectorArray<4, float> SVector4Array;
+
+// An array of double type vectors with 3 dimensions.
+typedef STVectorArray<3, double> SVectordArray;
+
+// An array of double type vectors with 4 dimensions.
+typedef STVectorArray<4, double> SVector4dArray;
+
+// An aligned buffer of floating point vectors with 3 dimensions.
+typedef STAlignedBuffer<STVector<3, float>> SVectorBuffer;
+
+// An aligned buffer of floating point vectors with 4 dimensions.
+typedef STAlignedBuffer<STVector<4, float>> SVector4Buffer;
+
+// An aligned buffer of double type vectors with 3 dimensions.
+typedef STAlignedBuffer<STVector<3, double>> SVectordBuffer;
+
+
+
+template <uint Size, typename Type>
+INLINE STVectorArrayRef<Size, Type>::operator STVector<Size, Type>() const
+{
+	STVector<Size, Type> Result;
+	for (uint i = 0; i < Size; ++i)
+	{
+		Result[i] = Axis[i][Index];
+	}
+	return Result;
+}
+
+
+template <uint Size, typename Type>
+INLINE STVectorArrayRef<Size, Type>& STVectorArrayRef<Size, Type>::operator=(const STVector<Size, Type>& Vector)
+{
+	for (uint i = 0; i < Size; ++i)
+	{
+		Axis[i][Index] = Vector[i];
+	}
+	return *this;
+}
+
+
+template <uint Size, typename Type>
+INLINE STVectorArrayRef<Size, Type>& STVectorArrayRef<Size, Type>::operator=(const STVectorArrayRef<Size, Type>& Other)
+{
+	for (uint i = 0; i < Size; ++i)
+	{
+		Axis[i][Index] = Other.Axis[i][Other.Index];
+	}
+	return *this;
+}
+
+
+template <uint Size, typename Type>
+INLINE STVectorArray<Size, Type>::STVectorArray()
+	:Axis{}, Count{ 0 }, Capacity{ 0 }, Arena{ nullptr }
+{}
+
+
+template <uint Size, typename Type>
+INLINE STVectorArray<Size, Type>::STVectorArray(uint InCount)
+	:STVectorArray()
+{
+	Resize(InCount);
+}
+
+
+template <uint Size, typename Type>
+INLINE STVectorArray<Size, Type>::STVectorArray(uint InCount, SArena& InArena)
+	:STVectorArray()
+{
+	Arena = &InArena;
+	Resize(InCount);
+}
+
+
+template <uint Size, typename Type>
+INLINE STVectorArray<Size, Type>::STVectorArray(const STVector<Size, Type>* Vectors, uint InCount)
+	:STVectorArray()
+{
+	Reserve(InCount);
+	Count = InCount;
+	for (uint i = 0; i < Count; ++i)
+	{
+		for (uint j = 0; j < Size; ++j)
+		{
+			Axis[j][i] = Vectors[i][j];
+		}
+	}
+}
+
+
+template <uint Size, typename Type>
+INLINE STVectorArray<Size, Type>::STVectorArray(const STVectorArray<Size, Type>& Other)
+	:STVectorArray()
+{
+	*this = Other;
+}
+
+
+template <uint Size, typename Type>
+INLINE STVectorArray<Size, Type>::STVectorArray(STVectorArray<Size, Type>&& Other) noexcept
+	:STVectorArray()
+{
+	*this = std::move(Other);
+}
+
+
+template <uint Size, typename Type>
+INLINE STVectorArray<Size, Type>::~STVectorArray()
+{
+	Free();
+}
+
+
+template <uint Size, typename Type>
+INLINE STVectorArray<Size, Type>& STVectorArray<Size, Type>::operator=(const STVectorArray<Size, Type>& Other)
+{
+	if (this == &Other) return *this;
+	Count = 0;
+	Reserve(Other.Count);
+	Count = Other.Count;
+	for (uint i = 0; i < Size && Count > 0; ++i)
+	{
+		memcpy(Axis[i], Other.Axis[i], sizeof(Type) * Count);
+	}
+	return *this;
+}
+
+
+template <uint Size, typename Type>
+INLINE STVectorArray<Size, Type>& STVectorArray<Size, Type>::operator=(STVectorArray<Size, Type>&& Other) noexcept
+{
+	if (this == &Other) return *this;
+	Free();
+	for (uint i = 0; i < Size; ++i)
+	{
+		Axis[i] = Other.Axis[i];
+		Other.Axis[i] = nullptr;
+	}
+	Count = Other.Count;
+	Capacity = Other.Capacity;
+	Arena = Other.Arena;
+	Other.Count = 0;
+	Other.Capacity = 0;
+	return *this;
+}
+
+
+template <uint Size, typename Type>
+INLINE STVectorArrayRef<Size, Type> STVectorArray<Size, Type>::operator[](const uint& Index)
+{
+	return STVectorArrayRef<Size, Type>{ Axis, Index };
+}
+
+
+template <uint Size, typename Type>
+INLINE STVector<Size, Type> STVectorArray<Size, Type>::operator[](const uint& Index) const
+{
+	STVector<Size, Type> Result;
+	for (uint i = 0; i < Size; ++i)
+	{
+		Result[i] = Axis[i][Index];
+	}
+	return Result;
+}
+
+
+template <uint Size, typename Type>
+INLINE STVectorArray<Size, Type>& STVectorArray<Size, Type>::operator+=(const STVectorArray<Size, Type>& Other)
+{
+	Apply(Other, [](const SLanes& A, const SLanes& B) { return A + B; });
+	return *this;
+}
+
+
+template <uint Size, typename Type>
+INLINE STVectorArray<Size, Type>& STVectorArray<Size, Type>::operator+=(const STVector<Size, Type>& Vector)
+{
+	Apply(Vector, [](const SLanes& A, const SLanes& B) { return A + B; });
+	return *this;
+}
+
+
+template <uint Size, typename Type>
+INLINE STVectorArray<Size, Type>& STVectorArray<Size, Type>::operator-=(const STVectorArray<Size, Type>& Other)
+{
+	Apply(Other, [](const SLanes& A, const SLanes& B) { return A - B; });
+	return *this;
+}
+
+
+template <uint Size, typename Type>
+INLINE STVectorArray<Size, Type>& STVectorArray<Size, Type>::operator-=(const STVector<Size, Type>& Vector)
+{
+	Apply(Vector, [](const SLanes& A, const SLanes& B) { return A - B; });
+	return *this;
+}
+
+
+template <uint Size, typename Type>
+INLINE STVectorArray<Size, Type>& STVectorArray<Size, Type>::operator*=(const STVectorArray<Size, Type>& Other)
+{
+	Apply(Other, [](const SLanes& A, const SLanes& B) { return A * B; });
+	return *this;
+}
+
+
+template <uint Size, typename Type>
+INLINE STVectorArray<Size, Type>& STVectorArray<Size, Type>::operator*=(const STVector<Size, Type>& Vector)
+{
+	Apply(Vector, [](const SLanes& A, const SLanes& B) { return A * B; });
+	return *this;
+}
+
+
+template <uint Size, typename Type>
+INLINE STVectorArray<Size, Type>& STVectorArray<Size, Type>::operator*=(const Type& Value)
+{
+	return *this *= STVector<Size, Type>{ Value };
+}
+
+
+template <uint Size, typename Type>
+INLINE STVectorArray<Size, Type>& STVectorArray<Size, Type>::operator/=(const STVectorArray<Size, Type>& Other)
+{
+	Apply(Other, [](const SLanes& A, const SLanes& B) { return A / B; });
+	return *this;
+}
+
+
+template <uint Size, typename Type>
+INLINE STVectorArray<Size, Type>& STVectorArray<Size, Type>::operator/=(const Type& Value)
+{
+	Apply(STVector<Size, Type>{ Value }, [](const SLanes& A, const SLanes& B) { return A / B; });
+	return *this;
+}
+
+
+template <uint Size, typename Type>
+INLINE void STVectorArray<Size, Type>::Reallocate(uint NewCapacity)
+{
+	NewCapacity = ((NewCapacity + Granularity - 1) / Granularity) * Granularity;
+	const size_t Bytes{ sizeof(Type) * NewCapacity * Size };
+	Type* NewData{ (Type*)(Arena ? Arena->Allocate(Bytes, Alignment) : ::operator new(Bytes, std::align_val_t{ Alignment })) };
+	memset(NewData, 0, Bytes);
+	for (uint i = 0; i < Size; ++i)
+	{
+		if (Count > 0) memcpy(NewData + (i * NewCapacity), Axis[i], sizeof(Type) * Count);
+	}
+	Free();
+	for (uint i = 0; i < Size; ++i)
+	{
+		Axis[i] = NewData + (i * NewCapacity);
+	}
+	Capacity = NewCapacity;
+}
+
+
+template <uint Size, typename Type>
+INLINE void STVectorArray<Size, Type>::Free()
+{
+	if (Axis[0] && !Arena) ::operator delete(Axis[0], std::align_val_t{ Alignment });
+}
+
+
+template <uint Size, typename Type>
+template <typename Function>
+INLINE void STVectorArray<Size, Type>::Apply(const STVectorArray<Size, Type>& Other, Function Func)
+{
+	assert(Other.Count == Count);
+	ForEachPiece([&](uint Begin, uint End)
+		{
+			for (uint j = 0; j < Size; ++j)
+			{
+				Type* A{ ASSUME_ALIGNED(Axis[j], Alignment) };
+				const Type* B{ ASSUME_ALIGNED(Other.Axis[j], Alignment) };
+				for (uint i = Begin; i < End; i += Lanes)
+				{
+					Func(SLanes::Load(A + i), SLanes::Load(B + i)).Store(A + i);
+				}
+			}
+		});
+}
+
+
+template <uint Size, typename Type>
+template <typename Function>
+INLINE void STVectorArray<Size, Type>::Apply(const STVector<Size, Type>& Vector, Function Func)
+{
+	ForEachPiece([&](uint Begin, uint End)
+		{
+			for (uint j = 0; j < Size; ++j)
+			{
+				Type* A{ ASSUME_ALIGNED(Axis[j], Alignment) };
+				const SLanes B{ Vector[j] };
+				for (uint i = Begin; i < End; i += Lanes)
+				{
+					Func(SLanes::Load(A + i), B).Store(A + i);
+				}
+			}
+		});
+}
+
+
+template <uint Size, typename Type>
+INLINE void STVectorArray<Size, Type>::Reserve(uint NewCapacity)
+{
+	if (NewCapacity > Capacity) Reallocate(NewCapacity);
+}
+
+
+template <uint Size, typename Type>
+INLINE void STVectorArray<Size, Type>::Resize(uint NewCount)
+{
+	if (NewCount > Capacity)
+	{
+		Reallocate(NewCount);
+	}
+	else if (NewCount > Count)
+	{
+		for (uint i = 0; i < Size; ++i)
+		{
+			memset(Axis[i] + Count, 0, sizeof(Type) * (NewCount - Count));
+		}
+	}
+	Count = NewCount;
+}
+
+
+template <uint Size, typename Type>
+INLINE uint STVectorArray<Size, Type>::Add(const STVector<Size, Type>& Vector)
+{
+	if (Count == Capacity) Reallocate((Capacity > 0) ? Capacity * 2 : Granularity);
+	for (uint i = 0; i < Size; ++i)
+	{
+		Axis[i][Count] = Vector[i];
+	}
+	return Count++;
+}
+
+
+template <uint Size, typename Type>
+INLINE void STVectorArray<Size, Type>::ToArray(STVector<Size, Type>* Out) const
+{
+	for (uint i = 0; i < Count; ++i)
+	{
+		for (uint j = 0; j < Size; ++j)
+		{
+			Out[i][j] = Axis[j][i];
+		}
+	}
+}
+
+
+template <uint Size, typename Type>
+INLINE void STVectorArray<Size, Type>::DotProduct(const STVectorArray<Size, Type>& Other, Type* Out) const
+{
+	assert(Other.Count == Count);
+	ForEachPiece([&](uint Begin, uint End)
+		{
+			for (uint i = Begin; i < End; i += Lanes)
+			{
+				SLanes Result{ SLanes::Load(Axis[0] + i) * SLanes::Load(Other.Axis[0] + i) };
+				for (uint j = 1; j < Size; ++j)
+				{
+					Result = SLanes::Load(Axis[j] + i).MulAdd(SLanes::Load(Other.Axis[j] + i), Result);
+				}
+
+				if (LIKELY(i + Lanes <= Count))
+				{
+					Result.StoreUnaligned(Out + i);
+				}
+				else
+				{
+					alignas(Alignment) Type Tail[Lanes];
+					Result.Store(Tail);
+					memcpy(Out + i, Tail, sizeof(Type) * (Count - i));
+				}
+			}
+		});
+}
+
+
+template <uint Size, typename Type>
+INLINE void STVectorArray<Size, Type>::DotProduct(const STVector<Size, Type>& Vector, Type* Out) const
+{
+	ForEachPiece([&](uint Begin, uint End)
+		{
+			for (uint i = Begin; i < End; i += Lanes)
+			{
+				SLanes Result{ SLanes::Load(Axis[0] + i) * SLanes{ Vector[0] } };
+				for (uint j = 1; j < Size; ++j)
+				{
+					Result = SLanes::Load(Axis[j] + i).MulAdd(SLanes{ Vector[j] }, Result);
+				}
+
+				if (LIKELY(i + Lanes <= Count))
+				{
+					Result.StoreUnaligned(Out + i);
+				}
+				else
+				{
+					alignas(Alignment) Type Tail[Lanes];
+					Result.Store(Tail);
+					memcpy(Out + i, Tail, sizeof(Type) * (Count - i));
+				}
+			}
+		});
+}
+
+
+template <uint Size, typename Type>
+INLINE void STVectorArray<Size, Type>::CrossProduct(const STVectorArray<Size, Type>& Other, STVectorArray<Size, Type>& Out) const
+{
+	ASSERT(Size == 3, "Vector must have 3 dimenions to calculate the cross product.");
+	assert(Other.Count == Count);
+	if (&Out != this && &Out != &Other) Out.Resize(Count);
+
+	ForEachPiece([&](uint Begin, uint End)
+		{
+			for (uint i = Begin; i < End; i += Lanes)
+			{
+				const SLanes AX{ SLanes::Load(Axis[0] + i) }, AY{ SLanes::Load(Axis[1] + i) }, AZ{ SLanes::Load(Axis[2] + i) };
+				const SLanes BX{ SLanes::Load(Other.Axis[0] + i) }, BY{ SLanes::Load(Other.Axis[1] + i) }, BZ{ SLanes::Load(Other.Axis[2] + i) };
+				((AY * BZ) - (AZ * BY)).Store(Out.Axis[0] + i);
+				((AZ * BX) - (AX * BZ)).Store(Out.Axis[1] + i);
+				((AX * BY) - (AY * BX)).Store(Out.Axis[2] + i);
+			}
+		});
+}
+
+
+template <uint Size, typename Type>
+INLINE void STVectorArray<Size, Type>::Max(const STVectorArray<Size, Type>& Other)
+{
+	Apply(Other, [](const SLanes& A, const SLanes& B) { return A.Max(B); });
+}
+
+
+template <uint Size, typename Type>
+INLINE void STVectorArray<Size, Type>::Max(const STVector<Size, Type>& Vector)
+{
+	Apply(Vector, [](const SLanes& A, const SLanes& B) { return A.Max(B); });
+}
+
+
+template <uint Size, typename Type>
+INLINE void STVectorArray<Size, Type>::Min(const STVectorArray<Size, Type>& Other)
+{
+	Apply(Other, [](const SLanes& A, const SLanes& B) { return A.Min(B); });
+}
+
+
+template <uint Size, typename Type>
+INLINE void STVectorArray<Size, Type>::Min(const STVector<Size, Type>& Vector)
+{
+	Apply(Vector, [](const SLanes& A, const SLanes& B) { return A.Min(B); });
+}
+
+
+template <uint Size, typename Type>
+template <bool Fast>
+INLINE void STVectorArray<Size, Type>::NormalizeLanes(Type Tolerance)
+{
+	constexpr bool UseEstimate{ Fast && std::is_same<Type, float>::value };
+	const SLanes One{ (Type)1.0f };
+	const SLanes Limit{ UseEstimate ? TMath::Max(Tolerance, std::numeric_limits<Type>::min()) : Tolerance };
+	const SLanes High{ std::numeric_limits<Type>::max() };
+	ForEachPiece([&](uint Begin, uint End)
+		{
+			for (uint i = Begin; i < End; i += Lanes)
+			{
+				SLanes Components[Size];
+				SLanes SquareSum{ (Type)0.0f };
+				for (uint j = 0; j < Size; ++j)
+				{
+					Components[j] = SLanes::Load(Axis[j] + i);
+					SquareSum = Components[j].MulAdd(Components[j], SquareSum);
+				}
+
+				// Vectors too short to normalize, or whose squared length overflows, keep a scale of 1.
+				SLanes Scale;
+				if constexpr (UseEstimate) Scale = ((SquareSum > Limit) & (SquareSum <= High)).Select(TMath::FastInvSqrt(SquareSum), One);
+				else Scale = ((SquareSum > Limit) & (SquareSum <= High)).Select(One / SquareSum.Sqrt(), One);
+				for (uint j = 0; j < Size; ++j)
+				{
+					(Components[j] * Scale).Store(Axis[j] + i);
+				}
+			}
+		});
+}
+
+
+template <uint Size, typename Type>
+INLINE void STVectorArray<Size, Type>::nearlyEqual(const STVectorArray<Size, Type>& Other, bool* Out, const Type& Threshold) const
+{
+	assert(Other.Count == Count);
+	const SLanes Limit{ Threshold };
+	ForEachPiece([&](uint Begin, uint End)
+		{
+			for (uint i = Begin; i < End; i += Lanes)
+			{
+				SLanes Mask{ (SLanes::Load(Axis[0] + i) - SLanes::Load(Other.Axis[0] + i)).Abs() <= Limit };
+				for (uint j = 1; j < Size; ++j)
+				{
+					Mask = Mask & ((SLanes::Load(Axis[j] + i) - SLanes::Load(Other.Axis[j] + i)).Abs() <= Limit);
+				}
+
+				const uint Bits{ Mask.MoveMask() };
+				const uint Valid{ (i + Lanes < Count) ? Lanes : Count - i };
+				for (uint k = 0; k < Valid; ++k)
+				{
+					Out[i + k] = (Bits >> k) & 1;
+				}
+			}
+		});
+}
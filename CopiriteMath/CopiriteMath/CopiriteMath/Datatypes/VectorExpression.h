@@ -0,0 +1,402 @@
+#pragma once
+#include "Vector.h"
+#include "VectorArray.h"
+#include <atomic>
+#include <type_traits>
+
+
+
+// Opt-in expression templates for vector arithmetic.
+// Wrapping an operand with Lazy() makes +, -, * and / build an expression instead of a vector, the expression is
+// evaluated in a single fused pass with a single NaN check when it is converted to a STVector or evaluated into a STVectorArray.
+//
+//	SVector Result = Lazy(A) + Lazy(B) * 2.0f - C;
+//	(Lazy(Positions) + Lazy(Velocities) * DeltaTime).Evaluate(Positions);
+//
+// @note - Expressions reference their operands, they must be evaluated before the operands go out of scope.
+
+
+
+// The base of every expression node, used to detect expressions in the operator overloads.
+struct SVectorExpressionBase
+{};
+
+
+// The interface shared by all expression nodes.
+// @template Derived - The expression node type.
+// @template Size - How many dimensions the expression's result has.
+// @template Type - The datatype the expression's result uses.
+template <typename Derived, uint Size, typename Type>
+struct TVectorExpression : public SVectorExpressionBase
+{
+	// How many dimensions the expression's result has.
+	static constexpr uint ExpressionSize{ Size };
+
+	// The datatype the expression's result uses.
+	typedef Type ExpressionType;
+
+	// The SIMD backend used when evaluating into a single vector.
+	typedef TVectorSIMD<Size, Type> SIMD;
+
+	// The lanes used when evaluating into an array.
+	typedef typename STVectorArray<Size, Type>::SLanes SLanes;
+
+
+	/// Operators
+
+	// Operator, Evaluates this expression into a vector.
+	INLINE operator STVector<Size, Type>() const { return Evaluate(); }
+
+
+	/// Functions
+
+	// Evaluates this expression into a vector.
+	// @note - The expression must not contain any arrays.
+	// @param Location - Where the expression is evaluated, reported if the result contains NaN.
+	// @return - The resulting vector.
+	INLINE STVector<Size, Type> Evaluate(const std::source_location& Location = std::source_location::current()) const;
+
+	// Evaluates this expression for every element of the arrays it contains, split across the thread pool when it is long.
+	// @note - Every array in the expression must have the same number of elements, nothing is written otherwise.
+	// Under the Sanitize policy every resulting vector that contains NaN is set to vector0.
+	// @param Out - The array to store the results in, may be one of the expression's own operands.
+	// @param Location - Where the expression is evaluated, reported if any result contains NaN.
+	// @return - Whether the arrays' lengths matched and the expression was evaluated.
+	INLINE bool Evaluate(STVectorArray<Size, Type>& Out, const std::source_location& Location = std::source_location::current()) const;
+};
+
+
+
+// An expression leaf that reads a vector.
+template <uint Size, typename Type>
+struct TVectorLeaf : public TVectorExpression<TVectorLeaf<Size, Type>, Size, Type>
+{
+	typedef TVectorExpression<TVectorLeaf<Size, Type>, Size, Type> Super;
+
+	// Does this expression contain an array.
+	static constexpr bool IsArray{ false };
+
+	// The referenced vector.
+	const STVector<Size, Type>& Vector;
+
+	INLINE TVectorLeaf(const STVector<Size, Type>& InVector) :Vector{ InVector } {}
+
+	INLINE uint Num() const { return 0; }
+	INLINE bool Matches(uint) const { return true; }
+	INLINE Type Get(uint Index) const { return Vector[Index]; }
+	INLINE auto Load() const { return Super::SIMD::Load(Vector.GetData()); }
+	INLINE typename Super::SLanes LoadLanes(uint Axis, uint) const { return typename Super::SLanes{ Vector[Axis] }; }
+};
+
+
+// An expression leaf that reads a single value for every component.
+template <uint Size, typename Type>
+struct TVectorScalarLeaf : public TVectorExpression<TVectorScalarLeaf<Size, Type>, Size, Type>
+{
+	typedef TVectorExpression<TVectorScalarLeaf<Size, Type>, Size, Type> Super;
+
+	// Does this expression contain an array.
+	static constexpr bool IsArray{ false };
+
+	// The value of every component.
+	Type Value;
+
+	INLINE TVectorScalarLeaf(Type InValue) :Value{ InValue } {}
+
+	INLINE uint Num() const { return 0; }
+	INLINE bool Matches(uint) const { return true; }
+	INLINE Type Get(uint) const { return Value; }
+	INLINE auto Load() const { return Super::SIMD::Set(Value); }
+	INLINE typename Super::SLanes LoadLanes(uint, uint) const { return typename Super::SLanes{ Value }; }
+};
+
+
+// An expression leaf that reads every element of an array.
+template <uint Size, typename Type>
+struct TVectorArrayLeaf : public TVectorExpression<TVectorArrayLeaf<Size, Type>, Size, Type>
+{
+	typedef TVectorExpression<TVectorArrayLeaf<Size, Type>, Size, Type> Super;
+
+	// Does this expression contain an array.
+	static constexpr bool IsArray{ true };
+
+	// The referenced array.
+	const STVectorArray<Size, Type>& Array;
+
+	INLINE TVectorArrayLeaf(const STVectorArray<Size, Type>& InArray) :Array{ InArray } {}
+
+	INLINE uint Num() const { return Array.Num(); }
+	INLINE bool Matches(uint Count) const { return Array.Num() == Count; }
+	INLINE typename Super::SLanes LoadLanes(uint Axis, uint Index) const { return Super::SLanes::Load(Array.GetAxis(Axis) + Index); }
+};
+
+
+// An expression node that combines two expressions component-wise.
+// @template Operation - The operation applied to each component.
+template <typename Operation, typename Left, typename Right>
+struct TVectorBinary : public TVectorExpression<TVectorBinary<Operation, Left, Right>, Left::ExpressionSize, typename Left::ExpressionType>
+{
+	typedef TVectorExpression<TVectorBinary<Operation, Left, Right>, Left::ExpressionSize, typename Left::ExpressionType> Super;
+
+	// Does this expression contain an array.
+	static constexpr bool IsArray{ Left::IsArray || Right::IsArray };
+
+	Left A;
+	Right B;
+
+	INLINE TVectorBinary(const Left& InA, const Right& InB) :A{ InA }, B{ InB } {}
+
+	INLINE uint Num() const { return (A.Num() > B.Num()) ? A.Num() : B.Num(); }
+	INLINE bool Matches(uint Count) const { return A.Matches(Count) && B.Matches(Count); }
+	INLINE typename Super::ExpressionType Get(uint Index) const { return Operation::Apply(A.Get(Index), B.Get(Index)); }
+	INLINE auto Load() const { return Operation::template ApplySIMD<typename Super::SIMD>(A.Load(), B.Load()); }
+	INLINE typename Super::SLanes LoadLanes(uint Axis, uint Index) const { return Operation::Apply(A.LoadLanes(Axis, Index), B.LoadLanes(Axis, Index)); }
+};
+
+
+// An expression node that negates an expression.
+template <typename Inner>
+struct TVectorNegate : public TVectorExpression<TVectorNegate<Inner>, Inner::ExpressionSize, typename Inner::ExpressionType>
+{
+	typedef TVectorExpression<TVectorNegate<Inner>, Inner::ExpressionSize, typename Inner::ExpressionType> Super;
+
+	// Does this expression contain an array.
+	static constexpr bool IsArray{ Inner::IsArray };
+
+	Inner A;
+
+	INLINE TVectorNegate(const Inner& InA) :A{ InA } {}
+
+	INLINE uint Num() const { return A.Num(); }
+	INLINE bool Matches(uint Count) const { return A.Matches(Count); }
+	INLINE typename Super::ExpressionType Get(uint Index) const { return -A.Get(Index); }
+	INLINE auto Load() const { return Super::SIMD::Negate(A.Load()); }
+	INLINE typename Super::SLanes LoadLanes(uint Axis, uint Index) const { return -A.LoadLanes(Axis, Index); }
+};
+
+
+
+// The component-wise operations used by TVectorBinary.
+struct SVectorAddOperation
+{
+	template <typename T> static INLINE T Apply(const T& A, const T& B) { return A + B; }
+	template <typename SIMD, typename R> static INLINE R ApplySIMD(R A, R B) { return SIMD::Add(A, B); }
+};
+
+struct SVectorSubOperation
+{
+	template <typename T> static INLINE T Apply(const T& A, const T& B) { return A - B; }
+	template <typename SIMD, typename R> static INLINE R ApplySIMD(R A, R B) { return SIMD::Sub(A, B); }
+};
+
+struct SVectorMulOperation
+{
+	template <typename T> static INLINE T Apply(const T& A, const T& B) { return A * B; }
+	template <typename SIMD, typename R> static INLINE R ApplySIMD(R A, R B) { return SIMD::Mul(A, B); }
+};
+
+struct SVectorDivOperation
+{
+	template <typename T> static INLINE T Apply(const T& A, const T& B) { return A / B; }
+	template <typename SIMD, typename R> static INLINE R ApplySIMD(R A, R B) { return SIMD::Div(A, B); }
+};
+
+
+
+// Converts an operand into an expression node.
+// @template Operand - The operand's type.
+// @template Size - The size of the expression the operand is used in.
+// @template Type - The datatype of the expression the operand is used in.
+template <typename Operand, uint Size, typename Type, typename Enable = void>
+struct TToVectorExpression
+{
+	// Any other operand is a value used for every component.
+	typedef TVectorScalarLeaf<Size, Type> Result;
+	static INLINE Result Make(const Operand& Value) { return Result{ (Type)Value }; }
+};
+
+template <typename Operand, uint Size, typename Type>
+struct TToVectorExpression<Operand, Size, Type, typename std::enable_if<std::is_base_of<SVectorExpressionBase, Operand>::value>::type>
+{
+	typedef Operand Result;
+	static INLINE const Result& Make(const Operand& Expression) { return Expression; }
+};
+
+template <uint Size, typename Type>
+struct TToVectorExpression<STVector<Size, Type>, Size, Type>
+{
+	typedef TVectorLeaf<Size, Type> Result;
+	static INLINE Result Make(const STVector<Size, Type>& Vector) { return Result{ Vector }; }
+};
+
+template <uint Size, typename Type>
+struct TToVectorExpression<STVectorArray<Size, Type>, Size, Type>
+{
+	typedef TVectorArrayLeaf<Size, Type> Result;
+	static INLINE Result Make(const STVectorArray<Size, Type>& Array) { return Result{ Array }; }
+};
+
+
+// Finds the expression in a pair of operands, at least one of which is an expression.
+template <typename A, typename B>
+struct TVectorExpressionPair
+{
+	typedef typename std::conditional<std::is_base_of<SVectorExpressionBase, A>::value, A, B>::type Expression;
+	static constexpr uint Size{ Expression::ExpressionSize };
+	typedef typename Expression::ExpressionType Type;
+	typedef typename TToVectorExpression<A, Size, Type>::Result Left;
+	typedef typename TToVectorExpression<B, Size, Type>::Result Right;
+};
+
+
+// Is either of two operands an expression.
+template <typename A, typename B>
+using TEnableIfVectorExpression = typename std::enable_if<std::is_base_of<SVectorExpressionBase, A>::value || std::is_base_of<SVectorExpressionBase, B>::value, int>::type;
+
+
+
+// Starts an expression with a vector.
+// @param Vector - The vector to use in the expression.
+// @return - The expression leaf.
+template <uint Size, typename Type>
+INLINE TVectorLeaf<Size, Type> Lazy(const STVector<Size, Type>& Vector)
+{
+	return TVectorLeaf<Size, Type>{ Vector };
+}
+
+
+// Starts an expression with an array, the expression is evaluated for every element.
+// @param Array - The array to use in the expression.
+// @return - The expression leaf.
+template <uint Size, typename Type>
+INLINE TVectorArrayLeaf<Size, Type> Lazy(const STVectorArray<Size, Type>& Array)
+{
+	return TVectorArrayLeaf<Size, Type>{ Array };
+}
+
+
+// Operator, Builds the addition of two operands where at least one is an expression.
+template <typename A, typename B, TEnableIfVectorExpression<A, B> = 0>
+INLINE auto operator+(const A& Left, const B& Right)
+{
+	typedef TVectorExpressionPair<A, B> Pair;
+	return TVectorBinary<SVectorAddOperation, typename Pair::Left, typename Pair::Right>{ TToVectorExpression<A, Pair::Size, typename Pair::Type>::Make(Left), TToVectorExpression<B, Pair::Size, typename Pair::Type>::Make(Right) };
+}
+
+
+// Operator, Builds the subtraction of two operands where at least one is an expression.
+template <typename A, typename B, TEnableIfVectorExpression<A, B> = 0>
+INLINE auto operator-(const A& Left, const B& Right)
+{
+	typedef TVectorExpressionPair<A, B> Pair;
+	return TVectorBinary<SVectorSubOperation, typename Pair::Left, typename Pair::Right>{ TToVectorExpression<A, Pair::Size, typename Pair::Type>::Make(Left), TToVectorExpression<B, Pair::Size, typename Pair::Type>::Make(Right) };
+}
+
+
+// Operator, Builds the multiplication of two operands where at least one is an expression.
+template <typename A, typename B, TEnableIfVectorExpression<A, B> = 0>
+INLINE auto operator*(const A& Left, const B& Right)
+{
+	typedef TVectorExpressionPair<A, B> Pair;
+	return TVectorBinary<SVectorMulOperation, typename Pair::Left, typename Pair::Right>{ TToVectorExpression<A, Pair::Size, typename Pair::Type>::Make(Left), TToVectorExpression<B, Pair::Size, typename Pair::Type>::Make(Right) };
+}
+
+
+// Operator, Builds the division of two operands where at least one is an expression.
+template <typename A, typename B, TEnableIfVectorExpression<A, B> = 0>
+INLINE auto operator/(const A& Left, const B& Right)
+{
+	typedef TVectorExpressionPair<A, B> Pair;
+	return TVectorBinary<SVectorDivOperation, typename Pair::Left, typename Pair::Right>{ TToVectorExpression<A, Pair::Size, typename Pair::Type>::Make(Left), TToVectorExpression<B, Pair::Size, typename Pair::Type>::Make(Right) };
+}
+
+
+// Operator, Builds the negation of an expression.
+template <typename A, TEnableIfVectorExpression<A, A> = 0>
+INLINE TVectorNegate<A> operator-(const A& Expression)
+{
+	return TVectorNegate<A>{ Expression };
+}
+
+
+
+template <typename Derived, uint Size, typename Type>
+INLINE STVector<Size, Type> TVectorExpression<Derived, Size, Type>::Evaluate(const std::source_location& Location) const
+{
+	ASSERT(!Derived::IsArray, "Expressions containing arrays must be evaluated into an array.");
+	const Derived& Expression{ static_cast<const Derived&>(*this) };
+	STVector<Size, Type> Result;
+	if constexpr (SIMD::Enabled)
+	{
+		SIMD::Store(Result.GetData(), Expression.Load());
+	}
+	else
+	{
+		for (uint i = 0; i < Size; ++i)
+		{
+			Result[i] = Expression.Get(i);
+		}
+	}
+	Result.CheckNaN(EMathOperation::Check, Location);
+	return Result;
+}
+
+
+template <typename Derived, uint Size, typename Type>
+INLINE bool TVectorExpression<Derived, Size, Type>::Evaluate(STVectorArray<Size, Type>& Out, const std::source_location& Location) const
+{
+	ASSERT(Derived::IsArray, "Expressions without arrays must be evaluated into a vector.");
+	const Derived& Expression{ static_cast<const Derived&>(*this) };
+	const uint Count{ Expression.Num() };
+
+	// A shorter operand would be read past its end, and resizing an operand used as the destination would move its storage.
+	// Once every operand has Count elements, Out either is one of them or is a separate array that can safely be resized.
+	if (!Expression.Matches(Count)) return false;
+
+	Out.Resize(Count);
+	constexpr bool CheckNaN{ SNaNPolicy::Enabled && std::is_floating_point<Type>::value };
+	std::atomic<bool> FoundNaN{ false };
+	Out.ForEachPiece([&](uint Begin, uint End)
+		{
+			for (uint j = 0; j < Size; ++j)
+			{
+				Type* Axis{ Out.GetAxis(j) };
+				for (uint i = Begin; i < End; i += SLanes::Lanes)
+				{
+					Expression.LoadLanes(j, i).Store(Axis + i);
+				}
+			}
+
+			// Each piece only looks for NaN, the single report is made once every piece has finished.
+			if constexpr (CheckNaN)
+			{
+				const SLanes Zero{ (Type)0.0f };
+				for (uint i = Begin; i < End; i += SLanes::Lanes)
+				{
+					SLanes NonFinite{ Zero != Zero };
+					for (uint j = 0; j < Size; ++j)
+					{
+						const SLanes Values{ SLanes::Load(Out.GetAxis(j) + i) };
+						NonFinite = NonFinite | ((Values - Values) != Zero);
+					}
+					const uint Valid{ (End - i < SLanes::Lanes) ? End - i : SLanes::Lanes };
+					if (NonFinite.MoveMask() & ((Valid < 32) ? (1u << Valid) - 1 : ~0u)) FoundNaN.store(true, std::memory_order_relaxed);
+				}
+			}
+		});
+
+	SInstrumentation::CountOperation(EMathOperation::Check);
+	if constexpr (CheckNaN)
+	{
+		if (FoundNaN.load(std::memory_order_relaxed) && SNaNPolicy::OnNaN("VectorArray", EMathOperation::Check, Location))
+		{
+			for (uint i = 0; i < Count; ++i)
+			{
+				bool Finite{ true };
+				for (uint j = 0; j < Size; ++j) Finite &= TMath::IsFinite(Out.GetAxis(j)[i]);
+				if (!Finite) Out[i] = STVector<Size, Type>{ (Type)0.0f };
+			}
+		}
+	}
+	return true;
+}
@@ -0,0 +1,473 @@
+#pragma once
+#include "../Math/Fixed.h"
+#include "../Math/SIMD.h"
+
+
+
+// The memory alignment used by a vector's components.
+// Vectors that fill an entire SIMD register are aligned to that register so they can be loaded with a single instruction.
+// @note - This is independent of the enabled instruction sets so the layout of a vector never changes between builds.
+// Defining COPIRITE_PAD_VECTOR3 pads SVector to 16 bytes so it loads and stores as a single aligned register, at the cost of a third more memory.
+// @template Size - How many dimensions the vector has.
+// @template Type - The datatype the vector uses.
+template <uint Size, typename Type>
+struct TVectorAlignment
+{
+	static constexpr uint Value{ alignof(Type) };
+};
+
+#if defined(COPIRITE_PAD_VECTOR3)
+template <>
+struct TVectorAlignment<3, float>
+{
+	static constexpr uint Value{ 16 };
+};
+#endif
+
+template <>
+struct TVectorAlignment<4, float>
+{
+	static constexpr uint Value{ 16 };
+};
+
+template <>
+struct TVectorAlignment<4, double>
+{
+	static constexpr uint Value{ 32 };
+};
+
+template <>
+struct TVectorAlignment<4, SFixed>
+{
+	static constexpr uint Value{ 16 };
+};
+
+template <>
+struct TVectorAlignment<4, SFixedd>
+{
+	static constexpr uint Value{ 32 };
+};
+
+
+
+// The SIMD backend used by STVector's component-wise operations.
+// Vectors without a specialization fall back to STVector's scalar loops.
+// @template Size - How many dimensions the vector has.
+// @template Type - The datatype the vector uses.
+template <uint Size, typename Type>
+struct TVectorSIMD
+{
+	// Does this vector type have a SIMD implementation.
+	static constexpr bool Enabled{ false };
+};
+
+
+
+#if defined(COPIRITE_SSE2)
+
+// Shared implementation of the float vector backends, the loading and storing is provided by the vector size.
+// @template Lanes - How many of the register's lanes are used by the vector.
+template <uint Lanes>
+struct TVectorSIMDFloat
+{
+	typedef __m128 Register;
+
+	// Does this vector type have a SIMD implementation.
+	static constexpr bool Enabled{ true };
+
+	// The movemask bits of the lanes used by the vector.
+	static constexpr int LaneMask{ (1 << Lanes) - 1 };
+
+	// Creates a register with all lanes set to a value.
+	// @param Value - The value to give every lane.
+	// @return - The resulting register.
+	static INLINE Register Set(float Value) { return _mm_set1_ps(Value); }
+
+	// Creates a register from the value of each lane.
+	static INLINE Register Set(float X, float Y, float Z, float W) { return _mm_setr_ps(X, Y, Z, W); }
+
+	static INLINE Register Add(Register A, Register B) { return _mm_add_ps(A, B); }
+	static INLINE Register Sub(Register A, Register B) { return _mm_sub_ps(A, B); }
+	static INLINE Register Mul(Register A, Register B) { return _mm_mul_ps(A, B); }
+	static INLINE Register Div(Register A, Register B) { return _mm_div_ps(A, B); }
+	static INLINE Register Min(Register A, Register B) { return _mm_min_ps(A, B); }
+	static INLINE Register Max(Register A, Register B) { return _mm_max_ps(A, B); }
+	static INLINE Register Xor(Register A, Register B) { return _mm_xor_ps(A, B); }
+
+	// Negates every lane by flipping the sign bit.
+	// @param A - The register to negate.
+	// @return - The resulting register.
+	static INLINE Register Negate(Register A) { return _mm_xor_ps(A, _mm_set1_ps(-0.0f)); }
+
+	// Copies one lane of a register into every lane.
+	// @template Lane - The lane to copy.
+	// @param A - The register to copy from.
+	// @return - The resulting register.
+	template <uint Lane>
+	static INLINE Register Splat(Register A) { return _mm_shuffle_ps(A, A, _MM_SHUFFLE(Lane, Lane, Lane, Lane)); }
+
+	// Rearranges the lanes of a register.
+	// @template X, Y, Z, W - The lane of the input register that each lane of the result is copied from.
+	template <uint X, uint Y, uint Z, uint W>
+	static INLINE Register Swizzle(Register A) { return _mm_shuffle_ps(A, A, _MM_SHUFFLE(W, Z, Y, X)); }
+
+	// Transposes 4 registers as the rows of a 4x4 matrix.
+	static INLINE void Transpose(Register& A, Register& B, Register& C, Register& D) { _MM_TRANSPOSE4_PS(A, B, C, D); }
+
+	// Calculates the dot product of the used lanes.
+	// @param A - The first register.
+	// @param B - The second register.
+	// @return - The resulting dot product.
+	static INLINE float Dot(Register A, Register B)
+	{
+#if defined(COPIRITE_SSE41)
+		return _mm_cvtss_f32(_mm_dp_ps(A, B, (LaneMask << 4) | 0x1));
+#else
+		Register M{ _mm_mul_ps(A, B) };
+		if (Lanes == 3) M = _mm_and_ps(M, _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1)));
+		Register S{ _mm_add_ps(M, _mm_movehl_ps(M, M)) };
+		return _mm_cvtss_f32(_mm_add_ss(S, _mm_shuffle_ps(S, S, _MM_SHUFFLE(1, 1, 1, 1))));
+#endif
+	}
+
+	// Calculates the cross product of the X, Y and Z lanes, the W lane is left as zero.
+	// @param A - The first register.
+	// @param B - The second register.
+	// @return - The resulting register.
+	static INLINE Register Cross(Register A, Register B)
+	{
+		Register AYZX{ _mm_shuffle_ps(A, A, _MM_SHUFFLE(3, 0, 2, 1)) };
+		Register BYZX{ _mm_shuffle_ps(B, B, _MM_SHUFFLE(3, 0, 2, 1)) };
+		Register C{ _mm_sub_ps(_mm_mul_ps(A, BYZX), _mm_mul_ps(AYZX, B)) };
+
+		// The W lane is masked rather than left to cancel, a compiler contracting the multiply and subtract leaves the rounding error of W * W.
+		C = _mm_and_ps(C, _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1)));
+		return _mm_shuffle_ps(C, C, _MM_SHUFFLE(3, 0, 2, 1));
+	}
+
+	// Tests if all the used lanes are neither NaN nor infinite.
+	// @param A - The register to test.
+	// @return - True if every used lane is finite.
+	static INLINE bool AllFinite(Register A)
+	{
+		// X - X is only NaN when X is NaN or infinite.
+		return (_mm_movemask_ps(_mm_cmpord_ps(_mm_sub_ps(A, A), _mm_setzero_ps())) & LaneMask) == LaneMask;
+	}
+};
+
+
+template <>
+struct TVectorSIMD<4, float> : public TVectorSIMDFloat<4>
+{
+	// Loads a vector's components into a register.
+	// @param V - The vector's aligned components.
+	// @return - The resulting register.
+	static INLINE Register Load(const float* V) { return _mm_load_ps(V); }
+
+	// Stores a register into a vector's components.
+	// @param V - The vector's aligned components.
+	// @param R - The register to store.
+	static INLINE void Store(float* V, Register R) { _mm_store_ps(V, R); }
+};
+
+
+#if defined(COPIRITE_PAD_VECTOR3)
+
+// SVector is padded to 16 bytes, the W lane is loaded as zero and written into the padding.
+template <>
+struct TVectorSIMD<3, float> : public TVectorSIMDFloat<3>
+{
+	static INLINE Register Load(const float* V)
+	{
+		return _mm_and_ps(_mm_load_ps(V), _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1)));
+	}
+
+	static INLINE void Store(float* V, Register R) { _mm_store_ps(V, R); }
+};
+
+#else
+
+// SVector is 12 bytes and not padded, the W lane is loaded as zero and never written back.
+template <>
+struct TVectorSIMD<3, float> : public TVectorSIMDFloat<3>
+{
+	static INLINE Register Load(const float* V)
+	{
+		return _mm_movelh_ps(_mm_castsi128_ps(_mm_loadl_epi64((const __m128i*)V)), _mm_load_ss(V + 2));
+	}
+
+	static INLINE void Store(float* V, Register R)
+	{
+		_mm_storel_epi64((__m128i*)V, _mm_castps_si128(R));
+		_mm_store_ss(V + 2, _mm_movehl_ps(R, R));
+	}
+};
+
+#endif // COPIRITE_PAD_VECTOR3
+
+#endif // COPIRITE_SSE2
+
+
+#if defined(COPIRITE_AVX)
+
+template <>
+struct TVectorSIMD<4, double>
+{
+	typedef __m256d Register;
+
+	// Does this vector type have a SIMD implementation.
+	static constexpr bool Enabled{ true };
+
+	static INLINE Register Load(const double* V) { return _mm256_load_pd(V); }
+	static INLINE void Store(double* V, Register R) { _mm256_store_pd(V, R); }
+	static INLINE Register Set(double Value) { return _mm256_set1_pd(Value); }
+
+	static INLINE Register Add(Register A, Register B) { return _mm256_add_pd(A, B); }
+	static INLINE Register Sub(Register A, Register B) { return _mm256_sub_pd(A, B); }
+	static INLINE Register Mul(Register A, Register B) { return _mm256_mul_pd(A, B); }
+	static INLINE Register Div(Register A, Register B) { return _mm256_div_pd(A, B); }
+	static INLINE Register Min(Register A, Register B) { return _mm256_min_pd(A, B); }
+	static INLINE Register Max(Register A, Register B) { return _mm256_max_pd(A, B); }
+	static INLINE Register Negate(Register A) { return _mm256_xor_pd(A, _mm256_set1_pd(-0.0)); }
+
+	template <uint Lane>
+	static INLINE Register Splat(Register A)
+	{
+		__m256d Half{ _mm256_permute2f128_pd(A, A, (Lane < 2) ? 0x00 : 0x11) };
+		return _mm256_permute_pd(Half, (Lane & 1) ? 0xF : 0x0);
+	}
+
+	static INLINE void Transpose(Register& A, Register& B, Register& C, Register& D)
+	{
+		__m256d AB0{ _mm256_unpacklo_pd(A, B) };
+		__m256d AB1{ _mm256_unpackhi_pd(A, B) };
+		__m256d CD0{ _mm256_unpacklo_pd(C, D) };
+		__m256d CD1{ _mm256_unpackhi_pd(C, D) };
+		A = _mm256_permute2f128_pd(AB0, CD0, 0x20);
+		B = _mm256_permute2f128_pd(AB1, CD1, 0x20);
+		C = _mm256_permute2f128_pd(AB0, CD0, 0x31);
+		D = _mm256_permute2f128_pd(AB1, CD1, 0x31);
+	}
+
+	static INLINE double Dot(Register A, Register B)
+	{
+		Register M{ _mm256_mul_pd(A, B) };
+		__m128d S{ _mm_add_pd(_mm256_castpd256_pd128(M), _mm256_extractf128_pd(M, 1)) };
+		return _mm_cvtsd_f64(_mm_add_sd(S, _mm_unpackhi_pd(S, S)));
+	}
+
+	static INLINE Register Cross(Register A, Register B)
+	{
+#if defined(COPIRITE_AVX2)
+		Register AYZX{ _mm256_permute4x64_pd(A, _MM_SHUFFLE(3, 0, 2, 1)) };
+		Register BYZX{ _mm256_permute4x64_pd(B, _MM_SHUFFLE(3, 0, 2, 1)) };
+		Register C{ _mm256_blend_pd(_mm256_sub_pd(_mm256_mul_pd(A, BYZX), _mm256_mul_pd(AYZX, B)), _mm256_setzero_pd(), 0x8) };
+		return _mm256_permute4x64_pd(C, _MM_SHUFFLE(3, 0, 2, 1));
+#else
+		alignas(32) double VA[4], VB[4];
+		_mm256_store_pd(VA, A);
+		_mm256_store_pd(VB, B);
+		return _mm256_set_pd(0.0, (VA[0] * VB[1]) - (VA[1] * VB[0]), (VA[2] * VB[0]) - (VA[0] * VB[2]), (VA[1] * VB[2]) - (VA[2] * VB[1]));
+#endif
+	}
+
+	static INLINE bool AllFinite(Register A)
+	{
+		return _mm256_movemask_pd(_mm256_cmp_pd(_mm256_sub_pd(A, A), _mm256_setzero_pd(), _CMP_ORD_Q)) == 0xF;
+	}
+};
+
+#endif // COPIRITE_AVX
+
+
+#if defined(COPIRITE_SSE2)
+
+// Q16.16 vectors in the 32-bit integer lanes of a register, every result is bit identical to SFixed's.
+template <>
+struct TVectorSIMD<4, SFixed>
+{
+	typedef __m128i Register;
+
+	// Does this vector type have a SIMD implementation.
+	static constexpr bool Enabled{ true };
+
+	static INLINE Register Load(const SFixed* V) { return _mm_load_si128((const __m128i*)V); }
+	static INLINE void Store(SFixed* V, Register R) { _mm_store_si128((__m128i*)V, R); }
+	static INLINE Register Set(SFixed Value) { return _mm_set1_epi32(Value.Bits); }
+
+	static INLINE Register Add(Register A, Register B) { return _mm_add_epi32(A, B); }
+	static INLINE Register Sub(Register A, Register B) { return _mm_sub_epi32(A, B); }
+	static INLINE Register Negate(Register A) { return _mm_sub_epi32(_mm_setzero_si128(), A); }
+
+	// Multiplies lanes 0 and 2 into 64-bit products, rounded and shifted so the low 32 bits of each are the result.
+	static INLINE Register MulEven(Register A, Register B)
+	{
+#if defined(COPIRITE_SSE41)
+		const __m128i Product{ _mm_mul_epi32(A, B) };
+#else
+		// The unsigned product becomes the signed one by subtracting the other factor from the high half for each negative factor.
+		const __m128i Correction{ _mm_add_epi32(_mm_and_si128(_mm_srai_epi32(A, 31), B), _mm_and_si128(_mm_srai_epi32(B, 31), A)) };
+		const __m128i Product{ _mm_sub_epi64(_mm_mul_epu32(A, B), _mm_slli_epi64(Correction, 32)) };
+#endif
+		return _mm_srli_epi64(_mm_add_epi64(Product, _mm_set1_epi64x(1ll << 15)), 16);
+	}
+
+	static INLINE Register Mul(Register A, Register B)
+	{
+#if defined(COPIRITE_AVX2)
+		// Widened to 64-bit lanes, bits 16 to 47 of the rounded product are the result whatever its sign.
+		const __m256i Product{ _mm256_mul_epi32(_mm256_cvtepi32_epi64(A), _mm256_cvtepi32_epi64(B)) };
+		const __m256i Shifted{ _mm256_srli_epi64(_mm256_add_epi64(Product, _mm256_set1_epi64x(1ll << 15)), 16) };
+		return _mm256_castsi256_si128(_mm256_permutevar8x32_epi32(Shifted, _mm256_setr_epi32(0, 2, 4, 6, 0, 2, 4, 6)));
+#else
+		const __m128i Even{ MulEven(A, B) }, Odd{ MulEven(_mm_srli_epi64(A, 32), _mm_srli_epi64(B, 32)) };
+		return _mm_unpacklo_epi32(_mm_shuffle_epi32(Even, _MM_SHUFFLE(3, 1, 2, 0)), _mm_shuffle_epi32(Odd, _MM_SHUFFLE(3, 1, 2, 0)));
+#endif
+	}
+
+	// There is no integer division instruction, each lane is divided on its own.
+	static INLINE Register Div(Register A, Register B)
+	{
+		alignas(16) SFixed VA[4], VB[4];
+		Store(VA, A);
+		Store(VB, B);
+		for (uint i = 0; i < 4; ++i) VA[i] /= VB[i];
+		return Load(VA);
+	}
+
+	static INLINE Register Min(Register A, Register B)
+	{
+#if defined(COPIRITE_SSE41)
+		return _mm_min_epi32(A, B);
+#else
+		const __m128i Greater{ _mm_cmpgt_epi32(A, B) };
+		return _mm_or_si128(_mm_and_si128(Greater, B), _mm_andnot_si128(Greater, A));
+#endif
+	}
+
+	static INLINE Register Max(Register A, Register B)
+	{
+#if defined(COPIRITE_SSE41)
+		return _mm_max_epi32(A, B);
+#else
+		const __m128i Greater{ _mm_cmpgt_epi32(A, B) };
+		return _mm_or_si128(_mm_and_si128(Greater, A), _mm_andnot_si128(Greater, B));
+#endif
+	}
+
+	template <uint Lane>
+	static INLINE Register Splat(Register A) { return _mm_shuffle_epi32(A, _MM_SHUFFLE(Lane, Lane, Lane, Lane)); }
+
+	static INLINE void Transpose(Register& A, Register& B, Register& C, Register& D)
+	{
+		const __m128i AB0{ _mm_unpacklo_epi32(A, B) }, AB1{ _mm_unpackhi_epi32(A, B) };
+		const __m128i CD0{ _mm_unpacklo_epi32(C, D) }, CD1{ _mm_unpackhi_epi32(C, D) };
+		A = _mm_unpacklo_epi64(AB0, CD0);
+		B = _mm_unpackhi_epi64(AB0, CD0);
+		C = _mm_unpacklo_epi64(AB1, CD1);
+		D = _mm_unpackhi_epi64(AB1, CD1);
+	}
+
+	// Integer addition wraps the same in any order, so summing the rounded products matches the scalar loop.
+	static INLINE SFixed Dot(Register A, Register B)
+	{
+		__m128i Sum{ Mul(A, B) };
+		Sum = _mm_add_epi32(Sum, _mm_shuffle_epi32(Sum, _MM_SHUFFLE(1, 0, 3, 2)));
+		Sum = _mm_add_epi32(Sum, _mm_shuffle_epi32(Sum, _MM_SHUFFLE(2, 3, 0, 1)));
+		return SFixed::FromBits(_mm_cvtsi128_si32(Sum));
+	}
+
+	static INLINE Register Cross(Register A, Register B)
+	{
+		const __m128i AYZX{ _mm_shuffle_epi32(A, _MM_SHUFFLE(3, 0, 2, 1)) };
+		const __m128i BYZX{ _mm_shuffle_epi32(B, _MM_SHUFFLE(3, 0, 2, 1)) };
+		const __m128i C{ Sub(Mul(A, BYZX), Mul(AYZX, B)) };
+		return _mm_shuffle_epi32(C, _MM_SHUFFLE(3, 0, 2, 1));
+	}
+
+	// Fixed point numbers are always finite.
+	static INLINE bool AllFinite(Register) { return true; }
+};
+
+#endif // COPIRITE_SSE2
+
+
+#if defined(COPIRITE_AVX2)
+
+// Q32.32 vectors in the 64-bit integer lanes of a register, every result is bit identical to SFixedd's.
+template <>
+struct TVectorSIMD<4, SFixedd>
+{
+	typedef __m256i Register;
+
+	// Does this vector type have a SIMD implementation.
+	static constexpr bool Enabled{ true };
+
+	static INLINE Register Load(const SFixedd* V) { return _mm256_load_si256((const __m256i*)V); }
+	static INLINE void Store(SFixedd* V, Register R) { _mm256_store_si256((__m256i*)V, R); }
+	static INLINE Register Set(SFixedd Value) { return _mm256_set1_epi64x(Value.Bits); }
+
+	static INLINE Register Add(Register A, Register B) { return _mm256_add_epi64(A, B); }
+	static INLINE Register Sub(Register A, Register B) { return _mm256_sub_epi64(A, B); }
+	static INLINE Register Negate(Register A) { return _mm256_sub_epi64(_mm256_setzero_si256(), A); }
+
+	// (A * B + 2^31) >> 32 from 32-bit partial products. The high halves' product only reaches the result's top 32 bits,
+	// and the cross products are made signed by subtracting the other factor's low half for each negative factor.
+	static INLINE Register Mul(Register A, Register B)
+	{
+		const __m256i Zero{ _mm256_setzero_si256() };
+		const __m256i AHigh{ _mm256_srli_epi64(A, 32) }, BHigh{ _mm256_srli_epi64(B, 32) };
+		const __m256i LowLow{ _mm256_srli_epi64(_mm256_add_epi64(_mm256_mul_epu32(A, B), _mm256_set1_epi64x(1ll << 31)), 32) };
+		const __m256i HighHigh{ _mm256_slli_epi64(_mm256_mul_epu32(AHigh, BHigh), 32) };
+		__m256i Middle{ _mm256_add_epi64(_mm256_mul_epu32(AHigh, B), _mm256_mul_epu32(A, BHigh)) };
+		Middle = _mm256_sub_epi64(Middle, _mm256_and_si256(_mm256_cmpgt_epi64(Zero, A), _mm256_slli_epi64(B, 32)));
+		Middle = _mm256_sub_epi64(Middle, _mm256_and_si256(_mm256_cmpgt_epi64(Zero, B), _mm256_slli_epi64(A, 32)));
+		return _mm256_add_epi64(_mm256_add_epi64(HighHigh, Middle), LowLow);
+	}
+
+	// There is no integer division instruction, each lane is divided on its own.
+	static INLINE Register Div(Register A, Register B)
+	{
+		alignas(32) SFixedd VA[4], VB[4];
+		Store(VA, A);
+		Store(VB, B);
+		for (uint i = 0; i < 4; ++i) VA[i] /= VB[i];
+		return Load(VA);
+	}
+
+	static INLINE Register Min(Register A, Register B) { return _mm256_blendv_epi8(A, B, _mm256_cmpgt_epi64(A, B)); }
+	static INLINE Register Max(Register A, Register B) { return _mm256_blendv_epi8(B, A, _mm256_cmpgt_epi64(A, B)); }
+
+	template <uint Lane>
+	static INLINE Register Splat(Register A) { return _mm256_permute4x64_epi64(A, _MM_SHUFFLE(Lane, Lane, Lane, Lane)); }
+
+	static INLINE void Transpose(Register& A, Register& B, Register& C, Register& D)
+	{
+		const __m256i AB0{ _mm256_unpacklo_epi64(A, B) }, AB1{ _mm256_unpackhi_epi64(A, B) };
+		const __m256i CD0{ _mm256_unpacklo_epi64(C, D) }, CD1{ _mm256_unpackhi_epi64(C, D) };
+		A = _mm256_permute2x128_si256(AB0, CD0, 0x20);
+		B = _mm256_permute2x128_si256(AB1, CD1, 0x20);
+		C = _mm256_permute2x128_si256(AB0, CD0, 0x31);
+		D = _mm256_permute2x128_si256(AB1, CD1, 0x31);
+	}
+
+	static INLINE SFixedd Dot(Register A, Register B)
+	{
+		const __m256i Product{ Mul(A, B) };
+		const __m128i Sum{ _mm_add_epi64(_mm256_castsi256_si128(Product), _mm256_extracti128_si256(Product, 1)) };
+		return SFixedd::FromBits(_mm_cvtsi128_si64(_mm_add_epi64(Sum, _mm_unpackhi_epi64(Sum, Sum))));
+	}
+
+	static INLINE Register Cross(Register A, Register B)
+	{
+		const __m256i AYZX{ _mm256_permute4x64_epi64(A, _MM_SHUFFLE(3, 0, 2, 1)) };
+		const __m256i BYZX{ _mm256_permute4x64_epi64(B, _MM_SHUFFLE(3, 0, 2, 1)) };
+		const __m256i C{ Sub(Mul(A, BYZX), Mul(AYZX, B)) };
+		return _mm256_permute4x64_epi64(C, _MM_SHUFFLE(3, 0, 2, 1));
+	}
+
+	// Fixed point numbers are always finite.
+	static INLINE bool AllFinite(Register) { return true; }
+};
+
+#endif // COPIRITE_AVX2
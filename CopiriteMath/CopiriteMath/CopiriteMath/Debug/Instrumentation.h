@@ -0,0 +1,329 @@
+#pragma once
+#include "../GlobalValues.h"
+#include <atomic>
+#include <mutex>
+#include <source_location>
+#include <vector>
+
+
+// Define COPIRITE_INSTRUMENTATION as 1 to count operations and trace NaN events, otherwise every hook compiles to nothing.
+#ifndef COPIRITE_INSTRUMENTATION
+#define COPIRITE_INSTRUMENTATION 0
+#endif // !COPIRITE_INSTRUMENTATION
+
+
+
+// The kinds of operation that are counted.
+enum class EMathOperation : uint8
+{
+	Add,
+	Sub,
+	Mul,
+	Div,
+	Negate,
+	Increment,
+	Decrement,
+	Assign,
+	Cross,
+	Dot,
+	MatrixInverse,
+	Convert,		// ToType() to another component type.
+	Check,			// An explicit CheckNaN() call.
+	Count
+};
+
+
+
+// A NaN or infinite result that was traced, with where it was checked.
+// Named functions and CheckNaN() report the line they were called from, operators report their own line in the library.
+struct SNaNEvent
+{
+	// Where the result was checked.
+	std::source_location Location;
+
+	// The operation that produced the result.
+	EMathOperation Operation;
+
+	// The order threads first used the instrumentation in, starting at 0.
+	uint Thread;
+
+	// The order events were traced in across every thread, starting at 0.
+	uint64 Sequence;
+};
+
+
+
+// A copy of every counter at one point in time, for exporting to a metrics pipeline.
+struct SInstrumentationSnapshot
+{
+	/// Properties
+
+	// How many times each operation ran, an estimate in multiples of SamplePeriod when sampling.
+	uint64 Operations[(uint)EMathOperation::Count];
+
+	// How many NaN or infinite results each operation produced, always exact.
+	uint64 NaNs[(uint)EMathOperation::Count];
+
+	// The sample period the operations were counted with.
+	uint SamplePeriod;
+
+	// How many threads have used the instrumentation, including ones that have exited.
+	uint Threads;
+
+	// The most recent traced NaN events, oldest first.
+	std::vector<SNaNEvent> Events;
+
+
+	/// Functions
+
+	// Returns the name of an operation, for labelling exported metrics.
+	static INLINE const char* GetName(EMathOperation Operation);
+
+	// Calls a function for every operation with its counters.
+	// @param Func - Takes the operation's name, how many times it ran and how many NaN or infinite results it produced.
+	template <typename Function>
+	INLINE void ForEach(Function Func) const
+	{
+		for (uint i = 0; i < (uint)EMathOperation::Count; ++i)
+		{
+			Func(GetName((EMathOperation)i), Operations[i], NaNs[i]);
+		}
+	}
+};
+
+
+
+// Per-thread counters of operations and NaN results, and a trace of where NaN results were found.
+// Each thread only ever writes its own counters, so counting is a plain load and store with no locks or atomic read-modify-writes.
+// Threads register the first time they count something and their counters are kept after they exit.
+// NaN results are counted under every NaN policy, Off included, the policy only decides what happens to the result.
+// @note - Every function does nothing unless COPIRITE_INSTRUMENTATION is 1.
+struct SInstrumentation
+{
+public:
+	// How many traced NaN events are kept, older ones are overwritten.
+	static constexpr uint EventCapacity{ 256 };
+
+
+private:
+	// The counters of one thread.
+	struct alignas(64) SThreadCounters
+	{
+		/// Properties
+
+		// How many times each operation ran, only written by the owning thread.
+		std::atomic<uint64> Operations[(uint)EMathOperation::Count]{};
+
+		// How many NaN or infinite results each operation produced, only written by the owning thread.
+		std::atomic<uint64> NaNs[(uint)EMathOperation::Count]{};
+
+		// How many operations are left before the next one is counted when sampling.
+		uint Countdown{ 0 };
+
+		// The order this thread registered in.
+		uint Thread{ 0 };
+
+
+		/// Constructors
+
+		// Constructor, Registers the counters so snapshots can find them.
+		INLINE SThreadCounters();
+
+		// Destructor, Moves the counters into the totals of exited threads.
+		INLINE ~SThreadCounters();
+
+
+		/// Functions
+
+		// Adds to a counter, safe since no other thread writes it.
+		static INLINE void Add(std::atomic<uint64>& Counter, uint64 Amount) { Counter.store(Counter.load(std::memory_order_relaxed) + Amount, std::memory_order_relaxed); }
+	};
+
+
+	/// Properties
+
+	// Guards Threads, Retired, Baseline and the event trace.
+	static inline std::mutex Mutex;
+
+	// The counters of every running thread that has used the instrumentation.
+	static inline std::vector<SThreadCounters*> Threads;
+
+	// How many threads have registered.
+	static inline uint ThreadCount{ 0 };
+
+	// The summed operation counters of threads that have exited.
+	static inline uint64 RetiredOperations[(uint)EMathOperation::Count]{};
+
+	// The summed NaN counters of threads that have exited.
+	static inline uint64 RetiredNaNs[(uint)EMathOperation::Count]{};
+
+	// The counters at the last reset, snapshots report the difference.
+	static inline SInstrumentationSnapshot Baseline{};
+
+	// The traced events, a ring buffer indexed by sequence.
+	static inline SNaNEvent Events[EventCapacity];
+
+	// How many events have been traced.
+	static inline uint64 EventCount{ 0 };
+
+	// The event count at the last reset.
+	static inline uint64 EventBaseline{ 0 };
+
+	// 1 counts every operation, N counts every Nth operation as N of them.
+	static inline std::atomic<uint> SamplePeriod{ 1 };
+
+
+	/// Functions
+
+	// Returns the calling thread's counters, registering them on first use.
+	static INLINE SThreadCounters& GetLocal()
+	{
+		thread_local SThreadCounters Counters;
+		return Counters;
+	}
+
+	// Returns the counters summed across every thread, without the baseline taken off.
+	static INLINE SInstrumentationSnapshot Sum();
+
+
+public:
+	// Counts an operation.
+	static INLINE void CountOperation(EMathOperation Operation)
+	{
+#if COPIRITE_INSTRUMENTATION
+		SThreadCounters& Local{ GetLocal() };
+		if (Local.Countdown > 1)
+		{
+			--Local.Countdown;
+			return;
+		}
+		const uint Period{ SamplePeriod.load(std::memory_order_relaxed) };
+		Local.Countdown = Period;
+		SThreadCounters::Add(Local.Operations[(uint)Operation], Period);
+#else
+		(void)Operation;
+#endif
+	}
+
+	// Counts a NaN or infinite result and traces where it was found.
+	// @param Operation - The operation that produced the result.
+	// @param Location - Where the result was checked.
+	static INLINE void CountNaN(EMathOperation Operation, const std::source_location& Location);
+
+	// Sets how often operations are counted. Each thread counts every Nth operation as N of them, trading precision for speed.
+	// NaN results are always counted, and only every Nth NaN result of each thread is traced.
+	// @param Period - 1 counts every operation.
+	static INLINE void SetSamplePeriod(uint Period) { SamplePeriod.store((Period > 0) ? Period : 1, std::memory_order_relaxed); }
+
+	// Returns how often operations are counted.
+	static INLINE uint GetSamplePeriod() { return SamplePeriod.load(std::memory_order_relaxed); }
+
+	// Returns the counters since the last reset, summed across every thread, and the most recent events.
+	// @note - Counters being written while the snapshot is taken may be included or not, each value is never torn.
+	static INLINE SInstrumentationSnapshot Snapshot();
+
+	// Starts the counters and the event trace over from zero.
+	static INLINE void Reset()
+	{
+#if COPIRITE_INSTRUMENTATION
+		const SInstrumentationSnapshot Current{ Sum() };
+		std::lock_guard<std::mutex> Lock{ Mutex };
+		Baseline = Current;
+		EventBaseline = EventCount;
+#endif
+	}
+};
+
+
+
+INLINE const char* SInstrumentationSnapshot::GetName(EMathOperation Operation)
+{
+	static constexpr const char* Names[]{ "Add", "Sub", "Mul", "Div", "Negate", "Increment", "Decrement", "Assign", "Cross", "Dot", "MatrixInverse", "Convert", "Check" };
+	static_assert(sizeof(Names) / sizeof(Names[0]) == (uint)EMathOperation::Count, "Every operation needs a name.");
+	return ((uint)Operation < (uint)EMathOperation::Count) ? Names[(uint)Operation] : "Unknown";
+}
+
+
+INLINE SInstrumentation::SThreadCounters::SThreadCounters()
+{
+	std::lock_guard<std::mutex> Lock{ Mutex };
+	Thread = ThreadCount++;
+	Threads.push_back(this);
+}
+
+
+INLINE SInstrumentation::SThreadCounters::~SThreadCounters()
+{
+	std::lock_guard<std::mutex> Lock{ Mutex };
+	for (uint i = 0; i < (uint)EMathOperation::Count; ++i)
+	{
+		RetiredOperations[i] += Operations[i].load(std::memory_order_relaxed);
+		RetiredNaNs[i] += NaNs[i].load(std::memory_order_relaxed);
+	}
+	std::erase(Threads, this);
+}
+
+
+INLINE void SInstrumentation::CountNaN(EMathOperation Operation, const std::source_location& Location)
+{
+#if COPIRITE_INSTRUMENTATION
+	SThreadCounters& Local{ GetLocal() };
+	const uint64 Found{ Local.NaNs[(uint)Operation].load(std::memory_order_relaxed) };
+	SThreadCounters::Add(Local.NaNs[(uint)Operation], 1);
+
+	// NaN results are rare enough that tracing them can take a lock.
+	if ((Found % SamplePeriod.load(std::memory_order_relaxed)) == 0)
+	{
+		std::lock_guard<std::mutex> Lock{ Mutex };
+		Events[EventCount % EventCapacity] = SNaNEvent{ Location, Operation, Local.Thread, EventCount };
+		++EventCount;
+	}
+#else
+	(void)Operation;
+	(void)Location;
+#endif
+}
+
+
+INLINE SInstrumentationSnapshot SInstrumentation::Sum()
+{
+	SInstrumentationSnapshot Result{};
+	std::lock_guard<std::mutex> Lock{ Mutex };
+	for (uint i = 0; i < (uint)EMathOperation::Count; ++i)
+	{
+		Result.Operations[i] = RetiredOperations[i];
+		Result.NaNs[i] = RetiredNaNs[i];
+		for (const SThreadCounters* Counters : Threads)
+		{
+			Result.Operations[i] += Counters->Operations[i].load(std::memory_order_relaxed);
+			Result.NaNs[i] += Counters->NaNs[i].load(std::memory_order_relaxed);
+		}
+	}
+	Result.Threads = ThreadCount;
+	return Result;
+}
+
+
+INLINE SInstrumentationSnapshot SInstrumentation::Snapshot()
+{
+	SInstrumentationSnapshot Result{};
+	Result.SamplePeriod = GetSamplePeriod();
+#if COPIRITE_INSTRUMENTATION
+	Result = Sum();
+	Result.SamplePeriod = GetSamplePeriod();
+
+	std::lock_guard<std::mutex> Lock{ Mutex };
+	for (uint i = 0; i < (uint)EMathOperation::Count; ++i)
+	{
+		Result.Operations[i] -= Baseline.Operations[i];
+		Result.NaNs[i] -= Baseline.NaNs[i];
+	}
+	const uint64 First{ (EventCount - EventBaseline > EventCapacity) ? EventCount - EventCapacity : EventBaseline };
+	Result.Events.reserve((size_t)(EventCount - First));
+	for (uint64 i = First; i < EventCount; ++i)
+	{
+		Result.Events.push_back(Events[i % EventCapacity]);
+	}
+#endif
+	return Result;
+}
@@ -0,0 +1,107 @@
+#pragma once
+#include "../GlobalValues.h"
+#include "Instrumentation.h"
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <source_location>
+
+
+// The values COPIRITE_NAN_POLICY can be defined as.
+#define COPIRITE_NAN_OFF 0
+#define COPIRITE_NAN_ASSERT 1
+#define COPIRITE_NAN_SANITIZE 2
+#define COPIRITE_NAN_COUNT 3
+
+// Selects how vectors handle NaN and infinite results.
+// Debug builds sanitize by default, release builds do not check at all.
+#ifndef COPIRITE_NAN_POLICY
+#if defined(NDEBUG) && !defined(_DEBUG)
+#define COPIRITE_NAN_POLICY COPIRITE_NAN_OFF
+#else
+#define COPIRITE_NAN_POLICY COPIRITE_NAN_SANITIZE
+#endif
+#endif // !COPIRITE_NAN_POLICY
+
+
+
+// The different ways a NaN or infinite result can be handled.
+enum class ENaNPolicy : uint8
+{
+	Off = COPIRITE_NAN_OFF,				// No checks are made unless instrumented, results are left as they are.
+	Assert = COPIRITE_NAN_ASSERT,		// Prints the error and aborts the program.
+	Sanitize = COPIRITE_NAN_SANITIZE,	// Prints the error, rate limited, and resets the result to zero.
+	Count = COPIRITE_NAN_COUNT			// Increments SNaNCounter without printing, results are left as they are.
+};
+
+
+
+// Counts how many NaN or infinite results have been found while using the Sanitize or Count policy.
+struct SNaNCounter
+{
+private:
+	/// Properties
+
+	// The amount of NaN or infinite results found since the last reset.
+	static inline std::atomic<uint64> Value{ 0 };
+
+
+public:
+	/// Functions
+
+	// Adds a found NaN to the counter.
+	// @return - How many NaN or infinite results were found before this one.
+	static INLINE uint64 Increment() { return Value.fetch_add(1, std::memory_order_relaxed); }
+
+	// Returns how many NaN or infinite results have been found since the last reset.
+	static INLINE uint64 Get() { return Value.load(std::memory_order_relaxed); }
+
+	// Resets the counter back to zero.
+	// @return - How many NaN or infinite results were found before the reset.
+	static INLINE uint64 Reset() { return Value.exchange(0, std::memory_order_relaxed); }
+};
+
+
+
+// Handles NaN and infinite results based on a policy.
+// @template Policy - How found NaNs should be handled.
+template <ENaNPolicy Policy>
+struct TNaNPolicy
+{
+	// Should results be checked for NaN at all, the Off policy still checks them when SInstrumentation counts NaN results.
+	static constexpr bool Enabled{ Policy != ENaNPolicy::Off || COPIRITE_INSTRUMENTATION };
+
+	// Handles a found NaN or infinite result.
+	// @param Name - The name of the datatype that contains NaN.
+	// @param Operation - The operation that produced the result, for SInstrumentation.
+	// @param Location - Where the result was checked, reported with the error.
+	// @return - True if the result should be reset to zero.
+	// @note - The Sanitize policy only prints the 1st, 2nd, 4th, 8th... result found so a flood of NaNs can not stall the thread.
+	static INLINE bool OnNaN(const char* Name, EMathOperation Operation, const std::source_location& Location = std::source_location::current())
+	{
+		SInstrumentation::CountNaN(Operation, Location);
+		if constexpr (Policy == ENaNPolicy::Assert)
+		{
+			fprintf(stderr, "%s contains NaN at %s:%u in %s\n", Name, Location.file_name(), (uint)Location.line(), Location.function_name());
+			abort();
+		}
+		else if constexpr (Policy == ENaNPolicy::Sanitize)
+		{
+			const uint64 Found{ SNaNCounter::Increment() + 1 };
+			if ((Found & (Found - 1)) == 0)
+			{
+				printf("%s contains NaN at %s:%u in %s (%llu found)\n", Name, Location.file_name(), (uint)Location.line(), Location.function_name(), Found);
+			}
+			return true;
+		}
+		else if constexpr (Policy == ENaNPolicy::Count)
+		{
+			SNaNCounter::Increment();
+		}
+		return false;
+	}
+};
+
+
+// The NaN policy used by this build.
+typedef TNaNPolicy<(ENaNPolicy)COPIRITE_NAN_POLICY> SNaNPolicy;
@@ -10,6 +10,11 @@
 #define SMALL_NUMBER (1.e-4f)
 #define LARGE_NUMBER (3.4e+38f)
 
+#define PI (3.1415926535897932f)
+#define HALF_PI (1.57079632679489662f)
+#define TWO_PI (6.28318530717958648f)
+#define INV_PI (0.31830988618379067f)
+
 
 typedef unsigned int uint;
 typedef bool byte;
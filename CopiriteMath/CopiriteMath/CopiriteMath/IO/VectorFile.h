@@ -0,0 +1,1064 @@
+#pragma once
+#include "../Datatypes/Box.h"
+#include "../Datatypes/Vector.h"
+#include "../Datatypes/VectorArray.h"
+#include "../Math/Reduce.h"
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define COPIRITE_MMAP 1
+#endif
+
+
+
+// How the vectors of a file are laid out in each chunk.
+enum class EVectorLayout : uint8
+{
+	// Each vector's components one after another, as an array of STVector.
+	AoS,
+
+	// Every X, then every Y and so on, as a STVectorArray. Each axis starts on a 64 byte boundary.
+	SoA
+};
+
+// The component type of a file's vectors.
+enum class EVectorFileType : uint8
+{
+	Unknown,
+	Float,
+	Double,
+	Int8,
+	Int16,
+	Int32,
+	Int64,
+	UInt8,
+	UInt16,
+	UInt32,
+	UInt64
+};
+
+
+
+// The first 64 bytes of a vector file.
+// A file is this header followed by chunks, each a SVectorChunkHeader and its vectors, every part starting on a 64 byte boundary.
+// @note - Every field is written in the byte order of the machine that wrote the file, Endian tells readers which that was.
+struct SVectorFileHeader
+{
+	// "CPVA", identifies the file.
+	char Magic[4];
+
+	// 0x01020304 as written by the machine that wrote the file.
+	uint32 Endian;
+
+	// The version of the format the file was written with.
+	uint16 Version;
+
+	// How many bytes the header takes, chunks start here.
+	uint16 HeaderBytes;
+
+	// How many dimensions the vectors have.
+	uint8 Size;
+
+	// The component type of the vectors.
+	EVectorFileType Type;
+
+	// How the vectors are laid out in each chunk.
+	EVectorLayout Layout;
+
+	uint8 Reserved0;
+
+	// The most vectors the writer put in a chunk.
+	uint32 ChunkCapacity;
+
+	uint32 Reserved1;
+
+	// How many vectors there are across every chunk, 0 until the writer is closed.
+	uint64 Count;
+
+	// How many chunks there are, 0 until the writer is closed.
+	uint64 ChunkCount;
+
+	uint8 Reserved2[24];
+
+
+	// Reverses the byte order of every field.
+	INLINE void SwapBytes();
+};
+
+// The start of each chunk of a vector file.
+struct SVectorChunkHeader
+{
+	// Set in Flags when Bounds holds the chunk's bounds.
+	static constexpr uint32 HasBounds{ 1 };
+
+	// "CHNK", identifies the chunk.
+	char Magic[4];
+
+	// Options the chunk was written with.
+	uint32 Flags;
+
+	// How many vectors the chunk holds.
+	uint64 Count;
+
+	// How many bytes of vectors follow this header, including padding, readers skip the chunk by seeking this far.
+	uint64 PayloadBytes;
+
+	uint8 Reserved0[8];
+
+	// The lowest then highest corner of the chunk's bounds, as components of the file's type.
+	uint8 Bounds[64];
+
+	uint8 Reserved1[32];
+
+
+	// Reverses the byte order of every field but the bounds, which depend on the file's type.
+	INLINE void SwapBytes();
+};
+
+ASSERT(sizeof(SVectorFileHeader) == 64, "The file header must stay 64 bytes.");
+ASSERT(sizeof(SVectorChunkHeader) == 128, "The chunk header must stay 128 bytes.");
+
+
+
+// A chunk of a vector file as seen by a reader.
+// @template Size - How many dimensions the vectors have.
+// @template Type - The datatype the vectors use.
+template <uint Size, typename Type>
+struct STVectorChunk
+{
+	// How many vectors the chunk holds.
+	uint Count;
+
+	// Was the chunk written with its bounds.
+	bool HasBounds;
+
+	// The smallest box containing the chunk's vectors, an infinite box if the chunk has no bounds.
+	STBox<Size, Type> Bounds;
+};
+
+
+
+// Helpers shared by the vector file readers and writers.
+namespace TVectorFile
+{
+	// The version files are written with, readers accept this version and older.
+	constexpr uint16 Version{ 1 };
+
+	// Written as a native uint32 to record the writer's byte order.
+	constexpr uint32 EndianMarker{ 0x01020304u };
+
+	// Every header, chunk and axis starts on a multiple of this many bytes.
+	constexpr uint64 Alignment{ 64 };
+
+	// Returns the file type of a component type, Unknown if it can't be stored.
+	template <typename Type>
+	constexpr EVectorFileType TypeOf()
+	{
+		if constexpr (std::is_same<Type, float>::value) return EVectorFileType::Float;
+		else if constexpr (std::is_same<Type, double>::value) return EVectorFileType::Double;
+		else if constexpr (std::is_integral<Type>::value && std::is_signed<Type>::value)
+		{
+			return (sizeof(Type) == 1) ? EVectorFileType::Int8 : (sizeof(Type) == 2) ? EVectorFileType::Int16 : (sizeof(Type) == 4) ? EVectorFileType::Int32 : (sizeof(Type) == 8) ? EVectorFileType::Int64 : EVectorFileType::Unknown;
+		}
+		else if constexpr (std::is_integral<Type>::value)
+		{
+			return (sizeof(Type) == 1) ? EVectorFileType::UInt8 : (sizeof(Type) == 2) ? EVectorFileType::UInt16 : (sizeof(Type) == 4) ? EVectorFileType::UInt32 : (sizeof(Type) == 8) ? EVectorFileType::UInt64 : EVectorFileType::Unknown;
+		}
+		else return EVectorFileType::Unknown;
+	}
+
+	// Rounds a byte count up to the alignment.
+	INLINE constexpr uint64 AlignUp(uint64 Bytes) { return (Bytes + Alignment - 1) & ~(Alignment - 1); }
+
+	// Returns how many bytes of vectors a chunk holds, including padding.
+	// @param Layout - How the vectors are laid out.
+	// @param Size - How many dimensions the vectors have.
+	// @param TypeBytes - How many bytes each component takes.
+	// @param Count - How many vectors the chunk holds.
+	INLINE constexpr uint64 PayloadBytes(EVectorLayout Layout, uint Size, uint64 TypeBytes, uint64 Count)
+	{
+		return (Layout == EVectorLayout::AoS) ? AlignUp(Count * Size * TypeBytes) : AlignUp(Count * TypeBytes) * Size;
+	}
+
+	// Reverses the byte order of an array of values.
+	// @param Data - The values.
+	// @param Width - How many bytes each value takes.
+	// @param Count - How many values there are.
+	INLINE void SwapBytes(void* Data, uint Width, uint64 Count)
+	{
+		uint8* Bytes{ (uint8*)Data };
+		for (uint64 i = 0; i < Count; ++i, Bytes += Width)
+		{
+			for (uint j = 0; j < Width / 2; ++j)
+			{
+				const uint8 Temp{ Bytes[j] };
+				Bytes[j] = Bytes[Width - 1 - j];
+				Bytes[Width - 1 - j] = Temp;
+			}
+		}
+	}
+
+	// Opens a file, returns nullptr on failure.
+	INLINE FILE* Open(const char* Path, const char* Mode)
+	{
+#if defined(_MSC_VER)
+		FILE* File{ nullptr };
+		return (fopen_s(&File, Path, Mode) == 0) ? File : nullptr;
+#else
+		return fopen(Path, Mode);
+#endif
+	}
+
+	// Moves a file's position with 64-bit offsets, returns true on success.
+	INLINE bool Seek(FILE* File, int64 Offset, int Origin)
+	{
+#if defined(_MSC_VER)
+		return _fseeki64(File, Offset, Origin) == 0;
+#else
+		return fseeko(File, (off_t)Offset, Origin) == 0;
+#endif
+	}
+
+	// Returns a file's position with 64-bit offsets, -1 on failure.
+	INLINE int64 Tell(FILE* File)
+	{
+#if defined(_MSC_VER)
+		return _ftelli64(File);
+#else
+		return (int64)ftello(File);
+#endif
+	}
+
+	// Returns how many bytes a file takes and moves its position to the start, -1 on failure.
+	INLINE int64 Length(FILE* File)
+	{
+		if (!Seek(File, 0, SEEK_END)) return -1;
+		const int64 Bytes{ Tell(File) };
+		return (Bytes >= 0 && Seek(File, 0, SEEK_SET)) ? Bytes : -1;
+	}
+
+	// Writes zeros until the file's position is a multiple of the alignment, returns true on success.
+	// @param Bytes - How many bytes have been written since the last aligned position.
+	INLINE bool Pad(FILE* File, uint64 Bytes)
+	{
+		static constexpr uint8 Zeros[Alignment]{};
+		const uint64 Padding{ AlignUp(Bytes) - Bytes };
+		return Padding == 0 || fwrite(Zeros, 1, (size_t)Padding, File) == Padding;
+	}
+
+	// Returns a chunk's bounds from its header.
+	template <uint Size, typename Type>
+	INLINE STVectorChunk<Size, Type> ReadChunk(const SVectorChunkHeader& Header)
+	{
+		STVectorChunk<Size, Type> Chunk{ (uint)Header.Count, (Header.Flags & SVectorChunkHeader::HasBounds) != 0, STBox<Size, Type>{} };
+		if (Chunk.HasBounds)
+		{
+			STVector<Size, Type> Min, Max;
+			memcpy(Min.GetData(), Header.Bounds, sizeof(Type) * Size);
+			memcpy(Max.GetData(), Header.Bounds + (sizeof(Type) * Size), sizeof(Type) * Size);
+			Chunk.Bounds = STBox<Size, Type>{ Min, Max };
+		}
+		else
+		{
+			const Type Highest{ std::numeric_limits<Type>::has_infinity ? std::numeric_limits<Type>::infinity() : std::numeric_limits<Type>::max() };
+			Chunk.Bounds = STBox<Size, Type>{ STVector<Size, Type>{ std::numeric_limits<Type>::lowest() }, STVector<Size, Type>{ Highest } };
+		}
+		return Chunk;
+	}
+}
+
+
+
+// Writes vectors to a file one chunk at a time, so datasets larger than memory can be streamed out.
+// Vectors are buffered until a chunk is full, each chunk can record its bounds so readers can skip it.
+// @note - Returns false from any function once a write has failed, the file is incomplete until Close returns true.
+// @template Size - How many dimensions the vectors have.
+// @template Type - The datatype the vectors use.
+template <uint Size, typename Type>
+struct STVectorFileWriter
+{
+	ASSERT(TVectorFile::TypeOf<Type>() != EVectorFileType::Unknown, "Vector files only store float, double and integer components.");
+	ASSERT(sizeof(Type) * Size * 2 <= sizeof(SVectorChunkHeader::Bounds), "The bounds of a chunk must fit in its header.");
+
+private:
+	/// Properties
+
+	// The file being written, nullptr when closed.
+	FILE* File{ nullptr };
+
+	// The header, written again with the totals on Close.
+	SVectorFileHeader Header;
+
+	// Should each chunk record its bounds.
+	bool WriteBounds{ true };
+
+	// Set once a write fails.
+	bool Failed{ false };
+
+	// Vectors waiting for their chunk to fill.
+	std::vector<STVector<Size, Type>> Pending;
+
+	// An axis being gathered from Pending when writing a SoA chunk.
+	std::vector<Type> Scratch;
+
+
+	/// Functions
+
+	// Writes a chunk's header.
+	INLINE bool WriteChunkHeader(uint Count, const STBox<Size, Type>& Bounds);
+
+	// Writes a chunk of vectors stored one after another.
+	INLINE bool WriteChunk(const STVector<Size, Type>* Vectors, uint Count);
+
+	// Writes a chunk of vectors from a range of a STVectorArray.
+	INLINE bool WriteChunk(const STVectorArray<Size, Type>& Vectors, uint Begin, uint Count);
+
+
+public:
+	/// Constructors
+
+	// Constructor, Default. The writer is closed.
+	INLINE STVectorFileWriter() = default;
+
+	// Destructor, Closes the file.
+	INLINE ~STVectorFileWriter() { Close(); }
+
+	STVectorFileWriter(const STVectorFileWriter&) = delete;
+	STVectorFileWriter& operator=(const STVectorFileWriter&) = delete;
+
+
+
+	/// Functions
+
+	// Creates a file and writes its header, replacing any file at the path.
+	// @param Path - Where to write the file.
+	// @param Layout - How to lay out the vectors of each chunk.
+	// @param ChunkCapacity - The most vectors in a chunk, rounded up to a multiple of 64. Readers hold a chunk in memory at a time.
+	// @param Bounds - Should each chunk record its bounds.
+	// @return - True if the file was created.
+	INLINE bool Open(const char* Path, EVectorLayout Layout = EVectorLayout::AoS, uint ChunkCapacity = 1u << 20, bool Bounds = true);
+
+	// Adds vectors to the file.
+	// @param Vectors - The vectors to add.
+	// @param Count - How many vectors there are.
+	// @return - False if a write failed.
+	INLINE bool Write(const STVector<Size, Type>* Vectors, uint Count);
+
+	// Adds the vectors of a structure of arrays to the file.
+	// @param Vectors - The vectors to add.
+	// @return - False if a write failed.
+	INLINE bool Write(const STVectorArray<Size, Type>& Vectors);
+
+	// Writes any buffered vectors and the totals, then closes the file.
+	// @return - True if every write succeeded, false if the file is incomplete or was not open.
+	INLINE bool Close();
+
+	// Returns if a file is open.
+	INLINE bool IsOpen() const { return File != nullptr; }
+
+	// Returns how many vectors have been added.
+	INLINE uint64 Num() const { return Header.Count + Pending.size(); }
+};
+
+
+
+// Reads a vector file one chunk at a time, converting the byte order and layout as needed.
+// Call Next to move to each chunk, then Read its vectors or Skip it, chunks whose bounds miss a query can be skipped unread.
+// @template Size - How many dimensions the vectors have, must match the file.
+// @template Type - The datatype the vectors use, must match the file.
+template <uint Size, typename Type>
+struct STVectorFileReader
+{
+private:
+	/// Properties
+
+	// The file being read, nullptr when closed.
+	FILE* File{ nullptr };
+
+	// The file's header, in native byte order.
+	SVectorFileHeader Header;
+
+	// The header of the chunk Next moved to, in native byte order.
+	SVectorChunkHeader Chunk;
+
+	// Has the current chunk's payload not been read or skipped yet.
+	bool InChunk{ false };
+
+	// Was the file written with the other byte order.
+	bool Swap{ false };
+
+	// How many bytes the file takes, no chunk may claim more than is left of it.
+	uint64 Bytes{ 0 };
+
+	// Holds a chunk's payload while it is converted.
+	std::vector<Type> Scratch;
+
+
+	/// Functions
+
+	// Reads the current chunk's components into a buffer in native byte order, as laid out in the file without padding.
+	INLINE bool ReadPayload(Type* Out);
+
+
+public:
+	/// Constructors
+
+	// Constructor, Default. The reader is closed.
+	INLINE STVectorFileReader() = default;
+
+	// Destructor, Closes the file.
+	INLINE ~STVectorFileReader() { Close(); }
+
+	STVectorFileReader(const STVectorFileReader&) = delete;
+	STVectorFileReader& operator=(const STVectorFileReader&) = delete;
+
+
+
+	/// Functions
+
+	// Opens a file and checks its header.
+	// @param Path - The file to read.
+	// @return - True if the file is a vector file of this size and type, in either byte order.
+	INLINE bool Open(const char* Path);
+
+	// Closes the file.
+	INLINE void Close();
+
+	// Returns if a file is open.
+	INLINE bool IsOpen() const { return File != nullptr; }
+
+	// Returns the file's header, in native byte order.
+	INLINE const SVectorFileHeader& GetHeader() const { return Header; }
+
+	// Moves to the next chunk, skipping the current one if it was not read.
+	// @param Out - Set to the chunk's size and bounds.
+	// @return - False at the end of the file or if it is damaged.
+	INLINE bool Next(STVectorChunk<Size, Type>& Out);
+
+	// Reads the current chunk's vectors.
+	// @param Out - Receives the chunk's Count vectors.
+	// @return - False if there is no current chunk or the file is damaged.
+	INLINE bool Read(STVector<Size, Type>* Out);
+
+	// Reads the current chunk's vectors into a structure of arrays.
+	// @param Out - Resized to the chunk's Count vectors.
+	// @return - False if there is no current chunk or the file is damaged.
+	INLINE bool Read(STVectorArray<Size, Type>& Out);
+
+	// Skips the current chunk without reading it.
+	// @return - False if there is no current chunk or the file is damaged.
+	INLINE bool Skip();
+
+	// Reads every chunk, or every chunk whose bounds overlap a box, passing each to a function.
+	// @param Func - Called with a pointer to each chunk's vectors and how many there are.
+	// @param Query - Chunks whose bounds miss this box are skipped unread, nullptr reads every chunk.
+	// @return - False if the file is damaged.
+	template <typename Function>
+	INLINE bool ForEachChunk(Function Func, const STBox<Size, Type>* Query = nullptr);
+};
+
+
+
+// A vector file mapped into memory, each chunk's vectors are used in place without being copied.
+// Uses mmap where available, elsewhere the file is read into memory once.
+// @note - The file must have been written with this machine's byte order, use STVectorFileReader for files from other machines.
+// @template Size - How many dimensions the vectors have, must match the file.
+// @template Type - The datatype the vectors use, must match the file.
+template <uint Size, typename Type>
+struct STMappedVectorFile
+{
+private:
+	// A chunk of the file and where its vectors are.
+	struct SChunk
+	{
+		// The chunk's size and bounds.
+		STVectorChunk<Size, Type> Info;
+
+		// The first byte of the chunk's vectors.
+		const uint8* Payload;
+	};
+
+
+	/// Properties
+
+	// The start of the file in memory.
+	const uint8* Data{ nullptr };
+
+	// How many bytes the file takes.
+	uint64 Bytes{ 0 };
+
+	// Is Data mapped rather than allocated.
+	bool Mapped{ false };
+
+	// The file's header.
+	SVectorFileHeader Header;
+
+	// Every chunk of the file, in order.
+	std::vector<SChunk> Chunks;
+
+	// How many vectors there are across every chunk.
+	uint64 Count{ 0 };
+
+
+public:
+	/// Constructors
+
+	// Constructor, Default. Nothing is mapped.
+	INLINE STMappedVectorFile() = default;
+
+	// Destructor, Unmaps the file.
+	INLINE ~STMappedVectorFile() { Close(); }
+
+	STMappedVectorFile(const STMappedVectorFile&) = delete;
+	STMappedVectorFile& operator=(const STMappedVectorFile&) = delete;
+
+
+
+	/// Functions
+
+	// Maps a file and finds its chunks.
+	// @param Path - The file to map.
+	// @return - True if the file is a vector file of this size, type and byte order.
+	INLINE bool Open(const char* Path);
+
+	// Unmaps the file, every pointer into it becomes invalid.
+	INLINE void Close();
+
+	// Returns if a file is mapped.
+	INLINE bool IsOpen() const { return Data != nullptr; }
+
+	// Returns the file's header.
+	INLINE const SVectorFileHeader& GetHeader() const { return Header; }
+
+	// Returns how many vectors there are across every chunk.
+	INLINE uint64 Num() const { return Count; }
+
+	// Returns how many chunks there are.
+	INLINE uint NumChunks() const { return (uint)Chunks.size(); }
+
+	// Returns a chunk's size and bounds.
+	INLINE const STVectorChunk<Size, Type>& GetChunk(uint Index) const { return Chunks[Index].Info; }
+
+	// Returns a chunk's vectors in place, for AoS files.
+	// @return - The vectors, nullptr for SoA files.
+	INLINE const STVector<Size, Type>* GetVectors(uint Index) const;
+
+	// Returns one axis of a chunk's vectors in place, for SoA files. Each axis is 64 byte aligned.
+	// @return - The components, nullptr for AoS files.
+	INLINE const Type* GetAxis(uint Index, uint Axis) const;
+
+	// Returns a vector of a chunk, for either layout.
+	// @param Index - The chunk.
+	// @param Vector - The vector in the chunk.
+	INLINE STVector<Size, Type> Get(uint Index, uint Vector) const;
+};
+
+
+
+INLINE void SVectorFileHeader::SwapBytes()
+{
+	TVectorFile::SwapBytes(&Endian, sizeof(Endian), 1);
+	TVectorFile::SwapBytes(&Version, sizeof(Version), 1);
+	TVectorFile::SwapBytes(&HeaderBytes, sizeof(HeaderBytes), 1);
+	TVectorFile::SwapBytes(&ChunkCapacity, sizeof(ChunkCapacity), 1);
+	TVectorFile::SwapBytes(&Count, sizeof(Count), 1);
+	TVectorFile::SwapBytes(&ChunkCount, sizeof(ChunkCount), 1);
+}
+
+
+INLINE void SVectorChunkHeader::SwapBytes()
+{
+	TVectorFile::SwapBytes(&Flags, sizeof(Flags), 1);
+	TVectorFile::SwapBytes(&Count, sizeof(Count), 1);
+	TVectorFile::SwapBytes(&PayloadBytes, sizeof(PayloadBytes), 1);
+}
+
+
+template <uint Size, typename Type>
+INLINE bool STVectorFileWriter<Size, Type>::Open(const char* Path, EVectorLayout Layout, uint ChunkCapacity, bool Bounds)
+{
+	Close();
+	File = TVectorFile::Open(Path, "wb");
+	if (!File) return false;
+
+	// A multiple of 64 keeps the chunks of a STVectorArray on whole lanes, so their bounds use aligned loads.
+	ChunkCapacity = (uint)std::min<uint64>(((uint64)std::max(ChunkCapacity, 1u) + 63) & ~63ull, 0xFFFFFFC0ull);
+
+	memset(&Header, 0, sizeof(Header));
+	memcpy(Header.Magic, "CPVA", 4);
+	Header.Endian = TVectorFile::EndianMarker;
+	Header.Version = TVectorFile::Version;
+	Header.HeaderBytes = (uint16)sizeof(SVectorFileHeader);
+	Header.Size = (uint8)Size;
+	Header.Type = TVectorFile::TypeOf<Type>();
+	Header.Layout = Layout;
+	Header.ChunkCapacity = ChunkCapacity;
+	WriteBounds = Bounds;
+	Failed = fwrite(&Header, sizeof(Header), 1, File) != 1;
+	Pending.clear();
+	Pending.reserve(std::min(ChunkCapacity, 1u << 20));
+	return !Failed;
+}
+
+
+template <uint Size, typename Type>
+INLINE bool STVectorFileWriter<Size, Type>::WriteChunkHeader(uint Count, const STBox<Size, Type>& Bounds)
+{
+	SVectorChunkHeader Chunk;
+	memset(&Chunk, 0, sizeof(Chunk));
+	memcpy(Chunk.Magic, "CHNK", 4);
+	Chunk.Count = Count;
+	Chunk.PayloadBytes = TVectorFile::PayloadBytes(Header.Layout, Size, sizeof(Type), Count);
+	if (WriteBounds)
+	{
+		Chunk.Flags |= SVectorChunkHeader::HasBounds;
+		memcpy(Chunk.Bounds, Bounds.GetMin().GetData(), sizeof(Type) * Size);
+		memcpy(Chunk.Bounds + (sizeof(Type) * Size), Bounds.GetMax().GetData(), sizeof(Type) * Size);
+	}
+	if (fwrite(&Chunk, sizeof(Chunk), 1, File) != 1) return false;
+
+	Header.Count += Count;
+	++Header.ChunkCount;
+	return true;
+}
+
+
+template <uint Size, typename Type>
+INLINE bool STVectorFileWriter<Size, Type>::WriteChunk(const STVector<Size, Type>* Vectors, uint Count)
+{
+	if (!WriteChunkHeader(Count, WriteBounds ? TReduce::Bounds(Vectors, Count) : STBox<Size, Type>{})) return false;
+
+	if (Header.Layout == EVectorLayout::AoS)
+	{
+		const uint64 Bytes{ (uint64)Count * Size * sizeof(Type) };
+		if constexpr (TReduce::IsPacked<Size, Type>)
+		{
+			if (fwrite(Vectors[0].GetData(), 1, (size_t)Bytes, File) != Bytes) return false;
+		}
+		else
+		{
+			for (uint i = 0; i < Count; ++i)
+			{
+				if (fwrite(Vectors[i].GetData(), sizeof(Type), Size, File) != Size) return false;
+			}
+		}
+		return TVectorFile::Pad(File, Bytes);
+	}
+
+	// Each axis is gathered into a buffer and written whole.
+	Scratch.resize(Count);
+	for (uint j = 0; j < Size; ++j)
+	{
+		for (uint i = 0; i < Count; ++i) Scratch[i] = Vectors[i][j];
+		if (fwrite(Scratch.data(), sizeof(Type), Count, File) != Count || !TVectorFile::Pad(File, (uint64)Count * sizeof(Type))) return false;
+	}
+	return true;
+}
+
+
+template <uint Size, typename Type>
+INLINE bool STVectorFileWriter<Size, Type>::WriteChunk(const STVectorArray<Size, Type>& Vectors, uint Begin, uint Count)
+{
+	if (!WriteChunkHeader(Count, WriteBounds ? TReduce::BoundsRange<true, true>(Vectors, Begin, Begin + Count) : STBox<Size, Type>{})) return false;
+
+	if (Header.Layout == EVectorLayout::SoA)
+	{
+		for (uint j = 0; j < Size; ++j)
+		{
+			if (fwrite(Vectors.GetAxis(j) + Begin, sizeof(Type), Count, File) != Count || !TVectorFile::Pad(File, (uint64)Count * sizeof(Type))) return false;
+		}
+		return true;
+	}
+
+	// Interleaved through a buffer of components.
+	Scratch.resize((size_t)Count * Size);
+	for (uint j = 0; j < Size; ++j)
+	{
+		const Type* Axis{ Vectors.GetAxis(j) + Begin };
+		for (uint i = 0; i < Count; ++i) Scratch[((size_t)i * Size) + j] = Axis[i];
+	}
+	const uint64 Bytes{ (uint64)Count * Size * sizeof(Type) };
+	return fwrite(Scratch.data(), 1, (size_t)Bytes, File) == Bytes && TVectorFile::Pad(File, Bytes);
+}
+
+
+template <uint Size, typename Type>
+INLINE bool STVectorFileWriter<Size, Type>::Write(const STVector<Size, Type>* Vectors, uint Count)
+{
+	if (!File || Failed) return false;
+
+	const uint Capacity{ Header.ChunkCapacity };
+	while (Count > 0 && !Failed)
+	{
+		// Whole chunks skip the buffer.
+		if (Pending.empty() && Count >= Capacity)
+		{
+			Failed = !WriteChunk(Vectors, Capacity);
+			Vectors += Capacity;
+			Count -= Capacity;
+			continue;
+		}
+
+		const uint Taken{ std::min(Count, Capacity - (uint)Pending.size()) };
+		Pending.insert(Pending.end(), Vectors, Vectors + Taken);
+		Vectors += Taken;
+		Count -= Taken;
+		if (Pending.size() == Capacity)
+		{
+			Failed = !WriteChunk(Pending.data(), Capacity);
+			Pending.clear();
+		}
+	}
+	return !Failed;
+}
+
+
+template <uint Size, typename Type>
+INLINE bool STVectorFileWriter<Size, Type>::Write(const STVectorArray<Size, Type>& Vectors)
+{
+	if (!File || Failed) return false;
+
+	const uint Capacity{ Header.ChunkCapacity };
+	uint Begin{ 0 };
+
+	// Only reachable on whole chunks when nothing is buffered, otherwise vectors go through the buffer like any others.
+	for (; Pending.empty() && Begin + Capacity <= Vectors.Num() && !Failed; Begin += Capacity)
+	{
+		Failed = !WriteChunk(Vectors, Begin, Capacity);
+	}
+	for (; Begin < Vectors.Num() && !Failed; ++Begin)
+	{
+		Pending.push_back(Vectors[Begin]);
+		if (Pending.size() == Capacity)
+		{
+			Failed = !WriteChunk(Pending.data(), Capacity);
+			Pending.clear();
+		}
+	}
+	return !Failed;
+}
+
+
+template <uint Size, typename Type>
+INLINE bool STVectorFileWriter<Size, Type>::Close()
+{
+	if (!File) return false;
+
+	if (!Pending.empty() && !Failed)
+	{
+		Failed = !WriteChunk(Pending.data(), (uint)Pending.size());
+	}
+	Pending.clear();
+
+	// The totals are only written once every chunk is, a file that was never closed still reads up to its last whole chunk.
+	if (!Failed)
+	{
+		Failed = !TVectorFile::Seek(File, 0, SEEK_SET) || fwrite(&Header, sizeof(Header), 1, File) != 1;
+	}
+	Failed = (fclose(File) != 0) || Failed;
+	File = nullptr;
+	return !Failed;
+}
+
+
+template <uint Size, typename Type>
+INLINE bool STVectorFileReader<Size, Type>::Open(const char* Path)
+{
+	Close();
+	File = TVectorFile::Open(Path, "rb");
+	if (!File) return false;
+
+	const int64 FileBytes{ TVectorFile::Length(File) };
+	if (FileBytes >= (int64)sizeof(SVectorFileHeader) && fread(&Header, sizeof(Header), 1, File) == 1 && memcmp(Header.Magic, "CPVA", 4) == 0)
+	{
+		Bytes = (uint64)FileBytes;
+		Swap = Header.Endian != TVectorFile::EndianMarker;
+		if (Swap) Header.SwapBytes();
+		if (Header.Endian == TVectorFile::EndianMarker && Header.Version <= TVectorFile::Version && Header.Size == Size && Header.Type == TVectorFile::TypeOf<Type>()
+			&& Header.Layout <= EVectorLayout::SoA && Header.HeaderBytes >= sizeof(SVectorFileHeader) && Header.HeaderBytes % TVectorFile::Alignment == 0
+			&& Header.HeaderBytes <= Bytes && TVectorFile::Seek(File, Header.HeaderBytes, SEEK_SET))
+		{
+			return true;
+		}
+	}
+	Close();
+	return false;
+}
+
+
+template <uint Size, typename Type>
+INLINE void STVectorFileReader<Size, Type>::Close()
+{
+	if (File) fclose(File);
+	File = nullptr;
+	InChunk = false;
+	Bytes = 0;
+}
+
+
+template <uint Size, typename Type>
+INLINE bool STVectorFileReader<Size, Type>::Next(STVectorChunk<Size, Type>& Out)
+{
+	if (!File || (InChunk && !Skip())) return false;
+
+	if (fread(&Chunk, sizeof(Chunk), 1, File) != 1 || memcmp(Chunk.Magic, "CHNK", 4) != 0) return false;
+	if (Swap)
+	{
+		Chunk.SwapBytes();
+		TVectorFile::SwapBytes(Chunk.Bounds, sizeof(Type), Size * 2);
+	}
+
+	// The same checks as STMappedVectorFile, a damaged count can not ask for more vectors than the rest of the file holds.
+	const int64 Offset{ TVectorFile::Tell(File) };
+	if (Offset < 0 || Chunk.Count > 0xFFFFFFFFull || Chunk.PayloadBytes % TVectorFile::Alignment != 0
+		|| Chunk.PayloadBytes < TVectorFile::PayloadBytes(Header.Layout, Size, sizeof(Type), Chunk.Count) || Chunk.PayloadBytes > Bytes - (uint64)Offset)
+	{
+		return false;
+	}
+
+	InChunk = true;
+	Out = TVectorFile::ReadChunk<Size, Type>(Chunk);
+	return true;
+}
+
+
+template <uint Size, typename Type>
+INLINE bool STVectorFileReader<Size, Type>::Skip()
+{
+	if (!File || !InChunk) return false;
+	InChunk = false;
+	return TVectorFile::Seek(File, (int64)Chunk.PayloadBytes, SEEK_CUR);
+}
+
+
+template <uint Size, typename Type>
+INLINE bool STVectorFileReader<Size, Type>::ReadPayload(Type* Out)
+{
+	if (!File || !InChunk) return false;
+	InChunk = false;
+
+	const uint64 Count{ Chunk.Count };
+	uint64 Read{ 0 };
+	if (Header.Layout == EVectorLayout::AoS)
+	{
+		const uint64 Bytes{ Count * Size * sizeof(Type) };
+		if (fread(Out, 1, (size_t)Bytes, File) != Bytes) return false;
+		Read = Bytes;
+	}
+	else
+	{
+		for (uint j = 0; j < Size; ++j)
+		{
+			if (fread(Out + (Count * j), sizeof(Type), (size_t)Count, File) != Count) return false;
+			Read += Count * sizeof(Type);
+			if (j + 1 < Size)
+			{
+				const uint64 Padding{ TVectorFile::AlignUp(Read) - Read };
+				if (!TVectorFile::Seek(File, (int64)Padding, SEEK_CUR)) return false;
+				Read += Padding;
+			}
+		}
+	}
+	if (Swap) TVectorFile::SwapBytes(Out, sizeof(Type), Count * Size);
+	return TVectorFile::Seek(File, (int64)(Chunk.PayloadBytes - Read), SEEK_CUR);
+}
+
+
+template <uint Size, typename Type>
+INLINE bool STVectorFileReader<Size, Type>::Read(STVector<Size, Type>* Out)
+{
+	const uint Count{ (uint)Chunk.Count };
+	if (Header.Layout == EVectorLayout::AoS && TReduce::IsPacked<Size, Type>)
+	{
+		return Count == 0 ? ReadPayload(nullptr) : ReadPayload(Out[0].GetData());
+	}
+
+	Scratch.resize((size_t)Count * Size);
+	if (!ReadPayload(Scratch.data())) return false;
+	for (uint i = 0; i < Count; ++i)
+	{
+		for (uint j = 0; j < Size; ++j)
+		{
+			Out[i][j] = (Header.Layout == EVectorLayout::AoS) ? Scratch[((size_t)i * Size) + j] : Scratch[((size_t)j * Count) + i];
+		}
+	}
+	return true;
+}
+
+
+template <uint Size, typename Type>
+INLINE bool STVectorFileReader<Size, Type>::Read(STVectorArray<Size, Type>& Out)
+{
+	const uint Count{ (uint)Chunk.Count };
+	Scratch.resize((size_t)Count * Size);
+	if (!ReadPayload(Scratch.data())) return false;
+
+	Out.Resize(Count);
+	for (uint j = 0; j < Size; ++j)
+	{
+		Type* Axis{ Out.GetAxis(j) };
+		if (Header.Layout == EVectorLayout::SoA)
+		{
+			memcpy(Axis, Scratch.data() + ((size_t)j * Count), sizeof(Type) * Count);
+		}
+		else
+		{
+			for (uint i = 0; i < Count; ++i) Axis[i] = Scratch[((size_t)i * Size) + j];
+		}
+	}
+	return true;
+}
+
+
+template <uint Size, typename Type>
+template <typename Function>
+INLINE bool STVectorFileReader<Size, Type>::ForEachChunk(Function Func, const STBox<Size, Type>* Query)
+{
+	std::vector<STVector<Size, Type>> Vectors;
+	STVectorChunk<Size, Type> Info;
+	while (Next(Info))
+	{
+		if (Query && Info.HasBounds && !Info.Bounds.Overlaps(*Query))
+		{
+			if (!Skip()) return false;
+			continue;
+		}
+
+		Vectors.resize(Info.Count);
+		if (!Read(Vectors.data())) return false;
+		Func((const STVector<Size, Type>*)Vectors.data(), Info.Count);
+	}
+
+	// Next fails at the end of the file and on a damaged chunk, only the end leaves nothing left to read.
+	return File && !InChunk && feof(File);
+}
+
+
+template <uint Size, typename Type>
+INLINE bool STMappedVectorFile<Size, Type>::Open(const char* Path)
+{
+	Close();
+
+#if defined(COPIRITE_MMAP)
+	const int Descriptor{ open(Path, O_RDONLY) };
+	if (Descriptor < 0) return false;
+	struct stat Status;
+	if (fstat(Descriptor, &Status) == 0 && Status.st_size >= (off_t)sizeof(SVectorFileHeader))
+	{
+		void* Mapping{ mmap(nullptr, (size_t)Status.st_size, PROT_READ, MAP_SHARED, Descriptor, 0) };
+		if (Mapping != MAP_FAILED)
+		{
+			Data = (const uint8*)Mapping;
+			Bytes = (uint64)Status.st_size;
+			Mapped = true;
+		}
+	}
+	close(Descriptor);
+#else
+	FILE* File{ TVectorFile::Open(Path, "rb") };
+	if (!File) return false;
+	const int64 FileBytes{ TVectorFile::Length(File) };
+	if (FileBytes >= (int64)sizeof(SVectorFileHeader))
+	{
+		uint8* Buffer{ (uint8*)::operator new((size_t)FileBytes, std::align_val_t{ TVectorFile::Alignment }) };
+		if (fread(Buffer, 1, (size_t)FileBytes, File) == (size_t)FileBytes)
+		{
+			Data = Buffer;
+			Bytes = (uint64)FileBytes;
+		}
+		else
+		{
+			::operator delete(Buffer, std::align_val_t{ TVectorFile::Alignment });
+		}
+	}
+	fclose(File);
+#endif
+	if (!Data) return false;
+
+	memcpy(&Header, Data, sizeof(Header));
+	if (memcmp(Header.Magic, "CPVA", 4) != 0 || Header.Endian != TVectorFile::EndianMarker || Header.Version > TVectorFile::Version || Header.Size != Size
+		|| Header.Type != TVectorFile::TypeOf<Type>() || Header.Layout > EVectorLayout::SoA || Header.HeaderBytes < sizeof(SVectorFileHeader)
+		|| Header.HeaderBytes % TVectorFile::Alignment != 0)
+	{
+		Close();
+		return false;
+	}
+
+	// Only the chunk headers are touched, so pages of vectors are not read until they are used.
+	uint64 Offset{ Header.HeaderBytes };
+	while (Offset + sizeof(SVectorChunkHeader) <= Bytes)
+	{
+		SVectorChunkHeader Chunk;
+		memcpy(&Chunk, Data + Offset, sizeof(Chunk));
+		if (memcmp(Chunk.Magic, "CHNK", 4) != 0 || Chunk.Count > 0xFFFFFFFFull || Chunk.PayloadBytes % TVectorFile::Alignment != 0
+			|| Chunk.PayloadBytes < TVectorFile::PayloadBytes(Header.Layout, Size, sizeof(Type), Chunk.Count) || Chunk.PayloadBytes > Bytes - Offset - sizeof(Chunk))
+		{
+			break;
+		}
+
+		Chunks.push_back(SChunk{ TVectorFile::ReadChunk<Size, Type>(Chunk), Data + Offset + sizeof(Chunk) });
+		Count += Chunk.Count;
+		Offset += sizeof(Chunk) + Chunk.PayloadBytes;
+	}
+	return true;
+}
+
+
+template <uint Size, typename Type>
+INLINE void STMappedVectorFile<Size, Type>::Close()
+{
+	if (Data)
+	{
+#if defined(COPIRITE_MMAP)
+		if (Mapped) munmap((void*)Data, (size_t)Bytes);
+#endif
+		if (!Mapped) ::operator delete((void*)Data, std::align_val_t{ TVectorFile::Alignment });
+	}
+	Data = nullptr;
+	Bytes = 0;
+	Mapped = false;
+	Chunks.clear();
+	Count = 0;
+}
+
+
+template <uint Size, typename Type>
+INLINE const STVector<Size, Type>* STMappedVectorFile<Size, Type>::GetVectors(uint Index) const
+{
+	if constexpr (TReduce::IsPacked<Size, Type>)
+	{
+		if (Header.Layout == EVectorLayout::AoS) return (const STVector<Size, Type>*)Chunks[Index].Payload;
+	}
+	return nullptr;
+}
+
+
+template <uint Size, typename Type>
+INLINE const Type* STMappedVectorFile<Size, Type>::GetAxis(uint Index, uint Axis) const
+{
+	if (Header.Layout != EVectorLayout::SoA) return nullptr;
+	return (const Type*)(Chunks[Index].Payload + (TVectorFile::AlignUp((uint64)Chunks[Index].Info.Count * sizeof(Type)) * Axis));
+}
+
+
+template <uint Size, typename Type>
+INLINE STVector<Size, Type> STMappedVectorFile<Size, Type>::Get(uint Index, uint Vector) const
+{
+	STVector<Size, Type> Result;
+	const uint8* Payload{ Chunks[Index].Payload };
+	for (uint j = 0; j < Size; ++j)
+	{
+		const uint8* Component{ (Header.Layout == EVectorLayout::AoS) ? Payload + (((uint64)Vector * Size + j) * sizeof(Type)) : (const uint8*)GetAxis(Index, j) + ((uint64)Vector * sizeof(Type)) };
+		memcpy(&Result[j], Component, sizeof(Type));
+	}
+	return Result;
+}
@@ -0,0 +1,321 @@
+#pragma once
+#include "../GlobalValues.h"
+#include "TMath.h"
+#include <limits>
+#include <type_traits>
+
+#if defined(_MSC_VER) && defined(_M_X64) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+
+
+// A fixed point number, an integer counting steps of 2^-Fraction.
+// Every operation is integer only, so results are bit identical on every machine and compiler.
+// Addition, subtraction and multiplication wrap around on overflow like integers do.
+// Multiplication and division round to the nearest step, halfway cases are rounded towards positive infinity.
+// Division saturates to the largest or lowest value on overflow and on division by zero.
+// @template Storage - The signed integer holding the number, int32 or int64.
+// @template Fraction - How many of the integer's bits are below the binary point.
+template <typename Storage, uint Fraction>
+struct STFixed
+{
+	ASSERT(std::is_same<Storage, int32>::value || std::is_same<Storage, int64>::value, "Fixed point numbers are stored in an int32 or an int64.");
+	ASSERT(Fraction > 0 && Fraction < sizeof(Storage) * 8 - 1, "A fixed point number needs at least one integer and one fraction bit.");
+
+private:
+	// The unsigned integer of the same size, arithmetic wraps around in it instead of overflowing.
+	typedef std::make_unsigned_t<Storage> SUnsigned;
+
+	// The step 1 is stored as.
+	static constexpr Storage OneBits{ (Storage)1 << Fraction };
+
+
+	/// Functions
+
+	// Returns the product of two numbers' bits, rounded to the nearest step.
+	static INLINE constexpr Storage Multiply(Storage A, Storage B);
+
+	// Returns the quotient of two numbers' bits, rounded to the nearest step.
+	static INLINE constexpr Storage Divide(Storage A, Storage B);
+
+
+public:
+	/// Properties
+
+	// The number in steps of 2^-Fraction.
+	Storage Bits;
+
+
+	/// Constructors
+
+	// Constructor, Default. The value is left uninitialized.
+	INLINE STFixed() = default;
+
+	// Constructor, Converts an integer or floating point value.
+	// @note - Floating point values are rounded to the nearest step, halfway cases away from zero, and clamped to the range.
+	// Integers wrap around if they are out of range.
+	template <typename Value>
+	INLINE constexpr explicit STFixed(Value InValue);
+
+	// Creates a number from its bits.
+	// @param InBits - The number in steps of 2^-Fraction.
+	static INLINE constexpr STFixed FromBits(Storage InBits) { STFixed Result; Result.Bits = InBits; return Result; }
+
+
+	/// Operators
+
+	// Operator, Converts to a floating point value, or to an integer rounded towards negative infinity.
+	template <typename Value>
+	INLINE constexpr explicit operator Value() const;
+
+	INLINE constexpr STFixed operator+(const STFixed& Other) const { return FromBits((Storage)((SUnsigned)Bits + (SUnsigned)Other.Bits)); }
+	INLINE constexpr STFixed operator-(const STFixed& Other) const { return FromBits((Storage)((SUnsigned)Bits - (SUnsigned)Other.Bits)); }
+	INLINE constexpr STFixed operator*(const STFixed& Other) const { return FromBits(Multiply(Bits, Other.Bits)); }
+	INLINE constexpr STFixed operator/(const STFixed& Other) const { return FromBits(Divide(Bits, Other.Bits)); }
+	INLINE constexpr STFixed operator-() const { return FromBits((Storage)(0 - (SUnsigned)Bits)); }
+	INLINE constexpr STFixed& operator+=(const STFixed& Other) { return *this = *this + Other; }
+	INLINE constexpr STFixed& operator-=(const STFixed& Other) { return *this = *this - Other; }
+	INLINE constexpr STFixed& operator*=(const STFixed& Other) { return *this = *this * Other; }
+	INLINE constexpr STFixed& operator/=(const STFixed& Other) { return *this = *this / Other; }
+	INLINE constexpr bool operator==(const STFixed& Other) const { return Bits == Other.Bits; }
+	INLINE constexpr bool operator!=(const STFixed& Other) const { return Bits != Other.Bits; }
+	INLINE constexpr bool operator<(const STFixed& Other) const { return Bits < Other.Bits; }
+	INLINE constexpr bool operator<=(const STFixed& Other) const { return Bits <= Other.Bits; }
+	INLINE constexpr bool operator>(const STFixed& Other) const { return Bits > Other.Bits; }
+	INLINE constexpr bool operator>=(const STFixed& Other) const { return Bits >= Other.Bits; }
+
+
+	/// Functions
+
+	// Returns the square root, rounded to the nearest step. Negative numbers return 0.
+	// @note - Estimated with a double square root, which IEEE 754 rounds the same everywhere, then corrected with integers.
+	INLINE STFixed Sqrt() const;
+};
+
+
+
+// A Q16.16 fixed point number, 16 integer bits including the sign and 16 fraction bits.
+// Covers -32768 to 32767.99998 in steps of 1.5e-5.
+typedef STFixed<int32, 16> SFixed;
+
+// A Q32.32 fixed point number, 32 integer bits including the sign and 32 fraction bits.
+// Covers -2147483648 to 2147483647.9999999998 in steps of 2.3e-10.
+typedef STFixed<int64, 32> SFixedd;
+
+
+
+// Helpers for the wide integer math of fixed point numbers.
+namespace TFixedMath
+{
+	// Multiplies two unsigned 64-bit integers into a 128-bit product.
+	// @param High - Set to the high 64 bits.
+	// @return - The low 64 bits.
+	INLINE constexpr uint64 MultiplyWide(uint64 A, uint64 B, uint64& High)
+	{
+		const uint64 ALow{ A & 0xFFFFFFFFull }, AHigh{ A >> 32 }, BLow{ B & 0xFFFFFFFFull }, BHigh{ B >> 32 };
+		const uint64 Low{ ALow * BLow }, MiddleA{ AHigh * BLow }, MiddleB{ ALow * BHigh };
+		const uint64 Middle{ (Low >> 32) + (MiddleA & 0xFFFFFFFFull) + (MiddleB & 0xFFFFFFFFull) };
+		High = (AHigh * BHigh) + (MiddleA >> 32) + (MiddleB >> 32) + (Middle >> 32);
+		return (Middle << 32) | (Low & 0xFFFFFFFFull);
+	}
+
+	// Divides a 128-bit unsigned integer by a 64-bit one, the quotient must fit in 64 bits.
+	// @param High - The high 64 bits of the dividend, must be less than the divisor.
+	// @param Low - The low 64 bits of the dividend.
+	// @param Divisor - What to divide by.
+	// @param Remainder - Set to the remainder.
+	// @return - The quotient.
+	INLINE constexpr uint64 DivideWide(uint64 High, uint64 Low, uint64 Divisor, uint64& Remainder)
+	{
+#if defined(__SIZEOF_INT128__)
+		const unsigned __int128 Dividend{ ((unsigned __int128)High << 64) | Low };
+		Remainder = (uint64)(Dividend % Divisor);
+		return (uint64)(Dividend / Divisor);
+#else
+#if defined(_MSC_VER) && defined(_M_X64) && !defined(__clang__)
+		if (!std::is_constant_evaluated()) return _udiv128(High, Low, Divisor, &Remainder);
+#endif
+		// Restoring division a bit at a time, the remainder's top bit is kept aside since it can be shifted out.
+		uint64 Quotient{ 0 };
+		for (uint i = 0; i < 64; ++i)
+		{
+			const bool Carry{ (High >> 63) != 0 };
+			High = (High << 1) | (Low >> 63);
+			Low <<= 1;
+			Quotient <<= 1;
+			if (Carry || High >= Divisor)
+			{
+				High -= Divisor;
+				Quotient |= 1;
+			}
+		}
+		Remainder = High;
+		return Quotient;
+#endif
+	}
+}
+
+
+
+namespace TMath
+{
+	// Returns the square root of a fixed point number, rounded to the nearest step. Negative numbers return 0.
+	template <typename Storage, uint Fraction>
+	INLINE STFixed<Storage, Fraction> Sqrt(STFixed<Storage, Fraction> Value) { return Value.Sqrt(); }
+
+	// Returns 1 / the square root of a fixed point number.
+	template <typename Storage, uint Fraction>
+	INLINE STFixed<Storage, Fraction> InvSqrt(STFixed<Storage, Fraction> Value) { return STFixed<Storage, Fraction>{ 1 } / Value.Sqrt(); }
+}
+
+
+
+// Fixed point numbers are exact, have no infinity or NaN and min is the smallest positive step like it is for floats.
+template <typename Storage, uint Fraction>
+class std::numeric_limits<STFixed<Storage, Fraction>>
+{
+public:
+	static constexpr bool is_specialized{ true };
+	static constexpr bool is_signed{ true };
+	static constexpr bool is_integer{ false };
+	static constexpr bool is_exact{ true };
+	static constexpr bool has_infinity{ false };
+	static constexpr bool has_quiet_NaN{ false };
+	static constexpr bool has_signaling_NaN{ false };
+	static constexpr bool is_bounded{ true };
+	static constexpr bool is_modulo{ true };
+	static constexpr int radix{ 2 };
+	static constexpr int digits{ std::numeric_limits<Storage>::digits };
+
+	static constexpr STFixed<Storage, Fraction> min() noexcept { return STFixed<Storage, Fraction>::FromBits(1); }
+	static constexpr STFixed<Storage, Fraction> max() noexcept { return STFixed<Storage, Fraction>::FromBits(std::numeric_limits<Storage>::max()); }
+	static constexpr STFixed<Storage, Fraction> lowest() noexcept { return STFixed<Storage, Fraction>::FromBits(std::numeric_limits<Storage>::lowest()); }
+	static constexpr STFixed<Storage, Fraction> epsilon() noexcept { return STFixed<Storage, Fraction>::FromBits(1); }
+	static constexpr STFixed<Storage, Fraction> round_error() noexcept { return STFixed<Storage, Fraction>::FromBits((Storage)1 << (Fraction - 1)); }
+};
+
+
+
+template <typename Storage, uint Fraction>
+template <typename Value>
+INLINE constexpr STFixed<Storage, Fraction>::STFixed(Value InValue)
+	:Bits{ 0 }
+{
+	if constexpr (std::is_floating_point<Value>::value)
+	{
+		// Clamped in double, whose 53 bits hold every int32 and round the int64 limits inwards.
+		const double Scaled{ (double)InValue * (double)OneBits };
+		constexpr double High{ (double)std::numeric_limits<Storage>::max() }, Low{ (double)std::numeric_limits<Storage>::lowest() };
+		if (!(Scaled < High)) Bits = (Scaled != Scaled) ? 0 : std::numeric_limits<Storage>::max();
+		else if (!(Scaled > Low)) Bits = std::numeric_limits<Storage>::lowest();
+		else Bits = (Storage)(Scaled + ((Scaled < 0.0) ? -0.5 : 0.5));
+	}
+	else
+	{
+		Bits = (Storage)((SUnsigned)(Storage)InValue << Fraction);
+	}
+}
+
+
+template <typename Storage, uint Fraction>
+template <typename Value>
+INLINE constexpr STFixed<Storage, Fraction>::operator Value() const
+{
+	if constexpr (std::is_floating_point<Value>::value) return (Value)((double)Bits * (1.0 / (double)OneBits));
+	else return (Value)(Bits >> Fraction);
+}
+
+
+template <typename Storage, uint Fraction>
+INLINE constexpr Storage STFixed<Storage, Fraction>::Multiply(Storage A, Storage B)
+{
+	constexpr Storage Half{ (Storage)1 << (Fraction - 1) };
+	if constexpr (sizeof(Storage) == 4)
+	{
+		return (Storage)(((int64)A * B + Half) >> Fraction);
+	}
+	else
+	{
+#if defined(__SIZEOF_INT128__)
+		return (Storage)((((__int128)A * B) + Half) >> Fraction);
+#else
+		// The unsigned product is corrected to the signed one by subtracting the other factor from the high half for each negative factor.
+		uint64 High;
+		uint64 Low{ TFixedMath::MultiplyWide((uint64)A, (uint64)B, High) };
+		High -= ((A < 0) ? (uint64)B : 0) + ((B < 0) ? (uint64)A : 0);
+		Low += (uint64)Half;
+		High += (Low < (uint64)Half) ? 1 : 0;
+		return (Storage)((Low >> Fraction) | (High << (64 - Fraction)));
+#endif
+	}
+}
+
+
+template <typename Storage, uint Fraction>
+INLINE constexpr Storage STFixed<Storage, Fraction>::Divide(Storage A, Storage B)
+{
+	const bool Negative{ (A < 0) != (B < 0) };
+	const uint64 Dividend{ (A < 0) ? 0 - (uint64)A : (uint64)A };
+	const uint64 Divisor{ (B < 0) ? 0 - (uint64)B : (uint64)B };
+	const uint64 Largest{ (uint64)std::numeric_limits<Storage>::max() + (Negative ? 1 : 0) };
+
+	uint64 Quotient{ Largest };
+	if (Divisor == 0)
+	{
+		if (Dividend == 0) return std::numeric_limits<Storage>::max();
+	}
+	else
+	{
+		// The dividend is shifted up by the fraction, only the bits shifted past 64 need the high half.
+		const uint64 High{ Dividend >> (64 - Fraction) };
+		uint64 Remainder{ 0 };
+		if constexpr (sizeof(Storage) == 4)
+		{
+			Quotient = (Dividend << Fraction) / Divisor;
+			Remainder = (Dividend << Fraction) % Divisor;
+		}
+		else if (High < Divisor)
+		{
+			Quotient = TFixedMath::DivideWide(High, Dividend << Fraction, Divisor, Remainder);
+		}
+
+		// Halfway cases round up for positive results and down in magnitude for negative ones, both towards positive infinity.
+		if (sizeof(Storage) == 4 || High < Divisor)
+		{
+			const uint64 Rest{ Divisor - Remainder };
+			if (Negative ? Remainder > Rest : Remainder >= Rest) ++Quotient;
+			if (Quotient > Largest) Quotient = Largest;
+		}
+	}
+	return Negative ? (Storage)(0 - Quotient) : (Storage)Quotient;
+}
+
+
+template <typename Storage, uint Fraction>
+INLINE STFixed<Storage, Fraction> STFixed<Storage, Fraction>::Sqrt() const
+{
+	if (Bits <= 0) return FromBits(0);
+
+	// The root of Bits * 2^Fraction, as a 128-bit integer when the shift passes 64 bits.
+	const uint64 Value{ (uint64)Bits };
+	const uint64 High{ Value >> (64 - Fraction) }, Low{ Value << Fraction };
+	uint64 Root{ (uint64)TMath::Sqrt((double)Value * (double)OneBits) };
+
+	// The estimate is within a step, Root^2 <= N < (Root + 1)^2 is restored with exact products.
+	auto Compare = [High, Low](uint64 Candidate)
+	{
+		uint64 SquareHigh;
+		const uint64 SquareLow{ TFixedMath::MultiplyWide(Candidate, Candidate, SquareHigh) };
+		return (SquareHigh != High) ? ((SquareHigh < High) ? -1 : 1) : ((SquareLow < Low) ? -1 : (SquareLow > Low) ? 1 : 0);
+	};
+	while (Compare(Root) > 0) --Root;
+	while (Compare(Root + 1) <= 0) ++Root;
+
+	// N is past the midpoint (Root + 0.5)^2 = Root^2 + Root + 0.25 when N - Root^2 > Root.
+	// The difference is less than 2^64, so the low halves subtract it exactly even when they borrow.
+	uint64 SquareHigh;
+	const uint64 SquareLow{ TFixedMath::MultiplyWide(Root, Root, SquareHigh) };
+	if (Low - SquareLow > Root) ++Root;
+	return FromBits((Storage)Root);
+}
@@ -0,0 +1,511 @@
+#pragma once
+#include "../Datatypes/Box.h"
+#include "../Datatypes/Matrix.h"
+#include "../Datatypes/VectorArray.h"
+#include "../Memory/Arena.h"
+#include "../Parallel/ThreadPool.h"
+#include <limits>
+#include <mutex>
+#include <numeric>
+
+
+
+// The order a reduction adds its values in.
+enum class ESumOrder : uint8
+{
+	Fast,		// Each piece is summed with several accumulators and the pieces are added as they finish, the result can change with the thread count.
+	Pairwise	// Fixed blocks are summed in a fixed order and then added in pairs, the result is the same on any thread count.
+};
+
+
+
+// Reductions over arrays of vectors, stored one after another or as a STVectorArray.
+// Each one runs over lanes with several accumulators, and can be split across SThreadPool::Get().
+// Min, Max and Bounds ignore NaN components, they are exact so their result never depends on the order.
+// @note - Pairwise results match across thread counts, not across builds with a different TNativeLanes.
+namespace TReduce
+{
+	/// Constants
+
+	// The fewest vectors a parallel reduction gives a thread.
+	constexpr uint ParallelGrain{ VectorGrain };
+
+	// How many vectors each block of a pairwise reduction holds.
+	constexpr uint PairwiseBlock{ 1024 };
+
+
+
+	/// Range Functions
+
+	// Runs a reduction over pieces of a range and combines the results.
+	// @param Count - How many values there are.
+	// @param Granularity - Every piece starts at a multiple of this.
+	// @param Order - How the pieces are combined, only Pairwise gives the same result for any thread count.
+	// @param Parallel - Should the pieces be split across the thread pool.
+	// @param Range - Takes the first and one past the last value of a piece and returns its result.
+	// @param Merge - Takes two results and returns their combination.
+	// @return - The combined result, Range(0, 0) if there are no values.
+	template <typename RangeFunction, typename MergeFunction>
+	INLINE auto Reduce(uint Count, uint Granularity, ESumOrder Order, bool Parallel, RangeFunction Range, MergeFunction Merge)
+	{
+		typedef decltype(Range(0u, 0u)) SResult;
+		if (Order == ESumOrder::Pairwise && Count > PairwiseBlock)
+		{
+			const uint Blocks{ (Count + PairwiseBlock - 1) / PairwiseBlock };
+			SArenaScope Scope;
+			SResult* Partials{ Scope.GetArena().Allocate<SResult>(Blocks) };
+			auto SumBlocks = [&](uint Begin, uint End)
+			{
+				for (uint i = Begin; i < End; ++i)
+				{
+					Partials[i] = Range(i * PairwiseBlock, std::min((i + 1) * PairwiseBlock, Count));
+				}
+			};
+			if (Parallel) ParallelFor(Blocks, SumBlocks, ParallelGrain / PairwiseBlock);
+			else SumBlocks(0, Blocks);
+
+			for (uint Stride = 1; Stride < Blocks; Stride *= 2)
+			{
+				for (uint i = 0; i + Stride < Blocks; i += Stride * 2)
+				{
+					Partials[i] = Merge(Partials[i], Partials[i + Stride]);
+				}
+			}
+			return Partials[0];
+		}
+
+		if (!Parallel || Count <= ParallelGrain) return Range(0, Count);
+
+		std::mutex Mutex;
+		SResult Total{ Range(0, 0) };
+		ParallelFor(Count, [&](uint Begin, uint End)
+			{
+				const SResult Piece{ Range(Begin, End) };
+				std::lock_guard<std::mutex> Lock{ Mutex };
+				Total = Merge(Total, Piece);
+			}, ParallelGrain, Granularity);
+		return Total;
+	}
+
+	// Returns true if an array of vectors can be read as one array of components.
+	template <uint Size, typename Type>
+	constexpr bool IsPacked{ sizeof(STVector<Size, Type>) == sizeof(Type) * Size };
+
+	// Sums a range of vectors stored one after another.
+	// @note - The components are read as a single stream of lanes, a whole number of vectors fit in every few registers.
+	// @param Vectors - The vectors.
+	// @param Begin - The first vector to sum.
+	// @param End - One past the last vector to sum.
+	template <uint Size, typename Type>
+	INLINE STVector<Size, Type> SumRange(const STVector<Size, Type>* Vectors, uint Begin, uint End)
+	{
+		Type Result[Size]{};
+		uint i{ Begin };
+		if constexpr (IsPacked<Size, Type>)
+		{
+			typedef TLanes<Type, TNativeLanes<Type>::Count> SLanes;
+			constexpr uint Lanes{ TNativeLanes<Type>::Count };
+			constexpr uint Registers{ std::lcm(Size, Lanes) / Lanes };
+			constexpr uint Accumulators{ Registers * ((4 + Registers - 1) / Registers) };
+			constexpr uint Step{ (Accumulators * Lanes) / Size };
+
+			if (End - Begin >= Step)
+			{
+				SLanes Sums[Accumulators];
+				for (uint j = 0; j < Accumulators; ++j) Sums[j] = SLanes{ (Type)0 };
+				for (; i + Step <= End; i += Step)
+				{
+					const Type* Data{ Vectors[i].GetData() };
+					for (uint j = 0; j < Accumulators; ++j)
+					{
+						Sums[j] = Sums[j] + SLanes::LoadUnaligned(Data + (j * Lanes));
+					}
+				}
+
+				// Accumulators a whole number of registers apart hold the same components.
+				alignas(64) Type Components[Registers * Lanes];
+				for (uint j = 0; j < Registers; ++j)
+				{
+					for (uint k = j + Registers; k < Accumulators; k += Registers) Sums[j] = Sums[j] + Sums[k];
+					Sums[j].Store(Components + (j * Lanes));
+				}
+				for (uint j = 0; j < Registers * Lanes; ++j) Result[j % Size] += Components[j];
+			}
+		}
+
+		for (; i < End; ++i)
+		{
+			for (uint j = 0; j < Size; ++j) Result[j] += Vectors[i][j];
+		}
+		STVector<Size, Type> Sum;
+		for (uint j = 0; j < Size; ++j) Sum[j] = Result[j];
+		return Sum;
+	}
+
+	// Sums a range of vectors in an array.
+	// @param Vectors - The vectors.
+	// @param Begin - The first vector to sum, a multiple of the array's lane count.
+	// @param End - One past the last vector to sum.
+	template <uint Size, typename Type>
+	INLINE STVector<Size, Type> SumRange(const STVectorArray<Size, Type>& Vectors, uint Begin, uint End)
+	{
+		typedef STVectorArray<Size, Type> SArray;
+		typedef typename SArray::SLanes SLanes;
+		constexpr uint Lanes{ SArray::Lanes };
+		STVector<Size, Type> Sum;
+		for (uint j = 0; j < Size; ++j)
+		{
+			const Type* Axis{ ASSUME_ALIGNED(Vectors.GetAxis(j), SArray::Alignment) };
+			SLanes Sums[4]{ SLanes{ (Type)0 }, SLanes{ (Type)0 }, SLanes{ (Type)0 }, SLanes{ (Type)0 } };
+			uint i{ Begin };
+			for (; i + (Lanes * 4) <= End; i += Lanes * 4)
+			{
+				for (uint k = 0; k < 4; ++k) Sums[k] = Sums[k] + SLanes::Load(Axis + i + (k * Lanes));
+			}
+			for (; i + Lanes <= End; i += Lanes) Sums[0] = Sums[0] + SLanes::Load(Axis + i);
+
+			Type Result{ ((Sums[0] + Sums[1]) + (Sums[2] + Sums[3])).ReduceAdd() };
+			for (; i < End; ++i) Result += Axis[i];
+			Sum[j] = Result;
+		}
+		return Sum;
+	}
+
+	// Finds the lowest and highest components of a range of vectors stored one after another.
+	// @template FindMin - Should the lowest components be found.
+	// @template FindMax - Should the highest components be found.
+	// @param Vectors - The vectors.
+	// @param Begin - The first vector.
+	// @param End - One past the last vector.
+	// @return - The box from the lowest to the highest components, empty if the range is.
+	template <bool FindMin, bool FindMax, uint Size, typename Type>
+	INLINE STBox<Size, Type> BoundsRange(const STVector<Size, Type>* Vectors, uint Begin, uint End)
+	{
+		Type Low[Size], High[Size];
+		for (uint j = 0; j < Size; ++j)
+		{
+			Low[j] = std::numeric_limits<Type>::max();
+			High[j] = std::numeric_limits<Type>::lowest();
+		}
+
+		uint i{ Begin };
+		if constexpr (IsPacked<Size, Type>)
+		{
+			typedef TLanes<Type, TNativeLanes<Type>::Count> SLanes;
+			constexpr uint Lanes{ TNativeLanes<Type>::Count };
+			constexpr uint Registers{ std::lcm(Size, Lanes) / Lanes };
+			constexpr uint Accumulators{ Registers * ((4 + Registers - 1) / Registers) };
+			constexpr uint Step{ (Accumulators * Lanes) / Size };
+
+			if (End - Begin >= Step)
+			{
+				SLanes Mins[Accumulators], Maxs[Accumulators];
+				for (uint j = 0; j < Accumulators; ++j)
+				{
+					Mins[j] = SLanes{ std::numeric_limits<Type>::max() };
+					Maxs[j] = SLanes{ std::numeric_limits<Type>::lowest() };
+				}
+
+				// The loaded value is the first argument, so a NaN gives back the accumulator.
+				for (; i + Step <= End; i += Step)
+				{
+					const Type* Data{ Vectors[i].GetData() };
+					for (uint j = 0; j < Accumulators; ++j)
+					{
+						const SLanes Values{ SLanes::LoadUnaligned(Data + (j * Lanes)) };
+						if constexpr (FindMin) Mins[j] = Values.Min(Mins[j]);
+						if constexpr (FindMax) Maxs[j] = Values.Max(Maxs[j]);
+					}
+				}
+
+				alignas(64) Type LowComponents[Registers * Lanes], HighComponents[Registers * Lanes];
+				for (uint j = 0; j < Registers; ++j)
+				{
+					for (uint k = j + Registers; k < Accumulators; k += Registers)
+					{
+						Mins[j] = Mins[j].Min(Mins[k]);
+						Maxs[j] = Maxs[j].Max(Maxs[k]);
+					}
+					Mins[j].Store(LowComponents + (j * Lanes));
+					Maxs[j].Store(HighComponents + (j * Lanes));
+				}
+				for (uint j = 0; j < Registers * Lanes; ++j)
+				{
+					Low[j % Size] = TMath::Min(Low[j % Size], LowComponents[j]);
+					High[j % Size] = TMath::Max(High[j % Size], HighComponents[j]);
+				}
+			}
+		}
+
+		for (; i < End; ++i)
+		{
+			for (uint j = 0; j < Size; ++j)
+			{
+				if constexpr (FindMin) Low[j] = (Vectors[i][j] < Low[j]) ? Vectors[i][j] : Low[j];
+				if constexpr (FindMax) High[j] = (Vectors[i][j] > High[j]) ? Vectors[i][j] : High[j];
+			}
+		}
+
+		STVector<Size, Type> Min, Max;
+		for (uint j = 0; j < Size; ++j)
+		{
+			Min[j] = Low[j];
+			Max[j] = High[j];
+		}
+		return STBox<Size, Type>{ Min, Max };
+	}
+
+	// Finds the lowest and highest components of a range of vectors in an array.
+	// @template FindMin - Should the lowest components be found.
+	// @template FindMax - Should the highest components be found.
+	// @param Vectors - The vectors.
+	// @param Begin - The first vector, a multiple of the array's lane count.
+	// @param End - One past the last vector.
+	// @return - The box from the lowest to the highest components, empty if the range is.
+	template <bool FindMin, bool FindMax, uint Size, typename Type>
+	INLINE STBox<Size, Type> BoundsRange(const STVectorArray<Size, Type>& Vectors, uint Begin, uint End)
+	{
+		typedef STVectorArray<Size, Type> SArray;
+		typedef typename SArray::SLanes SLanes;
+		constexpr uint Lanes{ SArray::Lanes };
+		STVector<Size, Type> Min, Max;
+		for (uint j = 0; j < Size; ++j)
+		{
+			const Type* Axis{ ASSUME_ALIGNED(Vectors.GetAxis(j), SArray::Alignment) };
+			SLanes Mins[2]{ SLanes{ std::numeric_limits<Type>::max() }, SLanes{ std::numeric_limits<Type>::max() } };
+			SLanes Maxs[2]{ SLanes{ std::numeric_limits<Type>::lowest() }, SLanes{ std::numeric_limits<Type>::lowest() } };
+			uint i{ Begin };
+			for (; i + Lanes <= End; i += Lanes)
+			{
+				const SLanes Values{ SLanes::Load(Axis + i) };
+				if constexpr (FindMin) Mins[(i / Lanes) & 1] = Values.Min(Mins[(i / Lanes) & 1]);
+				if constexpr (FindMax) Maxs[(i / Lanes) & 1] = Values.Max(Maxs[(i / Lanes) & 1]);
+			}
+
+			Type Low{ Mins[0].Min(Mins[1]).ReduceMin() }, High{ Maxs[0].Max(Maxs[1]).ReduceMax() };
+			for (; i < End; ++i)
+			{
+				Low = (Axis[i] < Low) ? Axis[i] : Low;
+				High = (Axis[i] > High) ? Axis[i] : High;
+			}
+			Min[j] = Low;
+			Max[j] = High;
+		}
+		return STBox<Size, Type>{ Min, Max };
+	}
+
+	// Sums the outer product of every vector in a range less a mean with itself, only the upper triangle is written.
+	// @param Vectors - The vectors.
+	// @param Begin - The first vector.
+	// @param End - One past the last vector.
+	// @param Mean - The value taken from every vector first.
+	template <uint Size, typename Type>
+	INLINE STMatrix<Size, Size, Type> CovarianceRange(const STVector<Size, Type>* Vectors, uint Begin, uint End, const STVector<Size, Type>& Mean)
+	{
+		typedef TLanes<Type, TNativeLanes<Type>::Count> SLanes;
+		constexpr uint Lanes{ TNativeLanes<Type>::Count };
+		SLanes Sums[Size][Size];
+		for (uint j = 0; j < Size; ++j)
+		{
+			for (uint k = j; k < Size; ++k) Sums[j][k] = SLanes{ (Type)0 };
+		}
+
+		// Each block of vectors is transposed on the stack so every axis fills a register.
+		uint i{ Begin };
+		for (; i + Lanes <= End; i += Lanes)
+		{
+			alignas(64) Type Block[Size][Lanes];
+			for (uint l = 0; l < Lanes; ++l)
+			{
+				for (uint j = 0; j < Size; ++j) Block[j][l] = Vectors[i + l][j];
+			}
+
+			SLanes Offsets[Size];
+			for (uint j = 0; j < Size; ++j) Offsets[j] = SLanes::Load(Block[j]) - SLanes{ Mean[j] };
+			for (uint j = 0; j < Size; ++j)
+			{
+				for (uint k = j; k < Size; ++k) Sums[j][k] = Offsets[j].MulAdd(Offsets[k], Sums[j][k]);
+			}
+		}
+
+		STMatrix<Size, Size, Type> Result;
+		for (uint j = 0; j < Size; ++j)
+		{
+			for (uint k = j; k < Size; ++k) Result[j][k] = Sums[j][k].ReduceAdd();
+		}
+		for (; i < End; ++i)
+		{
+			for (uint j = 0; j < Size; ++j)
+			{
+				for (uint k = j; k < Size; ++k) Result[j][k] += (Vectors[i][j] - Mean[j]) * (Vectors[i][k] - Mean[k]);
+			}
+		}
+		return Result;
+	}
+
+	// Sums the outer product of every vector in a range of an array less a mean with itself, only the upper triangle is written.
+	// @param Vectors - The vectors.
+	// @param Begin - The first vector, a multiple of the array's lane count.
+	// @param End - One past the last vector.
+	// @param Mean - The value taken from every vector first.
+	template <uint Size, typename Type>
+	INLINE STMatrix<Size, Size, Type> CovarianceRange(const STVectorArray<Size, Type>& Vectors, uint Begin, uint End, const STVector<Size, Type>& Mean)
+	{
+		typedef STVectorArray<Size, Type> SArray;
+		typedef typename SArray::SLanes SLanes;
+		constexpr uint Lanes{ SArray::Lanes };
+		SLanes Sums[Size][Size];
+		for (uint j = 0; j < Size; ++j)
+		{
+			for (uint k = j; k < Size; ++k) Sums[j][k] = SLanes{ (Type)0 };
+		}
+
+		uint i{ Begin };
+		for (; i + Lanes <= End; i += Lanes)
+		{
+			SLanes Offsets[Size];
+			for (uint j = 0; j < Size; ++j) Offsets[j] = SLanes::Load(Vectors.GetAxis(j) + i) - SLanes{ Mean[j] };
+			for (uint j = 0; j < Size; ++j)
+			{
+				for (uint k = j; k < Size; ++k) Sums[j][k] = Offsets[j].MulAdd(Offsets[k], Sums[j][k]);
+			}
+		}
+
+		STMatrix<Size, Size, Type> Result;
+		for (uint j = 0; j < Size; ++j)
+		{
+			for (uint k = j; k < Size; ++k) Result[j][k] = Sums[j][k].ReduceAdd();
+		}
+		for (; i < End; ++i)
+		{
+			for (uint j = 0; j < Size; ++j)
+			{
+				for (uint k = j; k < Size; ++k) Result[j][k] += (Vectors.GetAxis(j)[i] - Mean[j]) * (Vectors.GetAxis(k)[i] - Mean[k]);
+			}
+		}
+		return Result;
+	}
+
+
+
+	/// Functions
+
+	// Returns the sum of every vector.
+	// @param Vectors - The vectors, stored one after another or as a STVectorArray.
+	// @param Count - How many vectors there are, only for vectors stored one after another.
+	// @param Order - How the partial sums are combined.
+	// @param Parallel - Should the sum be split across the thread pool.
+	template <uint Size, typename Type>
+	INLINE STVector<Size, Type> Sum(const STVector<Size, Type>* Vectors, uint Count, ESumOrder Order = ESumOrder::Fast, bool Parallel = false)
+	{
+		return Reduce(Count, 1, Order, Parallel, [Vectors](uint Begin, uint End) { return SumRange(Vectors, Begin, End); }, [](const STVector<Size, Type>& A, const STVector<Size, Type>& B) { return A + B; });
+	}
+
+	template <uint Size, typename Type>
+	INLINE STVector<Size, Type> Sum(const STVectorArray<Size, Type>& Vectors, ESumOrder Order = ESumOrder::Fast, bool Parallel = false)
+	{
+		return Reduce(Vectors.Num(), STVectorArray<Size, Type>::Lanes, Order, Parallel, [&Vectors](uint Begin, uint End) { return SumRange(Vectors, Begin, End); }, [](const STVector<Size, Type>& A, const STVector<Size, Type>& B) { return A + B; });
+	}
+
+	// Returns the average of every vector, the centroid of a point set.
+	// @param Vectors - The vectors, stored one after another or as a STVectorArray.
+	// @param Count - How many vectors there are, only for vectors stored one after another.
+	// @param Order - How the partial sums are combined.
+	// @param Parallel - Should the sum be split across the thread pool.
+	// @return - The average, vector0 if there are no vectors.
+	template <uint Size, typename Type>
+	INLINE STVector<Size, Type> Mean(const STVector<Size, Type>* Vectors, uint Count, ESumOrder Order = ESumOrder::Fast, bool Parallel = false)
+	{
+		return (Count > 0) ? Sum(Vectors, Count, Order, Parallel) / (Type)Count : STVector<Size, Type>{ (Type)0 };
+	}
+
+	template <uint Size, typename Type>
+	INLINE STVector<Size, Type> Mean(const STVectorArray<Size, Type>& Vectors, ESumOrder Order = ESumOrder::Fast, bool Parallel = false)
+	{
+		return (Vectors.Num() > 0) ? Sum(Vectors, Order, Parallel) / (Type)Vectors.Num() : STVector<Size, Type>{ (Type)0 };
+	}
+
+	// Returns the smallest box containing every vector.
+	// @param Vectors - The vectors, stored one after another or as a STVectorArray.
+	// @param Count - How many vectors there are, only for vectors stored one after another.
+	// @param Parallel - Should the search be split across the thread pool.
+	// @return - The bounds, an empty box if there are no vectors.
+	template <uint Size, typename Type>
+	INLINE STBox<Size, Type> Bounds(const STVector<Size, Type>* Vectors, uint Count, bool Parallel = false)
+	{
+		return Reduce(Count, 1, ESumOrder::Fast, Parallel, [Vectors](uint Begin, uint End) { return BoundsRange<true, true>(Vectors, Begin, End); }, [](const STBox<Size, Type>& A, const STBox<Size, Type>& B) { return STBox<Size, Type>{ A.GetMin().Min(B.GetMin()), A.GetMax().Max(B.GetMax()) }; });
+	}
+
+	template <uint Size, typename Type>
+	INLINE STBox<Size, Type> Bounds(const STVectorArray<Size, Type>& Vectors, bool Parallel = false)
+	{
+		return Reduce(Vectors.Num(), STVectorArray<Size, Type>::Lanes, ESumOrder::Fast, Parallel, [&Vectors](uint Begin, uint End) { return BoundsRange<true, true>(Vectors, Begin, End); }, [](const STBox<Size, Type>& A, const STBox<Size, Type>& B) { return STBox<Size, Type>{ A.GetMin().Min(B.GetMin()), A.GetMax().Max(B.GetMax()) }; });
+	}
+
+	// Returns the lowest value in each dimension across every vector.
+	// @param Vectors - The vectors, stored one after another or as a STVectorArray.
+	// @param Count - How many vectors there are, only for vectors stored one after another.
+	// @param Parallel - Should the search be split across the thread pool.
+	// @return - The lowest values, the largest Type if there are no vectors.
+	template <uint Size, typename Type>
+	INLINE STVector<Size, Type> Min(const STVector<Size, Type>* Vectors, uint Count, bool Parallel = false)
+	{
+		return Reduce(Count, 1, ESumOrder::Fast, Parallel, [Vectors](uint Begin, uint End) { return BoundsRange<true, false>(Vectors, Begin, End).GetMin(); }, [](const STVector<Size, Type>& A, const STVector<Size, Type>& B) { return A.Min(B); });
+	}
+
+	template <uint Size, typename Type>
+	INLINE STVector<Size, Type> Min(const STVectorArray<Size, Type>& Vectors, bool Parallel = false)
+	{
+		return Reduce(Vectors.Num(), STVectorArray<Size, Type>::Lanes, ESumOrder::Fast, Parallel, [&Vectors](uint Begin, uint End) { return BoundsRange<true, false>(Vectors, Begin, End).GetMin(); }, [](const STVector<Size, Type>& A, const STVector<Size, Type>& B) { return A.Min(B); });
+	}
+
+	// Returns the highest value in each dimension across every vector.
+	// @param Vectors - The vectors, stored one after another or as a STVectorArray.
+	// @param Count - How many vectors there are, only for vectors stored one after another.
+	// @param Parallel - Should the search be split across the thread pool.
+	// @return - The highest values, the lowest Type if there are no vectors.
+	template <uint Size, typename Type>
+	INLINE STVector<Size, Type> Max(const STVector<Size, Type>* Vectors, uint Count, bool Parallel = false)
+	{
+		return Reduce(Count, 1, ESumOrder::Fast, Parallel, [Vectors](uint Begin, uint End) { return BoundsRange<false, true>(Vectors, Begin, End).GetMax(); }, [](const STVector<Size, Type>& A, const STVector<Size, Type>& B) { return A.Max(B); });
+	}
+
+	template <uint Size, typename Type>
+	INLINE STVector<Size, Type> Max(const STVectorArray<Size, Type>& Vectors, bool Parallel = false)
+	{
+		return Reduce(Vectors.Num(), STVectorArray<Size, Type>::Lanes, ESumOrder::Fast, Parallel, [&Vectors](uint Begin, uint End) { return BoundsRange<false, true>(Vectors, Begin, End).GetMax(); }, [](const STVector<Size, Type>& A, const STVector<Size, Type>& B) { return A.Max(B); });
+	}
+
+	// Returns the covariance matrix of a point set, each entry is the average product of two dimensions' offsets from the mean.
+	// @note - Divides by the count rather than the count less one, so it describes the points themselves, not a sample of more.
+	// @param Vectors - The vectors, stored one after another or as a STVectorArray.
+	// @param Count - How many vectors there are, only for vectors stored one after another.
+	// @param Order - How the partial sums are combined, both for the mean and the products.
+	// @param Parallel - Should both passes be split across the thread pool.
+	// @return - The symmetric covariance matrix, zero if there are no vectors.
+	template <uint Size, typename Type>
+	INLINE STMatrix<Size, Size, Type> Covariance(const STVector<Size, Type>* Vectors, uint Count, ESumOrder Order = ESumOrder::Fast, bool Parallel = false)
+	{
+		if (Count == 0) return STMatrix<Size, Size, Type>{ (Type)0 };
+		const STVector<Size, Type> Centroid{ Mean(Vectors, Count, Order, Parallel) };
+		STMatrix<Size, Size, Type> Result{ Reduce(Count, 1, Order, Parallel, [Vectors, &Centroid](uint Begin, uint End) { return CovarianceRange(Vectors, Begin, End, Centroid); }, [](const STMatrix<Size, Size, Type>& A, const STMatrix<Size, Size, Type>& B) { return A + B; }) };
+		for (uint j = 0; j < Size; ++j)
+		{
+			for (uint k = j; k < Size; ++k) Result[k][j] = Result[j][k] = Result[j][k] / (Type)Count;
+		}
+		return Result;
+	}
+
+	template <uint Size, typename Type>
+	INLINE STMatrix<Size, Size, Type> Covariance(const STVectorArray<Size, Type>& Vectors, ESumOrder Order = ESumOrder::Fast, bool Parallel = false)
+	{
+		if (Vectors.Num() == 0) return STMatrix<Size, Size, Type>{ (Type)0 };
+		const STVector<Size, Type> Centroid{ Mean(Vectors, Order, Parallel) };
+		STMatrix<Size, Size, Type> Result{ Reduce(Vectors.Num(), STVectorArray<Size, Type>::Lanes, Order, Parallel, [&Vectors, &Centroid](uint Begin, uint End) { return CovarianceRange(Vectors, Begin, End, Centroid); }, [](const STMatrix<Size, Size, Type>& A, const STMatrix<Size, Size, Type>& B) { return A + B; }) };
+		for (uint j = 0; j < Size; ++j)
+		{
+			for (uint k = j; k < Size; ++k) Result[k][j] = Result[j][k] = Result[j][k] / (Type)Vectors.Num();
+		}
+		return Result;
+	}
+}
@@ -0,0 +1,690 @@
+#pragma once
+#include "../GlobalValues.h"
+
+
+#ifndef COPIRITE_SIMD
+#define COPIRITE_SIMD
+
+
+// Detects which instruction sets the compiler is allowed to emit for this translation unit.
+// Define COPIRITE_NO_SIMD before including any CopiriteMath header to force the scalar paths.
+
+#ifndef COPIRITE_NO_SIMD
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define COPIRITE_SSE2 1
+#endif
+
+// MSVC has no SSE4.1 switch, /arch:AVX is the first option that guarantees it.
+#if defined(__SSE4_1__) || defined(__AVX__)
+#define COPIRITE_SSE41 1
+#endif
+
+#if defined(__AVX__)
+#define COPIRITE_AVX 1
+#endif
+
+#if defined(__AVX2__)
+#define COPIRITE_AVX2 1
+#endif
+
+#if defined(__FMA__) || (defined(_MSC_VER) && defined(__AVX2__))
+#define COPIRITE_FMA 1
+#endif
+
+// MSVC has no F16C switch, every CPU with AVX2 has it.
+#if defined(__F16C__) || (defined(_MSC_VER) && defined(__AVX2__))
+#define COPIRITE_F16C 1
+#endif
+
+#if defined(__AVX512F__)
+#define COPIRITE_AVX512 1
+#endif
+
+// MSVC has no BMI2 switch, every CPU with AVX2 has it.
+#if defined(__BMI2__) || (defined(_MSC_VER) && defined(__AVX2__))
+#define COPIRITE_BMI2 1
+#endif
+
+#endif // !COPIRITE_NO_SIMD
+
+
+#if defined(COPIRITE_SSE2)
+#include <immintrin.h>
+#endif
+
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+
+
+// The unsigned integer type with the same size as a lane type, used for the bit patterns of masks.
+// @template Type - The lane's datatype.
+template <typename Type>
+struct TLaneBits
+{
+	typedef uint32 Unsigned;
+};
+
+template <>
+struct TLaneBits<double>
+{
+	typedef uint64 Unsigned;
+};
+
+template <>
+struct TLaneBits<int64>
+{
+	typedef uint64 Unsigned;
+};
+
+
+
+// A group of values that are operated on together, mapped onto a SIMD register where the instruction set allows.
+// Comparisons return masks of the same type where a true lane has all its bits set.
+// @note - This generic version works on an array of values and is left for the compiler to vectorize.
+// @template Type - The datatype of each lane.
+// @template Count - How many lanes are operated on together.
+template <typename Type, uint Count>
+struct TLanes
+{
+private:
+	/// Properties
+
+	// The values of each lane.
+	Type Data[Count];
+
+	typedef typename TLaneBits<Type>::Unsigned Bits;
+
+
+	/// Functions
+
+	// Converts a lane to its bit pattern.
+	static INLINE Bits ToBits(Type Value)
+	{
+		Bits Result;
+		memcpy(&Result, &Value, sizeof(Type));
+		return Result;
+	}
+
+	// Converts a bit pattern to a lane.
+	static INLINE Type FromBits(Bits Value)
+	{
+		Type Result;
+		memcpy(&Result, &Value, sizeof(Type));
+		return Result;
+	}
+
+	// Creates a mask lane from a condition.
+	static INLINE Type MaskOf(bool Condition)
+	{
+		return FromBits(Condition ? ~Bits(0) : Bits(0));
+	}
+
+
+public:
+	// How many lanes are operated on together.
+	static constexpr uint Lanes{ Count };
+
+	/// Constructors
+
+	// Constructor, Default. The lanes are left uninitialized.
+	INLINE TLanes() = default;
+
+	// Constructor, Initializes all lanes with the inputted value.
+	// @param Value - The value used to initialize all lanes with.
+	INLINE TLanes(Type Value)
+	{
+		for (uint i = 0; i < Count; ++i) Data[i] = Value;
+	}
+
+
+	/// Operators
+
+	INLINE Type operator[](uint Index) const { return Data[Index]; }
+
+	INLINE friend TLanes operator+(const TLanes& A, const TLanes& B) { TLanes R; for (uint i = 0; i < Count; ++i) R.Data[i] = A.Data[i] + B.Data[i]; return R; }
+	INLINE friend TLanes operator-(const TLanes& A, const TLanes& B) { TLanes R; for (uint i = 0; i < Count; ++i) R.Data[i] = A.Data[i] - B.Data[i]; return R; }
+	INLINE friend TLanes operator*(const TLanes& A, const TLanes& B) { TLanes R; for (uint i = 0; i < Count; ++i) R.Data[i] = A.Data[i] * B.Data[i]; return R; }
+	INLINE friend TLanes operator/(const TLanes& A, const TLanes& B) { TLanes R; for (uint i = 0; i < Count; ++i) R.Data[i] = A.Data[i] / B.Data[i]; return R; }
+	INLINE friend TLanes operator-(const TLanes& A) { TLanes R; for (uint i = 0; i < Count; ++i) R.Data[i] = -A.Data[i]; return R; }
+
+	INLINE friend TLanes operator&(const TLanes& A, const TLanes& B) { TLanes R; for (uint i = 0; i < Count; ++i) R.Data[i] = FromBits(ToBits(A.Data[i]) & ToBits(B.Data[i])); return R; }
+	INLINE friend TLanes operator|(const TLanes& A, const TLanes& B) { TLanes R; for (uint i = 0; i < Count; ++i) R.Data[i] = FromBits(ToBits(A.Data[i]) | ToBits(B.Data[i])); return R; }
+	INLINE friend TLanes operator^(const TLanes& A, const TLanes& B) { TLanes R; for (uint i = 0; i < Count; ++i) R.Data[i] = FromBits(ToBits(A.Data[i]) ^ ToBits(B.Data[i])); return R; }
+
+	INLINE friend TLanes operator<(const TLanes& A, const TLanes& B) { TLanes R; for (uint i = 0; i < Count; ++i) R.Data[i] = MaskOf(A.Data[i] < B.Data[i]); return R; }
+	INLINE friend TLanes operator<=(const TLanes& A, const TLanes& B) { TLanes R; for (uint i = 0; i < Count; ++i) R.Data[i] = MaskOf(A.Data[i] <= B.Data[i]); return R; }
+	INLINE friend TLanes operator>(const TLanes& A, const TLanes& B) { TLanes R; for (uint i = 0; i < Count; ++i) R.Data[i] = MaskOf(A.Data[i] > B.Data[i]); return R; }
+	INLINE friend TLanes operator>=(const TLanes& A, const TLanes& B) { TLanes R; for (uint i = 0; i < Count; ++i) R.Data[i] = MaskOf(A.Data[i] >= B.Data[i]); return R; }
+	INLINE friend TLanes operator==(const TLanes& A, const TLanes& B) { TLanes R; for (uint i = 0; i < Count; ++i) R.Data[i] = MaskOf(A.Data[i] == B.Data[i]); return R; }
+	INLINE friend TLanes operator!=(const TLanes& A, const TLanes& B) { TLanes R; for (uint i = 0; i < Count; ++i) R.Data[i] = MaskOf(A.Data[i] != B.Data[i]); return R; }
+
+
+	/// Functions
+
+	// Loads lanes from memory aligned to the size of all lanes.
+	// @param Values - The values to load.
+	// @return - The resulting lanes.
+	static INLINE TLanes Load(const Type* Values) { TLanes R; for (uint i = 0; i < Count; ++i) R.Data[i] = Values[i]; return R; }
+
+	// Loads lanes from memory with any alignment.
+	// @param Values - The values to load.
+	// @return - The resulting lanes.
+	static INLINE TLanes LoadUnaligned(const Type* Values) { return Load(Values); }
+
+	// Stores the lanes to memory aligned to the size of all lanes.
+	// @param Values - Where to store the lanes.
+	INLINE void Store(Type* Values) const { for (uint i = 0; i < Count; ++i) Values[i] = Data[i]; }
+
+	// Stores the lanes to memory with any alignment.
+	// @param Values - Where to store the lanes.
+	INLINE void StoreUnaligned(Type* Values) const { Store(Values); }
+
+	// Returns the lowest value in each lane between these lanes and other lanes.
+	INLINE TLanes Min(const TLanes& Other) const { TLanes R; for (uint i = 0; i < Count; ++i) R.Data[i] = (Data[i] < Other.Data[i]) ? Data[i] : Other.Data[i]; return R; }
+
+	// Returns the highest value in each lane between these lanes and other lanes.
+	INLINE TLanes Max(const TLanes& Other) const { TLanes R; for (uint i = 0; i < Count; ++i) R.Data[i] = (Data[i] > Other.Data[i]) ? Data[i] : Other.Data[i]; return R; }
+
+	// Returns the square root of each lane.
+	INLINE TLanes Sqrt() const { TLanes R; for (uint i = 0; i < Count; ++i) R.Data[i] = (Type)std::sqrt(Data[i]); return R; }
+
+	// Returns the absolute value of each lane.
+	INLINE TLanes Abs() const { TLanes R; for (uint i = 0; i < Count; ++i) R.Data[i] = (Data[i] < (Type)0) ? -Data[i] : Data[i]; return R; }
+
+	// Returns each lane rounded to the nearest integer, halfway cases are rounded to even.
+	INLINE TLanes Round() const { TLanes R; for (uint i = 0; i < Count; ++i) R.Data[i] = (Type)std::nearbyint(Data[i]); return R; }
+
+	// Returns an estimate of 1 / sqrt of each lane.
+	// @note - The relative error depends on the lane type, it is at most 1.5 * 2^-12 for floats.
+	INLINE TLanes InvSqrtEstimate() const { TLanes R; for (uint i = 0; i < Count; ++i) R.Data[i] = (Type)1 / (Type)std::sqrt(Data[i]); return R; }
+
+	// Returns (this * B) + C for each lane.
+	INLINE TLanes MulAdd(const TLanes& B, const TLanes& C) const { return (*this * B) + C; }
+
+	// Uses this mask to pick each lane from one of two inputs.
+	// @param IfTrue - The lanes used where the mask is set.
+	// @param IfFalse - The lanes used where the mask is not set.
+	// @return - The resulting lanes.
+	INLINE TLanes Select(const TLanes& IfTrue, const TLanes& IfFalse) const
+	{
+		TLanes R;
+		for (uint i = 0; i < Count; ++i) R.Data[i] = (ToBits(Data[i]) >> (sizeof(Type) * 8 - 1)) ? IfTrue.Data[i] : IfFalse.Data[i];
+		return R;
+	}
+
+	// Returns a bit for each lane of this mask, the first lane is the lowest bit.
+	INLINE uint MoveMask() const
+	{
+		uint Result{ 0 };
+		for (uint i = 0; i < Count; ++i) Result |= uint(ToBits(Data[i]) >> (sizeof(Type) * 8 - 1)) << i;
+		return Result;
+	}
+
+	// Returns the sum of all lanes.
+	INLINE Type ReduceAdd() const { Type R{ Data[0] }; for (uint i = 1; i < Count; ++i) R += Data[i]; return R; }
+
+	// Returns the lowest of all lanes.
+	INLINE Type ReduceMin() const { Type R{ Data[0] }; for (uint i = 1; i < Count; ++i) R = (Data[i] < R) ? Data[i] : R; return R; }
+
+	// Returns the highest of all lanes.
+	INLINE Type ReduceMax() const { Type R{ Data[0] }; for (uint i = 1; i < Count; ++i) R = (Data[i] > R) ? Data[i] : R; return R; }
+};
+
+
+
+#if defined(COPIRITE_SSE2)
+
+template <>
+struct TLanes<float, 4>
+{
+private:
+	__m128 R;
+
+public:
+	static constexpr uint Lanes{ 4 };
+
+	INLINE TLanes() = default;
+	INLINE TLanes(float Value) :R{ _mm_set1_ps(Value) } {}
+	INLINE TLanes(__m128 InR) :R{ InR } {}
+	// Returns the underlying register.
+	INLINE __m128 Get() const { return R; }
+
+	INLINE float operator[](uint Index) const { alignas(16) float V[4]; _mm_store_ps(V, R); return V[Index]; }
+
+	INLINE friend TLanes operator+(const TLanes& A, const TLanes& B) { return _mm_add_ps(A.R, B.R); }
+	INLINE friend TLanes operator-(const TLanes& A, const TLanes& B) { return _mm_sub_ps(A.R, B.R); }
+	INLINE friend TLanes operator*(const TLanes& A, const TLanes& B) { return _mm_mul_ps(A.R, B.R); }
+	INLINE friend TLanes operator/(const TLanes& A, const TLanes& B) { return _mm_div_ps(A.R, B.R); }
+	INLINE friend TLanes operator-(const TLanes& A) { return _mm_xor_ps(A.R, _mm_set1_ps(-0.0f)); }
+
+	INLINE friend TLanes operator&(const TLanes& A, const TLanes& B) { return _mm_and_ps(A.R, B.R); }
+	INLINE friend TLanes operator|(const TLanes& A, const TLanes& B) { return _mm_or_ps(A.R, B.R); }
+	INLINE friend TLanes operator^(const TLanes& A, const TLanes& B) { return _mm_xor_ps(A.R, B.R); }
+
+	INLINE friend TLanes operator<(const TLanes& A, const TLanes& B) { return _mm_cmplt_ps(A.R, B.R); }
+	INLINE friend TLanes operator<=(const TLanes& A, const TLanes& B) { return _mm_cmple_ps(A.R, B.R); }
+	INLINE friend TLanes operator>(const TLanes& A, const TLanes& B) { return _mm_cmpgt_ps(A.R, B.R); }
+	INLINE friend TLanes operator>=(const TLanes& A, const TLanes& B) { return _mm_cmpge_ps(A.R, B.R); }
+	INLINE friend TLanes operator==(const TLanes& A, const TLanes& B) { return _mm_cmpeq_ps(A.R, B.R); }
+	INLINE friend TLanes operator!=(const TLanes& A, const TLanes& B) { return _mm_cmpneq_ps(A.R, B.R); }
+
+	static INLINE TLanes Load(const float* Values) { return _mm_load_ps(Values); }
+	static INLINE TLanes LoadUnaligned(const float* Values) { return _mm_loadu_ps(Values); }
+	INLINE void Store(float* Values) const { _mm_store_ps(Values, R); }
+	INLINE void StoreUnaligned(float* Values) const { _mm_storeu_ps(Values, R); }
+
+	INLINE TLanes Min(const TLanes& Other) const { return _mm_min_ps(R, Other.R); }
+	INLINE TLanes Max(const TLanes& Other) const { return _mm_max_ps(R, Other.R); }
+	INLINE TLanes Sqrt() const { return _mm_sqrt_ps(R); }
+	INLINE TLanes Abs() const { return _mm_andnot_ps(_mm_set1_ps(-0.0f), R); }
+
+	INLINE TLanes Round() const
+	{
+#if defined(COPIRITE_SSE41)
+		return _mm_round_ps(R, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+#else
+		// Adding and subtracting 2^23 rounds away the fraction, lanes at or above 2^23 are already integers.
+		__m128 Magic{ _mm_or_ps(_mm_and_ps(R, _mm_set1_ps(-0.0f)), _mm_set1_ps(8388608.0f)) };
+		__m128 Small{ _mm_cmplt_ps(_mm_andnot_ps(_mm_set1_ps(-0.0f), R), _mm_set1_ps(8388608.0f)) };
+		__m128 Rounded{ _mm_sub_ps(_mm_add_ps(R, Magic), Magic) };
+		return _mm_or_ps(_mm_and_ps(Small, Rounded), _mm_andnot_ps(Small, R));
+#endif
+	}
+
+	INLINE TLanes InvSqrtEstimate() const { return _mm_rsqrt_ps(R); }
+
+	INLINE TLanes MulAdd(const TLanes& B, const TLanes& C) const
+	{
+#if defined(COPIRITE_FMA)
+		return _mm_fmadd_ps(R, B.R, C.R);
+#else
+		return _mm_add_ps(_mm_mul_ps(R, B.R), C.R);
+#endif
+	}
+
+	INLINE TLanes Select(const TLanes& IfTrue, const TLanes& IfFalse) const
+	{
+#if defined(COPIRITE_SSE41)
+		return _mm_blendv_ps(IfFalse.R, IfTrue.R, R);
+#else
+		return _mm_or_ps(_mm_and_ps(R, IfTrue.R), _mm_andnot_ps(R, IfFalse.R));
+#endif
+	}
+
+	INLINE uint MoveMask() const { return (uint)_mm_movemask_ps(R); }
+
+	INLINE float ReduceAdd() const
+	{
+		__m128 S{ _mm_add_ps(R, _mm_movehl_ps(R, R)) };
+		return _mm_cvtss_f32(_mm_add_ss(S, _mm_shuffle_ps(S, S, _MM_SHUFFLE(1, 1, 1, 1))));
+	}
+
+	INLINE float ReduceMin() const
+	{
+		__m128 S{ _mm_min_ps(R, _mm_movehl_ps(R, R)) };
+		return _mm_cvtss_f32(_mm_min_ss(S, _mm_shuffle_ps(S, S, _MM_SHUFFLE(1, 1, 1, 1))));
+	}
+
+	INLINE float ReduceMax() const
+	{
+		__m128 S{ _mm_max_ps(R, _mm_movehl_ps(R, R)) };
+		return _mm_cvtss_f32(_mm_max_ss(S, _mm_shuffle_ps(S, S, _MM_SHUFFLE(1, 1, 1, 1))));
+	}
+};
+
+#endif // COPIRITE_SSE2
+
+
+#if defined(COPIRITE_AVX)
+
+template <>
+struct TLanes<float, 8>
+{
+private:
+	__m256 R;
+
+public:
+	static constexpr uint Lanes{ 8 };
+
+	INLINE TLanes() = default;
+	INLINE TLanes(float Value) :R{ _mm256_set1_ps(Value) } {}
+	INLINE TLanes(__m256 InR) :R{ InR } {}
+	// Returns the underlying register.
+	INLINE __m256 Get() const { return R; }
+
+	INLINE float operator[](uint Index) const { alignas(32) float V[8]; _mm256_store_ps(V, R); return V[Index]; }
+
+	INLINE friend TLanes operator+(const TLanes& A, const TLanes& B) { return _mm256_add_ps(A.R, B.R); }
+	INLINE friend TLanes operator-(const TLanes& A, const TLanes& B) { return _mm256_sub_ps(A.R, B.R); }
+	INLINE friend TLanes operator*(const TLanes& A, const TLanes& B) { return _mm256_mul_ps(A.R, B.R); }
+	INLINE friend TLanes operator/(const TLanes& A, const TLanes& B) { return _mm256_div_ps(A.R, B.R); }
+	INLINE friend TLanes operator-(const TLanes& A) { return _mm256_xor_ps(A.R, _mm256_set1_ps(-0.0f)); }
+
+	INLINE friend TLanes operator&(const TLanes& A, const TLanes& B) { return _mm256_and_ps(A.R, B.R); }
+	INLINE friend TLanes operator|(const TLanes& A, const TLanes& B) { return _mm256_or_ps(A.R, B.R); }
+	INLINE friend TLanes operator^(const TLanes& A, const TLanes& B) { return _mm256_xor_ps(A.R, B.R); }
+
+	INLINE friend TLanes operator<(const TLanes& A, const TLanes& B) { return _mm256_cmp_ps(A.R, B.R, _CMP_LT_OQ); }
+	INLINE friend TLanes operator<=(const TLanes& A, const TLanes& B) { return _mm256_cmp_ps(A.R, B.R, _CMP_LE_OQ); }
+	INLINE friend TLanes operator>(const TLanes& A, const TLanes& B) { return _mm256_cmp_ps(A.R, B.R, _CMP_GT_OQ); }
+	INLINE friend TLanes operator>=(const TLanes& A, const TLanes& B) { return _mm256_cmp_ps(A.R, B.R, _CMP_GE_OQ); }
+	INLINE friend TLanes operator==(const TLanes& A, const TLanes& B) { return _mm256_cmp_ps(A.R, B.R, _CMP_EQ_OQ); }
+	INLINE friend TLanes operator!=(const TLanes& A, const TLanes& B) { return _mm256_cmp_ps(A.R, B.R, _CMP_NEQ_UQ); }
+
+	static INLINE TLanes Load(const float* Values) { return _mm256_load_ps(Values); }
+	static INLINE TLanes LoadUnaligned(const float* Values) { return _mm256_loadu_ps(Values); }
+	INLINE void Store(float* Values) const { _mm256_store_ps(Values, R); }
+	INLINE void StoreUnaligned(float* Values) const { _mm256_storeu_ps(Values, R); }
+
+	INLINE TLanes Min(const TLanes& Other) const { return _mm256_min_ps(R, Other.R); }
+	INLINE TLanes Max(const TLanes& Other) const { return _mm256_max_ps(R, Other.R); }
+	INLINE TLanes Sqrt() const { return _mm256_sqrt_ps(R); }
+	INLINE TLanes Abs() const { return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), R); }
+	INLINE TLanes Round() const { return _mm256_round_ps(R, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+	INLINE TLanes InvSqrtEstimate() const { return _mm256_rsqrt_ps(R); }
+
+	INLINE TLanes MulAdd(const TLanes& B, const TLanes& C) const
+	{
+#if defined(COPIRITE_FMA)
+		return _mm256_fmadd_ps(R, B.R, C.R);
+#else
+		return _mm256_add_ps(_mm256_mul_ps(R, B.R), C.R);
+#endif
+	}
+
+	INLINE TLanes Select(const TLanes& IfTrue, const TLanes& IfFalse) const { return _mm256_blendv_ps(IfFalse.R, IfTrue.R, R); }
+	INLINE uint MoveMask() const { return (uint)_mm256_movemask_ps(R); }
+
+	INLINE float ReduceAdd() const { return TLanes<float, 4>(_mm_add_ps(_mm256_castps256_ps128(R), _mm256_extractf128_ps(R, 1))).ReduceAdd(); }
+	INLINE float ReduceMin() const { return TLanes<float, 4>(_mm_min_ps(_mm256_castps256_ps128(R), _mm256_extractf128_ps(R, 1))).ReduceMin(); }
+	INLINE float ReduceMax() const { return TLanes<float, 4>(_mm_max_ps(_mm256_castps256_ps128(R), _mm256_extractf128_ps(R, 1))).ReduceMax(); }
+};
+
+
+template <>
+struct TLanes<double, 4>
+{
+private:
+	__m256d R;
+
+public:
+	static constexpr uint Lanes{ 4 };
+
+	INLINE TLanes() = default;
+	INLINE TLanes(double Value) :R{ _mm256_set1_pd(Value) } {}
+	INLINE TLanes(__m256d InR) :R{ InR } {}
+	// Returns the underlying register.
+	INLINE __m256d Get() const { return R; }
+
+	INLINE double operator[](uint Index) const { alignas(32) double V[4]; _mm256_store_pd(V, R); return V[Index]; }
+
+	INLINE friend TLanes operator+(const TLanes& A, const TLanes& B) { return _mm256_add_pd(A.R, B.R); }
+	INLINE friend TLanes operator-(const TLanes& A, const TLanes& B) { return _mm256_sub_pd(A.R, B.R); }
+	INLINE friend TLanes operator*(const TLanes& A, const TLanes& B) { return _mm256_mul_pd(A.R, B.R); }
+	INLINE friend TLanes operator/(const TLanes& A, const TLanes& B) { return _mm256_div_pd(A.R, B.R); }
+	INLINE friend TLanes operator-(const TLanes& A) { return _mm256_xor_pd(A.R, _mm256_set1_pd(-0.0)); }
+
+	INLINE friend TLanes operator&(const TLanes& A, const TLanes& B) { return _mm256_and_pd(A.R, B.R); }
+	INLINE friend TLanes operator|(const TLanes& A, const TLanes& B) { return _mm256_or_pd(A.R, B.R); }
+	INLINE friend TLanes operator^(const TLanes& A, const TLanes& B) { return _mm256_xor_pd(A.R, B.R); }
+
+	INLINE friend TLanes operator<(const TLanes& A, const TLanes& B) { return _mm256_cmp_pd(A.R, B.R, _CMP_LT_OQ); }
+	INLINE friend TLanes operator<=(const TLanes& A, const TLanes& B) { return _mm256_cmp_pd(A.R, B.R, _CMP_LE_OQ); }
+	INLINE friend TLanes operator>(const TLanes& A, const TLanes& B) { return _mm256_cmp_pd(A.R, B.R, _CMP_GT_OQ); }
+	INLINE friend TLanes operator>=(const TLanes& A, const TLanes& B) { return _mm256_cmp_pd(A.R, B.R, _CMP_GE_OQ); }
+	INLINE friend TLanes operator==(const TLanes& A, const TLanes& B) { return _mm256_cmp_pd(A.R, B.R, _CMP_EQ_OQ); }
+	INLINE friend TLanes operator!=(const TLanes& A, const TLanes& B) { return _mm256_cmp_pd(A.R, B.R, _CMP_NEQ_UQ); }
+
+	static INLINE TLanes Load(const double* Values) { return _mm256_load_pd(Values); }
+	static INLINE TLanes LoadUnaligned(const double* Values) { return _mm256_loadu_pd(Values); }
+	INLINE void Store(double* Values) const { _mm256_store_pd(Values, R); }
+	INLINE void StoreUnaligned(double* Values) const { _mm256_storeu_pd(Values, R); }
+
+	INLINE TLanes Min(const TLanes& Other) const { return _mm256_min_pd(R, Other.R); }
+	INLINE TLanes Max(const TLanes& Other) const { return _mm256_max_pd(R, Other.R); }
+	INLINE TLanes Sqrt() const { return _mm256_sqrt_pd(R); }
+	INLINE TLanes Abs() const { return _mm256_andnot_pd(_mm256_set1_pd(-0.0), R); }
+	INLINE TLanes Round() const { return _mm256_round_pd(R, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+
+	// There is no double estimate before AVX-512, the exact value is returned instead.
+	INLINE TLanes InvSqrtEstimate() const { return _mm256_div_pd(_mm256_set1_pd(1.0), _mm256_sqrt_pd(R)); }
+
+	INLINE TLanes MulAdd(const TLanes& B, const TLanes& C) const
+	{
+#if defined(COPIRITE_FMA)
+		return _mm256_fmadd_pd(R, B.R, C.R);
+#else
+		return _mm256_add_pd(_mm256_mul_pd(R, B.R), C.R);
+#endif
+	}
+
+	INLINE TLanes Select(const TLanes& IfTrue, const TLanes& IfFalse) const { return _mm256_blendv_pd(IfFalse.R, IfTrue.R, R); }
+	INLINE uint MoveMask() const { return (uint)_mm256_movemask_pd(R); }
+
+	INLINE double ReduceAdd() const
+	{
+		__m128d S{ _mm_add_pd(_mm256_castpd256_pd128(R), _mm256_extractf128_pd(R, 1)) };
+		return _mm_cvtsd_f64(_mm_add_sd(S, _mm_unpackhi_pd(S, S)));
+	}
+
+	INLINE double ReduceMin() const
+	{
+		__m128d S{ _mm_min_pd(_mm256_castpd256_pd128(R), _mm256_extractf128_pd(R, 1)) };
+		return _mm_cvtsd_f64(_mm_min_sd(S, _mm_unpackhi_pd(S, S)));
+	}
+
+	INLINE double ReduceMax() const
+	{
+		__m128d S{ _mm_max_pd(_mm256_castpd256_pd128(R), _mm256_extractf128_pd(R, 1)) };
+		return _mm_cvtsd_f64(_mm_max_sd(S, _mm_unpackhi_pd(S, S)));
+	}
+};
+
+#endif // COPIRITE_AVX
+
+
+#if defined(COPIRITE_AVX512)
+
+template <>
+struct TLanes<float, 16>
+{
+private:
+	__m512 R;
+
+	// AVX-512 comparisons produce bit masks, they are expanded to lanes to match the other lane types.
+	static INLINE __m512 FromMask(__mmask16 Mask) { return _mm512_castsi512_ps(_mm512_maskz_set1_epi32(Mask, -1)); }
+	INLINE __mmask16 ToMask() const { return _mm512_test_epi32_mask(_mm512_castps_si512(R), _mm512_castps_si512(R)); }
+
+public:
+	static constexpr uint Lanes{ 16 };
+
+	INLINE TLanes() = default;
+	INLINE TLanes(float Value) :R{ _mm512_set1_ps(Value) } {}
+	INLINE TLanes(__m512 InR) :R{ InR } {}
+	// Returns the underlying register.
+	INLINE __m512 Get() const { return R; }
+
+	INLINE float operator[](uint Index) const { alignas(64) float V[16]; _mm512_store_ps(V, R); return V[Index]; }
+
+	INLINE friend TLanes operator+(const TLanes& A, const TLanes& B) { return _mm512_add_ps(A.R, B.R); }
+	INLINE friend TLanes operator-(const TLanes& A, const TLanes& B) { return _mm512_sub_ps(A.R, B.R); }
+	INLINE friend TLanes operator*(const TLanes& A, const TLanes& B) { return _mm512_mul_ps(A.R, B.R); }
+	INLINE friend TLanes operator/(const TLanes& A, const TLanes& B) { return _mm512_div_ps(A.R, B.R); }
+	INLINE friend TLanes operator-(const TLanes& A) { return _mm512_castsi512_ps(_mm512_xor_si512(_mm512_castps_si512(A.R), _mm512_set1_epi32(INT32_MIN))); }
+
+	INLINE friend TLanes operator&(const TLanes& A, const TLanes& B) { return _mm512_castsi512_ps(_mm512_and_si512(_mm512_castps_si512(A.R), _mm512_castps_si512(B.R))); }
+	INLINE friend TLanes operator|(const TLanes& A, const TLanes& B) { return _mm512_castsi512_ps(_mm512_or_si512(_mm512_castps_si512(A.R), _mm512_castps_si512(B.R))); }
+	INLINE friend TLanes operator^(const TLanes& A, const TLanes& B) { return _mm512_castsi512_ps(_mm512_xor_si512(_mm512_castps_si512(A.R), _mm512_castps_si512(B.R))); }
+
+	INLINE friend TLanes operator<(const TLanes& A, const TLanes& B) { return FromMask(_mm512_cmp_ps_mask(A.R, B.R, _CMP_LT_OQ)); }
+	INLINE friend TLanes operator<=(const TLanes& A, const TLanes& B) { return FromMask(_mm512_cmp_ps_mask(A.R, B.R, _CMP_LE_OQ)); }
+	INLINE friend TLanes operator>(const TLanes& A, const TLanes& B) { return FromMask(_mm512_cmp_ps_mask(A.R, B.R, _CMP_GT_OQ)); }
+	INLINE friend TLanes operator>=(const TLanes& A, const TLanes& B) { return FromMask(_mm512_cmp_ps_mask(A.R, B.R, _CMP_GE_OQ)); }
+	INLINE friend TLanes operator==(const TLanes& A, const TLanes& B) { return FromMask(_mm512_cmp_ps_mask(A.R, B.R, _CMP_EQ_OQ)); }
+	INLINE friend TLanes operator!=(const TLanes& A, const TLanes& B) { return FromMask(_mm512_cmp_ps_mask(A.R, B.R, _CMP_NEQ_UQ)); }
+
+	static INLINE TLanes Load(const float* Values) { return _mm512_load_ps(Values); }
+	static INLINE TLanes LoadUnaligned(const float* Values) { return _mm512_loadu_ps(Values); }
+	INLINE void Store(float* Values) const { _mm512_store_ps(Values, R); }
+	INLINE void StoreUnaligned(float* Values) const { _mm512_storeu_ps(Values, R); }
+
+	INLINE TLanes Min(const TLanes& Other) const { return _mm512_min_ps(R, Other.R); }
+	INLINE TLanes Max(const TLanes& Other) const { return _mm512_max_ps(R, Other.R); }
+	INLINE TLanes Sqrt() const { return _mm512_sqrt_ps(R); }
+	INLINE TLanes Abs() const { return _mm512_abs_ps(R); }
+	INLINE TLanes Round() const { return _mm512_roundscale_ps(R, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+	INLINE TLanes InvSqrtEstimate() const { return _mm512_rsqrt14_ps(R); }
+	INLINE TLanes MulAdd(const TLanes& B, const TLanes& C) const { return _mm512_fmadd_ps(R, B.R, C.R); }
+	INLINE TLanes Select(const TLanes& IfTrue, const TLanes& IfFalse) const { return _mm512_mask_blend_ps(ToMask(), IfFalse.R, IfTrue.R); }
+	INLINE uint MoveMask() const { return (uint)ToMask(); }
+
+	INLINE float ReduceAdd() const { return _mm512_reduce_add_ps(R); }
+	INLINE float ReduceMin() const { return _mm512_reduce_min_ps(R); }
+	INLINE float ReduceMax() const { return _mm512_reduce_max_ps(R); }
+};
+
+#endif // COPIRITE_AVX512
+
+
+
+// The widest lane count the enabled instruction sets can operate on in a single register.
+// @template Type - The lane's datatype.
+template <typename Type>
+struct TNativeLanes
+{
+	static constexpr uint Count{ 8 };
+};
+
+template <>
+struct TNativeLanes<float>
+{
+#if defined(COPIRITE_AVX512)
+	static constexpr uint Count{ 16 };
+#elif defined(COPIRITE_AVX)
+	static constexpr uint Count{ 8 };
+#else
+	static constexpr uint Count{ 4 };
+#endif
+};
+
+template <>
+struct TNativeLanes<double>
+{
+	static constexpr uint Count{ 4 };
+};
+
+
+// Stream compaction of lane masks, turns the lanes a mask keeps into a packed list of their indices.
+namespace TCompact
+{
+	// For every 4 bit mask, the lanes of its set bits with the lowest first. The rest are 0.
+	struct SLaneTable4
+	{
+		alignas(16) uint32 Lanes[16][4];
+	};
+
+	// For every 8 bit mask, the lanes of its set bits packed 4 bits each with the lowest first.
+	struct SLaneTable8
+	{
+		uint32 Lanes[256];
+	};
+
+	inline constexpr SLaneTable4 LaneTable4{ []()
+		{
+			SLaneTable4 Table{};
+			for (uint Mask = 0; Mask < 16; ++Mask)
+			{
+				uint Kept{ 0 };
+				for (uint i = 0; i < 4; ++i)
+				{
+					if ((Mask >> i) & 1) Table.Lanes[Mask][Kept++] = i;
+				}
+			}
+			return Table;
+		}() };
+
+	inline constexpr SLaneTable8 LaneTable8{ []()
+		{
+			SLaneTable8 Table{};
+			for (uint Mask = 0; Mask < 256; ++Mask)
+			{
+				uint Kept{ 0 };
+				for (uint i = 0; i < 8; ++i)
+				{
+					if ((Mask >> i) & 1) Table.Lanes[Mask] |= i << (4 * Kept++);
+				}
+			}
+			return Table;
+		}() };
+
+	// Writes the index of every lane a mask keeps, lowest first.
+	// @template Count - How many lanes the mask covers, at most 16.
+	// @param Mask - The lanes to keep, as returned by MoveMask().
+	// @param Base - The index of the first lane.
+	// @param Out - Receives the indices. Up to Count are written, the ones past the returned count hold nothing useful.
+	// @return - How many indices were kept.
+	template <uint Count>
+	INLINE uint CompressIndices(uint Mask, uint32 Base, uint32* Out)
+	{
+		ASSERT(Count <= 16, "Masks of more than 16 lanes are not supported.");
+		const uint Kept{ (uint)std::popcount(Mask) };
+
+#if defined(COPIRITE_AVX512)
+		// Only the kept indices are stored, nothing past them is touched.
+		const __m512i Indices{ _mm512_add_epi32(_mm512_set1_epi32((int)Base), _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15)) };
+		_mm512_mask_storeu_epi32(Out, (__mmask16)((1u << Kept) - 1), _mm512_maskz_compress_epi32((__mmask16)Mask, Indices));
+		return Kept;
+#else
+#if defined(COPIRITE_AVX2)
+		if constexpr (Count == 8)
+		{
+			const __m256i Packed{ _mm256_srlv_epi32(_mm256_set1_epi32((int)LaneTable8.Lanes[Mask]), _mm256_setr_epi32(0, 4, 8, 12, 16, 20, 24, 28)) };
+			_mm256_storeu_si256((__m256i*)Out, _mm256_add_epi32(_mm256_and_si256(Packed, _mm256_set1_epi32(15)), _mm256_set1_epi32((int)Base)));
+			return Kept;
+		}
+#endif
+#if defined(COPIRITE_SSE2)
+		if constexpr ((Count % 4) == 0)
+		{
+			uint32* Next{ Out };
+			for (uint i = 0; i < Count; i += 4)
+			{
+				const uint Quad{ (Mask >> i) & 15 };
+				_mm_storeu_si128((__m128i*)Next, _mm_add_epi32(_mm_load_si128((const __m128i*)LaneTable4.Lanes[Quad]), _mm_set1_epi32((int)(Base + i))));
+				Next += std::popcount(Quad);
+			}
+			return Kept;
+		}
+#endif
+		// Every lane is written and only kept ones move the output on, so there are no branches to mispredict.
+		uint32* Next{ Out };
+		for (uint i = 0; i < Count; ++i)
+		{
+			*Next = Base + i;
+			Next += (Mask >> i) & 1;
+		}
+		return Kept;
+#endif
+	}
+}
+
+
+
+// 4 floats operated on together.
+typedef TLanes<float, 4> SFloat4;
+
+// 8 floats operated on together.
+typedef TLanes<float, 8> SFloat8;
+
+// 16 floats operated on together.
+typedef TLanes<float, 16> SFloat16;
+
+// 4 doubles operated on together.
+typedef TLanes<double, 4> SDouble4;
+
+
+#endif // !COPIRITE_SIMD
@@ -0,0 +1,333 @@
+#pragma once
+#include "SIMD.h"
+#include "../Datatypes/Box.h"
+#include "../Datatypes/VectorArray.h"
+#include "../Memory/Arena.h"
+#include "../Parallel/RadixSort.h"
+#include <numeric>
+#include <type_traits>
+
+
+// Keys along space filling curves, which visit every cell of a grid so that cells close on the curve are close in space.
+// Sorting points by their key puts points that are near each other near each other in memory.
+// Morton keys interleave the bits of the coordinates, the lowest bit is x. With BMI2 they are a single pdep or pext per axis,
+// otherwise the bits are spread with shifts and masks. Prefer the shifts on AMD CPUs before Zen 3, where pdep and pext are slow.
+// Hilbert keys never jump between cells that are not neighbours, so they keep better locality at a higher cost to compute.
+// @note - 2D keys use the lowest 32 bits of each coordinate and 3D keys the lowest 21, as unsigned integers.
+
+
+
+// The space filling curves keys can follow.
+enum class ESpaceCurve : uint8
+{
+	Morton,
+	Hilbert
+};
+
+
+
+namespace TSpaceCurve
+{
+	// How many bits of each coordinate a key holds, for each number of dimensions.
+	// @template Size - 2 or 3 dimensions.
+	template <uint Size>
+	constexpr uint KeyBits{ (Size == 2) ? 32 : 21 };
+
+	// How many bits points are quantized to, 2D stops at 31 so every coordinate is a positive int.
+	// @template Size - 2 or 3 dimensions.
+	template <uint Size>
+	constexpr uint QuantizeBits{ (Size == 2) ? 31 : 21 };
+
+	// Spreads the lowest 32 bits of a value out to every second bit.
+	INLINE constexpr uint64 Spread2(uint64 Value)
+	{
+#if defined(COPIRITE_BMI2)
+		if (!std::is_constant_evaluated()) return _pdep_u64(Value, 0x5555555555555555ull);
+#endif
+		Value &= 0xFFFFFFFFull;
+		Value = (Value | (Value << 16)) & 0x0000FFFF0000FFFFull;
+		Value = (Value | (Value << 8)) & 0x00FF00FF00FF00FFull;
+		Value = (Value | (Value << 4)) & 0x0F0F0F0F0F0F0F0Full;
+		Value = (Value | (Value << 2)) & 0x3333333333333333ull;
+		return (Value | (Value << 1)) & 0x5555555555555555ull;
+	}
+
+	// Gathers every second bit of a value, the opposite of Spread2().
+	INLINE constexpr uint64 Compact2(uint64 Value)
+	{
+#if defined(COPIRITE_BMI2)
+		if (!std::is_constant_evaluated()) return _pext_u64(Value, 0x5555555555555555ull);
+#endif
+		Value &= 0x5555555555555555ull;
+		Value = (Value | (Value >> 1)) & 0x3333333333333333ull;
+		Value = (Value | (Value >> 2)) & 0x0F0F0F0F0F0F0F0Full;
+		Value = (Value | (Value >> 4)) & 0x00FF00FF00FF00FFull;
+		Value = (Value | (Value >> 8)) & 0x0000FFFF0000FFFFull;
+		return (Value | (Value >> 16)) & 0x00000000FFFFFFFFull;
+	}
+
+	// Spreads the lowest 21 bits of a value out to every third bit.
+	INLINE constexpr uint64 Spread3(uint64 Value)
+	{
+#if defined(COPIRITE_BMI2)
+		if (!std::is_constant_evaluated()) return _pdep_u64(Value, 0x1249249249249249ull);
+#endif
+		Value &= 0x1FFFFFull;
+		Value = (Value | (Value << 32)) & 0x001F00000000FFFFull;
+		Value = (Value | (Value << 16)) & 0x001F0000FF0000FFull;
+		Value = (Value | (Value << 8)) & 0x100F00F00F00F00Full;
+		Value = (Value | (Value << 4)) & 0x10C30C30C30C30C3ull;
+		return (Value | (Value << 2)) & 0x1249249249249249ull;
+	}
+
+	// Gathers every third bit of a value, the opposite of Spread3().
+	INLINE constexpr uint64 Compact3(uint64 Value)
+	{
+#if defined(COPIRITE_BMI2)
+		if (!std::is_constant_evaluated()) return _pext_u64(Value, 0x1249249249249249ull);
+#endif
+		Value &= 0x1249249249249249ull;
+		Value = (Value | (Value >> 2)) & 0x10C30C30C30C30C3ull;
+		Value = (Value | (Value >> 4)) & 0x100F00F00F00F00Full;
+		Value = (Value | (Value >> 8)) & 0x001F0000FF0000FFull;
+		Value = (Value | (Value >> 16)) & 0x001F00000000FFFFull;
+		return (Value | (Value >> 32)) & 0x00000000001FFFFFull;
+	}
+
+	// Returns the Morton key of a 2D cell.
+	INLINE constexpr uint64 Morton(const SVector2i& Cell) { return Spread2((uint32)Cell[0]) | (Spread2((uint32)Cell[1]) << 1); }
+
+	// Returns the Morton key of a 3D cell.
+	INLINE constexpr uint64 Morton(const SVector3i& Cell) { return Spread3((uint32)Cell[0]) | (Spread3((uint32)Cell[1]) << 1) | (Spread3((uint32)Cell[2]) << 2); }
+
+	// Returns the 2D cell of a Morton key.
+	INLINE constexpr SVector2i MortonDecode2(uint64 Key) { return SVector2i{ (int)Compact2(Key), (int)Compact2(Key >> 1) }; }
+
+	// Returns the 3D cell of a Morton key.
+	INLINE constexpr SVector3i MortonDecode3(uint64 Key) { return SVector3i{ (int)Compact3(Key), (int)Compact3(Key >> 1), (int)Compact3(Key >> 2) }; }
+
+	// Turns coordinates into the transposed Hilbert index, Skilling's method. The index' bits are the coordinates' bits interleaved
+	// with the first coordinate highest, so interleaving them as a Morton key in reverse order gives the Hilbert key.
+	// @template Size - How many coordinates there are.
+	// @param X - The coordinates, replaced by the transposed index.
+	// @param Bits - How many bits each coordinate has.
+	template <uint Size>
+	INLINE constexpr void AxesToTranspose(uint32 (&X)[Size], uint Bits)
+	{
+		// Undoes the rotations and reflections of each level from the top down.
+		for (uint32 Q = 1u << (Bits - 1); Q > 1; Q >>= 1)
+		{
+			const uint32 P{ Q - 1 };
+			for (uint i = 0; i < Size; ++i)
+			{
+				if (X[i] & Q)
+				{
+					X[0] ^= P;
+				}
+				else
+				{
+					const uint32 T{ (X[0] ^ X[i]) & P };
+					X[0] ^= T;
+					X[i] ^= T;
+				}
+			}
+		}
+
+		// Gray encodes.
+		for (uint i = 1; i < Size; ++i)
+		{
+			X[i] ^= X[i - 1];
+		}
+		uint32 T{ 0 };
+		for (uint32 Q = 1u << (Bits - 1); Q > 1; Q >>= 1)
+		{
+			if (X[Size - 1] & Q) T ^= Q - 1;
+		}
+		for (uint i = 0; i < Size; ++i)
+		{
+			X[i] ^= T;
+		}
+	}
+
+	// Turns the transposed Hilbert index back into coordinates, the opposite of AxesToTranspose().
+	// @template Size - How many coordinates there are.
+	// @param X - The transposed index, replaced by the coordinates.
+	// @param Bits - How many bits each coordinate has.
+	template <uint Size>
+	INLINE constexpr void TransposeToAxes(uint32 (&X)[Size], uint Bits)
+	{
+		// Gray decodes.
+		const uint32 T{ X[Size - 1] >> 1 };
+		for (uint i = Size - 1; i > 0; --i)
+		{
+			X[i] ^= X[i - 1];
+		}
+		X[0] ^= T;
+
+		// Redoes the rotations and reflections of each level from the bottom up.
+		for (uint64 Q = 2; Q != (2ull << (Bits - 1)); Q <<= 1)
+		{
+			const uint32 P{ (uint32)Q - 1 };
+			for (uint i = Size; i-- > 0;)
+			{
+				if (X[i] & (uint32)Q)
+				{
+					X[0] ^= P;
+				}
+				else
+				{
+					const uint32 U{ (X[0] ^ X[i]) & P };
+					X[0] ^= U;
+					X[i] ^= U;
+				}
+			}
+		}
+	}
+
+	// Returns the Hilbert key of a 2D cell.
+	INLINE constexpr uint64 Hilbert(const SVector2i& Cell)
+	{
+		uint32 X[2]{ (uint32)Cell[0], (uint32)Cell[1] };
+		AxesToTranspose(X, KeyBits<2>);
+		return Spread2(X[1]) | (Spread2(X[0]) << 1);
+	}
+
+	// Returns the Hilbert key of a 3D cell.
+	INLINE constexpr uint64 Hilbert(const SVector3i& Cell)
+	{
+		uint32 X[3]{ (uint32)Cell[0] & 0x1FFFFFu, (uint32)Cell[1] & 0x1FFFFFu, (uint32)Cell[2] & 0x1FFFFFu };
+		AxesToTranspose(X, KeyBits<3>);
+		return Spread3(X[2]) | (Spread3(X[1]) << 1) | (Spread3(X[0]) << 2);
+	}
+
+	// Returns the 2D cell of a Hilbert key.
+	INLINE constexpr SVector2i HilbertDecode2(uint64 Key)
+	{
+		uint32 X[2]{ (uint32)Compact2(Key >> 1), (uint32)Compact2(Key) };
+		TransposeToAxes(X, KeyBits<2>);
+		return SVector2i{ (int)X[0], (int)X[1] };
+	}
+
+	// Returns the 3D cell of a Hilbert key.
+	INLINE constexpr SVector3i HilbertDecode3(uint64 Key)
+	{
+		uint32 X[3]{ (uint32)Compact3(Key >> 2), (uint32)Compact3(Key >> 1), (uint32)Compact3(Key) };
+		TransposeToAxes(X, KeyBits<3>);
+		return SVector3i{ (int)X[0], (int)X[1], (int)X[2] };
+	}
+
+	// Returns the key of a cell on a curve.
+	// @template Size - 2 or 3 dimensions.
+	template <uint Size>
+	INLINE constexpr uint64 GetKey(const STVector<Size, int>& Cell, ESpaceCurve Curve) { return (Curve == ESpaceCurve::Morton) ? Morton(Cell) : Hilbert(Cell); }
+
+	// Returns the grid cell a point is in, with the bounds split into 2^QuantizeBits cells along each axis.
+	// @param Point - The point, clamped to the bounds.
+	// @param Bounds - The space the grid covers.
+	template <uint Size, typename Type>
+	INLINE STVector<Size, int> Quantize(const STVector<Size, Type>& Point, const STBox<Size, Type>& Bounds)
+	{
+		ASSERT(Size == 2 || Size == 3, "Space filling curves are only defined for 2 and 3 dimensions.");
+		constexpr double Cells{ (double)((1ull << QuantizeBits<Size>) - 1) };
+		STVector<Size, int> Result;
+		for (uint i = 0; i < Size; ++i)
+		{
+			// Computed in double so no float rounds up past the last cell.
+			const double Range{ (double)Bounds.GetMax()[i] - (double)Bounds.GetMin()[i] };
+			const double Scaled{ (Range > 0.0) ? (((double)Point[i] - (double)Bounds.GetMin()[i]) / Range) * Cells : 0.0 };
+			Result[i] = (int)((Scaled > 0.0) ? ((Scaled < Cells) ? Scaled : Cells) : 0.0);
+		}
+		return Result;
+	}
+
+	// Sets the key of every point along a curve through their bounds, split across the shared pool.
+	// @param Points - The points.
+	// @param Count - How many points there are.
+	// @param Curve - The curve to follow.
+	// @param Keys - Receives Count keys.
+	template <uint Size, typename Type>
+	INLINE void GetKeys(const STVector<Size, Type>* Points, uint Count, ESpaceCurve Curve, uint64* Keys)
+	{
+		const STBox<Size, Type> Bounds{ STBox<Size, Type>::FromPoints(Points, Count) };
+		ParallelTransform(Points, Keys, Count, [&Bounds, Curve](const STVector<Size, Type>& Point) { return GetKey(Quantize(Point, Bounds), Curve); });
+	}
+
+	// Sets the key of every point of an array along a curve through their bounds, split across the shared pool.
+	// @param Points - The points.
+	// @param Curve - The curve to follow.
+	// @param Keys - Receives Points.Num() keys.
+	template <uint Size, typename Type>
+	INLINE void GetKeys(const STVectorArray<Size, Type>& Points, ESpaceCurve Curve, uint64* Keys)
+	{
+		STBox<Size, Type> Bounds;
+		for (uint i = 0; i < Points.Num(); ++i)
+		{
+			Bounds += STVector<Size, Type>{ Points[i] };
+		}
+		ParallelFor(Points.Num(), [&Points, &Bounds, Curve, Keys](uint Begin, uint End)
+			{
+				for (uint i = Begin; i < End; ++i)
+				{
+					Keys[i] = GetKey(Quantize(STVector<Size, Type>{ Points[i] }, Bounds), Curve);
+				}
+			}, 4096, 8);
+	}
+
+	// Finds the order that sorts points along a curve, points with the same key keep their order.
+	// @param Keys - The key of each point, sorted in place.
+	// @param Count - How many keys there are.
+	// @param Order - Receives the index of the point that goes in each place.
+	INLINE void SortKeys(uint64* Keys, uint Count, uint32* Order)
+	{
+		SArenaScope Scope;
+		std::iota(Order, Order + Count, 0u);
+		ParallelRadixSort(Keys, Order, Count, Scope.GetArena().Allocate<uint64>(Count), Scope.GetArena().Allocate<uint32>(Count));
+	}
+
+	// Reorders points along a curve through their bounds, so points near each other in space are near each other in memory.
+	// @note - The scratch space comes from the calling thread's arena.
+	// @param Points - The points, reordered in place.
+	// @param Count - How many points there are.
+	// @param Curve - The curve to follow.
+	// @param OutOrder - Receives the index each point had before sorting, for reordering anything stored alongside them.
+	template <uint Size, typename Type>
+	INLINE void Sort(STVector<Size, Type>* Points, uint Count, ESpaceCurve Curve = ESpaceCurve::Hilbert, uint32* OutOrder = nullptr)
+	{
+		SArenaScope Scope;
+		SArena& Arena{ Scope.GetArena() };
+		uint64* const Keys{ Arena.Allocate<uint64>(Count) };
+		uint32* const Order{ OutOrder ? OutOrder : Arena.Allocate<uint32>(Count) };
+		GetKeys(Points, Count, Curve, Keys);
+		SortKeys(Keys, Count, Order);
+
+		STVector<Size, Type>* const Original{ Arena.Allocate<STVector<Size, Type>>(Count) };
+		std::copy(Points, Points + Count, Original);
+		ParallelTransform(Order, Points, Count, [Original](uint32 Index) { return Original[Index]; });
+	}
+
+	// Reorders the points of an array along a curve through their bounds, so points near each other in space are near each other in memory.
+	// @note - The scratch space comes from the calling thread's arena.
+	// @param Points - The points, reordered in place.
+	// @param Curve - The curve to follow.
+	// @param OutOrder - Receives the index each point had before sorting, for reordering anything stored alongside them.
+	template <uint Size, typename Type>
+	INLINE void Sort(STVectorArray<Size, Type>& Points, ESpaceCurve Curve = ESpaceCurve::Hilbert, uint32* OutOrder = nullptr)
+	{
+		const uint Count{ Points.Num() };
+		SArenaScope Scope;
+		SArena& Arena{ Scope.GetArena() };
+		uint64* const Keys{ Arena.Allocate<uint64>(Count) };
+		uint32* const Order{ OutOrder ? OutOrder : Arena.Allocate<uint32>(Count) };
+		GetKeys(Points, Curve, Keys);
+		SortKeys(Keys, Count, Order);
+
+		// Each axis is gathered through one scratch axis, then copied back.
+		Type* const Axis{ Arena.Allocate<Type>(Count) };
+		for (uint j = 0; j < Size; ++j)
+		{
+			Type* Values{ Points.GetAxis(j) };
+			ParallelTransform(Order, Axis, Count, [Values](uint32 Index) { return Values[Index]; });
+			std::copy(Axis, Axis + Count, Values);
+		}
+	}
+}
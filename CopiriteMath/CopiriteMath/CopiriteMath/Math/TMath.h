@@ -0,0 +1,394 @@
+#pragma once
+#include "../GlobalValues.h"
+#include "SIMD.h"
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+
+#ifndef COPIRITE_TMATH
+#define COPIRITE_TMATH
+
+
+// Converts radians to degrees.
+#define TO_DEGREES(Radians) ((Radians) * (180.0f / PI))
+
+// Converts degrees to radians.
+#define TO_RADIANS(Degrees) ((Degrees) * (PI / 180.0f))
+
+
+
+// Scalar and lane versions of the math functions used by the datatypes.
+// The exact functions match the standard library, the Fast functions trade a few ULP of accuracy for not calling into libm
+// and have lane overloads so the same code can run on SFloat4, SFloat8 and SFloat16.
+// Errors are measured against the correctly rounded result, in ULP (units in the last place) of a float.
+namespace TMath
+{
+	/// Constants
+
+	// Pi split into parts of 7 significant bits, so multiplying them by any integer below 2^17 is exact.
+	// Used for the range reduction of FastSin and FastCos, the last part holds the remainder.
+	constexpr float PI_A{ 3.125f };
+	constexpr float PI_B{ 0.016357421875f };
+	constexpr float PI_C{ 0.0002346038818359375f };
+	constexpr float PI_D{ 6.278329465203569e-07f };
+
+	// The largest magnitude FastSin and FastCos reduce exactly.
+	constexpr float FAST_TRIG_RANGE{ 100000.0f };
+
+
+
+	/// Scalar Functions
+
+	// Returns the absolute value of a value.
+	template <typename Type>
+	INLINE constexpr Type Abs(Type Value) { return (Value < (Type)0) ? -Value : Value; }
+
+	// Returns the lowest of two values.
+	template <typename Type>
+	INLINE constexpr Type Min(Type A, Type B) { return (A < B) ? A : B; }
+
+	// Returns the highest of two values.
+	template <typename Type>
+	INLINE constexpr Type Max(Type A, Type B) { return (A > B) ? A : B; }
+
+	// Limits a value to a range.
+	// @param Value - The value to limit.
+	// @param Low - The lowest value allowed.
+	// @param High - The highest value allowed.
+	// @return - The limited value.
+	template <typename Type>
+	INLINE constexpr Type Clamp(Type Value, Type Low, Type High) { return Min(Max(Value, Low), High); }
+
+	// Returns a value unchanged, but hidden from the optimizer so a product passed through it is rounded before it is added
+	// and can not be fused into an FMA. The empty asm keeps the value in its register, so it costs no instructions.
+	// Used where two functions must round the same sums the same way whatever -ffp-contract or /fp: setting they are built with.
+	// @template Type - A float, double or TLanes.
+	template <typename Type>
+	INLINE constexpr Type Unfused(Type Value)
+	{
+		if (std::is_constant_evaluated()) return Value;
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+		if constexpr (std::is_floating_point<Type>::value)
+		{
+			__asm__("" : "+v"(Value));
+		}
+		else if constexpr (requires { Type{ Value.Get() }; })
+		{
+			auto Register{ Value.Get() };
+			__asm__("" : "+v"(Register));
+			Value = Type{ Register };
+		}
+		else
+		{
+			__asm__("" : "+m"(Value));
+		}
+#elif defined(__GNUC__) || defined(__clang__)
+		__asm__("" : "+m"(Value));
+#endif
+		return Value;
+	}
+
+	// Tests if a value is NaN.
+	template <typename Type>
+	INLINE constexpr bool IsNaN(Type Value)
+	{
+		if constexpr (std::is_floating_point<Type>::value) return Value != Value;
+		else return false;
+	}
+
+	// Tests if a value is neither NaN nor infinite.
+	// @note - Branchless, X - X is only NaN when X is NaN or infinite. Integers are always finite.
+	template <typename Type>
+	INLINE constexpr bool IsFinite(Type Value)
+	{
+		if constexpr (std::is_floating_point<Type>::value) return (Value - Value) == (Value - Value);
+		else return true;
+	}
+
+	// Rounds a value to the nearest integer, halfway cases are rounded away from zero.
+	// @note - Only valid for values that fit in an int64.
+	template <typename Type>
+	INLINE constexpr Type Round(Type Value) { return (Type)(int64)(Value + ((Value < (Type)0) ? (Type)-0.5 : (Type)0.5)); }
+
+	// Rounds a float to the nearest integer, halfway cases are rounded to even like the lanes' Round().
+	// @note - Adding 1.5 * 2^23 leaves no bits for a fraction, floats at or above 2^23 are already integers.
+	INLINE constexpr float RoundEven(float Value) { return (Abs(Value) < 8388608.0f) ? (Value + 12582912.0f) - 12582912.0f : Value; }
+
+	// Returns A * B + C with a single rounding wherever the lanes' MulAdd fuses, so scalar and lane functions built on it agree.
+	// @note - Constant expressions always round twice, std::fma is not constexpr.
+	template <typename Type>
+	INLINE constexpr Type MulAdd(Type A, Type B, Type C)
+	{
+#if defined(COPIRITE_FMA)
+		if (!std::is_constant_evaluated()) return std::fma(A, B, C);
+#endif
+		return (A * B) + C;
+	}
+
+	// Returns the square root of a value with Newton's method, for constant expressions.
+	// @note - Within 1 ULP, the iteration stops once it no longer gets closer.
+	INLINE constexpr double ConstantSqrt(double Value)
+	{
+		if (Value != Value || Value < 0.0) return std::numeric_limits<double>::quiet_NaN();
+		if (Value == 0.0 || Value == std::numeric_limits<double>::infinity()) return Value;
+
+		// Halving the exponent gives a guess within a factor of 2, every step after the first stays above the root.
+		double Root{ std::bit_cast<double>((std::bit_cast<uint64>(Value) >> 1) + 0x1FF8000000000000ull) };
+		Root = 0.5 * (Root + (Value / Root));
+		for (uint i = 0; i < 64; ++i)
+		{
+			const double Next{ 0.5 * (Root + (Value / Root)) };
+			if (Next >= Root) break;
+			Root = Next;
+		}
+		return Root;
+	}
+
+	// Returns the square root of a value.
+	// @note - Floats and doubles use the sqrtss and sqrtsd instructions so no libm call or errno handling is made.
+	//	Constant expressions use ConstantSqrt instead, exact for floats and within 1 ULP for doubles.
+	template <typename Type>
+	INLINE constexpr Type Sqrt(Type Value)
+	{
+		if (std::is_constant_evaluated()) return (Type)ConstantSqrt((double)Value);
+#if defined(COPIRITE_SSE2)
+		if constexpr (std::is_same<Type, float>::value) return _mm_cvtss_f32(_mm_sqrt_ss(_mm_set_ss(Value)));
+		else if constexpr (std::is_same<Type, double>::value) return _mm_cvtsd_f64(_mm_sqrt_sd(_mm_setzero_pd(), _mm_set_sd(Value)));
+		else
+#endif
+		if constexpr (std::is_floating_point<Type>::value) return std::sqrt(Value);
+		else return (Type)std::sqrt((double)Value);
+	}
+
+	// Returns 1 / sqrt of a value.
+	template <typename Type>
+	INLINE Type InvSqrt(Type Value) { return (Type)1 / Sqrt(Value); }
+
+	// Returns an approximation of 1 / sqrt of a value.
+	// With SSE this is rsqrtss followed by one Newton-Raphson step, otherwise an integer estimate followed by three.
+	// @note - Max error 4 ULP for normal positive inputs, zero, denormals and negative values are undefined.
+	INLINE float FastInvSqrt(float Value)
+	{
+#if defined(COPIRITE_SSE2)
+		float Estimate{ _mm_cvtss_f32(_mm_rsqrt_ss(_mm_set_ss(Value))) };
+		return Estimate * (1.5f - (0.5f * Value * Estimate * Estimate));
+#else
+		uint32 Bits;
+		memcpy(&Bits, &Value, sizeof(float));
+		Bits = 0x5F375A86u - (Bits >> 1);
+		float Estimate;
+		memcpy(&Estimate, &Bits, sizeof(float));
+		Estimate = Estimate * (1.5f - (0.5f * Value * Estimate * Estimate));
+		Estimate = Estimate * (1.5f - (0.5f * Value * Estimate * Estimate));
+		return Estimate * (1.5f - (0.5f * Value * Estimate * Estimate));
+#endif
+	}
+
+	// Returns the sine of an angle in radians.
+	template <typename Type>
+	INLINE Type Sin(Type Radians) { return std::sin(Radians); }
+
+	// Returns the cosine of an angle in radians.
+	template <typename Type>
+	INLINE Type Cos(Type Radians) { return std::cos(Radians); }
+
+	// Returns the angle in radians between the positive X axis and a point.
+	// @param Y - The point's Y coordinate.
+	// @param X - The point's X coordinate.
+	// @return - The angle in the range [-PI, PI].
+	template <typename Type>
+	INLINE Type ATan2(Type Y, Type X) { return std::atan2(Y, X); }
+
+	// The polynomial used by FastSin and FastCos, approximates sin(X) for X in [-PI / 2, PI / 2].
+	template <typename Type>
+	INLINE constexpr Type SinPolynomial(Type X)
+	{
+		Type S{ X * X };
+		Type U{ MulAdd<Type>(2.6083159809786593541503e-06f, S, -0.0001981069071916863322258f) };
+		U = MulAdd<Type>(U, S, 0.00833307858556509017944336f);
+		U = MulAdd<Type>(U, S, -0.166666597127914428710938f);
+		return MulAdd(S * U, X, X);
+	}
+
+	// The polynomial used by FastATan2, approximates atan(X) for X in [0, 1].
+	template <typename Type>
+	INLINE constexpr Type ATanPolynomial(Type X)
+	{
+		Type S{ X * X };
+		Type U{ MulAdd<Type>(0.00282363896258175373077393f, S, -0.0159569028764963150024414f) };
+		U = MulAdd<Type>(U, S, 0.0425049886107444763183594f);
+		U = MulAdd<Type>(U, S, -0.0748900920152664184570312f);
+		U = MulAdd<Type>(U, S, 0.106347933411598205566406f);
+		U = MulAdd<Type>(U, S, -0.142027363181114196777344f);
+		U = MulAdd<Type>(U, S, 0.199926957488059997558594f);
+		U = MulAdd<Type>(U, S, -0.333331018686294555664062f);
+		return MulAdd(S * U, X, X);
+	}
+
+	// Returns an approximation of the sine of an angle in radians.
+	// @note - Max error 3 ULP, or 1.5e-7 absolute where the result is near zero, for angles within +-FAST_TRIG_RANGE.
+	INLINE constexpr float FastSin(float Radians)
+	{
+		float Q{ RoundEven(Radians * INV_PI) };
+		float R{ MulAdd(Q, -PI_A, Radians) };
+		R = MulAdd(Q, -PI_B, R);
+		R = MulAdd(Q, -PI_C, R);
+		R = MulAdd(Q, -PI_D, R);
+		float Result{ SinPolynomial(R) };
+		return ((int64)Q & 1) ? -Result : Result;
+	}
+
+	// Returns an approximation of the cosine of an angle in radians.
+	// @note - Max error 3 ULP, or 1.5e-7 absolute where the result is near zero, for angles within +-FAST_TRIG_RANGE.
+	INLINE constexpr float FastCos(float Radians)
+	{
+		// Reduces around the zeros of the cosine, cos(X) = -sin(X - (Q + 0.5) * PI) for even Q.
+		float Q{ MulAdd(RoundEven((Radians * INV_PI) - 0.5f), 2.0f, 1.0f) };
+		float R{ MulAdd(Q, -PI_A * 0.5f, Radians) };
+		R = MulAdd(Q, -PI_B * 0.5f, R);
+		R = MulAdd(Q, -PI_C * 0.5f, R);
+		R = MulAdd(Q, -PI_D * 0.5f, R);
+		float Result{ SinPolynomial(R) };
+		return ((int64)Q & 2) ? Result : -Result;
+	}
+
+	// Returns an approximation of the angle in radians between the positive X axis and a point.
+	// @param Y - The point's Y coordinate.
+	// @param X - The point's X coordinate.
+	// @return - The angle in the range [-PI, PI], zero when both coordinates are zero. Takes the sign of Y like the lane version,
+	//	so a Y of -0 with a negative X gives -PI.
+	// @note - Max error 3 ULP. Infinite coordinates are not supported.
+	INLINE constexpr float FastATan2(float Y, float X)
+	{
+		float AY{ Abs(Y) };
+		float AX{ Abs(X) };
+		float Denominator{ Max(AY, AX) };
+		float Ratio{ (Denominator == 0.0f) ? 0.0f : Min(AY, AX) / Denominator };
+		float Result{ ATanPolynomial(Ratio) };
+		if (AY > AX) Result = HALF_PI - Result;
+		if (X < 0.0f) Result = PI - Result;
+		return (std::bit_cast<uint32>(Y) >> 31) ? -Result : Result;
+	}
+
+
+
+	/// Lane Functions
+
+	// Tests if each lane is neither NaN nor infinite.
+	// @return - A mask with the finite lanes set.
+	template <typename Type, uint Count>
+	INLINE TLanes<Type, Count> IsFinite(const TLanes<Type, Count>& Value)
+	{
+		TLanes<Type, Count> Difference{ Value - Value };
+		return Difference == Difference;
+	}
+
+	// Returns the square root of each lane.
+	template <typename Type, uint Count>
+	INLINE TLanes<Type, Count> Sqrt(const TLanes<Type, Count>& Value) { return Value.Sqrt(); }
+
+	// Returns 1 / sqrt of each lane.
+	template <typename Type, uint Count>
+	INLINE TLanes<Type, Count> InvSqrt(const TLanes<Type, Count>& Value) { return TLanes<Type, Count>{ (Type)1 } / Value.Sqrt(); }
+
+	// Returns an approximation of 1 / sqrt of each lane, an estimate followed by one Newton-Raphson step.
+	// @note - Max error 4 ULP for normal positive inputs, zero, denormals and negative values are undefined.
+	template <uint Count>
+	INLINE TLanes<float, Count> FastInvSqrt(const TLanes<float, Count>& Value)
+	{
+		typedef TLanes<float, Count> SLanes;
+		SLanes Estimate{ Value.InvSqrtEstimate() };
+		return Estimate * ((SLanes{ -0.5f } * Value * Estimate).MulAdd(Estimate, SLanes{ 1.5f }));
+	}
+
+	// The polynomial used by FastSin and FastCos, approximates sin(X) for X in [-PI / 2, PI / 2].
+	template <uint Count>
+	INLINE TLanes<float, Count> SinPolynomial(const TLanes<float, Count>& X)
+	{
+		typedef TLanes<float, Count> SLanes;
+		SLanes S{ X * X };
+		SLanes U{ SLanes{ 2.6083159809786593541503e-06f }.MulAdd(S, SLanes{ -0.0001981069071916863322258f }) };
+		U = U.MulAdd(S, SLanes{ 0.00833307858556509017944336f });
+		U = U.MulAdd(S, SLanes{ -0.166666597127914428710938f });
+		return (S * U).MulAdd(X, X);
+	}
+
+	// The polynomial used by FastATan2, approximates atan(X) for X in [0, 1].
+	template <uint Count>
+	INLINE TLanes<float, Count> ATanPolynomial(const TLanes<float, Count>& X)
+	{
+		typedef TLanes<float, Count> SLanes;
+		SLanes S{ X * X };
+		SLanes U{ SLanes{ 0.00282363896258175373077393f }.MulAdd(S, SLanes{ -0.0159569028764963150024414f }) };
+		U = U.MulAdd(S, SLanes{ 0.0425049886107444763183594f });
+		U = U.MulAdd(S, SLanes{ -0.0748900920152664184570312f });
+		U = U.MulAdd(S, SLanes{ 0.106347933411598205566406f });
+		U = U.MulAdd(S, SLanes{ -0.142027363181114196777344f });
+		U = U.MulAdd(S, SLanes{ 0.199926957488059997558594f });
+		U = U.MulAdd(S, SLanes{ -0.333331018686294555664062f });
+		return (S * U).MulAdd(X, X);
+	}
+
+	// Returns an approximation of the sine of each lane in radians.
+	// @note - Max error 3 ULP, or 1.5e-7 absolute where the result is near zero, for angles within +-FAST_TRIG_RANGE.
+	template <uint Count>
+	INLINE TLanes<float, Count> FastSin(const TLanes<float, Count>& Radians)
+	{
+		typedef TLanes<float, Count> SLanes;
+		SLanes Q{ (Radians * SLanes{ INV_PI }).Round() };
+		SLanes R{ Q.MulAdd(SLanes{ -PI_A }, Radians) };
+		R = Q.MulAdd(SLanes{ -PI_B }, R);
+		R = Q.MulAdd(SLanes{ -PI_C }, R);
+		R = Q.MulAdd(SLanes{ -PI_D }, R);
+
+		// Odd multiples of PI flip the sign, Q / 2 has a fraction only when Q is odd.
+		SLanes Half{ Q * SLanes{ 0.5f } };
+		SLanes Odd{ Half != Half.Round() };
+		return SinPolynomial(R) ^ (Odd & SLanes{ -0.0f });
+	}
+
+	// Returns an approximation of the cosine of each lane in radians.
+	// @note - Max error 3 ULP, or 1.5e-7 absolute where the result is near zero, for angles within +-FAST_TRIG_RANGE.
+	template <uint Count>
+	INLINE TLanes<float, Count> FastCos(const TLanes<float, Count>& Radians)
+	{
+		typedef TLanes<float, Count> SLanes;
+		SLanes Q{ (Radians * SLanes{ INV_PI } - SLanes{ 0.5f }).Round() };
+		SLanes Q2{ Q.MulAdd(SLanes{ 2.0f }, SLanes{ 1.0f }) };
+		SLanes R{ Q2.MulAdd(SLanes{ -PI_A * 0.5f }, Radians) };
+		R = Q2.MulAdd(SLanes{ -PI_B * 0.5f }, R);
+		R = Q2.MulAdd(SLanes{ -PI_C * 0.5f }, R);
+		R = Q2.MulAdd(SLanes{ -PI_D * 0.5f }, R);
+
+		// Even values of Q flip the sign.
+		SLanes Half{ Q * SLanes{ 0.5f } };
+		SLanes Even{ Half == Half.Round() };
+		return SinPolynomial(R) ^ (Even & SLanes{ -0.0f });
+	}
+
+	// Returns an approximation of the angle in radians between the positive X axis and each lane's point.
+	// @param Y - The points' Y coordinates.
+	// @param X - The points' X coordinates.
+	// @return - The angles in the range [-PI, PI], zero where both coordinates are zero.
+	// @note - Max error 3 ULP. Infinite coordinates are not supported.
+	template <uint Count>
+	INLINE TLanes<float, Count> FastATan2(const TLanes<float, Count>& Y, const TLanes<float, Count>& X)
+	{
+		typedef TLanes<float, Count> SLanes;
+		SLanes Zero{ 0.0f };
+		SLanes AY{ Y.Abs() };
+		SLanes AX{ X.Abs() };
+		SLanes Denominator{ AY.Max(AX) };
+		SLanes Ratio{ (Denominator == Zero).Select(Zero, AY.Min(AX) / Denominator) };
+		SLanes Result{ ATanPolynomial(Ratio) };
+		Result = (AY > AX).Select(SLanes{ HALF_PI } - Result, Result);
+		Result = (X < Zero).Select(SLanes{ PI } - Result, Result);
+		return Result ^ (Y & SLanes{ -0.0f });
+	}
+}
+
+
+#endif // !COPIRITE_TMATH
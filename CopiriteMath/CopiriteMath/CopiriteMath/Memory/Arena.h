@@ -0,0 +1,422 @@
+#pragma once
+#include "../GlobalValues.h"
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+
+
+
+// A linear allocator for temporary arrays. Allocating moves a pointer forward and everything is freed at once.
+// Memory comes from a chain of 64-byte aligned blocks that are kept for reuse, so once an arena has grown to a frame's
+// needs it never touches the heap again. Reset() and Rewind() are O(1), they only move the pointer back.
+// @note - An arena is not thread safe. Every thread has its own in GetThread(), which the batched functions borrow
+// scratch space from inside a SArenaScope.
+struct SArena
+{
+public:
+	// The alignment of every allocation unless a larger one is asked for, a whole cache line.
+	static constexpr size_t Alignment{ 64 };
+
+	// How many bytes each block holds unless an allocation needs more.
+	static constexpr size_t DefaultBlockSize{ 1 << 20 };
+
+
+private:
+	// The header in front of every block's memory.
+	struct SBlock
+	{
+		// The next block in the chain, kept after a reset so it can be reused.
+		SBlock* Next;
+
+		// How many bytes the block holds after its header.
+		size_t Capacity;
+
+		// How many of those bytes are allocated.
+		size_t Used;
+	};
+
+	// The header's size, rounded up so every block's memory starts on a cache line.
+	static constexpr size_t HeaderSize{ ((sizeof(SBlock) + Alignment - 1) / Alignment) * Alignment };
+
+
+public:
+	// A position in an arena to rewind to, everything allocated after it is freed by Rewind().
+	struct SMarker
+	{
+		// The block that was being allocated from, nullptr before the first allocation.
+		SBlock* Block;
+
+		// How many bytes of that block were used.
+		size_t Used;
+	};
+
+
+private:
+	/// Properties
+
+	// The first block in the chain.
+	SBlock* First;
+
+	// The block being allocated from.
+	SBlock* Current;
+
+	// How many bytes new blocks hold.
+	size_t BlockSize;
+
+
+	/// Functions
+
+	// Returns the first byte of a block's memory.
+	static INLINE uint8* GetMemory(SBlock* Block) { return (uint8*)Block + HeaderSize; }
+
+	// Allocates from the blocks after the current one, adding a block when none of them are large enough.
+	// @param Bytes - How many bytes to allocate.
+	// @param InAlignment - The alignment of the allocation.
+	// @return - The allocation.
+	INLINE void* AllocateSlow(size_t Bytes, size_t InAlignment);
+
+
+public:
+	/// Constructors
+
+	// Constructor, Initializes an empty arena, no memory is allocated until it is needed.
+	// @param InBlockSize - How many bytes each block holds unless an allocation needs more.
+	INLINE explicit SArena(size_t InBlockSize = DefaultBlockSize)
+		:First{ nullptr }, Current{ nullptr }, BlockSize{ InBlockSize }
+	{}
+
+	// Destructor, Frees every block.
+	INLINE ~SArena();
+
+	SArena(const SArena&) = delete;
+	SArena& operator=(const SArena&) = delete;
+
+
+
+	/// Getters
+
+	// Returns how many bytes are allocated, counting the space skipped to align allocations and at the end of full blocks.
+	INLINE size_t GetUsed() const;
+
+	// Returns how many bytes the arena's blocks hold in total.
+	INLINE size_t GetCapacity() const;
+
+	// Returns the current position, to rewind to later.
+	INLINE SMarker GetMarker() const { return SMarker{ Current, Current ? Current->Used : 0 }; }
+
+
+
+	/// Functions
+
+	// Returns the arena of the calling thread, created the first time the thread uses it.
+	// It can be used as the thread's frame arena: allocate from it through the frame and call Reset() at the end.
+	static INLINE SArena& GetThread()
+	{
+		thread_local SArena Arena;
+		return Arena;
+	}
+
+	// Allocates memory that stays valid until the arena is reset or rewound to before it.
+	// @param Bytes - How many bytes to allocate.
+	// @param InAlignment - The alignment of the allocation, a power of 2.
+	// @return - The allocation, never nullptr.
+	INLINE void* Allocate(size_t Bytes, size_t InAlignment = Alignment);
+
+	// Allocates an array, its values start uninitialized and are never destroyed.
+	// @template Type - A trivially copyable and destructible type.
+	// @param Count - How many values the array holds.
+	// @return - The array, 64-byte aligned.
+	template <typename Type>
+	INLINE Type* Allocate(size_t Count)
+	{
+		ASSERT(std::is_trivially_copyable<Type>::value && std::is_trivially_destructible<Type>::value, "Arena arrays are never constructed or destroyed.");
+		return (Type*)Allocate(sizeof(Type) * Count, (alignof(Type) > Alignment) ? alignof(Type) : Alignment);
+	}
+
+	// Frees everything allocated after a marker, the blocks are kept.
+	// @param Marker - A position from GetMarker(), later positions are no longer valid to rewind to.
+	INLINE void Rewind(const SMarker& Marker);
+
+	// Frees everything allocated, the blocks are kept.
+	INLINE void Reset() { Rewind(SMarker{ nullptr, 0 }); }
+
+	// Frees the blocks after the current one, giving their memory back once an unusually large frame has passed.
+	INLINE void Trim();
+};
+
+
+
+// Rewinds an arena to where it was when the scope was entered, so temporary arrays can be allocated in nested calls.
+struct SArenaScope
+{
+private:
+	/// Properties
+
+	// The arena to rewind.
+	SArena& Arena;
+
+	// The position to rewind to.
+	SArena::SMarker Marker;
+
+
+public:
+	/// Constructors
+
+	// Constructor, Remembers the arena's current position.
+	// @param InArena - The arena to rewind, defaults to the calling thread's.
+	INLINE explicit SArenaScope(SArena& InArena = SArena::GetThread())
+		:Arena{ InArena }, Marker{ InArena.GetMarker() }
+	{}
+
+	// Destructor, Frees everything allocated since the scope was entered.
+	INLINE ~SArenaScope() { Arena.Rewind(Marker); }
+
+	SArenaScope(const SArenaScope&) = delete;
+	SArenaScope& operator=(const SArenaScope&) = delete;
+
+
+
+	/// Getters
+
+	// Returns the arena being rewound.
+	INLINE SArena& GetArena() const { return Arena; }
+};
+
+
+
+// A 64-byte aligned array whose size is set once, for scratch space and the inputs of batched functions.
+// The memory comes from the heap, or from an arena when one is given, in which case it is freed with the arena.
+// @note - The size in bytes is rounded up to whole cache lines, so lane loops may read past the end up to the next cache line.
+// @template Type - A trivially copyable and destructible type, the values start uninitialized.
+template <typename Type>
+struct STAlignedBuffer
+{
+public:
+	// The alignment of the array in bytes.
+	static constexpr size_t Alignment{ (alignof(Type) > SArena::Alignment) ? alignof(Type) : SArena::Alignment };
+
+
+private:
+	/// Properties
+
+	// The values.
+	Type* Data;
+
+	// How many values there are.
+	uint Count;
+
+	// The arena the values were allocated from, nullptr if they are on the heap.
+	SArena* Arena;
+
+
+	/// Functions
+
+	// Returns how many bytes an array of values takes, rounded up to whole cache lines.
+	static INLINE size_t GetBytes(uint InCount) { return (((sizeof(Type) * InCount) + Alignment - 1) / Alignment) * Alignment; }
+
+	// Frees the values if they are on the heap.
+	INLINE void Free() { if (Data && !Arena) ::operator delete(Data, std::align_val_t{ Alignment }); }
+
+
+public:
+	/// Constructors
+
+	// Constructor, Default. Initializes an empty buffer.
+	INLINE STAlignedBuffer()
+		:Data{ nullptr }, Count{ 0 }, Arena{ nullptr }
+	{}
+
+	// Constructor, Allocates an array on the heap.
+	// @param InCount - How many values the array holds.
+	INLINE explicit STAlignedBuffer(uint InCount)
+		:Data{ (InCount > 0) ? (Type*)::operator new(GetBytes(InCount), std::align_val_t{ Alignment }) : nullptr }, Count{ InCount }, Arena{ nullptr }
+	{
+		ASSERT(std::is_trivially_copyable<Type>::value && std::is_trivially_destructible<Type>::value, "Aligned buffers are never constructed or destroyed.");
+	}
+
+	// Constructor, Allocates an array from an arena.
+	// @param InCount - How many values the array holds.
+	// @param InArena - The arena to allocate from, the buffer must not outlive its next reset.
+	INLINE STAlignedBuffer(uint InCount, SArena& InArena)
+		:Data{ (Type*)InArena.Allocate(GetBytes(InCount), Alignment) }, Count{ InCount }, Arena{ &InArena }
+	{
+		ASSERT(std::is_trivially_copyable<Type>::value && std::is_trivially_destructible<Type>::value, "Aligned buffers are never constructed or destroyed.");
+	}
+
+	// Constructor, Move.
+	INLINE STAlignedBuffer(STAlignedBuffer<Type>&& Other) noexcept
+		:Data{ Other.Data }, Count{ Other.Count }, Arena{ Other.Arena }
+	{
+		Other.Data = nullptr;
+		Other.Count = 0;
+		Other.Arena = nullptr;
+	}
+
+	// Destructor.
+	INLINE ~STAlignedBuffer() { Free(); }
+
+	STAlignedBuffer(const STAlignedBuffer<Type>&) = delete;
+
+
+
+	/// Operators
+
+	// Operator, Move assignment.
+	INLINE STAlignedBuffer<Type>& operator=(STAlignedBuffer<Type>&& Other) noexcept
+	{
+		if (this == &Other) return *this;
+		Free();
+		Data = Other.Data;
+		Count = Other.Count;
+		Arena = Other.Arena;
+		Other.Data = nullptr;
+		Other.Count = 0;
+		Other.Arena = nullptr;
+		return *this;
+	}
+
+	STAlignedBuffer<Type>& operator=(const STAlignedBuffer<Type>&) = delete;
+
+	// Operator, Returns the value at the given index.
+	INLINE Type& operator[](const uint& Index) { return Data[Index]; }
+
+	// Operator, Returns the value at the given index.
+	INLINE const Type& operator[](const uint& Index) const { return Data[Index]; }
+
+
+
+	/// Getters
+
+	// Returns the values.
+	INLINE Type* GetData() { return ASSUME_ALIGNED(Data, Alignment); }
+
+	// Returns the values.
+	INLINE const Type* GetData() const { return ASSUME_ALIGNED(Data, Alignment); }
+
+	// Returns how many values there are.
+	INLINE uint Num() const { return Count; }
+
+	// Returns the first value, for range based loops.
+	INLINE Type* begin() { return Data; }
+	INLINE const Type* begin() const { return Data; }
+
+	// Returns one past the last value, for range based loops.
+	INLINE Type* end() { return Data + Count; }
+	INLINE const Type* end() const { return Data + Count; }
+};
+
+
+
+INLINE SArena::~SArena()
+{
+	while (First)
+	{
+		SBlock* Next{ First->Next };
+		::operator delete(First, std::align_val_t{ Alignment });
+		First = Next;
+	}
+}
+
+
+INLINE size_t SArena::GetUsed() const
+{
+	if (!Current) return 0;
+	size_t Result{ Current->Used };
+	for (SBlock* Block = First; Block != Current; Block = Block->Next)
+	{
+		Result += Block->Capacity;
+	}
+	return Result;
+}
+
+
+INLINE size_t SArena::GetCapacity() const
+{
+	size_t Result{ 0 };
+	for (SBlock* Block = First; Block; Block = Block->Next)
+	{
+		Result += Block->Capacity;
+	}
+	return Result;
+}
+
+
+INLINE void* SArena::Allocate(size_t Bytes, size_t InAlignment)
+{
+	assert(InAlignment > 0 && (InAlignment & (InAlignment - 1)) == 0);
+	if (LIKELY(Current != nullptr))
+	{
+		// Aligned by address, so alignments larger than the block's own still work.
+		uint8* const Memory{ GetMemory(Current) };
+		const size_t Begin{ (size_t)((((uintptr_t)Memory + Current->Used + InAlignment - 1) & ~(uintptr_t)(InAlignment - 1)) - (uintptr_t)Memory) };
+		if (Begin + Bytes <= Current->Capacity)
+		{
+			Current->Used = Begin + Bytes;
+			return Memory + Begin;
+		}
+	}
+	return AllocateSlow(Bytes, InAlignment);
+}
+
+
+INLINE void* SArena::AllocateSlow(size_t Bytes, size_t InAlignment)
+{
+	const size_t Needed{ Bytes + ((InAlignment > Alignment) ? InAlignment : 0) };
+
+	// Kept blocks that are too small for this allocation stay in the chain for later ones.
+	SBlock* Previous{ Current };
+	SBlock* Block{ Current ? Current->Next : First };
+	while (Block && Block->Capacity < Needed)
+	{
+		Block->Used = 0;
+		Previous = Block;
+		Block = Block->Next;
+	}
+
+	if (!Block)
+	{
+		const size_t Capacity{ (((Needed > BlockSize) ? Needed : BlockSize) + Alignment - 1) & ~(Alignment - 1) };
+		Block = (SBlock*)::operator new(HeaderSize + Capacity, std::align_val_t{ Alignment });
+		Block->Next = nullptr;
+		Block->Capacity = Capacity;
+		if (Previous) Previous->Next = Block;
+		else First = Block;
+	}
+
+	uint8* const Memory{ GetMemory(Block) };
+	const size_t Begin{ (size_t)((((uintptr_t)Memory + InAlignment - 1) & ~(uintptr_t)(InAlignment - 1)) - (uintptr_t)Memory) };
+	Block->Used = Begin + Bytes;
+	Current = Block;
+	return Memory + Begin;
+}
+
+
+INLINE void SArena::Rewind(const SMarker& Marker)
+{
+	Current = Marker.Block ? Marker.Block : First;
+	if (Current) Current->Used = Marker.Used;
+}
+
+
+INLINE void SArena::Trim()
+{
+	SBlock* Block{ Current ? Current->Next : First };
+	if (Current) Current->Next = nullptr;
+	else First = nullptr;
+	while (Block)
+	{
+		SBlock* Next{ Block->Next };
+		::operator delete(Block, std::align_val_t{ Alignment });
+		Block = Next;
+	}
+}
+
+
+
+// An aligned array of floats.
+typedef STAlignedBuffer<float> SFloatBuffer;
+
+// An aligned array of double type values.
+typedef STAlignedBuffer<double> SDoubleBuffer;
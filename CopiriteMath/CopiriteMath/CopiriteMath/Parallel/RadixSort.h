@@ -0,0 +1,101 @@
+#pragma once
+#include "ThreadPool.h"
+#include "../Memory/Arena.h"
+#include <cstring>
+#include <type_traits>
+
+
+
+// How many bits of the key each radix sort pass sorts by, 256 buckets fit in the L1 cache with room for the data streaming through.
+constexpr uint RadixSortDigitBits{ 8 };
+
+// Arrays shorter than this are sorted on the calling thread.
+constexpr uint RadixSortParallelThreshold{ 65536 };
+
+
+
+// Sorts unsigned integer keys and a value for each, split across the shared pool. The sort is stable and least significant digit first.
+// Every pass counts its digits in each piece of the array in parallel, then each piece scatters its keys to its own part of every bucket.
+// Passes where every key has the same digit are skipped, so keys that only use their low bits cost fewer passes.
+// @template Key - The unsigned integer type of the keys.
+// @template Value - The type of the values, usually the index of what each key belongs to.
+// @param Keys - The keys, sorted in place.
+// @param Values - The value of each key, moved with its key.
+// @param Count - How many keys there are.
+// @param KeyScratch - Space for Count keys, overwritten.
+// @param ValueScratch - Space for Count values, overwritten.
+// @param KeyBits - How many of the keys' lowest bits to sort by, the rest are ignored.
+template <typename Key, typename Value>
+INLINE void ParallelRadixSort(Key* Keys, Value* Values, uint Count, Key* KeyScratch, Value* ValueScratch, uint KeyBits = sizeof(Key) * 8)
+{
+	ASSERT(std::is_unsigned<Key>::value, "Radix sort keys must be unsigned integers.");
+	constexpr uint Buckets{ 1u << RadixSortDigitBits };
+
+	const uint Pieces{ (Count < RadixSortParallelThreshold) ? 1 : std::min(SThreadPool::Get().Num() * SThreadPool::ChunksPerThread, Count / (RadixSortParallelThreshold / 8)) };
+	const auto PieceBegin{ [Count, Pieces](uint Piece) { return (uint)(((uint64)Count * Piece) / Pieces); } };
+	SArenaScope Scope;
+	uint* const Offsets{ Scope.GetArena().Allocate<uint>((size_t)Pieces * Buckets) };
+
+	Key* Source{ Keys };
+	Key* Destination{ KeyScratch };
+	Value* SourceValues{ Values };
+	Value* DestinationValues{ ValueScratch };
+	for (uint Shift = 0; Shift < KeyBits; Shift += RadixSortDigitBits)
+	{
+		// The last digit is cut short when KeyBits is not a multiple of the digit size, so the bits above KeyBits are never sorted by.
+		const uint DigitMask{ (KeyBits - Shift < RadixSortDigitBits) ? (1u << (KeyBits - Shift)) - 1 : Buckets - 1 };
+
+		// Counts each piece's digits.
+		ParallelFor(Pieces, [&](uint Begin, uint End)
+			{
+				for (uint Piece = Begin; Piece < End; ++Piece)
+				{
+					uint* Counts{ Offsets + ((size_t)Piece * Buckets) };
+					std::memset(Counts, 0, Buckets * sizeof(uint));
+					for (uint i = PieceBegin(Piece); i < PieceBegin(Piece + 1); ++i)
+					{
+						++Counts[(Source[i] >> Shift) & DigitMask];
+					}
+				}
+			});
+
+		// Turns the counts into where each piece starts writing each bucket, bucket by bucket then piece by piece so the sort is stable.
+		uint Total{ 0 };
+		bool Sorted{ false };
+		for (uint Bucket = 0; Bucket < Buckets; ++Bucket)
+		{
+			const uint BucketBegin{ Total };
+			for (uint Piece = 0; Piece < Pieces; ++Piece)
+			{
+				uint& Offset{ Offsets[((size_t)Piece * Buckets) + Bucket] };
+				const uint Counted{ Offset };
+				Offset = Total;
+				Total += Counted;
+			}
+			Sorted |= (Total - BucketBegin == Count);
+		}
+		if (Sorted) continue;
+
+		ParallelFor(Pieces, [&](uint Begin, uint End)
+			{
+				for (uint Piece = Begin; Piece < End; ++Piece)
+				{
+					uint* Next{ Offsets + ((size_t)Piece * Buckets) };
+					for (uint i = PieceBegin(Piece); i < PieceBegin(Piece + 1); ++i)
+					{
+						const uint Slot{ Next[(Source[i] >> Shift) & DigitMask]++ };
+						Destination[Slot] = Source[i];
+						DestinationValues[Slot] = SourceValues[i];
+					}
+				}
+			});
+		std::swap(Source, Destination);
+		std::swap(SourceValues, DestinationValues);
+	}
+
+	if (Source != Keys)
+	{
+		std::memcpy(Keys, Source, (size_t)Count * sizeof(Key));
+		std::copy(SourceValues, SourceValues + Count, Values);
+	}
+}
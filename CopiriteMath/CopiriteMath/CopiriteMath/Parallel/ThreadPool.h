@@ -0,0 +1,354 @@
+#pragma once
+#include "../GlobalValues.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+
+
+// A pool of worker threads that run ranges of a loop, idle threads steal work from busy ones.
+// A range is split in half again and again, the first half is run and the second half is queued, so the largest pieces
+// are always the first to be stolen and no more splits are made than there are threads to take them.
+// The thread that starts a loop works on it too, and runs other queued ranges while it waits for the loop to finish.
+// @note - Loops may be started from inside other loops. The functions run must not throw.
+struct SThreadPool
+{
+public:
+	// How many pieces per thread the automatic grain size aims for, more pieces balance uneven work better.
+	static constexpr uint ChunksPerThread{ 8 };
+
+
+private:
+	// A loop started with ParallelFor.
+	struct SJob
+	{
+		// Runs the loop's function over a range.
+		void (*Run)(void* Context, uint Begin, uint End);
+
+		// The loop's function.
+		void* Context;
+
+		// Ranges this size or smaller are not split.
+		uint Grain;
+
+		// Every split is a multiple of this from the start of the loop.
+		uint Granularity;
+
+		// How many iterations have not finished yet.
+		std::atomic<uint> Remaining;
+	};
+
+	// A queued range of a loop.
+	struct STask
+	{
+		// The loop the range belongs to.
+		SJob* Job;
+
+		// The first iteration.
+		uint Begin;
+
+		// One past the last iteration.
+		uint End;
+	};
+
+	// The tasks queued by one thread, it takes from the back and thieves take from the front.
+	struct alignas(64) SQueue
+	{
+		// Guards Tasks.
+		std::mutex Mutex;
+
+		// The queued tasks, oldest first.
+		std::deque<STask> Tasks;
+	};
+
+
+	/// Properties
+
+	// The worker threads.
+	std::vector<std::thread> Workers;
+
+	// A queue for each worker, followed by one shared by every thread that is not a worker.
+	std::unique_ptr<SQueue[]> Queues;
+
+	// How many tasks are queued across every queue.
+	std::atomic<uint> Pending{ 0 };
+
+	// How many workers are waiting for tasks.
+	std::atomic<uint> Sleeping{ 0 };
+
+	// Set when the pool is being destroyed.
+	std::atomic<bool> Stop{ false };
+
+	// Guards sleeping workers.
+	std::mutex SleepMutex;
+
+	// Wakes sleeping workers when tasks are queued.
+	std::condition_variable WakeUp;
+
+	// The pool the current thread is a worker of, nullptr for threads outside any pool.
+	static inline thread_local SThreadPool* CurrentPool{ nullptr };
+
+	// The index of the current thread's queue in CurrentPool.
+	static inline thread_local uint CurrentQueue{ 0 };
+
+
+	/// Functions
+
+	// Returns the queue the current thread pushes to and takes from first.
+	INLINE uint GetQueue() const { return (CurrentPool == this) ? CurrentQueue : (uint)Workers.size(); }
+
+	// Queues a task on the current thread's queue and wakes a worker to steal it.
+	// @param Task - The task to queue.
+	INLINE void Push(const STask& Task);
+
+	// Takes a task from the current thread's queue, or steals one from another queue.
+	// @param Task - Set to the task taken.
+	// @return - True if a task was taken.
+	INLINE bool Pop(STask& Task);
+
+	// Runs a range of a loop, splitting off and queuing the second half until the range is no larger than the grain.
+	// @param Task - The range to run.
+	INLINE void Execute(STask Task);
+
+	// The loop each worker runs until the pool is destroyed.
+	// @param Index - The worker's queue.
+	INLINE void WorkerLoop(uint Index);
+
+
+public:
+	/// Constructors
+
+	// Constructor, Starts the worker threads.
+	// @param Threads - How many threads run loops including the one that starts them, 0 uses one per core.
+	INLINE explicit SThreadPool(uint Threads = 0);
+
+	// Destructor, Waits for the workers to finish their current tasks and stops them.
+	INLINE ~SThreadPool();
+
+	SThreadPool(const SThreadPool&) = delete;
+	SThreadPool& operator=(const SThreadPool&) = delete;
+
+
+
+	/// Functions
+
+	// Returns the pool shared by the library, it has a thread per core and is created the first time it is used.
+	static INLINE SThreadPool& Get();
+
+	// Returns how many threads run loops, including the one that starts them.
+	INLINE uint Num() const { return (uint)Workers.size() + 1; }
+
+	// Runs a function over a range of iterations split into pieces across the pool, returns once every piece has finished.
+	// @note - Runs on the calling thread alone if the range is no larger than a single piece.
+	// @param Count - How many iterations there are.
+	// @param Func - Called with the first and one past the last iteration of each piece, from any thread.
+	// @param MinGrain - The smallest piece worth running on its own, pieces are larger when there are fewer threads.
+	// @param Granularity - Every piece starts at a multiple of this, use it to keep pieces on whole lanes or cache lines.
+	template <typename Function>
+	INLINE void ParallelFor(uint Count, Function&& Func, uint MinGrain = 1, uint Granularity = 1);
+};
+
+
+
+// The fewest vectors the library's batched functions give a thread, shorter arrays run on the calling thread.
+constexpr uint VectorGrain{ 16384 };
+
+
+// Runs a function over a range of iterations split into pieces across the shared pool.
+// @param Count - How many iterations there are.
+// @param Func - Called with the first and one past the last iteration of each piece, from any thread.
+// @param MinGrain - The smallest piece worth running on its own.
+// @param Granularity - Every piece starts at a multiple of this.
+template <typename Function>
+INLINE void ParallelFor(uint Count, Function&& Func, uint MinGrain = 1, uint Granularity = 1)
+{
+	SThreadPool::Get().ParallelFor(Count, std::forward<Function>(Func), MinGrain, Granularity);
+}
+
+
+// Sets every output to the result of a function on the matching input, split across the shared pool.
+// Pieces start on cache line boundaries of the output so no two threads write to the same line.
+// @template Input - The type of each input, usually a STVector.
+// @template Output - The type of each output, usually a STVector.
+// @param In - The inputs.
+// @param Out - Receives Count outputs, may be the same array as In.
+// @param Count - How many inputs there are.
+// @param Func - Takes an input and returns its output, from any thread.
+// @param MinGrain - The smallest piece worth running on its own.
+template <typename Input, typename Output, typename Function>
+INLINE void ParallelTransform(const Input* In, Output* Out, uint Count, Function&& Func, uint MinGrain = 4096)
+{
+	constexpr uint Granularity{ 64 / std::gcd((uint)sizeof(Output), 64u) };
+	SThreadPool::Get().ParallelFor(Count, [In, Out, &Func](uint Begin, uint End)
+		{
+			for (uint i = Begin; i < End; ++i)
+			{
+				Out[i] = Func(In[i]);
+			}
+		}, MinGrain, Granularity);
+}
+
+
+
+INLINE SThreadPool::SThreadPool(uint Threads)
+{
+	const uint Total{ (Threads > 0) ? Threads : std::max(std::thread::hardware_concurrency(), 1u) };
+	Queues.reset(new SQueue[Total]);
+	Workers.reserve(Total - 1);
+	for (uint i = 0; i < Total - 1; ++i)
+	{
+		Workers.emplace_back([this, i]() { WorkerLoop(i); });
+	}
+}
+
+
+INLINE SThreadPool::~SThreadPool()
+{
+	{
+		std::lock_guard<std::mutex> Lock{ SleepMutex };
+		Stop.store(true);
+	}
+	WakeUp.notify_all();
+	for (std::thread& Worker : Workers)
+	{
+		Worker.join();
+	}
+}
+
+
+INLINE SThreadPool& SThreadPool::Get()
+{
+	static SThreadPool Pool;
+	return Pool;
+}
+
+
+INLINE void SThreadPool::Push(const STask& Task)
+{
+	SQueue& Queue{ Queues[GetQueue()] };
+	{
+		std::lock_guard<std::mutex> Lock{ Queue.Mutex };
+		Queue.Tasks.push_back(Task);
+	}
+
+	// Both counters are sequentially consistent, so either the sleeper sees the task or this sees the sleeper.
+	Pending.fetch_add(1);
+	if (Sleeping.load() > 0)
+	{
+		std::lock_guard<std::mutex> Lock{ SleepMutex };
+		WakeUp.notify_one();
+	}
+}
+
+
+INLINE bool SThreadPool::Pop(STask& Task)
+{
+	if (Pending.load(std::memory_order_relaxed) == 0) return false;
+
+	const uint QueueCount{ (uint)Workers.size() + 1 };
+	const uint Own{ GetQueue() };
+	for (uint i = 0; i < QueueCount; ++i)
+	{
+		const uint Index{ (Own + i) % QueueCount };
+		SQueue& Queue{ Queues[Index] };
+		std::lock_guard<std::mutex> Lock{ Queue.Mutex };
+		if (Queue.Tasks.empty()) continue;
+
+		// The newest task is still in this thread's cache, the oldest is the largest range left to steal.
+		if (Index == Own)
+		{
+			Task = Queue.Tasks.back();
+			Queue.Tasks.pop_back();
+		}
+		else
+		{
+			Task = Queue.Tasks.front();
+			Queue.Tasks.pop_front();
+		}
+		Pending.fetch_sub(1);
+		return true;
+	}
+	return false;
+}
+
+
+INLINE void SThreadPool::Execute(STask Task)
+{
+	SJob& Job{ *Task.Job };
+	while (Task.End - Task.Begin > Job.Grain)
+	{
+		const uint Half{ (((Task.End - Task.Begin) / 2 + Job.Granularity - 1) / Job.Granularity) * Job.Granularity };
+		Push(STask{ &Job, Task.Begin + Half, Task.End });
+		Task.End = Task.Begin + Half;
+	}
+	Job.Run(Job.Context, Task.Begin, Task.End);
+	Job.Remaining.fetch_sub(Task.End - Task.Begin, std::memory_order_release);
+}
+
+
+INLINE void SThreadPool::WorkerLoop(uint Index)
+{
+	CurrentPool = this;
+	CurrentQueue = Index;
+	while (true)
+	{
+		STask Task;
+		if (Pop(Task))
+		{
+			Execute(Task);
+			continue;
+		}
+
+		std::unique_lock<std::mutex> Lock{ SleepMutex };
+		Sleeping.fetch_add(1);
+		WakeUp.wait(Lock, [this]() { return Pending.load() > 0 || Stop.load(); });
+		Sleeping.fetch_sub(1);
+		if (Stop.load()) return;
+	}
+}
+
+
+template <typename Function>
+INLINE void SThreadPool::ParallelFor(uint Count, Function&& Func, uint MinGrain, uint Granularity)
+{
+	if (Count == 0) return;
+
+	// Enough pieces for every thread to take several, but never smaller than the caller says is worth it.
+	Granularity = std::max(Granularity, 1u);
+	uint Grain{ std::max((Count + (Num() * ChunksPerThread) - 1) / (Num() * ChunksPerThread), std::max(MinGrain, 1u)) };
+	Grain = ((Grain + Granularity - 1) / Granularity) * Granularity;
+	if (Workers.empty() || Count <= Grain)
+	{
+		Func(0u, Count);
+		return;
+	}
+
+	typedef std::remove_reference_t<Function> SFunction;
+	SJob Job;
+	Job.Run = [](void* Context, uint Begin, uint End) { (*(SFunction*)Context)(Begin, End); };
+	Job.Context = (void*)&Func;
+	Job.Grain = Grain;
+	Job.Granularity = Granularity;
+	Job.Remaining.store(Count, std::memory_order_relaxed);
+	Execute(STask{ &Job, 0, Count });
+
+	// Help with any queued work, this loop's or another's, until every piece of this loop is done.
+	while (Job.Remaining.load(std::memory_order_acquire) > 0)
+	{
+		STask Task;
+		if (Pop(Task))
+		{
+			Execute(Task);
+		}
+		else
+		{
+			std::this_thread::yield();
+		}
+	}
+}
@@ -4,13 +4,61 @@
 #define COPIRITE_UTILITY
 
 #define ASSERT static_assert
+
+#define DEPRECATED(Message) [[deprecated(Message)]]
+
+
+// Compiler specific keywords, each one expands to nothing where the compiler has no equivalent.
+//	INLINE - Always inline the function, even in debug builds.
+//	VECTORCALL - Pass vector registers in registers, only differs from the default on Windows x86/x64.
+//	FASTCALL - Pass the first arguments in registers, only differs from the default on 32-bit x86.
+//	RESTRICT - The pointer is the only way the memory it points to is accessed in its scope.
+//	ASSUME_ALIGNED - Returns the pointer, telling the compiler its address is a multiple of the alignment.
+//	LIKELY / UNLIKELY - Hints which way a condition usually goes, the condition is still evaluated.
+//	PREFETCH - Requests the cache line at the address ahead of a read, never faults.
+
+#if defined(_MSC_VER) && !defined(__clang__)
+
 #define INLINE __forceinline
 #define VECTORCALL __vectorcall
 #define FASTCALL __fastcall
+#define RESTRICT __restrict
+#define ASSUME_ALIGNED(Pointer, Alignment) (Pointer)
+#define LIKELY(Condition) (Condition)
+#define UNLIKELY(Condition) (Condition)
 
-#define DEPRECATED(Message) [[deprecated(Message)]]
+#if defined(_M_X64) || defined(_M_IX86)
+#include <xmmintrin.h>
+#define PREFETCH(Address) _mm_prefetch((const char*)(Address), _MM_HINT_T0)
+#else
+#define PREFETCH(Address) ((void)(Address))
+#endif
+
+#else // GCC and Clang.
+
+#define INLINE inline __attribute__((always_inline))
+
+#if defined(_WIN32) && (defined(__x86_64__) || defined(__i386__))
+#define VECTORCALL __vectorcall
+#else
+#define VECTORCALL
+#endif
+
+#if defined(__i386__)
+#define FASTCALL __attribute__((fastcall))
+#else
+#define FASTCALL
+#endif
+
+#define RESTRICT __restrict__
+#define ASSUME_ALIGNED(Pointer, Alignment) ((decltype(+(Pointer)))__builtin_assume_aligned((Pointer), (Alignment)))
+#define LIKELY(Condition) __builtin_expect(!!(Condition), 1)
+#define UNLIKELY(Condition) __builtin_expect(!!(Condition), 0)
+#define PREFETCH(Address) __builtin_prefetch((const void*)(Address), 0, 3)
+
+#endif // _MSC_VER
 
 
 
 
-#endif // !COPIRITE_UTILITY
\ No newline at end of file
+#endif // !COPIRITE_UTILITY
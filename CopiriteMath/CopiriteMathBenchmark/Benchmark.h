@@ -0,0 +1,239 @@
+#pragma once
+#include "CopiriteMath/GlobalValues.h"
+#include "CopiriteMath/Utility.h"
+#include "CopiriteMath/Math/SIMD.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <vector>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+
+// A small benchmark harness modelled on Google Benchmark, without the dependency.
+// Each benchmark is run with a growing iteration count until a single run takes at least the minimum time, the
+// fastest of several runs at that count is reported so background noise only ever makes a result slower.
+
+
+
+// Forces the compiler to treat a value as used so the work producing it can not be removed.
+// @param Value - The value to keep.
+template <typename Type>
+INLINE void DoNotOptimize(const Type& Value)
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+	static const void* volatile Sink;
+	Sink = &Value;
+	_ReadWriteBarrier();
+#else
+	asm volatile("" : : "r,m"(Value) : "memory");
+#endif
+}
+
+
+// Forces the compiler to assume all memory has been read and written, so stores can not be removed or reordered.
+INLINE void ClobberMemory()
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+	_ReadWriteBarrier();
+#else
+	asm volatile("" : : : "memory");
+#endif
+}
+
+
+
+// The iteration count a benchmark should run for and the amount of work each iteration does.
+struct SBenchmarkState
+{
+	// How many times the benchmarked operation should be repeated.
+	uint64 Iterations;
+
+	// How many operations a single iteration performs, batched benchmarks process many vectors per iteration.
+	uint64 ItemsPerIteration;
+
+	// How many bytes a single iteration reads and writes.
+	uint64 BytesPerIteration;
+};
+
+
+
+// A registered benchmark.
+struct SBenchmark
+{
+	// The name the benchmark is reported and filtered by.
+	std::string Name;
+
+	// Runs the benchmark for the state's iteration count.
+	std::function<void(SBenchmarkState&)> Function;
+
+	// How many operations a single iteration performs.
+	uint64 ItemsPerIteration;
+
+	// How many bytes a single iteration reads and writes.
+	uint64 BytesPerIteration;
+};
+
+
+
+// The options the benchmarks are run with, set from the command line.
+struct SBenchmarkOptions
+{
+	// Only benchmarks whose name contains this are run, empty runs everything.
+	std::string Filter;
+
+	// The minimum time in seconds a single run should take.
+	double MinTime{ 0.05 };
+
+	// How many runs each benchmark gets, the fastest is reported.
+	uint Repetitions{ 3 };
+
+	// Prints comma separated values instead of a table, for comparing backends with other tools.
+	bool CSV{ false };
+
+	// Prints the names of the benchmarks instead of running them.
+	bool List{ false };
+};
+
+
+
+// Returns every registered benchmark.
+INLINE std::vector<SBenchmark>& GetBenchmarks()
+{
+	static std::vector<SBenchmark> Benchmarks;
+	return Benchmarks;
+}
+
+
+// Registers a benchmark.
+// @param Name - The name the benchmark is reported and filtered by.
+// @param Function - Runs the benchmark for the state's iteration count.
+// @param ItemsPerIteration - How many operations a single iteration performs.
+// @param BytesPerIteration - How many bytes a single iteration reads and writes.
+INLINE void RegisterBenchmark(std::string Name, std::function<void(SBenchmarkState&)> Function, uint64 ItemsPerIteration, uint64 BytesPerIteration)
+{
+	GetBenchmarks().push_back(SBenchmark{ std::move(Name), std::move(Function), ItemsPerIteration, BytesPerIteration });
+}
+
+
+// Returns the name of the instruction sets the library was compiled with.
+INLINE const char* GetBackendName()
+{
+#if defined(COPIRITE_AVX512)
+	return "AVX-512";
+#elif defined(COPIRITE_AVX2) && defined(COPIRITE_FMA)
+	return "AVX2+FMA";
+#elif defined(COPIRITE_AVX2)
+	return "AVX2";
+#elif defined(COPIRITE_AVX)
+	return "AVX";
+#elif defined(COPIRITE_SSE41)
+	return "SSE4.1";
+#elif defined(COPIRITE_SSE2)
+	return "SSE2";
+#else
+	return "Scalar";
+#endif
+}
+
+
+// Reads the command line into a set of options.
+// @param ArgC - The number of arguments.
+// @param ArgV - The arguments.
+// @param Options - The options to fill.
+// @return - False if the benchmarks should not be run, the usage has been printed.
+INLINE bool ParseBenchmarkOptions(int ArgC, char** ArgV, SBenchmarkOptions& Options)
+{
+	for (int i = 1; i < ArgC; ++i)
+	{
+		const char* Arg{ ArgV[i] };
+		if (std::strncmp(Arg, "--filter=", 9) == 0) Options.Filter = Arg + 9;
+		else if (std::strncmp(Arg, "--min_time=", 11) == 0) Options.MinTime = std::atof(Arg + 11);
+		else if (std::strncmp(Arg, "--repetitions=", 14) == 0) Options.Repetitions = std::max(1, std::atoi(Arg + 14));
+		else if (std::strcmp(Arg, "--csv") == 0) Options.CSV = true;
+		else if (std::strcmp(Arg, "--list") == 0) Options.List = true;
+		else
+		{
+			if (std::strcmp(Arg, "--help") != 0) std::printf("Unknown argument '%s'.\n", Arg);
+			std::printf("Usage: %s [--filter=Text] [--min_time=Seconds] [--repetitions=Count] [--csv] [--list]\n", ArgV[0]);
+			return false;
+		}
+	}
+	return true;
+}
+
+
+// Times a single run of a benchmark.
+// @param Benchmark - The benchmark to run.
+// @param Iterations - How many iterations to run for.
+// @return - The time the run took in seconds.
+INLINE double TimeBenchmark(const SBenchmark& Benchmark, uint64 Iterations)
+{
+	SBenchmarkState State{ Iterations, Benchmark.ItemsPerIteration, Benchmark.BytesPerIteration };
+	const auto Start{ std::chrono::steady_clock::now() };
+	Benchmark.Function(State);
+	const auto End{ std::chrono::steady_clock::now() };
+	return std::chrono::duration<double>(End - Start).count();
+}
+
+
+// Runs every registered benchmark matching the options and prints the results.
+// @param Options - The options to run with.
+// @return - How many benchmarks were run.
+INLINE uint RunBenchmarks(const SBenchmarkOptions& Options)
+{
+	uint Count{ 0 };
+	if (Options.CSV) std::printf("name,iterations,ns_per_op,ops_per_sec,bytes_per_sec\n");
+	else if (!Options.List)
+	{
+		std::printf("Backend: %s\n", GetBackendName());
+		std::printf("%-44s %14s %12s %14s %14s\n", "Benchmark", "Iterations", "ns/op", "ops/sec", "bytes/sec");
+		std::printf("%s\n", std::string(102, '-').c_str());
+	}
+
+	for (const SBenchmark& Benchmark : GetBenchmarks())
+	{
+		if (!Options.Filter.empty() && Benchmark.Name.find(Options.Filter) == std::string::npos) continue;
+		++Count;
+		if (Options.List)
+		{
+			std::printf("%s\n", Benchmark.Name.c_str());
+			continue;
+		}
+
+		// Grow the iteration count until a run is long enough to time, aiming a little past the minimum.
+		uint64 Iterations{ 1 };
+		double Seconds{ TimeBenchmark(Benchmark, Iterations) };
+		while (Seconds < Options.MinTime)
+		{
+			const double Scale{ (Seconds > 0.0) ? (Options.MinTime * 1.4) / Seconds : 100.0 };
+			Iterations = std::max(Iterations + 1, (uint64)((double)Iterations * std::min(Scale, 100.0)));
+			Seconds = TimeBenchmark(Benchmark, Iterations);
+		}
+		for (uint i = 1; i < Options.Repetitions; ++i)
+		{
+			Seconds = std::min(Seconds, TimeBenchmark(Benchmark, Iterations));
+		}
+
+		const double Ops{ (double)Iterations * (double)Benchmark.ItemsPerIteration };
+		const double NsPerOp{ (Seconds * 1e9) / Ops };
+		const double OpsPerSecond{ Ops / Seconds };
+		const double BytesPerSecond{ ((double)Iterations * (double)Benchmark.BytesPerIteration) / Seconds };
+		if (Options.CSV)
+		{
+			std::printf("%s,%llu,%.4f,%.6e,%.6e\n", Benchmark.Name.c_str(), (unsigned long long)Iterations, NsPerOp, OpsPerSecond, BytesPerSecond);
+		}
+		else
+		{
+			std::printf("%-44s %14llu %12.3f %14.4g %14.4g\n", Benchmark.Name.c_str(), (unsigned long long)Iterations, NsPerOp, OpsPerSecond, BytesPerSecond);
+		}
+		std::fflush(stdout);
+	}
+	return Count;
+}
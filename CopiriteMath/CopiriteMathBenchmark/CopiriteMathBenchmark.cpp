@@ -0,0 +1,371 @@
+// CopiriteMathBenchmark.cpp : Microbenchmarks for every STVector operator and function.
+//
+// Every benchmark is registered for Size 2, 3 and 4 with float, double and int components, and the arithmetic ones
+// for Size 3 and 4 with Q16.16 and Q32.32 fixed point components, in two modes:
+//	Scalar/<Name>/<Vector>			- One operation per iteration on a single vector, the cost of a call in isolation.
+//	Batched/<Name>/<Vector>			- The operation over an array of vectors, the throughput when the compiler can pipeline calls.
+//	Batched/<Name>/<Vector>Array	- The batched STVectorArray function, for the operations the structure of arrays supports.
+//
+// Build the same source with different instruction sets and compare the output to compare backends, --csv makes
+// the results easy to diff. Run with --help to see the other options.
+
+#include "Benchmark.h"
+#include "CopiriteMath/Datatypes/PackedVector.h"
+#include "CopiriteMath/Datatypes/Vector.h"
+#include "CopiriteMath/Datatypes/VectorArray.h"
+#include "CopiriteMath/Datatypes/VectorExpression.h"
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+
+
+// The inputs shared by every benchmark of a vector type.
+// @template Size - How many dimensions the vectors have.
+// @template Type - The datatype the vectors use.
+template <uint Size, typename Type>
+struct TBenchmarkData
+{
+	// How many vectors the batched benchmarks operate on, small enough to stay in the L2 cache.
+	static constexpr uint Count{ 4096 };
+
+	// How many vectors the scalar benchmarks cycle through, small enough to stay in the L1 cache.
+	static constexpr uint ScalarCount{ 256 };
+
+	// The left hand operands, each component is between 1 and 2 or -1 and -2 so divisions and square roots are safe.
+	STVector<Size, Type> A[Count];
+
+	// The right hand operands, in the same range as the left hand operands.
+	STVector<Size, Type> B[Count];
+
+	// Vectors of -1, repeatedly multiplying or dividing an array by these keeps its values in range.
+	STVector<Size, Type> Signs[Count];
+
+	// The left hand operands as a structure of arrays.
+	STVectorArray<Size, Type> ArrayA;
+
+	// The right hand operands as a structure of arrays.
+	STVectorArray<Size, Type> ArrayB;
+
+	// The signs as a structure of arrays.
+	STVectorArray<Size, Type> ArraySigns;
+
+
+	// Constructor, Fills the operands with the same pseudo random values on every run.
+	TBenchmarkData()
+	{
+		uint32 Seed{ 0x9E3779B9u };
+		auto Random = [&Seed]()
+		{
+			Seed = (Seed * 1664525u) + 1013904223u;
+			const Type Magnitude{ std::is_integral<Type>::value ? (Type)(1 + ((Seed >> 8) % 16)) : (Type)(1.0 + ((double)(Seed >> 8) / 16777216.0)) };
+			return (Seed & 0x80000000u) ? -Magnitude : Magnitude;
+		};
+		for (uint i = 0; i < Count; ++i)
+		{
+			for (uint j = 0; j < Size; ++j)
+			{
+				A[i][j] = Random();
+				B[i][j] = Random();
+			}
+			Signs[i] = STVector<Size, Type>{ (Type)-1 };
+		}
+		ArrayA = STVectorArray<Size, Type>{ A, Count };
+		ArrayB = STVectorArray<Size, Type>{ B, Count };
+		ArraySigns = STVectorArray<Size, Type>{ Signs, Count };
+	}
+
+	// Returns the shared inputs, created on first use.
+	static const TBenchmarkData<Size, Type>& Get()
+	{
+		static const TBenchmarkData<Size, Type> Data;
+		return Data;
+	}
+};
+
+
+
+// Returns the name of a vector type the same way its typedef is named, SVector3d is reported as Vector3d.
+template <uint Size, typename Type>
+std::string GetVectorName()
+{
+	const char* Suffix{ std::is_same<Type, double>::value ? "d" : std::is_integral<Type>::value ? "i" : std::is_same<Type, SFixed>::value ? "x" : std::is_same<Type, SFixedd>::value ? "xd" : "" };
+	return "Vector" + std::to_string(Size) + Suffix;
+}
+
+
+// Registers the scalar and batched benchmarks of an operation on single vectors.
+// @param Name - The name of the operation.
+// @param Op - Takes one or two vectors and returns the result, functions that modify a vector take a copy and return it.
+template <uint Size, typename Type, typename Operation>
+void AddVectorBenchmark(const char* Name, Operation Op)
+{
+	typedef STVector<Size, Type> SVectorType;
+	typedef TBenchmarkData<Size, Type> SData;
+	constexpr bool Unary{ std::is_invocable<Operation, const SVectorType&>::value };
+	auto Call = [Op](const SVectorType& A, const SVectorType& B)
+	{
+		if constexpr (Unary) return Op(A);
+		else return Op(A, B);
+	};
+	typedef decltype(Call(std::declval<const SVectorType&>(), std::declval<const SVectorType&>())) SResult;
+	const uint64 Bytes{ ((Unary ? 1 : 2) * sizeof(SVectorType)) + sizeof(SResult) };
+	const std::string Suffix{ std::string{ "/" } + Name + "/" + GetVectorName<Size, Type>() };
+
+	RegisterBenchmark("Scalar" + Suffix, [Call](SBenchmarkState& State)
+		{
+			const SData& Data{ SData::Get() };
+			uint Index{ 0 };
+			for (uint64 i = 0; i < State.Iterations; ++i)
+			{
+				DoNotOptimize(Call(Data.A[Index], Data.B[Index]));
+				Index = (Index + 1) & (SData::ScalarCount - 1);
+			}
+		}, 1, Bytes);
+
+	std::shared_ptr<SResult[]> Out{ new SResult[SData::Count] };
+	RegisterBenchmark("Batched" + Suffix, [Call, Out](SBenchmarkState& State)
+		{
+			const SData& Data{ SData::Get() };
+			for (uint64 i = 0; i < State.Iterations; ++i)
+			{
+				for (uint j = 0; j < SData::Count; ++j)
+				{
+					Out[j] = Call(Data.A[j], Data.B[j]);
+				}
+				ClobberMemory();
+			}
+		}, SData::Count, Bytes * SData::Count);
+}
+
+
+// Registers the batched benchmark of a STVectorArray function.
+// @param Name - The name of the operation.
+// @param BytesPerVector - How many bytes the operation reads and writes for each vector.
+// @param Op - Takes a copy of the left hand array to modify, the data and a buffer of results it may write to.
+template <uint Size, typename Type, typename Operation>
+void AddArrayBenchmark(const char* Name, uint64 BytesPerVector, Operation Op)
+{
+	typedef TBenchmarkData<Size, Type> SData;
+	const std::string FullName{ std::string{ "Batched/" } + Name + "/" + GetVectorName<Size, Type>() + "Array" };
+	std::shared_ptr<STVectorArray<Size, Type>> Array{ new STVectorArray<Size, Type> };
+	std::shared_ptr<Type[]> Out{ new Type[SData::Count] };
+	RegisterBenchmark(FullName, [Op, Array, Out](SBenchmarkState& State)
+		{
+			const SData& Data{ SData::Get() };
+			if (Array->Num() == 0) *Array = Data.ArrayA;
+			for (uint64 i = 0; i < State.Iterations; ++i)
+			{
+				Op(*Array, Data, Out.get());
+				ClobberMemory();
+			}
+		}, SData::Count, BytesPerVector * SData::Count);
+}
+
+
+// Registers every benchmark of a vector type.
+template <uint Size, typename Type>
+void AddVectorBenchmarks()
+{
+	typedef STVector<Size, Type> V;
+	typedef STVectorArray<Size, Type> VA;
+	typedef TBenchmarkData<Size, Type> SData;
+	constexpr uint64 VectorBytes{ Size * sizeof(Type) };
+
+	/// Constructors and conversions
+
+	AddVectorBenchmark<Size, Type>("Construct", [](const V& A) { return V{ A[0] }; });
+	AddVectorBenchmark<Size, Type>("Assign", [](V A, const V& B) { A = B[0]; return A; });
+	AddVectorBenchmark<Size, Type>("ToFloat", [](const V& A) { return A.ToFloat(); });
+	AddVectorBenchmark<Size, Type>("ToDouble", [](const V& A) { return A.ToDouble(); });
+	AddVectorBenchmark<Size, Type>("ToInt", [](const V& A) { return A.ToInt(); });
+
+	/// Arithmetic
+
+	AddVectorBenchmark<Size, Type>("Add", [](const V& A, const V& B) { return A + B; });
+	AddVectorBenchmark<Size, Type>("AddValue", [](const V& A, const V& B) { return A + B[0]; });
+	AddVectorBenchmark<Size, Type>("Sub", [](const V& A, const V& B) { return A - B; });
+	AddVectorBenchmark<Size, Type>("SubValue", [](const V& A, const V& B) { return A - B[0]; });
+	AddVectorBenchmark<Size, Type>("Mul", [](const V& A, const V& B) { return A * B; });
+	AddVectorBenchmark<Size, Type>("MulValue", [](const V& A, const V& B) { return A * B[0]; });
+	AddVectorBenchmark<Size, Type>("Div", [](const V& A, const V& B) { return A / B; });
+	AddVectorBenchmark<Size, Type>("DivValue", [](const V& A, const V& B) { return A / B[0]; });
+	AddVectorBenchmark<Size, Type>("ValueDiv", [](const V& A, const V& B) { return B[0] / A; });
+	AddVectorBenchmark<Size, Type>("Negate", [](const V& A) { return -A; });
+	AddVectorBenchmark<Size, Type>("AddAssign", [](V A, const V& B) { A += B; return A; });
+	AddVectorBenchmark<Size, Type>("AddAssignValue", [](V A, const V& B) { A += B[0]; return A; });
+	AddVectorBenchmark<Size, Type>("SubAssign", [](V A, const V& B) { A -= B; return A; });
+	AddVectorBenchmark<Size, Type>("SubAssignValue", [](V A, const V& B) { A -= B[0]; return A; });
+	AddVectorBenchmark<Size, Type>("MulAssign", [](V A, const V& B) { A *= B; return A; });
+	AddVectorBenchmark<Size, Type>("MulAssignValue", [](V A, const V& B) { A *= B[0]; return A; });
+	AddVectorBenchmark<Size, Type>("DivAssign", [](V A, const V& B) { A /= B; return A; });
+	AddVectorBenchmark<Size, Type>("DivAssignValue", [](V A, const V& B) { A /= B[0]; return A; });
+	AddVectorBenchmark<Size, Type>("Increment", [](V A) { ++A; return A; });
+	AddVectorBenchmark<Size, Type>("Decrement", [](V A) { --A; return A; });
+	AddVectorBenchmark<Size, Type>("Expression", [](const V& A, const V& B) { return V{ Lazy(A) + Lazy(B) * (Type)2 - A }; });
+
+	/// Products
+
+	AddVectorBenchmark<Size, Type>("Dot", [](const V& A, const V& B) { return A ^ B; });
+	AddVectorBenchmark<Size, Type>("DotProduct", [](const V& A, const V& B) { return A.DotProduct(B); });
+	if constexpr (Size >= 3)
+	{
+		AddVectorBenchmark<Size, Type>("Cross", [](const V& A, const V& B) { return A | B; });
+		AddVectorBenchmark<Size, Type>("CrossProduct", [](const V& A, const V& B) { return A.CrossProduct(STVector<3, Type>{ B }); });
+	}
+
+	/// Comparisons
+
+	AddVectorBenchmark<Size, Type>("Greater", [](const V& A, const V& B) { return A > B; });
+	AddVectorBenchmark<Size, Type>("GreaterValue", [](const V& A, const V& B) { return A > B[0]; });
+	AddVectorBenchmark<Size, Type>("GreaterEqual", [](const V& A, const V& B) { return A >= B; });
+	AddVectorBenchmark<Size, Type>("GreaterEqualValue", [](const V& A, const V& B) { return A >= B[0]; });
+	AddVectorBenchmark<Size, Type>("Less", [](const V& A, const V& B) { return A < B; });
+	AddVectorBenchmark<Size, Type>("LessValue", [](const V& A, const V& B) { return A < B[0]; });
+	AddVectorBenchmark<Size, Type>("LessEqual", [](const V& A, const V& B) { return A <= B; });
+	AddVectorBenchmark<Size, Type>("LessEqualValue", [](const V& A, const V& B) { return A <= B[0]; });
+	AddVectorBenchmark<Size, Type>("Equal", [](const V& A, const V& B) { return A == B; });
+	AddVectorBenchmark<Size, Type>("EqualValue", [](const V& A, const V& B) { return A == B[0]; });
+	AddVectorBenchmark<Size, Type>("NotEqual", [](const V& A, const V& B) { return A != B; });
+	AddVectorBenchmark<Size, Type>("NotEqualValue", [](const V& A, const V& B) { return A != B[0]; });
+	AddVectorBenchmark<Size, Type>("NearlyEqual", [](const V& A, const V& B) { return A.nearlyEqual(B); });
+
+	/// Functions
+
+	AddVectorBenchmark<Size, Type>("Index", [](const V& A, const V& B) { return A[(uint)(B[0] < 0) + (Size - 2)]; });
+	AddVectorBenchmark<Size, Type>("Max", [](const V& A, const V& B) { return A.Max(B); });
+	AddVectorBenchmark<Size, Type>("Min", [](const V& A, const V& B) { return A.Min(B); });
+	AddVectorBenchmark<Size, Type>("ContainsNaN", [](const V& A) { return A.ContainsNaN(); });
+	AddVectorBenchmark<Size, Type>("CheckNaN", [](V A) { A.CheckNaN(); return A; });
+	if constexpr (std::is_floating_point<Type>::value)
+	{
+		AddVectorBenchmark<Size, Type>("Normalize", [](V A) { A.Normalize(); return A; });
+		AddVectorBenchmark<Size, Type>("FastNormalize", [](V A) { A.FastNormalize(); return A; });
+		AddVectorBenchmark<Size, Type>("SafeNormal", [](const V& A) { return A.SafeNormal(); });
+		AddVectorBenchmark<Size, Type>("Length", [](const V& A) { return A.Length(); });
+		AddVectorBenchmark<Size, Type>("FastLength", [](const V& A) { return A.FastLength(); });
+	}
+	if constexpr (Size >= 3)
+	{
+		AddVectorBenchmark<Size, Type>("Rotation", [](const V& A) { return A.Rotation(); });
+	}
+
+	/// Structure of arrays
+
+	AddArrayBenchmark<Size, Type>("AddAssign", 3 * VectorBytes, [](VA& A, const SData& Data, Type*) { A += Data.ArrayB; });
+	AddArrayBenchmark<Size, Type>("AddAssignVector", 2 * VectorBytes, [](VA& A, const SData& Data, Type*) { A += Data.B[0]; });
+	AddArrayBenchmark<Size, Type>("SubAssign", 3 * VectorBytes, [](VA& A, const SData& Data, Type*) { A -= Data.ArrayB; });
+	AddArrayBenchmark<Size, Type>("SubAssignVector", 2 * VectorBytes, [](VA& A, const SData& Data, Type*) { A -= Data.B[0]; });
+	AddArrayBenchmark<Size, Type>("MulAssign", 3 * VectorBytes, [](VA& A, const SData& Data, Type*) { A *= Data.ArraySigns; });
+	AddArrayBenchmark<Size, Type>("MulAssignVector", 2 * VectorBytes, [](VA& A, const SData& Data, Type*) { A *= Data.Signs[0]; });
+	AddArrayBenchmark<Size, Type>("MulAssignValue", 2 * VectorBytes, [](VA& A, const SData& Data, Type*) { A *= Data.Signs[0][0]; });
+	AddArrayBenchmark<Size, Type>("DivAssign", 3 * VectorBytes, [](VA& A, const SData& Data, Type*) { A /= Data.ArraySigns; });
+	AddArrayBenchmark<Size, Type>("DivAssignValue", 2 * VectorBytes, [](VA& A, const SData& Data, Type*) { A /= Data.Signs[0][0]; });
+	AddArrayBenchmark<Size, Type>("Expression", 3 * VectorBytes, [](VA& A, const SData& Data, Type*) { (Lazy(A) + Lazy(Data.ArrayB) * Data.Signs[0][0]).Evaluate(A); });
+	AddArrayBenchmark<Size, Type>("DotProduct", (2 * VectorBytes) + sizeof(Type), [](VA& A, const SData& Data, Type* Out) { A.DotProduct(Data.ArrayB, Out); });
+	AddArrayBenchmark<Size, Type>("DotProductVector", VectorBytes + sizeof(Type), [](VA& A, const SData& Data, Type* Out) { A.DotProduct(Data.B[0], Out); });
+	if constexpr (Size == 3)
+	{
+		std::shared_ptr<VA> Cross{ new VA{ TBenchmarkData<Size, Type>::Count } };
+		AddArrayBenchmark<Size, Type>("CrossProduct", 3 * VectorBytes, [Cross](VA& A, const SData& Data, Type*) { A.CrossProduct(Data.ArrayB, *Cross); });
+	}
+	AddArrayBenchmark<Size, Type>("Max", 3 * VectorBytes, [](VA& A, const SData& Data, Type*) { A.Max(Data.ArrayB); });
+	AddArrayBenchmark<Size, Type>("MaxVector", 2 * VectorBytes, [](VA& A, const SData& Data, Type*) { A.Max(Data.B[0]); });
+	AddArrayBenchmark<Size, Type>("Min", 3 * VectorBytes, [](VA& A, const SData& Data, Type*) { A.Min(Data.ArrayB); });
+	AddArrayBenchmark<Size, Type>("MinVector", 2 * VectorBytes, [](VA& A, const SData& Data, Type*) { A.Min(Data.B[0]); });
+	AddArrayBenchmark<Size, Type>("NearlyEqual", (2 * VectorBytes) + sizeof(bool), [](VA& A, const SData& Data, Type* Out) { A.nearlyEqual(Data.ArrayB, (bool*)Out); });
+	if constexpr (std::is_floating_point<Type>::value)
+	{
+		AddArrayBenchmark<Size, Type>("Normalize", 2 * VectorBytes, [](VA& A, const SData&, Type*) { A.Normalize(); });
+		AddArrayBenchmark<Size, Type>("FastNormalize", 2 * VectorBytes, [](VA& A, const SData&, Type*) { A.FastNormalize(); });
+	}
+}
+
+
+// Registers the benchmarks of the operations fixed point vectors support, to compare them with the float and int vectors.
+template <uint Size, typename Type>
+void AddFixedBenchmarks()
+{
+	typedef STVector<Size, Type> V;
+
+	AddVectorBenchmark<Size, Type>("Add", [](const V& A, const V& B) { return A + B; });
+	AddVectorBenchmark<Size, Type>("Sub", [](const V& A, const V& B) { return A - B; });
+	AddVectorBenchmark<Size, Type>("Mul", [](const V& A, const V& B) { return A * B; });
+	AddVectorBenchmark<Size, Type>("MulValue", [](const V& A, const V& B) { return A * B[0]; });
+	AddVectorBenchmark<Size, Type>("Div", [](const V& A, const V& B) { return A / B; });
+	AddVectorBenchmark<Size, Type>("Negate", [](const V& A) { return -A; });
+	AddVectorBenchmark<Size, Type>("Dot", [](const V& A, const V& B) { return A ^ B; });
+	if constexpr (Size == 3)
+	{
+		AddVectorBenchmark<Size, Type>("Cross", [](const V& A, const V& B) { return A | B; });
+	}
+	AddVectorBenchmark<Size, Type>("Max", [](const V& A, const V& B) { return A.Max(B); });
+	AddVectorBenchmark<Size, Type>("Min", [](const V& A, const V& B) { return A.Min(B); });
+	AddVectorBenchmark<Size, Type>("Length", [](const V& A) { return A.Length(); });
+}
+
+
+// Registers the bulk encode and decode benchmarks of a packed vector format.
+// @template Size - How many dimensions the unpacked vectors have.
+// @template Packed - The packed format.
+// @param Name - The name of the format.
+template <uint Size, typename Packed>
+void AddPackedBenchmark(const char* Name)
+{
+	typedef TBenchmarkData<Size, float> SData;
+	constexpr uint64 Bytes{ (Size * sizeof(float)) + sizeof(Packed) };
+	std::shared_ptr<Packed[]> Encoded{ new Packed[SData::Count] };
+	std::shared_ptr<STVector<Size, float>[]> Decoded{ new STVector<Size, float>[SData::Count] };
+
+	RegisterBenchmark(std::string{ "Batched/Encode/" } + Name, [Encoded](SBenchmarkState& State)
+		{
+			const SData& Data{ SData::Get() };
+			for (uint64 i = 0; i < State.Iterations; ++i)
+			{
+				Packed::Encode(Data.A, Encoded.get(), SData::Count);
+				ClobberMemory();
+			}
+		}, SData::Count, Bytes * SData::Count);
+
+	RegisterBenchmark(std::string{ "Batched/Decode/" } + Name, [Encoded, Decoded](SBenchmarkState& State)
+		{
+			Packed::Encode(SData::Get().A, Encoded.get(), SData::Count);
+			for (uint64 i = 0; i < State.Iterations; ++i)
+			{
+				Packed::Decode(Encoded.get(), Decoded.get(), SData::Count);
+				ClobberMemory();
+			}
+		}, SData::Count, Bytes * SData::Count);
+}
+
+
+int main(int ArgC, char** ArgV)
+{
+	SBenchmarkOptions Options;
+	if (!ParseBenchmarkOptions(ArgC, ArgV, Options)) return 1;
+
+	AddVectorBenchmarks<2, float>();
+	AddVectorBenchmarks<3, float>();
+	AddVectorBenchmarks<4, float>();
+	AddVectorBenchmarks<2, double>();
+	AddVectorBenchmarks<3, double>();
+	AddVectorBenchmarks<4, double>();
+	AddVectorBenchmarks<2, int>();
+	AddVectorBenchmarks<3, int>();
+	AddVectorBenchmarks<4, int>();
+
+	AddFixedBenchmarks<3, SFixed>();
+	AddFixedBenchmarks<4, SFixed>();
+	AddFixedBenchmarks<3, SFixedd>();
+	AddFixedBenchmarks<4, SFixedd>();
+
+	AddPackedBenchmark<3, SHalfVector3>("HalfVector3");
+	AddPackedBenchmark<4, SHalfVector4>("HalfVector4");
+	AddPackedBenchmark<3, SSNorm16Vector3>("SNorm16Vector3");
+	AddPackedBenchmark<4, SUNorm8Vector4>("UNorm8Vector4");
+	AddPackedBenchmark<3, SOctahedral32>("Octahedral32");
+	AddPackedBenchmark<3, SOctahedral16>("Octahedral16");
+	AddPackedBenchmark<4, SUNorm1010102>("UNorm1010102");
+
+	return (RunBenchmarks(Options) > 0) ? 0 : 1;
+}
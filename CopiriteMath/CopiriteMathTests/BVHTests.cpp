@@ -0,0 +1,150 @@
+// BVHTests.cpp : Tests for STBVH, the ray and overlap queries against testing every primitive.
+
+#include "Test.h"
+#include "CopiriteMath/Datatypes/BVH.h"
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <vector>
+
+
+
+// Below a leaf, at the parallel build threshold and well past it.
+static const uint PrimitiveCounts[]{ 0, 1, 5, 1000, 20000 };
+
+
+static std::vector<SBox3> RandomBoxes(std::mt19937& Random, uint Count)
+{
+	std::uniform_real_distribution<float> Position{ -100.0f, 100.0f }, Extent{ 0.0f, 2.0f };
+	std::vector<SBox3> Boxes(Count);
+	for (SBox3& Box : Boxes)
+	{
+		const SVector3 Center{ Position(Random), Position(Random), Position(Random) };
+		Box = SBox3::FromCenterExtent(Center, SVector3{ Extent(Random), Extent(Random), Extent(Random) });
+	}
+	return Boxes;
+}
+
+
+// Checks every query of a hierarchy against every primitive, returns false after the first failure.
+static bool CheckHierarchy(const SBVH3& Hierarchy, const std::vector<SBox3>& Boxes, std::mt19937& Random)
+{
+	const uint Count{ (uint)Boxes.size() };
+	std::vector<uint32> Sorted{ Hierarchy.GetPrimitives() };
+	std::sort(Sorted.begin(), Sorted.end());
+	for (uint i = 0; i < Count; ++i)
+	{
+		if (!CHECK(Sorted[i] == i)) return false;
+	}
+	if (!CHECK(Hierarchy.IsEmpty() == (Count == 0))) return false;
+
+	std::uniform_real_distribution<float> Position{ -110.0f, 110.0f }, Extent{ 0.0f, 20.0f }, Direction{ -1.0f, 1.0f };
+	std::vector<uint> Visits(Count);
+	for (uint Iteration = 0; Iteration < 200; ++Iteration)
+	{
+		// Every overlapping primitive is visited exactly once, anything else may be visited once with its leaf.
+		const SVector3 Center{ Position(Random), Position(Random), Position(Random) };
+		const SBox3 Search{ SBox3::FromCenterExtent(Center, SVector3{ Extent(Random) }) };
+		std::fill(Visits.begin(), Visits.end(), 0u);
+		Hierarchy.Query(Search, [&](uint32 Index) { ++Visits[Index]; });
+		for (uint i = 0; i < Count; ++i)
+		{
+			if (!CHECK(Visits[i] <= 1 && (Visits[i] == 1 || !Boxes[i].Overlaps(Search)))) return false;
+		}
+
+		const SVector3 Point{ (Count > 0 && Iteration % 2 == 0) ? Boxes[Iteration % Count].GetCenter() : Center };
+		std::fill(Visits.begin(), Visits.end(), 0u);
+		Hierarchy.Query(Point, [&](uint32 Index) { ++Visits[Index]; });
+		for (uint i = 0; i < Count; ++i)
+		{
+			if (!CHECK(Visits[i] <= 1 && (Visits[i] == 1 || !Boxes[i].Contains(Point)))) return false;
+		}
+
+		// The hierarchy runs the same primitive test on fewer primitives, so it finds the same closest distance.
+		SVector3 Ray{ Direction(Random), Direction(Random), Direction(Random) };
+		if (Iteration % 5 == 0) Ray[Iteration % 3] = 0.0f;
+		const SVector3 Inverse{ 1.0f / Ray[0], 1.0f / Ray[1], 1.0f / Ray[2] };
+		const auto TestBox{ [&](uint32 Index, float Limit)
+			{
+				float Hit;
+				return Boxes[Index].IntersectRay(Center, Inverse, Limit, Hit) ? Hit : Limit;
+			} };
+		const float MaxDistance{ (Iteration % 3 == 0) ? 50.0f : std::numeric_limits<float>::max() };
+		float Closest{ MaxDistance };
+		for (uint i = 0; i < Count; ++i) Closest = std::min(Closest, TestBox(i, Closest));
+		float Distance{ MaxDistance };
+		const uint32 Hit{ Hierarchy.IntersectRay(Center, Ray, Distance, TestBox) };
+		if (!CHECK(Distance == Closest)) return false;
+		if (!CHECK((Hit == SBVH3::None) == (Closest == MaxDistance))) return false;
+		if (Hit != SBVH3::None && !CHECK(TestBox(Hit, MaxDistance) == Closest)) return false;
+	}
+	return true;
+}
+
+
+static void TestBVHMatchesBruteForce()
+{
+	std::mt19937 Random{ 43 };
+	for (uint Count : PrimitiveCounts)
+	{
+		const std::vector<SBox3> Boxes{ RandomBoxes(Random, Count) };
+		for (uint MaxLeafSize : { 1u, 4u, 16u })
+		{
+			for (bool Parallel : { false, true })
+			{
+				SBVH3 Hierarchy;
+				Hierarchy.Build(Boxes.data(), Count, MaxLeafSize, Parallel);
+				if (!CheckHierarchy(Hierarchy, Boxes, Random)) return;
+				if (Count > 0) CHECK(Hierarchy.GetBounds() == std::accumulate(Boxes.begin(), Boxes.end(), Boxes[0]));
+			}
+		}
+	}
+}
+
+
+static void TestBVHRefit()
+{
+	// After the primitives move, a refit tree answers like a new one.
+	std::mt19937 Random{ 47 };
+	for (uint Count : PrimitiveCounts)
+	{
+		std::vector<SBox3> Boxes{ RandomBoxes(Random, Count) };
+		SBVH3 Hierarchy{ Boxes.data(), Count };
+		const uint Nodes{ (uint)Hierarchy.GetNodes().size() };
+		std::uniform_real_distribution<float> Offset{ -20.0f, 20.0f };
+		for (SBox3& Box : Boxes)
+		{
+			const SVector3 Move{ Offset(Random), Offset(Random), Offset(Random) };
+			Box = SBox3{ Box.GetMin() + Move, Box.GetMax() + Move };
+		}
+		Hierarchy.Refit(Boxes.data());
+		CHECK(Hierarchy.GetNodes().size() == Nodes);
+		if (!CheckHierarchy(Hierarchy, Boxes, Random)) return;
+
+		// Points are boxes without extent.
+		std::vector<SVector3> Points(Count);
+		std::vector<SBox3> PointBoxes(Count);
+		for (uint i = 0; i < Count; ++i)
+		{
+			Points[i] = Boxes[i].GetCenter();
+			PointBoxes[i] = SBox3{ Points[i] };
+		}
+		SBVH3 PointHierarchy;
+		PointHierarchy.Build(Points.data(), Count);
+		if (!CheckHierarchy(PointHierarchy, PointBoxes, Random)) return;
+		for (SVector3& Point : Points) Point += SVector3{ Offset(Random), Offset(Random), Offset(Random) };
+		for (uint i = 0; i < Count; ++i) PointBoxes[i] = SBox3{ Points[i] };
+		PointHierarchy.Refit(Points.data());
+		if (!CheckHierarchy(PointHierarchy, PointBoxes, Random)) return;
+	}
+}
+
+
+
+// Registers the BVH tests.
+void AddBVHTests()
+{
+	RegisterTest("BVH/MatchesBruteForce", TestBVHMatchesBruteForce);
+	RegisterTest("BVH/Refit", TestBVHRefit);
+}
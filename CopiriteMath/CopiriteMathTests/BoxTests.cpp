@@ -0,0 +1,148 @@
+// BoxTests.cpp : Tests for STBox, the ray and box packets against the scalar slab test.
+
+#include "Test.h"
+#include "CopiriteMath/Datatypes/Box.h"
+#include <cmath>
+#include <limits>
+#include <random>
+
+
+
+template <typename Type, uint Count>
+static void TestBoxPacketsMatchScalar()
+{
+	typedef STBox<3, Type> SBox;
+	typedef STVector<3, Type> SVector;
+	std::mt19937 Random{ 11 };
+	std::uniform_real_distribution<float> Value{ -10.0f, 10.0f };
+	const auto RandomVector{ [&]() { return SVector{ (Type)Value(Random), (Type)Value(Random), (Type)Value(Random) }; } };
+
+	for (uint i = 0; i < 5000; ++i)
+	{
+		SBox Boxes[Count];
+		for (uint j = 0; j < Count; ++j)
+		{
+			const SVector A{ RandomVector() }, B{ RandomVector() };
+			Boxes[j] = SBox{ A.Min(B), A.Max(B) };
+		}
+		const uint Used{ 1 + (uint)(Random() % Count) };
+		const STBoxPacket<3, Type, Count> Packet{ Boxes, Used };
+
+		// Every fifth ray is parallel to an axis, every seventh lies on the first box's slab plane.
+		SVector Origin{ RandomVector() }, Direction{ RandomVector() };
+		if (i % 5 == 0) Direction[i % 3] = 0;
+		if (i % 7 == 0)
+		{
+			Origin[0] = Boxes[0].GetMin()[0];
+			Direction[0] = 0;
+		}
+		const SVector Inverse{ (Type)1 / Direction[0], (Type)1 / Direction[1], (Type)1 / Direction[2] };
+		const Type MaxDistance{ (i % 3 == 0) ? (Type)0.5 : std::numeric_limits<Type>::max() };
+
+		TLanes<Type, Count> Distances;
+		const uint Hits{ Packet.IntersectRay(Origin, Inverse, MaxDistance, Distances) };
+		for (uint j = 0; j < Count; ++j)
+		{
+			Type Distance;
+			const bool Hit{ j < Used && Boxes[j].IntersectRay(Origin, Inverse, MaxDistance, Distance) };
+			if (CHECK(Hit == (bool)((Hits >> j) & 1)) && Hit) CHECK(Distance == Distances[j]);
+			CHECK((j < Used && Boxes[j].Overlaps(Boxes[0])) == (bool)((Packet.Overlaps(Boxes[0]) >> j) & 1));
+			CHECK((j < Used && Boxes[j].Contains(Origin)) == (bool)((Packet.Contains(Origin) >> j) & 1));
+		}
+
+		SVector Origins[Count], Directions[Count];
+		for (uint j = 0; j < Count; ++j)
+		{
+			Origins[j] = RandomVector();
+			Directions[j] = RandomVector();
+			if ((i + j) % 4 == 0) Directions[j][j % 3] = 0;
+		}
+		const STRayPacket<3, Type, Count> Rays{ Origins, Directions, Used, MaxDistance };
+		const uint RayHits{ Boxes[0].IntersectRays(Rays, Distances) };
+		for (uint j = 0; j < Count; ++j)
+		{
+			Type Distance;
+			const SVector RayInverse{ (Type)1 / Directions[j][0], (Type)1 / Directions[j][1], (Type)1 / Directions[j][2] };
+			const bool Hit{ j < Used && Boxes[0].IntersectRay(Origins[j], RayInverse, MaxDistance, Distance) };
+			if (CHECK(Hit == (bool)((RayHits >> j) & 1)) && Hit) CHECK(Distance == Distances[j]);
+		}
+	}
+}
+
+
+static void TestBoxQueries()
+{
+	// Merging, overlap, containment and area against the same questions asked one axis at a time.
+	std::mt19937 Random{ 13 };
+	std::uniform_real_distribution<float> Value{ -10.0f, 10.0f };
+	const auto RandomVector{ [&]() { return SVector3{ Value(Random), Value(Random), Value(Random) }; } };
+	for (uint i = 0; i < 5000; ++i)
+	{
+		SVector3 Points[9];
+		for (SVector3& Point : Points) Point = RandomVector();
+		const SBox3 A{ Points[0].Min(Points[1]), Points[0].Max(Points[1]) }, B{ Points[2].Min(Points[3]), Points[2].Max(Points[3]) };
+		const SBox3 Merged{ A + B }, Bounds{ SBox3::FromPoints(Points, 9) };
+		bool Overlaps{ true }, Contains{ true };
+		float Area{ 0.0f };
+		for (uint j = 0; j < 3; ++j)
+		{
+			CHECK(Merged.GetMin()[j] == std::fmin(A.GetMin()[j], B.GetMin()[j]) && Merged.GetMax()[j] == std::fmax(A.GetMax()[j], B.GetMax()[j]));
+			float Low{ Points[0][j] }, High{ Points[0][j] };
+			for (const SVector3& Point : Points)
+			{
+				Low = std::fmin(Low, Point[j]);
+				High = std::fmax(High, Point[j]);
+			}
+			CHECK(Bounds.GetMin()[j] == Low && Bounds.GetMax()[j] == High);
+			Overlaps = Overlaps && A.GetMin()[j] <= B.GetMax()[j] && B.GetMin()[j] <= A.GetMax()[j];
+			Contains = Contains && A.GetMin()[j] <= Points[4][j] && Points[4][j] <= A.GetMax()[j];
+			const float Size{ A.GetMax()[j] - A.GetMin()[j] }, Other{ A.GetMax()[(j + 1) % 3] - A.GetMin()[(j + 1) % 3] };
+			Area += 2.0f * Size * Other;
+		}
+		CHECK(A.Overlaps(B) == Overlaps && B.Overlaps(A) == Overlaps);
+		CHECK(A.Contains(Points[4]) == Contains);
+		CHECK(Merged.Contains(A) && Merged.Contains(B) && Bounds.Contains(Points[8]));
+		CHECK(std::fabs(A.SurfaceArea() - Area) <= Area * 1e-5f);
+		CHECK(A.IsValid() && !SBox3{ A.GetMax(), A.GetMin() - 1.0f }.IsValid());
+	}
+}
+
+
+static void TestBoxRayOnSlabPlane()
+{
+	// Rays parallel to a slab count as inside it when they lie exactly on one of its planes.
+	const SBox3 Box{ SVector3{ 0.0f }, SVector3{ 1.0f } };
+	const float Infinity{ std::numeric_limits<float>::infinity() };
+	const float Heights[5]{ 0.0f, 1.0f, 0.5f, -0.1f, 1.1f };
+	const bool Expected[5]{ true, true, true, false, false };
+	for (float Sign : { -1.0f, 1.0f })
+	{
+		for (uint i = 0; i < 5; ++i)
+		{
+			const SVector3 Origin{ (Sign < 0.0f) ? 2.0f : -1.0f, Heights[i], 0.5f }, Direction{ Sign, 0.0f, 0.0f };
+			const SVector3 Inverse{ 1.0f / Direction[0], 1.0f / Direction[1], 1.0f / Direction[2] };
+			float Distance;
+			CHECK(Box.IntersectRay(Origin, Inverse, Infinity, Distance) == Expected[i]);
+
+			const SBox3 Boxes[3]{ Box, Box, Box };
+			CHECK(STBoxPacket<3, float>(Boxes, 3).IntersectRay(Origin, Inverse, Infinity) == (Expected[i] ? 7u : 0u));
+
+			// The unused lanes of a ray packet never hit, even an infinite box.
+			const STRayPacket<3, float> Rays{ &Origin, &Direction, 1, Infinity };
+			CHECK(Box.IntersectRays(Rays) == (Expected[i] ? 1u : 0u));
+			CHECK(SBox3(SVector3{ -Infinity }, SVector3{ Infinity }).IntersectRays(Rays) == 1u);
+		}
+	}
+}
+
+
+
+// Registers the Box tests.
+void AddBoxTests()
+{
+	RegisterTest("Box/PacketsMatchScalar", TestBoxPacketsMatchScalar<float, TNativeLanes<float>::Count>);
+	RegisterTest("Box/PacketsMatchScalar4", TestBoxPacketsMatchScalar<float, 4>);
+	RegisterTest("Box/PacketsMatchScalarDouble", TestBoxPacketsMatchScalar<double, TNativeLanes<double>::Count>);
+	RegisterTest("Box/Queries", TestBoxQueries);
+	RegisterTest("Box/RayOnSlabPlane", TestBoxRayOnSlabPlane);
+}
@@ -0,0 +1,62 @@
+// ConstexprTests.cpp : Tests for STVector in constant expressions, the compile time results against the SIMD paths at runtime.
+
+#include "Test.h"
+#include "CopiriteMath/Datatypes/Vector.h"
+
+
+
+// Tables like these are the reason STVector is constexpr, they must be built by the compiler.
+static constexpr SVector3i CubeCorners[8]{ { 0, 0, 0 }, { 1, 0, 0 }, { 0, 1, 0 }, { 1, 1, 0 }, { 0, 0, 1 }, { 1, 0, 1 }, { 0, 1, 1 }, { 1, 1, 1 } };
+static constexpr SVector Directions[6]{ SVector{ 1.0f, 0.0f, 0.0f }, -SVector{ 1.0f, 0.0f, 0.0f }, SVector{ 0.0f, 1.0f, 0.0f }, -SVector{ 0.0f, 1.0f, 0.0f },
+	SVector{ 1.0f, 0.0f, 0.0f } | SVector{ 0.0f, 1.0f, 0.0f }, SVector{ 0.0f, 1.0f, 0.0f } | SVector{ 1.0f, 0.0f, 0.0f } };
+static constexpr SVector4 Blended{ (SVector4{ 1.0f, 2.0f, 3.0f, 4.0f } * 2.0f + 1.0f - SVector4{ 0.5f }) / SVector4{ 2.0f, 4.0f, 8.0f, 16.0f } };
+static constexpr SVector4d Clamped{ SVector4d{ -2.0, 0.5, 3.0, 10.0 }.Max(SVector4d{ 0.0 }).Min(SVector4d{ 1.0 }) };
+static constexpr SVector2 Widened{ SVector2{ SVector4{ 5.0f, 6.0f, 7.0f, 8.0f } } };
+static constexpr SVector4 Flooded{ SVector4{ SVector2d{ 1.0, 2.0 }, 9.0f } };
+
+static_assert(CubeCorners[7] == SVector3i{ 1 } && CubeCorners[5][1] == 0);
+static_assert(Directions[4] == SVector{ 0.0f, 0.0f, 1.0f } && Directions[5] == SVector{ 0.0f, 0.0f, -1.0f });
+static_assert((SVector{ 1.0f, 2.0f, 3.0f } ^ SVector{ 4.0f, 5.0f, 6.0f }) == 32.0f);
+static_assert((SVector4i{ 1, 2, 3, 4 } ^ SVector4i{ 1, 2, 3, 4 }) == 30);
+static_assert(Blended == SVector4{ 1.25f, 1.125f, 0.8125f, 0.53125f });
+static_assert(Clamped == SVector4d{ 0.0, 0.5, 1.0, 1.0 });
+static_assert(Widened == SVector2{ 5.0f, 6.0f } && Flooded == SVector4{ 1.0f, 2.0f, 9.0f, 9.0f });
+static_assert(SVector{ 3.0f, 4.0f, 0.0f }.LengthSquared() == 25.0f && SVector{} == 0.0f);
+
+
+
+// Keeps the compiler from folding the runtime side of a comparison.
+template <typename Type>
+static Type Opaque(Type Value)
+{
+	volatile Type Copy{ Value };
+	return Copy;
+}
+
+
+static void TestConstexprMatchesRuntime()
+{
+	// Exactly representable inputs, so the SIMD paths must agree with the compile time loops bit for bit.
+	const SVector4 A{ Opaque(1.0f), Opaque(2.0f), Opaque(3.0f), Opaque(4.0f) };
+	CHECK(((A * 2.0f + 1.0f - SVector4{ 0.5f }) / SVector4{ 2.0f, 4.0f, 8.0f, 16.0f }) == Blended);
+
+	const SVector4d B{ Opaque(-2.0), Opaque(0.5), Opaque(3.0), Opaque(10.0) };
+	CHECK(B.Max(SVector4d{ 0.0 }).Min(SVector4d{ 1.0 }) == Clamped);
+
+	const SVector X{ Opaque(1.0f), 0.0f, 0.0f }, Y{ 0.0f, Opaque(1.0f), 0.0f };
+	CHECK((X | Y) == Directions[4]);
+	CHECK((Y | X) == Directions[5]);
+	CHECK((SVector{ Opaque(1.0f), 2.0f, 3.0f } ^ SVector{ 4.0f, 5.0f, 6.0f }) == 32.0f);
+
+	SVector3i Sum{ 0 };
+	for (const SVector3i& Corner : CubeCorners) Sum += Corner;
+	CHECK(Sum == SVector3i{ Opaque(4) });
+}
+
+
+
+// Registers the Constexpr tests.
+void AddConstexprTests()
+{
+	RegisterTest("Constexpr/MatchesRuntime", TestConstexprMatchesRuntime);
+}
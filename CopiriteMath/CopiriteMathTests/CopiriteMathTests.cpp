@@ -0,0 +1,65 @@
+// CopiriteMathTests.cpp : Tests for the guarantees the library documents.
+//
+// Each group of tests lives in <Group>Tests.cpp and checks one part of the library, usually its SIMD, batched or
+// parallel paths against a scalar or brute force reference. Build the same source with different instruction sets to
+// test each backend. Run with --help to see the options.
+
+#include "Test.h"
+
+
+
+// Registered by the source file of each group.
+void AddNaNTests();
+void AddVectorTests();
+void AddVectorArrayTests();
+void AddExpressionTests();
+void AddMathTests();
+void AddMatrixTests();
+void AddQuaternionTests();
+void AddConstexprTests();
+void AddBoxTests();
+void AddBVHTests();
+void AddKDTreeTests();
+void AddParallelTests();
+void AddReduceTests();
+void AddNormalizeTests();
+void AddPackedTests();
+void AddFileTests();
+void AddFixedTests();
+void AddInstrumentationTests();
+void AddTriangleTests();
+void AddFrustumTests();
+
+
+
+int main(int ArgC, char** ArgV)
+{
+	STestOptions Options;
+	if (!ParseTestOptions(ArgC, ArgV, Options)) return 1;
+
+	AddNaNTests();
+	AddVectorTests();
+	AddVectorArrayTests();
+	AddExpressionTests();
+	AddMathTests();
+	AddMatrixTests();
+	AddQuaternionTests();
+	AddConstexprTests();
+	AddBoxTests();
+	AddBVHTests();
+	AddKDTreeTests();
+	AddParallelTests();
+	AddReduceTests();
+	AddNormalizeTests();
+	AddPackedTests();
+	AddFileTests();
+	AddFixedTests();
+	AddInstrumentationTests();
+	AddTriangleTests();
+	AddFrustumTests();
+
+	uint Run;
+	const uint Failed{ RunTests(Options, Run) };
+	if (!Options.List) std::printf("%u of %u tests passed\n", Run - Failed, Run);
+	return (Failed == 0 && Run > 0) ? 0 : 1;
+}
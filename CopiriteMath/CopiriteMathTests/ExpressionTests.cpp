@@ -0,0 +1,151 @@
+// ExpressionTests.cpp : Tests for the vector expression templates, the fused evaluation against the same operators applied one at a time.
+
+#include "Test.h"
+#include "CopiriteMath/Datatypes/VectorExpression.h"
+#include <cmath>
+#include <limits>
+#include <random>
+#include <utility>
+
+
+
+// Returns whether two values are within a few rounding errors, either side may have been contracted into fused multiply adds.
+template <typename Type>
+static bool NearlyEqual(Type A, Type B, Type Magnitude)
+{
+	return std::fabs(A - B) <= std::numeric_limits<Type>::epsilon() * 4 * Magnitude;
+}
+
+
+template <uint Size, typename Type>
+static void TestVectorExpressionMatchesOperators()
+{
+	typedef STVector<Size, Type> SVector;
+	std::mt19937 Random{ 13 };
+	std::uniform_real_distribution<Type> Value{ (Type)0.5, (Type)10 };
+	for (uint i = 0; i < 10000; ++i)
+	{
+		SVector A, B, C;
+		for (uint j = 0; j < Size; ++j)
+		{
+			A[j] = Value(Random);
+			B[j] = Value(Random);
+			C[j] = Value(Random);
+		}
+		const SVector Lazily{ Lazy(A) + Lazy(B) * (Type)2 - C / Lazy(A) };
+		const SVector Negated{ -(Lazy(A) - B) };
+		for (uint j = 0; j < Size; ++j)
+		{
+			const Type Expected{ (A[j] + (B[j] * (Type)2)) - (C[j] / A[j]) };
+			CHECK(NearlyEqual(Lazily[j], Expected, std::fabs(A[j]) + (B[j] * (Type)2) + std::fabs(C[j] / A[j])));
+			CHECK(BitEqual(Negated[j], (Type)-(A[j] - B[j])));
+		}
+	}
+}
+
+
+template <uint Size, typename Type>
+static void TestArrayExpressionMatchesOperators()
+{
+	typedef STVector<Size, Type> SVector;
+	typedef STVectorArray<Size, Type> SArray;
+	std::mt19937 Random{ 17 };
+	std::uniform_real_distribution<Type> Value{ (Type)-10, (Type)10 };
+	for (uint Count : { 0u, 1u, 19u, 40000u + 5u })
+	{
+		std::vector<SVector> Positions(Count), Velocities(Count);
+		for (uint i = 0; i < Count; ++i)
+		{
+			for (uint j = 0; j < Size; ++j)
+			{
+				Positions[i][j] = Value(Random);
+				Velocities[i][j] = Value(Random);
+			}
+		}
+		SArray P{ Positions.data(), Count };
+		const SArray V{ Velocities.data(), Count };
+		const SVector Offset{ (Type)3 };
+		const Type Delta{ (Type)0.25 };
+
+		// Into a separate array, then into one of its own operands.
+		SArray Out;
+		CHECK((Lazy(P) + Lazy(V) * Delta - Offset).Evaluate(Out));
+		CHECK(Out.Num() == Count);
+		CHECK((Lazy(P) + Lazy(V) * Delta - Offset).Evaluate(P));
+		for (uint i = 0; i < Count; ++i)
+		{
+			const SVector Separate{ std::as_const(Out)[i] }, InPlace{ std::as_const(P)[i] };
+			for (uint j = 0; j < Size; ++j)
+			{
+				const Type Expected{ (Positions[i][j] + (Velocities[i][j] * Delta)) - Offset[j] };
+				CHECK(NearlyEqual(Separate[j], Expected, std::fabs(Positions[i][j]) + std::fabs(Velocities[i][j] * Delta) + Offset[j]));
+				CHECK(BitEqual(Separate[j], InPlace[j]));
+			}
+		}
+
+		// Operands of different lengths leave the destination untouched.
+		const SArray Longer{ Velocities.data(), Count / 2 };
+		SArray Untouched{ Positions.data(), Count };
+		CHECK(!(Lazy(Untouched) + Lazy(Longer)).Evaluate(Untouched) || Count == 0);
+		if (Count > 0) CHECK(std::as_const(Untouched)[Count - 1] == Positions[Count - 1]);
+	}
+}
+
+
+static void TestArrayExpressionNaN()
+{
+	// NaN in any piece is reported once for the whole evaluation, garbage in the padding past the end is never reported.
+	if constexpr ((ENaNPolicy)COPIRITE_NAN_POLICY == ENaNPolicy::Assert) return;
+	const float NaN{ std::numeric_limits<float>::quiet_NaN() };
+	const uint Count{ 40000 + 7 };
+	SVector3Array A{ Count };
+	for (uint i = 0; i < Count; ++i) A[i] = SVector3{ (float)i };
+	A[5][1] = NaN;
+	A[30001][2] = std::numeric_limits<float>::infinity();
+
+	const uint64 Before{ SNaNCounter::Reset() };
+	SVector3Array Out;
+	CHECK((Lazy(A) * 2.0f).Evaluate(Out));
+	const uint64 Reported{ SNaNCounter::Get() };
+	if constexpr ((ENaNPolicy)COPIRITE_NAN_POLICY == ENaNPolicy::Off)
+	{
+		CHECK(Reported == 0);
+		CHECK(std::isnan(std::as_const(Out)[5][1]));
+	}
+	else
+	{
+		CHECK(Reported == 1);
+		if constexpr ((ENaNPolicy)COPIRITE_NAN_POLICY == ENaNPolicy::Sanitize)
+		{
+			CHECK(std::as_const(Out)[5] == SVector3{ 0.0f });
+			CHECK(std::as_const(Out)[30001] == SVector3{ 0.0f });
+		}
+	}
+	CHECK(std::as_const(Out)[6] == SVector3{ 12.0f });
+
+	SVector3Array Short{ 20 };
+	for (uint i = 0; i < 20; ++i)
+	{
+		for (uint j = 0; j < 3; ++j) Short.GetAxis(j)[i] = (i < 17) ? 1.0f : NaN;
+	}
+	Short.Resize(17);
+	SNaNCounter::Reset();
+	CHECK((Lazy(Short) + 1.0f).Evaluate(Out));
+	CHECK(SNaNCounter::Get() == 0);
+
+	SNaNCounter::Reset();
+	for (uint64 i = 0; i < Before; ++i) SNaNCounter::Increment();
+}
+
+
+
+// Registers the Expression tests.
+void AddExpressionTests()
+{
+	RegisterTest("Expression/VectorMatchesOperators3", TestVectorExpressionMatchesOperators<3, float>);
+	RegisterTest("Expression/VectorMatchesOperators4", TestVectorExpressionMatchesOperators<4, float>);
+	RegisterTest("Expression/VectorMatchesOperators4Double", TestVectorExpressionMatchesOperators<4, double>);
+	RegisterTest("Expression/ArrayMatchesOperators3", TestArrayExpressionMatchesOperators<3, float>);
+	RegisterTest("Expression/ArrayMatchesOperators4Double", TestArrayExpressionMatchesOperators<4, double>);
+	RegisterTest("Expression/ArrayNaN", TestArrayExpressionNaN);
+}
@@ -0,0 +1,174 @@
+// FileTests.cpp : Tests for vector files, round trips through every reader and damaged files being rejected.
+
+#include "Test.h"
+#include "CopiriteMath/IO/VectorFile.h"
+#include <filesystem>
+#include <random>
+#include <utility>
+
+
+
+// Returns a path in the temporary directory for the file tests.
+static std::string TempPath(const char* Name)
+{
+	return (std::filesystem::temp_directory_path() / Name).string();
+}
+
+
+template <uint Size, typename Type>
+static void TestFileRoundTrip(EVectorLayout Layout, bool Bounds)
+{
+	typedef STVector<Size, Type> SVector;
+	std::mt19937 Random{ 3 };
+	std::uniform_real_distribution<double> Value{ -100.0, 100.0 };
+	std::vector<SVector> Vectors(1000);
+	for (SVector& Vector : Vectors)
+	{
+		for (uint j = 0; j < Size; ++j) Vector[j] = (Type)Value(Random);
+	}
+
+	// Written as pointers and as an array, across chunk boundaries.
+	const std::string Path{ TempPath("CopiriteMathTests.cpv") };
+	{
+		STVectorFileWriter<Size, Type> Writer;
+		CHECK(Writer.Open(Path.c_str(), Layout, 100, Bounds));
+		CHECK(Writer.Write(Vectors.data(), 10));
+		CHECK(Writer.Write(Vectors.data() + 10, 300));
+		CHECK(Writer.Write(STVectorArray<Size, Type>{ Vectors.data() + 310, 400 }));
+		CHECK(Writer.Write(Vectors.data() + 710, 290));
+		CHECK(Writer.Close());
+	}
+
+	{
+		STVectorFileReader<Size, Type> Reader;
+		CHECK(Reader.Open(Path.c_str()));
+		CHECK(Reader.GetHeader().Count == 1000);
+		std::vector<SVector> Read;
+		STVectorChunk<Size, Type> Chunk;
+		uint Chunks{ 0 };
+		while (Reader.Next(Chunk))
+		{
+			if (Chunks++ % 2 == 0)
+			{
+				std::vector<SVector> Part(Chunk.Count);
+				CHECK(Reader.Read(Part.data()));
+				Read.insert(Read.end(), Part.begin(), Part.end());
+				if (Bounds)
+				{
+					for (const SVector& Vector : Part) CHECK(Chunk.Bounds.Contains(Vector));
+				}
+			}
+			else
+			{
+				STVectorArray<Size, Type> Part;
+				CHECK(Reader.Read(Part));
+				for (uint i = 0; i < Part.Num(); ++i) Read.push_back(std::as_const(Part)[i]);
+			}
+		}
+		CHECK(Read == Vectors);
+		CHECK(Reader.GetHeader().ChunkCount == Chunks);
+	}
+
+	{
+		STMappedVectorFile<Size, Type> Mapped;
+		CHECK(Mapped.Open(Path.c_str()));
+		CHECK(Mapped.Num() == 1000);
+		size_t Index{ 0 };
+		for (uint c = 0; c < Mapped.NumChunks(); ++c)
+		{
+			for (uint i = 0; i < Mapped.GetChunk(c).Count && Index < Vectors.size(); ++i, ++Index) CHECK(Mapped.Get(c, i) == Vectors[Index]);
+		}
+		CHECK(Index == Vectors.size());
+	}
+
+	{
+		// A file is only opened as the type and size it was written with.
+		STVectorFileReader<Size + 1, Type> Reader;
+		CHECK(!Reader.Open(Path.c_str()));
+	}
+	std::filesystem::remove(Path);
+}
+
+
+static void TestFileRejectsDamage()
+{
+	const std::string Path{ TempPath("CopiriteMathTests.cpv") }, DamagedPath{ TempPath("CopiriteMathTestsDamaged.cpv") };
+	std::vector<SVector3> Vectors(1000);
+	for (uint i = 0; i < 1000; ++i) Vectors[i] = SVector3{ (float)i, (float)i * 2.0f, (float)i * 3.0f };
+	{
+		STVectorFileWriter<3, float> Writer;
+		CHECK(Writer.Open(Path.c_str(), EVectorLayout::AoS, 300));
+		CHECK(Writer.Write(Vectors.data(), 1000));
+		CHECK(Writer.Close());
+	}
+
+	std::vector<uint8> Good(std::filesystem::file_size(Path));
+	{
+		FILE* File{ TVectorFile::Open(Path.c_str(), "rb") };
+		if (!CHECK(File != nullptr)) return;
+		CHECK(std::fread(Good.data(), 1, Good.size(), File) == Good.size());
+		std::fclose(File);
+	}
+	const auto Damage{ [&](const std::function<void(std::vector<uint8>&)>& Change)
+		{
+			std::vector<uint8> Bytes{ Good };
+			Change(Bytes);
+			FILE* File{ TVectorFile::Open(DamagedPath.c_str(), "wb") };
+			if (!CHECK(File != nullptr)) return;
+			std::fwrite(Bytes.data(), 1, Bytes.size(), File);
+			std::fclose(File);
+		} };
+	SVectorFileHeader Header;
+	std::memcpy(&Header, Good.data(), sizeof(SVectorFileHeader));
+	const size_t HeaderBytes{ Header.HeaderBytes };
+
+	Damage([](std::vector<uint8>& Bytes) { ((SVectorFileHeader*)Bytes.data())->Layout = (EVectorLayout)7; });
+	{
+		STVectorFileReader<3, float> Reader;
+		CHECK(!Reader.Open(DamagedPath.c_str()));
+		STMappedVectorFile<3, float> Mapped;
+		CHECK(!Mapped.Open(DamagedPath.c_str()));
+	}
+
+	Damage([HeaderBytes](std::vector<uint8>& Bytes) { ((SVectorFileHeader*)Bytes.data())->HeaderBytes = (uint16)(HeaderBytes + 8); });
+	{
+		STVectorFileReader<3, float> Reader;
+		CHECK(!Reader.Open(DamagedPath.c_str()));
+	}
+
+	// A chunk claiming more vectors than the file holds.
+	Damage([HeaderBytes](std::vector<uint8>& Bytes)
+		{
+			SVectorChunkHeader* Chunk{ (SVectorChunkHeader*)(Bytes.data() + HeaderBytes) };
+			Chunk->Count = 0xFFFFFFF0ull;
+			Chunk->PayloadBytes = TVectorFile::PayloadBytes(EVectorLayout::AoS, 3, sizeof(float), Chunk->Count);
+		});
+	{
+		STVectorFileReader<3, float> Reader;
+		STVectorChunk<3, float> Chunk;
+		CHECK(Reader.Open(DamagedPath.c_str()));
+		CHECK(!Reader.Next(Chunk));
+	}
+
+	Damage([](std::vector<uint8>& Bytes) { Bytes.resize(Bytes.size() - 64); });
+	{
+		STVectorFileReader<3, float> Reader;
+		CHECK(Reader.Open(DamagedPath.c_str()));
+		CHECK(!Reader.ForEachChunk([](const SVector3*, uint) {}));
+	}
+
+	std::filesystem::remove(Path);
+	std::filesystem::remove(DamagedPath);
+}
+
+
+
+// Registers the File tests.
+void AddFileTests()
+{
+	RegisterTest("File/RoundTripAoS", [] { TestFileRoundTrip<3, float>(EVectorLayout::AoS, true); });
+	RegisterTest("File/RoundTripSoA", [] { TestFileRoundTrip<3, float>(EVectorLayout::SoA, true); });
+	RegisterTest("File/RoundTripDouble", [] { TestFileRoundTrip<4, double>(EVectorLayout::SoA, false); });
+	RegisterTest("File/RoundTripInt", [] { TestFileRoundTrip<2, int>(EVectorLayout::AoS, false); });
+	RegisterTest("File/RejectsDamage", TestFileRejectsDamage);
+}
@@ -0,0 +1,97 @@
+// FixedTests.cpp : Tests for fixed point numbers, rounding against an exact reference and the SIMD vectors against the scalar operators.
+
+#include "Test.h"
+#include "CopiriteMath/Datatypes/Vector.h"
+#include "CopiriteMath/Math/Fixed.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+
+
+
+
+// Returns a Q16.16 quotient rounded to nearest with ties up, saturated, or the saturated sign of the numerator for a zero divisor.
+static int32 ReferenceDivide(int32 A, int32 B)
+{
+	if (B == 0) return (A < 0) ? std::numeric_limits<int32>::lowest() : std::numeric_limits<int32>::max();
+	const int64 Numerator{ (int64)A * 65536 };
+	int64 Quotient{ Numerator / B };
+	const int64 Remainder{ Numerator % B };
+	const bool Negative{ (Numerator < 0) != (B < 0) };
+	const int64 Twice{ 2 * (Remainder < 0 ? -Remainder : Remainder) }, Divisor{ B < 0 ? -(int64)B : (int64)B };
+	if (Twice > Divisor || (Twice == Divisor && !Negative)) Quotient += Negative ? -1 : 1;
+	return (int32)std::clamp<int64>(Quotient, std::numeric_limits<int32>::lowest(), std::numeric_limits<int32>::max());
+}
+
+
+static void TestFixedRounding()
+{
+	std::mt19937_64 Random{ 19 };
+	for (uint i = 0; i < 100000; ++i)
+	{
+		// Shifted by a random amount so small and large magnitudes are both covered.
+		const int32 A{ (int32)((int64)Random() >> (32 + Random() % 32)) }, B{ (int32)((int64)Random() >> (32 + Random() % 32)) };
+		const SFixed X{ SFixed::FromBits(A) }, Y{ SFixed::FromBits(B) };
+		CHECK((X * Y).Bits == (int32)(((int64)A * B + 32768) >> 16));
+		if (A != 0 || B != 0) CHECK((X / Y).Bits == ReferenceDivide(A, B));
+		if (A > 0)
+		{
+			// Rounded to nearest, the integer square root of the value scaled up by 2^16.
+			const uint64 Scaled{ (uint64)A << 16 };
+			uint64 Root{ (uint64)std::sqrt((double)Scaled) };
+			while (Root * Root > Scaled) --Root;
+			while ((Root + 1) * (Root + 1) <= Scaled) ++Root;
+			if (Scaled - (Root * Root) > Root) ++Root;
+			CHECK((uint64)X.Sqrt().Bits == Root);
+		}
+
+		// Q32.32 products that fit in 64 bits, so the reference needs no wider type.
+		const int64 C{ (int64)Random() >> 33 }, D{ (int64)Random() >> 33 };
+		CHECK((SFixedd::FromBits(C) * SFixedd::FromBits(D)).Bits == ((C * D) + (1ll << 31)) >> 32);
+	}
+	static_assert(SFixed(1.5).Bits == 0x18000, "Converting from a double must be exact for representable values.");
+	static_assert((SFixed(3) * SFixed(0.5)).Bits == 0x18000, "Multiplication must be usable in constant expressions.");
+}
+
+
+template <typename Fixed>
+static void TestFixedVectorMatchesScalar()
+{
+	typedef decltype(Fixed::Bits) Storage;
+	std::mt19937_64 Random{ 23 };
+	for (uint i = 0; i < 20000; ++i)
+	{
+		Fixed A[4], B[4];
+		for (uint j = 0; j < 4; ++j)
+		{
+			A[j] = Fixed::FromBits((Storage)((int64)Random() >> (16 + (i % 3) * 4)));
+			B[j] = Fixed::FromBits((Storage)((int64)Random() >> (16 + (i % 3) * 4)));
+			if (B[j].Bits == 0) B[j].Bits = 1;
+		}
+		const STVector<4, Fixed> VA{ A[0], A[1], A[2], A[3] }, VB{ B[0], B[1], B[2], B[3] };
+		const STVector<4, Fixed> Sum{ VA + VB }, Difference{ VA - VB }, Product{ VA * VB }, Quotient{ VA / VB }, Lowest{ VA.Min(VB) }, Highest{ VA.Max(VB) };
+		Fixed Dot{ Fixed::FromBits(0) };
+		for (uint j = 0; j < 4; ++j)
+		{
+			CHECK(Sum[j] == A[j] + B[j]);
+			CHECK(Difference[j] == A[j] - B[j]);
+			CHECK(Product[j] == A[j] * B[j]);
+			CHECK(Quotient[j] == A[j] / B[j]);
+			CHECK(Lowest[j] == ((A[j] < B[j]) ? A[j] : B[j]));
+			CHECK(Highest[j] == ((A[j] > B[j]) ? A[j] : B[j]));
+			Dot += A[j] * B[j];
+		}
+		CHECK((VA ^ VB) == Dot);
+	}
+}
+
+
+
+// Registers the Fixed tests.
+void AddFixedTests()
+{
+	RegisterTest("Fixed/Rounding", TestFixedRounding);
+	RegisterTest("Fixed/VectorMatchesScalar", TestFixedVectorMatchesScalar<SFixed>);
+	RegisterTest("Fixed/VectorMatchesScalarDouble", TestFixedVectorMatchesScalar<SFixedd>);
+}
@@ -0,0 +1,165 @@
+// FrustumTests.cpp : Tests for STFrustum, the batched culling against classifying each sphere and box on its own.
+
+#include "Test.h"
+#include "CopiriteMath/Datatypes/Frustum.h"
+#include <limits>
+#include <random>
+#include <vector>
+
+
+
+// Lengths around the lane count, so partial groups at the end are covered.
+static const uint FrustumLengths[]{ 0, 1, 7, 17, 1000, 20000 + 3 };
+
+
+// Returns a frustum of six unit planes facing the origin from between 1 and 3 units away, so spheres near it are inside.
+template <typename Type>
+static STFrustum<Type> RandomFrustum(std::mt19937& Random)
+{
+	std::uniform_real_distribution<Type> Value{ (Type)-1, (Type)1 }, Distance{ (Type)1, (Type)3 };
+	STPlane<Type> Planes[STFrustum<Type>::PlaneCount];
+	for (STPlane<Type>& Plane : Planes)
+	{
+		const STVector<3, Type> Normal{ STVector<3, Type>{ Value(Random), Value(Random), Value(Random) }.SafeNormal() };
+		Plane = STPlane<Type>{ (Normal == STVector<3, Type>{ (Type)0 }) ? STVector<3, Type>{ (Type)0, (Type)0, (Type)1 } : Normal, Distance(Random) };
+	}
+	return STFrustum<Type>{ Planes };
+}
+
+
+// Moves a point along a plane's normal until its signed distance is a value, as close as rounding allows.
+template <typename Type>
+static STVector<3, Type> OntoDistance(const STPlane<Type>& Plane, const STVector<3, Type>& Point, Type Distance)
+{
+	const STVector<3, Type> Normal{ Plane.GetNormal() };
+	const Type Move{ Distance - Plane.SignedDistance(Point) };
+	return STVector<3, Type>{ Point[0] + (Normal[0] * Move), Point[1] + (Normal[1] * Move), Point[2] + (Normal[2] * Move) };
+}
+
+
+// Checks the batched results are the single results and the visible indices are the ones not outside, in order.
+template <typename Type>
+static void CheckCull(const std::vector<ECullResult>& Expected, const std::vector<ECullResult>& Results, const std::vector<uint32>& Visible, uint Written)
+{
+	const uint Count{ (uint)Expected.size() };
+	uint Wrong{ 0 }, Kept{ 0 };
+	for (uint i = 0; i < Count; ++i)
+	{
+		Wrong += (Results[i] != Expected[i]);
+		if (Expected[i] != ECullResult::Outside) Wrong += (Kept >= Written || Visible[Kept++] != i);
+	}
+	CHECK(Wrong == 0 && Written == Kept && Visible[Count] == ~0u);
+}
+
+
+template <typename Type>
+static void TestFrustumSpheresMatchSingle()
+{
+	typedef STVector<3, Type> SVector;
+	std::mt19937 Random{ 71 };
+	std::uniform_real_distribution<Type> Value{ (Type)-4, (Type)4 }, Radius{ (Type)0, (Type)1.5 };
+	for (uint Count : FrustumLengths)
+	{
+		const STFrustum<Type> Frustum{ RandomFrustum<Type>(Random) };
+		std::vector<SVector> Centers(Count);
+		std::vector<Type> Radii(Count);
+		for (uint i = 0; i < Count; ++i)
+		{
+			Centers[i] = SVector{ Value(Random), Value(Random), Value(Random) };
+			Radii[i] = (i % 13 == 0) ? (Type)0 : Radius(Random);
+
+			// Every third sphere touches a plane from one side or the other, where a fused multiply add would change the result.
+			if (i % 3 == 0) Centers[i] = OntoDistance(Frustum.GetPlane(i % 6), Centers[i], (i % 2 == 0) ? Radii[i] : -Radii[i]);
+		}
+
+		std::vector<ECullResult> Expected(Count), Results(Count);
+		for (uint i = 0; i < Count; ++i) Expected[i] = Frustum.Classify(Centers[i], Radii[i]);
+		const STVectorArray<3, Type> Array{ Centers.data(), Count };
+		std::vector<uint32> Visible(Count + 1, ~0u);
+		const uint Written{ Frustum.CullSpheres(Array, Radii.data(), Visible.data(), Results.data()) };
+		CheckCull<Type>(Expected, Results, Visible, Written);
+		CHECK(Frustum.CullSpheres(Array, Radii.data(), Visible.data()) == Written);
+	}
+}
+
+
+template <typename Type>
+static void TestFrustumBoxesMatchSingle()
+{
+	typedef STVector<3, Type> SVector;
+	const Type Infinity{ std::numeric_limits<Type>::infinity() };
+	std::mt19937 Random{ 73 };
+	std::uniform_real_distribution<Type> Value{ (Type)-4, (Type)4 }, Size{ (Type)-0.5, (Type)2 };
+	for (uint Count : FrustumLengths)
+	{
+		const STFrustum<Type> Frustum{ RandomFrustum<Type>(Random) };
+		std::vector<SVector> Mins(Count), Maxs(Count);
+		for (uint i = 0; i < Count; ++i)
+		{
+			// Negative sizes give boxes that are empty on some axes.
+			SVector Min{ Value(Random), Value(Random), Value(Random) };
+			const SVector Extent{ Size(Random) * (Type)0.5, Size(Random) * (Type)0.5, Size(Random) * (Type)0.5 };
+
+			// Every third box touches a plane from one side or the other.
+			if (i % 3 == 0)
+			{
+				const STPlane<Type>& Plane{ Frustum.GetPlane(i % 6) };
+				const Type Reach{ (TMath::Abs(Plane.GetNormal()[0]) * Extent[0]) + (TMath::Abs(Plane.GetNormal()[1]) * Extent[1]) + (TMath::Abs(Plane.GetNormal()[2]) * Extent[2]) };
+				Min = OntoDistance(Plane, Min, (i % 2 == 0) ? Reach : -Reach);
+			}
+			Mins[i] = SVector{ Min[0] - Extent[0], Min[1] - Extent[1], Min[2] - Extent[2] };
+			Maxs[i] = SVector{ Min[0] + Extent[0], Min[1] + Extent[1], Min[2] + Extent[2] };
+
+			// Boxes with infinite bounds are valid as long as no minimum is above its maximum.
+			if (i % 17 == 5) Mins[i] = Maxs[i] = SVector{ (i % 2 == 0) ? Infinity : -Infinity };
+			if (i % 17 == 11)
+			{
+				Mins[i][i % 3] = -Infinity;
+				Maxs[i][i % 3] = Infinity;
+			}
+		}
+
+		std::vector<ECullResult> Expected(Count), Results(Count);
+		for (uint i = 0; i < Count; ++i) Expected[i] = Frustum.Classify(STBox<3, Type>{ Mins[i], Maxs[i] });
+		const STVectorArray<3, Type> MinArray{ Mins.data(), Count }, MaxArray{ Maxs.data(), Count };
+		std::vector<uint32> Visible(Count + 1, ~0u);
+		const uint Written{ Frustum.CullBoxes(MinArray, MaxArray, Visible.data(), Results.data()) };
+		CheckCull<Type>(Expected, Results, Visible, Written);
+
+		// Arrays of different lengths are rejected without writing anything.
+		if (Count > 0)
+		{
+			std::vector<uint32> Untouched(Count + 1, ~0u);
+			CHECK(Frustum.CullBoxes(MinArray, STVectorArray<3, Type>{ Maxs.data(), Count - 1 }, Untouched.data()) == 0 && Untouched[0] == ~0u);
+		}
+	}
+}
+
+
+static void TestFrustumFromMatrix()
+{
+	// The identity is clip space itself, the frustum is the cube from -1 to 1 with depth from 0 or -1.
+	for (bool ZeroToOneDepth : { true, false })
+	{
+		const SFrustum Frustum{ SFrustum::FromMatrix(SMatrix4{}, ZeroToOneDepth) };
+		const float Near{ ZeroToOneDepth ? 0.0f : -1.0f };
+		CHECK(Frustum.Classify(SVector3{ 0.0f, 0.0f, 0.5f }, 0.25f) == ECullResult::Inside);
+		CHECK(Frustum.Classify(SVector3{ 0.0f, 0.0f, Near - 0.5f }, 0.25f) == ECullResult::Outside);
+		CHECK(Frustum.Classify(SVector3{ 1.0f, 0.0f, 0.5f }, 0.25f) == ECullResult::Intersecting);
+		CHECK(Frustum.Classify(SBox3{ SVector3{ -0.5f, -0.5f, 0.25f }, SVector3{ 0.5f, 0.5f, 0.75f } }) == ECullResult::Inside);
+		CHECK(Frustum.Classify(SBox3{ SVector3{ 2.0f }, SVector3{ 3.0f } }) == ECullResult::Outside);
+		CHECK(Frustum.Classify(SBox3{ SVector3{ 0.5f }, SVector3{ 0.25f } }) == ECullResult::Outside);
+	}
+}
+
+
+
+// Registers the Frustum tests.
+void AddFrustumTests()
+{
+	RegisterTest("Frustum/SpheresMatchSingle", TestFrustumSpheresMatchSingle<float>);
+	RegisterTest("Frustum/SpheresMatchSingleDouble", TestFrustumSpheresMatchSingle<double>);
+	RegisterTest("Frustum/BoxesMatchSingle", TestFrustumBoxesMatchSingle<float>);
+	RegisterTest("Frustum/BoxesMatchSingleDouble", TestFrustumBoxesMatchSingle<double>);
+	RegisterTest("Frustum/FromMatrix", TestFrustumFromMatrix);
+}
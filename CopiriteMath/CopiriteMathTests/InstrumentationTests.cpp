@@ -0,0 +1,91 @@
+// InstrumentationTests.cpp : Tests for SInstrumentation, the per-thread counters summed against how many operations ran.
+
+#include "Test.h"
+#include "CopiriteMath/Datatypes/Vector.h"
+#include <cstring>
+#include <source_location>
+
+
+
+static void TestInstrumentationCountsAcrossThreads()
+{
+	// Every thread's counters are summed, with sampling each thread is off by less than a period.
+	constexpr uint Count{ 200000 };
+	for (uint Period : { 1u, 16u })
+	{
+		SInstrumentation::SetSamplePeriod(Period);
+		SInstrumentation::Reset();
+		ParallelFor(Count, [](uint Begin, uint End)
+			{
+				for (uint i = Begin; i < End; ++i) SInstrumentation::CountOperation(EMathOperation::Dot);
+			}, 1024);
+		const SInstrumentationSnapshot Snapshot{ SInstrumentation::Snapshot() };
+		CHECK(Snapshot.SamplePeriod == Period);
+		if constexpr (COPIRITE_INSTRUMENTATION)
+		{
+			const uint64 Counted{ Snapshot.Operations[(uint)EMathOperation::Dot] };
+			if (Period == 1) CHECK(Counted == Count);
+			else CHECK(Counted + ((uint64)Period * Snapshot.Threads) >= Count && Counted <= Count + ((uint64)Period * Snapshot.Threads));
+			CHECK(Snapshot.Threads >= 1 && Snapshot.Operations[(uint)EMathOperation::Cross] == 0);
+		}
+		else
+		{
+			CHECK(Snapshot.Operations[(uint)EMathOperation::Dot] == 0 && Snapshot.Events.empty());
+		}
+	}
+	SInstrumentation::SetSamplePeriod(1);
+	SInstrumentation::SetSamplePeriod(0);
+	CHECK(SInstrumentation::GetSamplePeriod() == 1);
+}
+
+
+static void TestInstrumentationTracesNaN()
+{
+	// NaN results are always counted exactly, the trace keeps the most recent EventCapacity of them in order.
+	SInstrumentation::SetSamplePeriod(1);
+	SInstrumentation::Reset();
+	const std::source_location Here{ std::source_location::current() };
+	const uint64 Count{ SInstrumentation::EventCapacity + 44 };
+	for (uint64 i = 0; i < Count; ++i) SInstrumentation::CountNaN(EMathOperation::Div, Here);
+	const SInstrumentationSnapshot Snapshot{ SInstrumentation::Snapshot() };
+	if constexpr (COPIRITE_INSTRUMENTATION)
+	{
+		CHECK(Snapshot.NaNs[(uint)EMathOperation::Div] == Count && Snapshot.NaNs[(uint)EMathOperation::Mul] == 0);
+		CHECK(Snapshot.Events.size() == SInstrumentation::EventCapacity);
+		for (uint i = 1; i < Snapshot.Events.size(); ++i) CHECK(Snapshot.Events[i].Sequence == Snapshot.Events[i - 1].Sequence + 1);
+		CHECK(Snapshot.Events.back().Operation == EMathOperation::Div && Snapshot.Events.back().Location.line() == Here.line());
+
+		// A reset starts the counters and the trace over.
+		SInstrumentation::Reset();
+		const SInstrumentationSnapshot Cleared{ SInstrumentation::Snapshot() };
+		CHECK(Cleared.NaNs[(uint)EMathOperation::Div] == 0 && Cleared.Events.empty());
+	}
+	else
+	{
+		CHECK(Snapshot.NaNs[(uint)EMathOperation::Div] == 0 && Snapshot.Events.empty());
+	}
+}
+
+
+static void TestInstrumentationNames()
+{
+	uint Named{ 0 };
+	SInstrumentationSnapshot Snapshot{};
+	Snapshot.ForEach([&Named](const char* Name, uint64 Operations, uint64 NaNs)
+		{
+			Named += (Name != nullptr && std::strcmp(Name, "Unknown") != 0 && Operations == 0 && NaNs == 0);
+		});
+	CHECK(Named == (uint)EMathOperation::Count);
+	CHECK(std::strcmp(SInstrumentationSnapshot::GetName(EMathOperation::MatrixInverse), "MatrixInverse") == 0);
+	CHECK(std::strcmp(SInstrumentationSnapshot::GetName(EMathOperation::Count), "Unknown") == 0);
+}
+
+
+
+// Registers the Instrumentation tests.
+void AddInstrumentationTests()
+{
+	RegisterTest("Instrumentation/CountsAcrossThreads", TestInstrumentationCountsAcrossThreads);
+	RegisterTest("Instrumentation/TracesNaN", TestInstrumentationTracesNaN);
+	RegisterTest("Instrumentation/Names", TestInstrumentationNames);
+}
@@ -0,0 +1,124 @@
+// KDTreeTests.cpp : Tests for STKDTree, the nearest neighbour and radius queries against measuring every point.
+
+#include "Test.h"
+#include "CopiriteMath/Datatypes/KDTree.h"
+#include <algorithm>
+#include <limits>
+#include <random>
+#include <vector>
+
+
+
+// Within a leaf, a few levels deep and past the parallel build threshold.
+static const uint PointCounts[]{ 0, 1, 8, 9, 1000, 20000 + 11 };
+
+
+template <uint Size, typename Type>
+static void TestKDTreeMatchesBruteForce()
+{
+	// Distances are measured with the same expression the tree uses, so they compare exactly. Ties may pick any of the
+	// tied points, so the indices are only checked by the distance they are at.
+	typedef STVector<Size, Type> SVector;
+	std::mt19937 Random{ 53 };
+	std::uniform_real_distribution<Type> Value{ (Type)-100, (Type)100 };
+	const auto RandomVector{ [&]()
+		{
+			SVector Vector;
+			for (uint j = 0; j < Size; ++j) Vector[j] = Value(Random);
+			return Vector;
+		} };
+	const auto DistanceSquared{ [](const SVector& A, const SVector& B)
+		{
+			const SVector Offset{ A - B };
+			return Offset ^ Offset;
+		} };
+	constexpr uint K{ 5 };
+
+	for (uint Count : PointCounts)
+	{
+		// Every tenth point is a copy of another, so ties are common.
+		std::vector<SVector> Points(Count);
+		for (uint i = 0; i < Count; ++i) Points[i] = (i % 10 == 9) ? Points[i / 2] : RandomVector();
+		for (bool Parallel : { false, true })
+		{
+			STKDTree<Size, Type> Tree;
+			Tree.Build(Points.data(), Count, Parallel);
+			CHECK(Tree.Num() == Count && Tree.IsEmpty() == (Count == 0));
+
+			std::vector<SVector> Queries(100);
+			for (uint q = 0; q < 100; ++q) Queries[q] = (Count > 0 && q % 4 == 0) ? Points[(q * 7) % Count] : RandomVector();
+			std::vector<uint32> BatchIndices(100 * K);
+			std::vector<Type> BatchDistances(100 * K);
+			std::vector<std::vector<uint32>> BatchRadius;
+			const Type Radius{ (Type)15 };
+			Tree.KNearest(Queries.data(), 100, K, BatchIndices.data(), BatchDistances.data(), Parallel);
+			Tree.Radius(Queries.data(), 100, Radius, BatchRadius, Parallel);
+			CHECK(BatchRadius.size() == 100);
+
+			for (uint q = 0; q < 100; ++q)
+			{
+				const SVector& Query{ Queries[q] };
+				std::vector<Type> Distances(Count);
+				std::vector<uint32> InRadius;
+				for (uint i = 0; i < Count; ++i)
+				{
+					Distances[i] = DistanceSquared(Points[i], Query);
+					if (Distances[i] <= Radius * Radius) InRadius.push_back(i);
+				}
+				std::vector<Type> Sorted{ Distances };
+				std::sort(Sorted.begin(), Sorted.end());
+
+				Type Nearest{ (Type)-1 };
+				const uint32 Closest{ Tree.Nearest(Query, Nearest) };
+				if (Count == 0)
+				{
+					CHECK(Closest == STKDTree<Size, Type>::None && Nearest == (Type)-1);
+				}
+				else if (!CHECK(Closest < Count && Nearest == Sorted[0] && Distances[Closest] == Sorted[0])) return;
+
+				// Only points within MaxDistance are found.
+				Type Limited{ (Type)-1 };
+				const uint32 LimitedClosest{ Tree.Nearest(Query, Limited, (Type)5) };
+				const bool AnyClose{ Count > 0 && Sorted[0] <= (Type)25 };
+				CHECK((LimitedClosest != STKDTree<Size, Type>::None) == AnyClose);
+				if (AnyClose) CHECK(Limited == Sorted[0]);
+
+				uint32 Indices[K];
+				Type KDistances[K];
+				const uint Found{ Tree.KNearest(Query, K, Indices, KDistances) };
+				if (!CHECK(Found == std::min(K, Count))) return;
+				for (uint k = 0; k < K; ++k)
+				{
+					if (k < Found)
+					{
+						if (!CHECK(KDistances[k] == Sorted[k] && Distances[Indices[k]] == Sorted[k])) return;
+						CHECK(std::count(Indices, Indices + Found, Indices[k]) == 1);
+						CHECK(BatchIndices[(q * K) + k] == Indices[k] && BatchDistances[(q * K) + k] == KDistances[k]);
+					}
+					else
+					{
+						CHECK(BatchIndices[(q * K) + k] == STKDTree<Size, Type>::None);
+						CHECK(BatchDistances[(q * K) + k] == std::numeric_limits<Type>::max());
+					}
+				}
+
+				std::vector<uint32> Neighbours;
+				Tree.Radius(Query, Radius, Neighbours);
+				std::sort(Neighbours.begin(), Neighbours.end());
+				std::sort(BatchRadius[q].begin(), BatchRadius[q].end());
+				if (!CHECK(Neighbours == InRadius)) return;
+				CHECK(BatchRadius[q] == InRadius);
+			}
+		}
+	}
+}
+
+
+
+// Registers the KDTree tests.
+void AddKDTreeTests()
+{
+	RegisterTest("KDTree/MatchesBruteForce3", TestKDTreeMatchesBruteForce<3, float>);
+	RegisterTest("KDTree/MatchesBruteForce2Double", TestKDTreeMatchesBruteForce<2, double>);
+	RegisterTest("KDTree/MatchesBruteForce4", TestKDTreeMatchesBruteForce<4, float>);
+}
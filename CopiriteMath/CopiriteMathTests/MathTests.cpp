@@ -0,0 +1,103 @@
+// MathTests.cpp : Tests for TMath, the fast functions against their lane versions and an exact reference.
+
+#include "Test.h"
+#include "CopiriteMath/Math/TMath.h"
+#include <cmath>
+#include <limits>
+#include <random>
+
+
+
+// Returns how many float ULP a result is from a reference computed in double.
+static double ULPError(float Result, double Reference)
+{
+	const float Rounded{ (float)Reference };
+	const double Step{ (double)std::nextafter(std::fabs(Rounded), std::numeric_limits<float>::infinity()) - std::fabs(Rounded) };
+	return std::fabs((double)Result - Reference) / Step;
+}
+
+
+static_assert(TMath::Sqrt(16.0f) == 4.0f, "Sqrt must be exact for perfect squares in constant expressions.");
+static_assert(TMath::Sqrt(0.0f) == 0.0f, "Sqrt must be exact for zero in constant expressions.");
+static_assert(TMath::Sqrt(2.0) * TMath::Sqrt(2.0) > 1.9999999999, "Sqrt must be accurate in constant expressions.");
+
+
+static void TestConstantSqrt()
+{
+	// ConstantSqrt is documented as exact for floats.
+	std::mt19937 Random{ 5 };
+	for (uint i = 0; i < 100000; ++i)
+	{
+		const uint32 Bits{ (uint32)Random() & 0x7F7FFFFFu };
+		float Value;
+		std::memcpy(&Value, &Bits, sizeof(float));
+		CHECK(BitEqual((float)TMath::ConstantSqrt((double)Value), std::sqrt(Value)));
+	}
+}
+
+
+static void TestFastTrigLanesMatchScalar()
+{
+	std::mt19937 Random{ 7 };
+	std::uniform_real_distribution<float> Angle{ -TMath::FAST_TRIG_RANGE, TMath::FAST_TRIG_RANGE }, Coordinate{ -1000.0f, 1000.0f };
+	for (uint i = 0; i < 100000; ++i)
+	{
+		const float X{ (i % 2 == 0) ? Angle(Random) : Angle(Random) * 1e-4f };
+		float Y{ Coordinate(Random) };
+		if (i % 5 == 0) Y = -0.0f;
+		if (i % 7 == 0) Y = 0.0f;
+		CHECK(BitEqual(TMath::FastSin(X), TMath::FastSin(SNativeFloats{ X })[0]));
+		CHECK(BitEqual(TMath::FastCos(X), TMath::FastCos(SNativeFloats{ X })[0]));
+		CHECK(BitEqual(TMath::FastATan2(Y, X), TMath::FastATan2(SNativeFloats{ Y }, SNativeFloats{ X })[0]));
+	}
+	CHECK(TMath::FastATan2(-0.0f, -1.0f) == -PI);
+	CHECK(TMath::FastATan2(SNativeFloats{ -0.0f }, SNativeFloats{ -1.0f })[0] == -PI);
+}
+
+
+static void TestFastFunctionAccuracy()
+{
+	std::mt19937 Random{ 9 };
+	std::uniform_real_distribution<float> Angle{ -TMath::FAST_TRIG_RANGE, TMath::FAST_TRIG_RANGE }, Small{ -10.0f, 10.0f };
+	for (uint i = 0; i < 100000; ++i)
+	{
+		// Sin and cos are allowed 1.5e-7 absolute where the result is near zero.
+		const float X{ (i % 2 == 0) ? Angle(Random) : Small(Random) };
+		const double Sin{ std::sin((double)X) }, Cos{ std::cos((double)X) };
+		CHECK(ULPError(TMath::FastSin(X), Sin) <= 3.0 || std::fabs(TMath::FastSin(X) - Sin) <= 1.5e-7);
+		CHECK(ULPError(TMath::FastCos(X), Cos) <= 3.0 || std::fabs(TMath::FastCos(X) - Cos) <= 1.5e-7);
+
+		const float Y{ Small(Random) }, Positive{ std::ldexp(std::fabs(Small(Random)) + 0.5f, (int)(Random() % 200) - 100) };
+		CHECK(ULPError(TMath::FastATan2(Y, X), std::atan2((double)Y, (double)X)) <= 3.0);
+		CHECK(ULPError(TMath::FastInvSqrt(Positive), 1.0 / std::sqrt((double)Positive)) <= 4.0);
+		CHECK(ULPError(TMath::FastInvSqrt(SNativeFloats{ Positive })[0], 1.0 / std::sqrt((double)Positive)) <= 4.0);
+	}
+}
+
+
+template <typename Type, uint Count>
+static void TestLanesMinMaxNaN()
+{
+	// Min and Max return their second operand when either is NaN, like minps and maxps, which the slab tests rely on.
+	typedef TLanes<Type, Count> SLanes;
+	const Type NaN{ std::numeric_limits<Type>::quiet_NaN() };
+	CHECK(SLanes{ NaN }.Min(SLanes{ (Type)1 })[0] == (Type)1);
+	CHECK(SLanes{ NaN }.Max(SLanes{ (Type)1 })[0] == (Type)1);
+	CHECK(std::isnan(SLanes{ (Type)1 }.Min(SLanes{ NaN })[0]));
+	CHECK(std::isnan(SLanes{ (Type)1 }.Max(SLanes{ NaN })[0]));
+	CHECK(TMath::Min(NaN, (Type)1) == (Type)1);
+	CHECK(TMath::Max(NaN, (Type)1) == (Type)1);
+}
+
+
+
+// Registers the Math tests.
+void AddMathTests()
+{
+	RegisterTest("Math/ConstantSqrt", TestConstantSqrt);
+	RegisterTest("Math/FastTrigLanesMatchScalar", TestFastTrigLanesMatchScalar);
+	RegisterTest("Math/FastFunctionAccuracy", TestFastFunctionAccuracy);
+	RegisterTest("Math/LanesMinMaxNaN", TestLanesMinMaxNaN<float, TNativeLanes<float>::Count>);
+	RegisterTest("Math/LanesMinMaxNaN4", TestLanesMinMaxNaN<float, 4>);
+	RegisterTest("Math/LanesMinMaxNaNDouble", TestLanesMinMaxNaN<double, TNativeLanes<double>::Count>);
+}
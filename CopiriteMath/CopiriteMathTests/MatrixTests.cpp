@@ -0,0 +1,179 @@
+// MatrixTests.cpp : Tests for STMatrix, the batched transforms against transforming each vector on its own.
+
+#include "Test.h"
+#include "CopiriteMath/Datatypes/Matrix.h"
+#include <cmath>
+#include <limits>
+#include <random>
+#include <utility>
+#include <vector>
+
+
+
+// Lengths around the lane count and the parallel grain, so tails and pieces split across threads are covered.
+static const uint TransformLengths[]{ 0, 1, 7, 17, 1000, 40000 + 3 };
+
+
+// Returns an affine matrix, the last column is (0, 0, 0, 1) and the linear part is well conditioned.
+template <typename Type>
+static STMatrix<4, 4, Type> RandomAffine(std::mt19937& Random)
+{
+	std::uniform_real_distribution<Type> Value{ (Type)-1, (Type)1 };
+	STMatrix<4, 4, Type> Matrix{ STMatrix<4, 4, Type>::Identity() };
+	for (uint i = 0; i < 4; ++i)
+	{
+		for (uint j = 0; j < 3; ++j) Matrix[i][j] += (i < 3) ? Value(Random) * (Type)0.25 : Value(Random) * (Type)10;
+	}
+	return Matrix;
+}
+
+
+template <typename Type>
+static void TestMatrixBatchMatchesSingle()
+{
+	// Every path, even the same loop over aliased arrays, may be contracted into fused multiply adds differently once
+	// inlined, so each is held to the rounding error of the textbook sum.
+	typedef STVector<3, Type> SVector;
+	std::mt19937 Random{ 19 };
+	std::uniform_real_distribution<Type> Value{ (Type)-10, (Type)10 };
+	const STMatrix<4, 4, Type> Matrix{ RandomAffine<Type>(Random) };
+	const Type Epsilon{ std::numeric_limits<Type>::epsilon() * 8 };
+	for (uint Count : TransformLengths)
+	{
+		std::vector<SVector> Vectors(Count);
+		for (SVector& Vector : Vectors)
+		{
+			for (uint j = 0; j < 3; ++j) Vector[j] = Value(Random);
+		}
+		for (bool IsPoint : { true, false })
+		{
+			std::vector<SVector> Batched(Count + 1, SVector{ (Type)-1 }), InPlace{ Vectors };
+			STVectorArray<3, Type> Lanes;
+			const STVectorArray<3, Type> Array{ Vectors.data(), Count };
+			if (IsPoint)
+			{
+				Matrix.TransformPoints(Vectors.data(), Batched.data(), Count);
+				Matrix.TransformPoints(InPlace.data(), InPlace.data(), Count);
+				Matrix.TransformPoints(Array, Lanes);
+			}
+			else
+			{
+				Matrix.TransformDirections(Vectors.data(), Batched.data(), Count);
+				Matrix.TransformDirections(InPlace.data(), InPlace.data(), Count);
+				Matrix.TransformDirections(Array, Lanes);
+			}
+			CHECK(Batched[Count] == SVector{ (Type)-1 });
+			CHECK(Lanes.Num() == Count);
+			for (uint i = 0; i < Count; ++i)
+			{
+				const SVector Single{ IsPoint ? Matrix.TransformPoint(Vectors[i]) : Matrix.TransformDirection(Vectors[i]) };
+				const SVector Streamed{ std::as_const(Lanes)[i] };
+				for (uint j = 0; j < 3; ++j)
+				{
+					Type Expected{ (Vectors[i][0] * Matrix[0][j]) + (Vectors[i][1] * Matrix[1][j]) + (Vectors[i][2] * Matrix[2][j]) };
+					Type Magnitude{ std::fabs(Vectors[i][0] * Matrix[0][j]) + std::fabs(Vectors[i][1] * Matrix[1][j]) + std::fabs(Vectors[i][2] * Matrix[2][j]) };
+					if (IsPoint)
+					{
+						Expected += Matrix[3][j];
+						Magnitude += std::fabs(Matrix[3][j]);
+					}
+					if (!CHECK(std::fabs(InPlace[i][j] - Expected) <= Magnitude * Epsilon)) return;
+					if (!CHECK(std::fabs(Batched[i][j] - Expected) <= Magnitude * Epsilon)) return;
+					if (!CHECK(std::fabs(Single[j] - Expected) <= Magnitude * Epsilon)) return;
+					if (!CHECK(std::fabs(Streamed[j] - Expected) <= Magnitude * Epsilon)) return;
+				}
+			}
+		}
+	}
+}
+
+
+template <typename Type>
+static void TestMatrixMultiply()
+{
+	// The SIMD product against the textbook sum over each row and column.
+	std::mt19937 Random{ 23 };
+	std::uniform_real_distribution<Type> Value{ (Type)-10, (Type)10 };
+	const Type Epsilon{ std::numeric_limits<Type>::epsilon() * 8 };
+	for (uint Iteration = 0; Iteration < 1000; ++Iteration)
+	{
+		STMatrix<4, 4, Type> A, B;
+		for (uint i = 0; i < 4; ++i)
+		{
+			for (uint j = 0; j < 4; ++j)
+			{
+				A[i][j] = Value(Random);
+				B[i][j] = Value(Random);
+			}
+		}
+		const STMatrix<4, 4, Type> Product{ A * B }, Transposed{ A.Transpose() };
+		for (uint i = 0; i < 4; ++i)
+		{
+			for (uint j = 0; j < 4; ++j)
+			{
+				Type Expected{ 0 }, Magnitude{ 0 };
+				for (uint k = 0; k < 4; ++k)
+				{
+					Expected += A[i][k] * B[k][j];
+					Magnitude += std::fabs(A[i][k] * B[k][j]);
+				}
+				CHECK(std::fabs(Product[i][j] - Expected) <= Magnitude * Epsilon);
+				CHECK(Transposed[j][i] == A[i][j]);
+			}
+		}
+	}
+}
+
+
+template <typename Type>
+static void TestMatrixInverseAffine()
+{
+	std::mt19937 Random{ 29 };
+	for (uint Iteration = 0; Iteration < 1000; ++Iteration)
+	{
+		const STMatrix<4, 4, Type> Matrix{ RandomAffine<Type>(Random) };
+		const STMatrix<4, 4, Type> Inverse{ Matrix.InverseAffine() };
+		CHECK((Matrix * Inverse).nearlyEqual(STMatrix<4, 4, Type>::Identity(), (Type)1e-4));
+		CHECK((Inverse * Matrix).nearlyEqual(STMatrix<4, 4, Type>::Identity(), (Type)1e-4));
+
+		STMatrix<3, 3, Type> Linear;
+		for (uint i = 0; i < 3; ++i)
+		{
+			for (uint j = 0; j < 3; ++j) Linear[i][j] = Matrix[i][j];
+		}
+		CHECK((Linear * Linear.InverseAffine()).nearlyEqual(STMatrix<3, 3, Type>::Identity(), (Type)1e-4));
+	}
+
+	// A singular matrix is reported and, when the policy sanitizes, replaced with identity.
+	if constexpr ((ENaNPolicy)COPIRITE_NAN_POLICY == ENaNPolicy::Count || (ENaNPolicy)COPIRITE_NAN_POLICY == ENaNPolicy::Sanitize)
+	{
+		const uint64 Before{ SNaNCounter::Reset() };
+		const STMatrix<4, 4, Type> Singular{ (Type)0 };
+		const STMatrix<4, 4, Type> Inverse{ Singular.InverseAffine() };
+		if constexpr ((ENaNPolicy)COPIRITE_NAN_POLICY == ENaNPolicy::Sanitize)
+		{
+			CHECK(SNaNCounter::Get() == 1);
+			CHECK(Inverse.nearlyEqual(STMatrix<4, 4, Type>::Identity()));
+		}
+		else
+		{
+			// Counting leaves the infinite determinant in place, the rows scaled by it may be reported again.
+			CHECK(SNaNCounter::Get() >= 1);
+		}
+		SNaNCounter::Reset();
+		for (uint64 i = 0; i < Before; ++i) SNaNCounter::Increment();
+	}
+}
+
+
+
+// Registers the Matrix tests.
+void AddMatrixTests()
+{
+	RegisterTest("Matrix/BatchMatchesSingle", TestMatrixBatchMatchesSingle<float>);
+	RegisterTest("Matrix/BatchMatchesSingleDouble", TestMatrixBatchMatchesSingle<double>);
+	RegisterTest("Matrix/Multiply", TestMatrixMultiply<float>);
+	RegisterTest("Matrix/MultiplyDouble", TestMatrixMultiply<double>);
+	RegisterTest("Matrix/InverseAffine", TestMatrixInverseAffine<float>);
+	RegisterTest("Matrix/InverseAffineDouble", TestMatrixInverseAffine<double>);
+}
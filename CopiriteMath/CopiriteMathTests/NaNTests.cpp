@@ -0,0 +1,54 @@
+// NaNTests.cpp : Tests for the NaN policies and how the vector operators apply them.
+
+#include "Test.h"
+#include "CopiriteMath/Datatypes/Vector.h"
+#include "CopiriteMath/Debug/NaNPolicy.h"
+#include <cmath>
+#include <limits>
+
+
+
+static void TestNaNPolicies()
+{
+	const uint64 Before{ SNaNCounter::Reset() };
+	CHECK(!TNaNPolicy<ENaNPolicy::Off>::OnNaN("Test", EMathOperation::Check));
+	CHECK(SNaNCounter::Get() == 0);
+	CHECK(!TNaNPolicy<ENaNPolicy::Count>::OnNaN("Test", EMathOperation::Check));
+	CHECK(SNaNCounter::Get() == 1);
+	CHECK(TNaNPolicy<ENaNPolicy::Sanitize>::OnNaN("Test", EMathOperation::Check));
+	CHECK(SNaNCounter::Get() == 2);
+	CHECK(SNaNCounter::Reset() == 2);
+	for (uint64 i = 0; i < Before; ++i) SNaNCounter::Increment();
+}
+
+
+static void TestVectorNaN()
+{
+	// The vector operators follow the policy this build was compiled with, the assert policy would abort on them.
+	const float NaN{ std::numeric_limits<float>::quiet_NaN() };
+	if constexpr ((ENaNPolicy)COPIRITE_NAN_POLICY != ENaNPolicy::Assert)
+	{
+		const SVector3 Result{ SVector3{ NaN, 1.0f, 2.0f } + SVector3{ 1.0f } };
+		if constexpr ((ENaNPolicy)COPIRITE_NAN_POLICY == ENaNPolicy::Sanitize)
+		{
+			CHECK(Result == SVector3{ 0.0f });
+		}
+		else
+		{
+			CHECK(std::isnan(Result[0]));
+			CHECK(Result[1] == 2.0f && Result[2] == 3.0f);
+		}
+	}
+	CHECK(SVector3{ NaN, 0.0f, 0.0f }.ContainsNaN());
+	CHECK(SVector3{ std::numeric_limits<float>::infinity(), 0.0f, 0.0f }.ContainsNaN());
+	CHECK(!SVector3{ 1.0f, 2.0f, 3.0f }.ContainsNaN());
+}
+
+
+
+// Registers the NaN tests.
+void AddNaNTests()
+{
+	RegisterTest("NaN/Policies", TestNaNPolicies);
+	RegisterTest("NaN/Vector", TestVectorNaN);
+}
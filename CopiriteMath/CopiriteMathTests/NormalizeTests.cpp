@@ -0,0 +1,128 @@
+// NormalizeTests.cpp : Tests for normalizing vectors, the array kernels against STVector::Normalize and the edge cases both leave alone.
+
+#include "Test.h"
+#include "CopiriteMath/Datatypes/VectorArray.h"
+#include <cmath>
+#include <limits>
+#include <random>
+#include <utility>
+#include <vector>
+
+
+
+// Lengths around the lane count and the parallel grain, so tails and pieces split across threads are covered.
+static const uint NormalizeLengths[]{ 0, 1, 7, 17, 1000, 40000 + 3 };
+
+
+// Returns vectors that must be left unchanged, too short, overflowing when squared or not finite.
+// @note - The assert policy aborts on the squared length of the last ones, so it only gets the short ones.
+template <uint Size, typename Type>
+static std::vector<STVector<Size, Type>> UnchangedVectors()
+{
+	std::vector<STVector<Size, Type>> Vectors{ STVector<Size, Type>{ (Type)0 }, STVector<Size, Type>{ (Type)1e-7 } };
+	if constexpr ((ENaNPolicy)COPIRITE_NAN_POLICY == ENaNPolicy::Assert) return Vectors;
+
+	const Type Huge{ std::sqrt(std::numeric_limits<Type>::max()) * (Type)2 };
+	Vectors.push_back(STVector<Size, Type>{ Huge });
+	Vectors.push_back(STVector<Size, Type>{ std::numeric_limits<Type>::infinity() });
+	Vectors.push_back(STVector<Size, Type>{ std::numeric_limits<Type>::quiet_NaN() });
+	STVector<Size, Type> OneAxis{ (Type)0 };
+	OneAxis[0] = Huge;
+	Vectors.push_back(OneAxis);
+	OneAxis[Size - 1] = -std::numeric_limits<Type>::infinity();
+	Vectors.push_back(OneAxis);
+	return Vectors;
+}
+
+
+template <uint Size, typename Type>
+static void TestNormalizeLeavesUnchanged()
+{
+	// Each overflowing vector used to be scaled by InvSqrt(infinity), giving zero or NaN and reporting success.
+	typedef STVector<Size, Type> SVector;
+	const std::vector<SVector> Vectors{ UnchangedVectors<Size, Type>() };
+	for (const SVector& Original : Vectors)
+	{
+		SVector Exact{ Original }, Fast{ Original };
+		CHECK(!Exact.Normalize());
+		CHECK(!Fast.FastNormalize());
+		for (uint j = 0; j < Size; ++j) CHECK(BitEqual(Exact[j], Original[j]) && BitEqual(Fast[j], Original[j]));
+		CHECK(Original.SafeNormal() == SVector{ (Type)0 } && Original.FastSafeNormal() == SVector{ (Type)0 });
+	}
+
+	// The array kernels leave them unchanged too, in full lanes and in the tail.
+	std::vector<SVector> Repeated;
+	for (uint i = 0; i < 5; ++i) Repeated.insert(Repeated.end(), Vectors.begin(), Vectors.end());
+	const uint Count{ (uint)Repeated.size() };
+	for (bool Fast : { false, true })
+	{
+		std::vector<SVector> Normalized{ Repeated };
+		STVectorArray<Size, Type> Array{ Repeated.data(), Count };
+		if (Fast)
+		{
+			SVector::FastNormalizeArray(Normalized.data(), Count);
+			Array.FastNormalize();
+		}
+		else
+		{
+			SVector::NormalizeArray(Normalized.data(), Count);
+			Array.Normalize();
+		}
+		for (uint i = 0; i < Count; ++i)
+		{
+			const SVector FromArray{ std::as_const(Array)[i] };
+			for (uint j = 0; j < Size; ++j) CHECK(BitEqual(Normalized[i][j], Repeated[i][j]) && BitEqual(FromArray[j], Repeated[i][j]));
+		}
+	}
+}
+
+
+template <uint Size, typename Type>
+static void TestNormalizeArrayMatchesSingle()
+{
+	// The arrays sum the squares in another order, so they are held to the documented error rather than bit equality.
+	typedef STVector<Size, Type> SVector;
+	std::mt19937 Random{ 67 };
+	std::uniform_real_distribution<Type> Value{ (Type)-1e3, (Type)1e3 };
+	const std::vector<SVector> Special{ UnchangedVectors<Size, Type>() };
+	for (uint Count : NormalizeLengths)
+	{
+		std::vector<SVector> Vectors(Count);
+		for (uint i = 0; i < Count; ++i)
+		{
+			for (uint j = 0; j < Size; ++j) Vectors[i][j] = Value(Random);
+			if (i % 11 == 3) Vectors[i] = Special[i % Special.size()];
+		}
+		for (bool Fast : { false, true })
+		{
+			const Type Error{ std::numeric_limits<Type>::epsilon() * ((Fast && std::is_same<Type, float>::value) ? 8 : 4) };
+			std::vector<SVector> Normalized{ Vectors };
+			if (Fast) SVector::FastNormalizeArray(Normalized.data(), Count);
+			else SVector::NormalizeArray(Normalized.data(), Count);
+			for (uint i = 0; i < Count; ++i)
+			{
+				SVector Single{ Vectors[i] };
+				const bool Changed{ Fast ? Single.FastNormalize() : Single.Normalize() };
+				for (uint j = 0; j < Size; ++j)
+				{
+					if (Changed) CHECK(std::fabs(Normalized[i][j] - Single[j]) <= Error);
+					else CHECK(BitEqual(Normalized[i][j], Vectors[i][j]));
+				}
+				if (Changed) CHECK(std::fabs(Single.Length() - (Type)1) <= Error);
+			}
+		}
+	}
+}
+
+
+
+// Registers the Normalize tests.
+void AddNormalizeTests()
+{
+	RegisterTest("Normalize/LeavesUnchanged3", TestNormalizeLeavesUnchanged<3, float>);
+	RegisterTest("Normalize/LeavesUnchanged4", TestNormalizeLeavesUnchanged<4, float>);
+	RegisterTest("Normalize/LeavesUnchanged3Double", TestNormalizeLeavesUnchanged<3, double>);
+	RegisterTest("Normalize/ArrayMatchesSingle3", TestNormalizeArrayMatchesSingle<3, float>);
+	RegisterTest("Normalize/ArrayMatchesSingle4", TestNormalizeArrayMatchesSingle<4, float>);
+	RegisterTest("Normalize/ArrayMatchesSingle4Double", TestNormalizeArrayMatchesSingle<4, double>);
+}
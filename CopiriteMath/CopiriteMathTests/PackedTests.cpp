@@ -0,0 +1,167 @@
+// PackedTests.cpp : Tests for the packed vector formats, the bulk encoders against the per-vector constructors and their round trip error.
+
+#include "Test.h"
+#include "CopiriteMath/Datatypes/PackedVector.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+
+
+
+template <typename Packed, uint Size>
+static void CheckPackedMatchesScalar(const std::vector<STVector<Size, float>>& Vectors, float MaxError, float Low)
+{
+	const uint Count{ (uint)Vectors.size() };
+	std::vector<Packed> Encoded(Count);
+	std::vector<STVector<Size, float>> Decoded(Count);
+	Packed::Encode(Vectors.data(), Encoded.data(), Count);
+	Packed::Decode(Encoded.data(), Decoded.data(), Count);
+	for (uint i = 0; i < Count; ++i)
+	{
+		const Packed Single{ Vectors[i] };
+		CHECK(std::memcmp(&Single, &Encoded[i], sizeof(Packed)) == 0);
+		CHECK(Single.ToVector() == Decoded[i]);
+		for (uint j = 0; j < Size; ++j)
+		{
+			// NaN clamps to the top of the range.
+			const float Clamped{ std::isnan(Vectors[i][j]) ? 1.0f : std::clamp(Vectors[i][j], Low, 1.0f) };
+			CHECK(std::fabs(Decoded[i][j] - Clamped) <= MaxError);
+		}
+	}
+}
+
+
+static void TestHalfRoundTrip()
+{
+	for (uint32 Bits = 0; Bits < 65536; ++Bits)
+	{
+		const float Value{ SHalf::ToFloat((uint16)Bits) };
+		if (std::isnan(Value)) CHECK(std::isnan(SHalf::ToFloat(SHalf::FromFloat(Value))));
+		else CHECK(SHalf::FromFloat(Value) == Bits);
+	}
+
+	std::mt19937 Random{ 17 };
+	std::vector<float> Values(10007);
+	for (float& Value : Values)
+	{
+		const uint32 Bits{ (uint32)Random() };
+		std::memcpy(&Value, &Bits, sizeof(float));
+	}
+	std::vector<SHalf> Halves(Values.size());
+	std::vector<float> Decoded(Values.size());
+	SHalf::Encode(Values.data(), Halves.data(), (uint)Values.size());
+	SHalf::Decode(Halves.data(), Decoded.data(), (uint)Values.size());
+	for (size_t i = 0; i < Values.size(); ++i)
+	{
+		CHECK(Halves[i].Bits == SHalf::FromFloat(Values[i]));
+		CHECK(BitEqual(Decoded[i], SHalf::ToFloat(Halves[i].Bits)));
+	}
+}
+
+
+static void TestNormRoundTrip()
+{
+	std::mt19937 Random{ 17 };
+	std::uniform_real_distribution<float> Signed{ -1.2f, 1.2f }, Unsigned{ -0.2f, 1.2f };
+	std::vector<SVector3> SignedVectors(1003), UnsignedVectors(1003);
+	std::vector<SVector4> Colors(1001);
+	for (SVector3& Vector : SignedVectors) Vector = SVector3{ Signed(Random), Signed(Random), Signed(Random) };
+	for (SVector3& Vector : UnsignedVectors) Vector = SVector3{ Unsigned(Random), Unsigned(Random), Unsigned(Random) };
+	for (SVector4& Color : Colors) Color = SVector4{ Unsigned(Random), Unsigned(Random), Unsigned(Random), Unsigned(Random) };
+	SignedVectors[3][0] = UnsignedVectors[3][0] = Colors[3][0] = std::numeric_limits<float>::quiet_NaN();
+
+	CheckPackedMatchesScalar<STNormVector<3, int16>>(SignedVectors, 1.6e-5f, -1.0f);
+	CheckPackedMatchesScalar<STNormVector<3, int8>>(SignedVectors, 4e-3f, -1.0f);
+	CheckPackedMatchesScalar<STNormVector<3, uint16>>(UnsignedVectors, 8e-6f, 0.0f);
+	CheckPackedMatchesScalar<STNormVector<3, uint8>>(UnsignedVectors, 2e-3f, 0.0f);
+	CheckPackedMatchesScalar<SUNorm8Vector4>(Colors, 2e-3f, 0.0f);
+}
+
+
+template <typename Octahedral>
+static void TestOctahedralRoundTrip(double MaxDegrees)
+{
+	std::mt19937 Random{ 29 };
+	std::normal_distribution<float> Normal;
+	std::vector<SVector3> Vectors(1003);
+	for (SVector3& Vector : Vectors) Vector = SVector3{ Normal(Random), Normal(Random), Normal(Random) };
+	Vectors[0] = SVector3{ 0.0f, 0.0f, -1.0f };
+	Vectors[1] = SVector3{ 1.0f, 0.0f, 0.0f };
+	Vectors[2] = SVector3{ 0.0f, -1.0f, 0.0f };
+
+	std::vector<Octahedral> Encoded(Vectors.size());
+	std::vector<SVector3> Decoded(Vectors.size());
+	Octahedral::Encode(Vectors.data(), Encoded.data(), (uint)Vectors.size());
+	Octahedral::Decode(Encoded.data(), Decoded.data(), (uint)Vectors.size());
+	for (size_t i = 0; i < Vectors.size(); ++i)
+	{
+		const Octahedral Single{ Vectors[i] };
+		CHECK(std::memcmp(&Single, &Encoded[i], sizeof(Octahedral)) == 0);
+
+		// The lanes normalize with a multiply add, so the decoded vectors may differ from the scalar ones by rounding.
+		const SVector3 Scalar{ Single.ToVector() };
+		for (uint j = 0; j < 3; ++j) CHECK(std::fabs(Scalar[j] - Decoded[i][j]) <= 2e-6f);
+
+		double Dot{ 0.0 }, Length{ 0.0 }, DecodedLength{ 0.0 };
+		for (uint j = 0; j < 3; ++j)
+		{
+			Dot += (double)Vectors[i][j] * Decoded[i][j];
+			Length += (double)Vectors[i][j] * Vectors[i][j];
+			DecodedLength += (double)Decoded[i][j] * Decoded[i][j];
+		}
+		CHECK(std::fabs(std::sqrt(DecodedLength) - 1.0) <= 1e-6);
+		CHECK(std::acos(std::min(1.0, Dot / std::sqrt(Length * DecodedLength))) * 180.0 / 3.14159265358979 <= MaxDegrees);
+	}
+}
+
+
+template <bool Signed>
+static void TestPacked1010102RoundTrip()
+{
+	std::mt19937 Random{ 31 };
+	const float Low{ Signed ? -1.0f : 0.0f };
+	std::uniform_real_distribution<float> Value{ Low - 0.1f, 1.1f };
+	std::vector<SVector4> Vectors(1001);
+	for (SVector4& Vector : Vectors) Vector = SVector4{ Value(Random), Value(Random), Value(Random), Value(Random) };
+	Vectors[2] = SVector4{ -1.0f };
+	Vectors[3] = SVector4{ std::numeric_limits<float>::quiet_NaN(), 1.0f, Low, 0.0f };
+
+	// W only has 2 bits, so it is checked through the scalar conversion alone.
+	const uint Count{ (uint)Vectors.size() };
+	std::vector<STPacked1010102<Signed>> Encoded(Count);
+	std::vector<SVector4> Decoded(Count);
+	STPacked1010102<Signed>::Encode(Vectors.data(), Encoded.data(), Count);
+	STPacked1010102<Signed>::Decode(Encoded.data(), Decoded.data(), Count);
+	for (uint i = 0; i < Count; ++i)
+	{
+		const STPacked1010102<Signed> Single{ Vectors[i] };
+		CHECK(Single.Bits == Encoded[i].Bits);
+		CHECK(Single.ToVector() == Decoded[i]);
+		for (uint j = 0; j < 3; ++j)
+		{
+			const float Clamped{ std::isnan(Vectors[i][j]) ? 1.0f : std::clamp(Vectors[i][j], Low, 1.0f) };
+			CHECK(std::fabs(Decoded[i][j] - Clamped) <= (Signed ? 9.8e-4f : 4.9e-4f));
+		}
+	}
+
+	// Every bit pattern decodes the same in bulk as on its own.
+	std::vector<STPacked1010102<Signed>> Patterns(10000);
+	for (STPacked1010102<Signed>& Pattern : Patterns) Pattern.Bits = Random();
+	std::vector<SVector4> PatternsDecoded(Patterns.size());
+	STPacked1010102<Signed>::Decode(Patterns.data(), PatternsDecoded.data(), (uint)Patterns.size());
+	for (size_t i = 0; i < Patterns.size(); ++i) CHECK(Patterns[i].ToVector() == PatternsDecoded[i]);
+}
+
+
+
+// Registers the Packed tests.
+void AddPackedTests()
+{
+	RegisterTest("Packed/HalfRoundTrip", TestHalfRoundTrip);
+	RegisterTest("Packed/NormRoundTrip", TestNormRoundTrip);
+	RegisterTest("Packed/Octahedral32RoundTrip", [] { TestOctahedralRoundTrip<SOctahedral32>(0.006); });
+	RegisterTest("Packed/Octahedral16RoundTrip", [] { TestOctahedralRoundTrip<SOctahedral16>(1.6); });
+	RegisterTest("Packed/UNorm1010102RoundTrip", TestPacked1010102RoundTrip<false>);
+	RegisterTest("Packed/SNorm1010102RoundTrip", TestPacked1010102RoundTrip<true>);
+}
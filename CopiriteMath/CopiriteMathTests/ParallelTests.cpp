@@ -0,0 +1,102 @@
+// ParallelTests.cpp : Tests for SThreadPool, how ParallelFor splits a loop into pieces.
+
+#include "Test.h"
+#include "CopiriteMath/Parallel/ThreadPool.h"
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+
+
+static void TestParallelForCoversEachIndex()
+{
+	// Every iteration runs exactly once, pieces start on the granularity and only the last may be short of the grain.
+	for (uint Count : { 0u, 1u, 63u, 1000u, 100000u + 7u })
+	{
+		for (uint MinGrain : { 1u, 64u, VectorGrain })
+		{
+			for (uint Granularity : { 1u, 8u, 48u })
+			{
+				std::unique_ptr<std::atomic<uint>[]> Runs{ new std::atomic<uint>[Count + 1] };
+				for (uint i = 0; i <= Count; ++i) Runs[i] = 0;
+				std::atomic<uint> BadPieces{ 0 };
+				ParallelFor(Count, [&](uint Begin, uint End)
+					{
+						if (Begin >= End || Begin % Granularity != 0 || (End != Count && End - Begin < MinGrain)) ++BadPieces;
+						for (uint i = Begin; i < End; ++i) ++Runs[i];
+					}, MinGrain, Granularity);
+				CHECK(BadPieces == 0);
+				uint Wrong{ 0 };
+				for (uint i = 0; i < Count; ++i) Wrong += (Runs[i] != 1);
+				CHECK(Wrong == 0 && Runs[Count] == 0);
+			}
+		}
+	}
+}
+
+
+static void TestParallelForSmallRunsInline()
+{
+	// A range no larger than a piece runs as one piece on the calling thread.
+	const std::thread::id Caller{ std::this_thread::get_id() };
+	uint Pieces{ 0 };
+	bool OnCaller{ true };
+	ParallelFor(VectorGrain, [&](uint Begin, uint End)
+		{
+			++Pieces;
+			OnCaller = OnCaller && std::this_thread::get_id() == Caller && Begin == 0 && End == VectorGrain;
+		}, VectorGrain);
+	CHECK(Pieces == 1 && OnCaller);
+}
+
+
+static void TestParallelForNested()
+{
+	// Loops started inside other loops finish, the waiting threads run the inner pieces.
+	constexpr uint Outer{ 64 }, Inner{ 5000 };
+	std::vector<uint> Sums(Outer);
+	ParallelFor(Outer, [&](uint Begin, uint End)
+		{
+			for (uint i = Begin; i < End; ++i)
+			{
+				std::atomic<uint> Sum{ 0 };
+				ParallelFor(Inner, [&Sum](uint InnerBegin, uint InnerEnd)
+					{
+						uint Local{ 0 };
+						for (uint j = InnerBegin; j < InnerEnd; ++j) Local += j;
+						Sum += Local;
+					}, 16);
+				Sums[i] = Sum;
+			}
+		});
+	for (uint i = 0; i < Outer; ++i) CHECK(Sums[i] == (Inner * (Inner - 1)) / 2);
+}
+
+
+static void TestParallelTransform()
+{
+	constexpr uint Count{ 50000 + 3 };
+	std::vector<uint> In(Count), Out(Count + 1, ~0u);
+	for (uint i = 0; i < Count; ++i) In[i] = i;
+	ParallelTransform(In.data(), Out.data(), Count, [](uint Value) { return Value * 3; });
+	uint Wrong{ 0 };
+	for (uint i = 0; i < Count; ++i) Wrong += (Out[i] != i * 3);
+	CHECK(Wrong == 0 && Out[Count] == ~0u);
+
+	// In place.
+	ParallelTransform(In.data(), In.data(), Count, [](uint Value) { return Value + 1; });
+	for (uint i = 0; i < Count; ++i) Wrong += (In[i] != i + 1);
+	CHECK(Wrong == 0);
+}
+
+
+
+// Registers the Parallel tests.
+void AddParallelTests()
+{
+	RegisterTest("Parallel/CoversEachIndex", TestParallelForCoversEachIndex);
+	RegisterTest("Parallel/SmallRunsInline", TestParallelForSmallRunsInline);
+	RegisterTest("Parallel/Nested", TestParallelForNested);
+	RegisterTest("Parallel/Transform", TestParallelTransform);
+}
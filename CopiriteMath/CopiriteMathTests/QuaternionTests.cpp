@@ -0,0 +1,144 @@
+// QuaternionTests.cpp : Tests for STQuaternion, the batched rotations against rotating each vector on its own.
+
+#include "Test.h"
+#include "CopiriteMath/Datatypes/Quaternion.h"
+#include <cmath>
+#include <limits>
+#include <random>
+#include <utility>
+#include <vector>
+
+
+
+// Lengths around the lane count and the parallel grain, so tails and pieces split across threads are covered.
+static const uint RotateLengths[]{ 0, 1, 7, 17, 1000, 40000 + 3 };
+
+
+template <typename Type>
+static STQuaternion<Type> RandomRotation(std::mt19937& Random)
+{
+	std::uniform_real_distribution<Type> Value{ (Type)-1, (Type)1 };
+	STQuaternion<Type> Rotation{ Value(Random), Value(Random), Value(Random), Value(Random) + (Type)1.5 };
+	Rotation.Normalize();
+	return Rotation;
+}
+
+
+// Returns whether two vectors are within a few rounding errors of a rotation of the given length.
+template <typename Type>
+static bool RotationNearlyEqual(const STVector<3, Type>& A, const STVector<3, Type>& B, Type Length)
+{
+	const Type Tolerance{ std::numeric_limits<Type>::epsilon() * 32 * (Length + (Type)1) };
+	return std::fabs(A[0] - B[0]) <= Tolerance && std::fabs(A[1] - B[1]) <= Tolerance && std::fabs(A[2] - B[2]) <= Tolerance;
+}
+
+
+template <typename Type>
+static void TestQuaternionBatchMatchesSingle()
+{
+	// Every path, even the same loop over aliased arrays, may be contracted into fused multiply adds differently, so they match within rounding.
+	typedef STVector<3, Type> SVector;
+	std::mt19937 Random{ 31 };
+	std::uniform_real_distribution<Type> Value{ (Type)-10, (Type)10 };
+	const STQuaternion<Type> Rotation{ RandomRotation<Type>(Random) };
+	for (uint Count : RotateLengths)
+	{
+		std::vector<SVector> Vectors(Count);
+		for (SVector& Vector : Vectors)
+		{
+			for (uint j = 0; j < 3; ++j) Vector[j] = Value(Random);
+		}
+		for (bool Inverse : { false, true })
+		{
+			std::vector<SVector> Batched(Count + 1, SVector{ (Type)-1 }), InPlace{ Vectors };
+			STVectorArray<3, Type> Lanes;
+			const STVectorArray<3, Type> Array{ Vectors.data(), Count };
+			if (Inverse)
+			{
+				Rotation.UnrotateVectors(Vectors.data(), Batched.data(), Count);
+				Rotation.UnrotateVectors(InPlace.data(), InPlace.data(), Count);
+				Rotation.UnrotateVectors(Array, Lanes);
+			}
+			else
+			{
+				Rotation.RotateVectors(Vectors.data(), Batched.data(), Count);
+				Rotation.RotateVectors(InPlace.data(), InPlace.data(), Count);
+				Rotation.RotateVectors(Array, Lanes);
+			}
+			CHECK(Batched[Count] == SVector{ (Type)-1 });
+			CHECK(Lanes.Num() == Count);
+			for (uint i = 0; i < Count; ++i)
+			{
+				const SVector Single{ Inverse ? Rotation.UnrotateVector(Vectors[i]) : Rotation.RotateVector(Vectors[i]) };
+				const Type Length{ std::fabs(Vectors[i][0]) + std::fabs(Vectors[i][1]) + std::fabs(Vectors[i][2]) };
+				if (!CHECK(RotationNearlyEqual(InPlace[i], Single, Length))) return;
+				if (!CHECK(RotationNearlyEqual(Batched[i], Single, Length))) return;
+				if (!CHECK(RotationNearlyEqual(std::as_const(Lanes)[i], Single, Length))) return;
+			}
+		}
+	}
+}
+
+
+template <typename Type>
+static void TestQuaternionConversions()
+{
+	// Rotations survive the trip through a matrix and back, and rotate vectors like the matrix does.
+	std::mt19937 Random{ 37 };
+	std::uniform_real_distribution<Type> Value{ (Type)-10, (Type)10 };
+	for (uint Iteration = 0; Iteration < 1000; ++Iteration)
+	{
+		const STQuaternion<Type> Rotation{ RandomRotation<Type>(Random) };
+		const STVector<3, Type> Vector{ Value(Random), Value(Random), Value(Random) };
+		const Type Length{ std::fabs(Vector[0]) + std::fabs(Vector[1]) + std::fabs(Vector[2]) };
+		const STVector<3, Type> Rotated{ Rotation.RotateVector(Vector) };
+		CHECK(RotationNearlyEqual(Rotation.UnrotateVector(Rotated), Vector, Length));
+		CHECK(RotationNearlyEqual((Rotation * Rotation.Conjugate()).RotateVector(Vector), Vector, Length));
+
+		const STMatrix<4, 4, Type> Matrix{ Rotation.template ToMatrix<4>() };
+		CHECK(RotationNearlyEqual(Matrix.TransformDirection(Vector), Rotated, Length));
+		const STQuaternion<Type> Back{ STQuaternion<Type>::FromMatrix(Matrix) };
+		CHECK(Back.nearlyEqual(Rotation, (Type)1e-4) || Back.nearlyEqual(-Rotation, (Type)1e-4));
+	}
+
+	// PI is a float, so the quarter turn is only that precise.
+	const STQuaternion<Type> Quarter{ STQuaternion<Type>::FromAxisAngle(STVector<3, Type>{ (Type)0, (Type)0, (Type)1 }, (Type)PI / 2) };
+	CHECK(Quarter.RotateVector(STVector<3, Type>{ (Type)1, (Type)0, (Type)0 }).nearlyEqual(STVector<3, Type>{ (Type)0, (Type)1, (Type)0 }, (Type)1e-6));
+}
+
+
+template <typename Type>
+static void TestQuaternionInterpolation()
+{
+	// Both interpolations hit their end points, stay unit length and take the shortest path.
+	std::mt19937 Random{ 41 };
+	std::uniform_real_distribution<Type> Alpha{ (Type)0, (Type)1 };
+	for (uint Iteration = 0; Iteration < 1000; ++Iteration)
+	{
+		const STQuaternion<Type> A{ RandomRotation<Type>(Random) }, B{ RandomRotation<Type>(Random) };
+		const STQuaternion<Type> Closest{ (A.DotProduct(B) < (Type)0) ? -B : B };
+		CHECK(STQuaternion<Type>::Slerp(A, B, (Type)0).nearlyEqual(A, (Type)1e-3));
+		CHECK(STQuaternion<Type>::Slerp(A, B, (Type)1).nearlyEqual(Closest, (Type)1e-3));
+		CHECK(STQuaternion<Type>::Nlerp(A, B, (Type)0).nearlyEqual(A, (Type)1e-4));
+		CHECK(STQuaternion<Type>::Nlerp(A, B, (Type)1).nearlyEqual(Closest, (Type)1e-4));
+
+		const Type T{ Alpha(Random) };
+		const STQuaternion<Type> Slerped{ STQuaternion<Type>::Slerp(A, B, T) }, Nlerped{ STQuaternion<Type>::Nlerp(A, B, T) };
+		CHECK(std::fabs(Slerped.DotProduct(Slerped) - (Type)1) <= (Type)1e-3);
+		CHECK(std::fabs(Nlerped.DotProduct(Nlerped) - (Type)1) <= (Type)1e-4);
+		CHECK(Slerped.DotProduct(A) >= (Type)0 && Slerped.DotProduct(Closest) >= (Type)0);
+	}
+}
+
+
+
+// Registers the Quaternion tests.
+void AddQuaternionTests()
+{
+	RegisterTest("Quaternion/BatchMatchesSingle", TestQuaternionBatchMatchesSingle<float>);
+	RegisterTest("Quaternion/BatchMatchesSingleDouble", TestQuaternionBatchMatchesSingle<double>);
+	RegisterTest("Quaternion/Conversions", TestQuaternionConversions<float>);
+	RegisterTest("Quaternion/ConversionsDouble", TestQuaternionConversions<double>);
+	RegisterTest("Quaternion/Interpolation", TestQuaternionInterpolation<float>);
+	RegisterTest("Quaternion/InterpolationDouble", TestQuaternionInterpolation<double>);
+}
@@ -0,0 +1,160 @@
+// ReduceTests.cpp : Tests for TReduce, the lane and parallel reductions against a serial loop.
+
+#include "Test.h"
+#include "CopiriteMath/Math/Reduce.h"
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+
+
+// Lengths around the lane count, the pairwise block and the parallel grain.
+static const uint ReduceLengths[]{ 0, 1, 7, 17, 1000, 1024 + 5, 40000 + 3 };
+
+
+template <uint Size, typename Type>
+static void TestReduceMatchesSerial()
+{
+	typedef STVector<Size, Type> SVector;
+	std::mt19937 Random{ 59 };
+	std::uniform_real_distribution<Type> Value{ (Type)-10, (Type)10 };
+	const Type Epsilon{ std::numeric_limits<Type>::epsilon() * 64 };
+	for (uint Count : ReduceLengths)
+	{
+		std::vector<SVector> Vectors(Count);
+		for (SVector& Vector : Vectors)
+		{
+			for (uint j = 0; j < Size; ++j) Vector[j] = Value(Random) + (Type)3;
+		}
+		const STVectorArray<Size, Type> Array{ Vectors.data(), Count };
+
+		// The references are summed in long double, the reductions only have to be as close as their rounding allows.
+		long double Sums[Size]{}, Magnitudes[Size]{};
+		SVector Lowest{ std::numeric_limits<Type>::max() }, Highest{ std::numeric_limits<Type>::lowest() };
+		for (const SVector& Vector : Vectors)
+		{
+			for (uint j = 0; j < Size; ++j)
+			{
+				Sums[j] += Vector[j];
+				Magnitudes[j] += std::fabs(Vector[j]);
+				Lowest[j] = std::fmin(Lowest[j], Vector[j]);
+				Highest[j] = std::fmax(Highest[j], Vector[j]);
+			}
+		}
+
+		for (ESumOrder Order : { ESumOrder::Fast, ESumOrder::Pairwise })
+		{
+			for (bool Parallel : { false, true })
+			{
+				const SVector Sum{ TReduce::Sum(Vectors.data(), Count, Order, Parallel) }, ArraySum{ TReduce::Sum(Array, Order, Parallel) };
+				const SVector Mean{ TReduce::Mean(Vectors.data(), Count, Order, Parallel) };
+				for (uint j = 0; j < Size; ++j)
+				{
+					CHECK(std::fabs(Sum[j] - (Type)Sums[j]) <= (Type)Magnitudes[j] * Epsilon);
+					CHECK(std::fabs(ArraySum[j] - (Type)Sums[j]) <= (Type)Magnitudes[j] * Epsilon);
+					if (Count > 0) CHECK(std::fabs(Mean[j] - (Type)(Sums[j] / Count)) <= (Type)(Magnitudes[j] / Count) * Epsilon);
+					else CHECK(Mean[j] == (Type)0);
+				}
+			}
+
+			// Pairwise sums are the same on any number of threads.
+			if (Order == ESumOrder::Pairwise)
+			{
+				CHECK(TReduce::Sum(Vectors.data(), Count, Order, true) == TReduce::Sum(Vectors.data(), Count, Order, false));
+				CHECK(TReduce::Sum(Array, Order, true) == TReduce::Sum(Array, Order, false));
+			}
+		}
+
+		// Bounds are exact.
+		for (bool Parallel : { false, true })
+		{
+			CHECK(TReduce::Min(Vectors.data(), Count, Parallel) == Lowest && TReduce::Min(Array, Parallel) == Lowest);
+			CHECK(TReduce::Max(Vectors.data(), Count, Parallel) == Highest && TReduce::Max(Array, Parallel) == Highest);
+			const STBox<Size, Type> Bounds{ TReduce::Bounds(Vectors.data(), Count, Parallel) };
+			CHECK(Bounds == STBox<Size, Type>{ Lowest, Highest } && TReduce::Bounds(Array, Parallel) == Bounds);
+		}
+	}
+}
+
+
+template <uint Size, typename Type>
+static void TestReduceCovariance()
+{
+	typedef STVector<Size, Type> SVector;
+	std::mt19937 Random{ 61 };
+	std::uniform_real_distribution<Type> Value{ (Type)-10, (Type)10 };
+	for (uint Count : ReduceLengths)
+	{
+		// The second axis follows the first, so the matrix has entries off its diagonal.
+		std::vector<SVector> Vectors(Count);
+		for (SVector& Vector : Vectors)
+		{
+			for (uint j = 0; j < Size; ++j) Vector[j] = Value(Random) + (Type)5;
+			Vector[1] += Vector[0] * (Type)0.5;
+		}
+		const STVectorArray<Size, Type> Array{ Vectors.data(), Count };
+
+		long double Mean[Size]{}, Expected[Size][Size]{};
+		for (const SVector& Vector : Vectors)
+		{
+			for (uint j = 0; j < Size; ++j) Mean[j] += Vector[j];
+		}
+		for (uint j = 0; j < Size; ++j) Mean[j] /= (Count > 0) ? Count : 1;
+		for (const SVector& Vector : Vectors)
+		{
+			for (uint j = 0; j < Size; ++j)
+			{
+				for (uint k = 0; k < Size; ++k) Expected[j][k] += (Vector[j] - Mean[j]) * (Vector[k] - Mean[k]);
+			}
+		}
+
+		const Type Tolerance{ std::numeric_limits<Type>::epsilon() * 65536 };
+		for (bool Parallel : { false, true })
+		{
+			const STMatrix<Size, Size, Type> Covariance{ TReduce::Covariance(Vectors.data(), Count, ESumOrder::Pairwise, Parallel) };
+			const STMatrix<Size, Size, Type> ArrayCovariance{ TReduce::Covariance(Array, ESumOrder::Fast, Parallel) };
+			for (uint j = 0; j < Size; ++j)
+			{
+				for (uint k = 0; k < Size; ++k)
+				{
+					const Type Reference{ (Count > 0) ? (Type)(Expected[j][k] / Count) : (Type)0 };
+					CHECK(std::fabs(Covariance[j][k] - Reference) <= Tolerance);
+					CHECK(std::fabs(ArrayCovariance[j][k] - Reference) <= Tolerance);
+					CHECK(Covariance[j][k] == Covariance[k][j]);
+				}
+			}
+		}
+	}
+}
+
+
+static void TestReduceIgnoresNaN()
+{
+	// NaN components are skipped by the bounds, whichever lane or piece they land in.
+	const float NaN{ std::numeric_limits<float>::quiet_NaN() };
+	const uint Count{ 40000 + 3 };
+	std::vector<SVector3> Vectors(Count);
+	for (uint i = 0; i < Count; ++i) Vectors[i] = SVector3{ (float)(i % 1000) - 500.0f };
+	for (uint i = 0; i < Count; i += 997) Vectors[i][i % 3] = NaN;
+	const STVectorArray<3, float> Array{ Vectors.data(), Count };
+	for (bool Parallel : { false, true })
+	{
+		CHECK(TReduce::Min(Vectors.data(), Count, Parallel) == SVector3{ -500.0f });
+		CHECK(TReduce::Max(Array, Parallel) == SVector3{ 499.0f });
+		CHECK(TReduce::Bounds(Array, Parallel) == SBox3{ SVector3{ -500.0f }, SVector3{ 499.0f } });
+	}
+}
+
+
+
+// Registers the Reduce tests.
+void AddReduceTests()
+{
+	RegisterTest("Reduce/MatchesSerial3", TestReduceMatchesSerial<3, float>);
+	RegisterTest("Reduce/MatchesSerial4", TestReduceMatchesSerial<4, float>);
+	RegisterTest("Reduce/MatchesSerial3Double", TestReduceMatchesSerial<3, double>);
+	RegisterTest("Reduce/Covariance3", TestReduceCovariance<3, float>);
+	RegisterTest("Reduce/Covariance4Double", TestReduceCovariance<4, double>);
+	RegisterTest("Reduce/IgnoresNaN", TestReduceIgnoresNaN);
+}
@@ -0,0 +1,178 @@
+#pragma once
+#include "CopiriteMath/GlobalValues.h"
+#include "CopiriteMath/Utility.h"
+#include "CopiriteMath/Math/SIMD.h"
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <vector>
+
+
+// A small test harness in the style of Benchmark.h, without a dependency on a test framework.
+// Each test is a function that reports its checks through CHECK(), a test passes when none of its checks failed.
+// Tests are named Group/Name, each group lives in <Group>Tests.cpp and is registered from main by Add<Group>Tests().
+// CTest runs each group on its own with --filter=Group/.
+
+
+
+// Checks a condition inside a test, a failed check is reported with its line and fails the test without stopping it.
+// @param ... - The condition that should hold, commas inside it do not need extra parentheses.
+// @return - The condition, so the test can skip work that depends on it.
+#define CHECK(...) ReportCheck((bool)(__VA_ARGS__), #__VA_ARGS__, __FILE__, __LINE__)
+
+
+
+// The native float lanes, the width the lane functions and packets are tested at.
+typedef TLanes<float, TNativeLanes<float>::Count> SNativeFloats;
+
+
+
+// A registered test.
+struct STest
+{
+	// The name the test is reported and filtered by.
+	std::string Name;
+
+	// Runs the test.
+	std::function<void()> Function;
+};
+
+
+
+// The options the tests are run with, set from the command line.
+struct STestOptions
+{
+	// Only tests whose name contains this are run, empty runs everything.
+	std::string Filter;
+
+	// Prints the names of the tests instead of running them.
+	bool List{ false };
+};
+
+
+
+// Returns every registered test.
+INLINE std::vector<STest>& GetTests()
+{
+	static std::vector<STest> Tests;
+	return Tests;
+}
+
+
+// Returns how many checks the running test has failed.
+INLINE uint& GetFailedChecks()
+{
+	static uint FailedChecks{ 0 };
+	return FailedChecks;
+}
+
+
+// Registers a test.
+// @param Name - The name the test is reported and filtered by.
+// @param Function - Runs the test.
+INLINE void RegisterTest(std::string Name, std::function<void()> Function)
+{
+	GetTests().push_back(STest{ std::move(Name), std::move(Function) });
+}
+
+
+// Records the result of a check, use CHECK() rather than calling this directly.
+// @note - Only the first few failures of a test are printed so a broken loop does not flood the output.
+// @return - Whether the check passed.
+INLINE bool ReportCheck(bool Passed, const char* Condition, const char* File, int Line)
+{
+	if (Passed) return true;
+	if (++GetFailedChecks() <= 8) std::printf("    %s:%d: CHECK(%s) failed\n", File, Line, Condition);
+	return false;
+}
+
+
+// Returns whether two values have the same bit pattern, so NaN matches NaN and -0 does not match 0.
+template <typename Type>
+INLINE bool BitEqual(const Type& A, const Type& B)
+{
+	return std::memcmp(&A, &B, sizeof(Type)) == 0;
+}
+
+
+// Returns the name of the instruction sets the library was compiled with.
+INLINE const char* GetBackendName()
+{
+#if defined(COPIRITE_AVX512)
+	return "AVX-512";
+#elif defined(COPIRITE_AVX2) && defined(COPIRITE_FMA)
+	return "AVX2+FMA";
+#elif defined(COPIRITE_AVX2)
+	return "AVX2";
+#elif defined(COPIRITE_AVX)
+	return "AVX";
+#elif defined(COPIRITE_SSE41)
+	return "SSE4.1";
+#elif defined(COPIRITE_SSE2)
+	return "SSE2";
+#else
+	return "Scalar";
+#endif
+}
+
+
+// Reads the command line into a set of options.
+// @param ArgC - The number of arguments.
+// @param ArgV - The arguments.
+// @param Options - The options to fill.
+// @return - False if the tests should not be run, the usage has been printed.
+INLINE bool ParseTestOptions(int ArgC, char** ArgV, STestOptions& Options)
+{
+	for (int i = 1; i < ArgC; ++i)
+	{
+		const char* Arg{ ArgV[i] };
+		if (std::strncmp(Arg, "--filter=", 9) == 0) Options.Filter = Arg + 9;
+		else if (std::strcmp(Arg, "--list") == 0) Options.List = true;
+		else
+		{
+			if (std::strcmp(Arg, "--help") != 0) std::printf("Unknown argument '%s'.\n", Arg);
+			std::printf("Usage: %s [--filter=Text] [--list]\n", ArgV[0]);
+			return false;
+		}
+	}
+	return true;
+}
+
+
+// Runs every registered test matching the options and prints the results.
+// @param Options - The options to run with.
+// @param Run - Receives how many tests were run.
+// @return - How many tests failed.
+INLINE uint RunTests(const STestOptions& Options, uint& Run)
+{
+	uint Failed{ 0 };
+	Run = 0;
+	if (!Options.List) std::printf("Backend: %s\n", GetBackendName());
+
+	for (const STest& Test : GetTests())
+	{
+		if (!Options.Filter.empty() && Test.Name.find(Options.Filter) == std::string::npos) continue;
+		++Run;
+		if (Options.List)
+		{
+			std::printf("%s\n", Test.Name.c_str());
+			continue;
+		}
+
+		GetFailedChecks() = 0;
+		Test.Function();
+		const uint FailedChecks{ GetFailedChecks() };
+		if (FailedChecks == 0)
+		{
+			std::printf("[  OK  ] %s\n", Test.Name.c_str());
+		}
+		else
+		{
+			std::printf("[ FAIL ] %s, %u checks failed\n", Test.Name.c_str(), FailedChecks);
+			++Failed;
+		}
+		std::fflush(stdout);
+	}
+	return Failed;
+}
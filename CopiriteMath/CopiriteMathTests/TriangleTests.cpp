@@ -0,0 +1,117 @@
+// TriangleTests.cpp : Tests for ray triangle intersection, the packet kernels against the scalar test and rays through shared edges.
+
+#include "Test.h"
+#include "CopiriteMath/Datatypes/Triangle.h"
+#include <random>
+
+
+
+static void TestTrianglePacketsMatchScalar()
+{
+	constexpr uint Lanes{ TNativeLanes<float>::Count };
+	std::mt19937 Random{ 21 };
+	std::uniform_real_distribution<float> Value{ -1.0f, 1.0f };
+	const auto RandomVector{ [&](float Scale) { return SVector3{ Value(Random) * Scale, Value(Random) * Scale, Value(Random) * Scale }; } };
+
+	for (uint i = 0; i < 2000; ++i)
+	{
+		SVector3 Vertices[Lanes * 3], Origins[Lanes], Directions[Lanes];
+		for (SVector3& Vertex : Vertices) Vertex = RandomVector(2.0f);
+		for (uint r = 0; r < Lanes; ++r)
+		{
+			Origins[r] = RandomVector(3.0f);
+			Directions[r] = RandomVector(1.0f);
+			if (i % 7 == 0) Directions[r][i % 3] = 0.0f;
+		}
+
+		// Compared bit for bit, the packets must make the same decisions and give the same results as the scalar test.
+		const STTrianglePacket<float> Triangles{ Vertices, Lanes };
+		const STTriangleRayPacket<float> Rays{ Origins, Directions, Lanes };
+		for (uint r = 0; r < Lanes; ++r)
+		{
+			const STriangleRay Ray{ Origins[r], Directions[r] };
+			SNativeFloats Distances, U, V;
+			const uint Hits{ Triangles.IntersectRay(Ray, 100.0f, Distances, U, V) };
+			for (uint t = 0; t < Lanes; ++t)
+			{
+				float Distance, TU, TV;
+				const bool Hit{ Ray.Intersect(Vertices[3 * t], Vertices[(3 * t) + 1], Vertices[(3 * t) + 2], 100.0f, Distance, TU, TV) };
+				if (CHECK(Hit == (bool)((Hits >> t) & 1)) && Hit) CHECK(BitEqual(Distance, Distances[t]) && BitEqual(TU, U[t]) && BitEqual(TV, V[t]));
+			}
+		}
+		for (uint t = 0; t < Lanes; ++t)
+		{
+			SNativeFloats Distances, U, V;
+			const uint Hits{ Rays.IntersectTriangle(Vertices[3 * t], Vertices[(3 * t) + 1], Vertices[(3 * t) + 2], SNativeFloats{ 100.0f }, Distances, U, V) };
+			for (uint r = 0; r < Lanes; ++r)
+			{
+				float Distance, TU, TV;
+				const bool Hit{ STriangleRay{ Origins[r], Directions[r] }.Intersect(Vertices[3 * t], Vertices[(3 * t) + 1], Vertices[(3 * t) + 2], 100.0f, Distance, TU, TV) };
+				if (CHECK(Hit == (bool)((Hits >> r) & 1)) && Hit) CHECK(BitEqual(Distance, Distances[r]) && BitEqual(TU, U[r]) && BitEqual(TV, V[r]));
+			}
+		}
+
+		// The unused lanes of partial packets never hit.
+		const uint Used{ i % Lanes };
+		SNativeFloats Distances, U, V;
+		CHECK((STTriangleRayPacket<float>{ Origins, Directions, Used }.IntersectTriangle(Vertices[0], Vertices[1], Vertices[2], SNativeFloats{ 1e30f }, Distances, U, V) >> Used) == 0);
+		CHECK((STTrianglePacket<float>{ Vertices, Used }.IntersectRay(STriangleRay{ Origins[0], Directions[0] }, 1e30f, Distances, U, V) >> Used) == 0);
+	}
+}
+
+
+static void TestTriangleWatertight()
+{
+	// A jittered grid of triangles sharing every edge, rays aimed exactly at the shared edges and vertices must hit one of them.
+	constexpr int Grid{ 32 };
+	std::mt19937 Random{ 21 };
+	std::uniform_real_distribution<float> Jitter{ -0.003f, 0.003f }, Unit{ 0.0f, 1.0f }, Spread{ -1.0f, 2.0f }, Height{ 1.0f, 4.0f };
+	std::vector<SVector3> Vertices;
+	std::vector<uint32> Indices;
+	for (int y = 0; y <= Grid; ++y)
+	{
+		for (int x = 0; x <= Grid; ++x) Vertices.push_back(SVector3{ ((float)x / Grid) + Jitter(Random), ((float)y / Grid) + Jitter(Random), Jitter(Random) });
+	}
+	for (int y = 0; y < Grid; ++y)
+	{
+		for (int x = 0; x < Grid; ++x)
+		{
+			const uint32 A{ (uint32)((y * (Grid + 1)) + x) }, B{ A + 1 }, C{ A + Grid + 1 }, D{ C + 1 };
+			Indices.insert(Indices.end(), { A, B, D, A, D, C });
+		}
+	}
+	const STriangleMesh Mesh{ Vertices.data(), Indices.data(), (uint)Indices.size() / 3 };
+
+	std::vector<SVector3> Origins, Directions;
+	for (uint i = 0; i < 50000; ++i)
+	{
+		// Along the edge to the right, up or diagonally up from an interior vertex, every fifth ray at the vertex itself.
+		const uint32 A{ (uint32)(((1 + Random() % (Grid - 1)) * (Grid + 1)) + 1 + Random() % (Grid - 1)) };
+		const uint32 B{ (i % 3 == 0) ? A + 1 : (i % 3 == 1) ? A + Grid + 1 : A + Grid + 2 };
+		const float Along{ (i % 5 == 0) ? 0.0f : Unit(Random) };
+		const SVector3 Target{ Vertices[A][0] + ((Vertices[B][0] - Vertices[A][0]) * Along), Vertices[A][1] + ((Vertices[B][1] - Vertices[A][1]) * Along), Vertices[A][2] + ((Vertices[B][2] - Vertices[A][2]) * Along) };
+		SVector3 Origin{ Spread(Random), Spread(Random), Height(Random) };
+		if (i % 2 == 1) Origin[2] = -Origin[2];
+		Origins.push_back(Origin);
+		Directions.push_back(SVector3{ Target[0] - Origin[0], Target[1] - Origin[1], Target[2] - Origin[2] });
+		CHECK(Mesh.IntersectRay(Origin, Directions.back(), 2.0f).IsHit());
+	}
+
+	// The streaming batch finds the same closest hits as the single ray query.
+	std::vector<STriangleHit> Hits(Origins.size());
+	Mesh.IntersectRays(Origins.data(), Directions.data(), (uint)Origins.size(), Hits.data(), 2.0f);
+	for (size_t i = 0; i < Origins.size(); i += 13)
+	{
+		const STriangleHit Hit{ Mesh.IntersectRay(Origins[i], Directions[i], 2.0f) };
+		CHECK(Hit.Triangle == Hits[i].Triangle && BitEqual(Hit.Distance, Hits[i].Distance));
+	}
+}
+
+
+
+// Registers the Triangle tests.
+void AddTriangleTests()
+{
+	RegisterTest("Triangle/PacketsMatchScalar", TestTrianglePacketsMatchScalar);
+	RegisterTest("Triangle/Watertight", TestTriangleWatertight);
+}
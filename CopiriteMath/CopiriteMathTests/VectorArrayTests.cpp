@@ -0,0 +1,203 @@
+// VectorArrayTests.cpp : Tests for STVectorArray, the batched kernels against the same operation on each vector.
+
+#include "Test.h"
+#include "CopiriteMath/Datatypes/VectorArray.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <random>
+#include <utility>
+
+
+
+// Lengths around the lane count and the parallel grain, so tails and pieces split across threads are covered.
+static const uint ArrayLengths[]{ 0, 1, 7, 17, 1000, 40000 + 3 };
+
+
+template <uint Size, typename Type>
+static std::vector<STVector<Size, Type>> RandomVectors(std::mt19937& Random, uint Count, Type Low, Type High)
+{
+	std::uniform_real_distribution<Type> Value{ Low, High };
+	std::vector<STVector<Size, Type>> Vectors(Count);
+	for (STVector<Size, Type>& Vector : Vectors)
+	{
+		for (uint j = 0; j < Size; ++j) Vector[j] = Value(Random);
+	}
+	return Vectors;
+}
+
+
+template <uint Size, typename Type>
+static void TestVectorArrayStorage()
+{
+	typedef STVector<Size, Type> SVector;
+	typedef STVectorArray<Size, Type> SArray;
+	std::mt19937 Random{ 3 };
+	for (uint Count : ArrayLengths)
+	{
+		const std::vector<SVector> Vectors{ RandomVectors<Size, Type>(Random, Count, (Type)-10, (Type)10) };
+		SArray Array{ Vectors.data(), Count };
+		CHECK(Array.Num() == Count);
+		CHECK(Array.GetCapacity() >= Count);
+		for (uint j = 0; j < Size; ++j) CHECK(((size_t)Array.GetAxis(j) % SArray::Alignment) == 0);
+
+		std::vector<SVector> Copied(Count);
+		Array.ToArray(Copied.data());
+		CHECK(Copied == Vectors);
+
+		// Copies and moves keep the vectors, growing fills with zero vectors.
+		SArray Copy{ Array };
+		SArray Moved{ std::move(Copy) };
+		Moved.Resize(Count + 5);
+		for (uint i = 0; i < Count; ++i) CHECK(std::as_const(Moved)[i] == Vectors[i]);
+		for (uint i = Count; i < Count + 5; ++i) CHECK(std::as_const(Moved)[i] == SVector{ (Type)0 });
+		CHECK(Moved.Add(SVector{ (Type)2 }) == Count + 5);
+		CHECK(std::as_const(Moved)[Count + 5] == SVector{ (Type)2 });
+
+		// References write straight into the axes.
+		if (Count > 0)
+		{
+			Array[Count - 1] = SVector{ (Type)7 };
+			CHECK(Array.GetAxis(Size - 1)[Count - 1] == (Type)7);
+		}
+
+		SArena Arena{ 1 << 20 };
+		SArray Scratch{ Count, Arena };
+		CHECK(Scratch.GetArena() == &Arena && Scratch.Num() == Count);
+	}
+}
+
+
+template <uint Size, typename Type>
+static void TestVectorArrayMatchesScalar()
+{
+	// The component-wise kernels are exact, the dot and cross products may be fused.
+	typedef STVector<Size, Type> SVector;
+	typedef STVectorArray<Size, Type> SArray;
+	std::mt19937 Random{ 5 };
+	const Type Epsilon{ std::numeric_limits<Type>::epsilon() * 8 };
+	for (uint Count : ArrayLengths)
+	{
+		const std::vector<SVector> A{ RandomVectors<Size, Type>(Random, Count, (Type)-10, (Type)10) }, B{ RandomVectors<Size, Type>(Random, Count, (Type)0.5, (Type)10) };
+		const SVector V{ RandomVectors<Size, Type>(Random, 1, (Type)0.5, (Type)10)[0] };
+		const Type Scalar{ (Type)1.5 };
+		const SArray ArrayA{ A.data(), Count }, ArrayB{ B.data(), Count };
+
+		const auto Compare{ [&](const SArray& Result, auto Operation)
+			{
+				for (uint i = 0; i < Count; ++i)
+				{
+					const SVector Got{ Result[i] };
+					for (uint j = 0; j < Size; ++j)
+					{
+						if (!CHECK(BitEqual(Got[j], (Type)Operation(A[i][j], B[i][j], V[j])))) return;
+					}
+				}
+			} };
+		SArray R{ ArrayA };
+		R += ArrayB; Compare(R, [](Type X, Type Y, Type) { return X + Y; });
+		R = ArrayA; R -= ArrayB; Compare(R, [](Type X, Type Y, Type) { return X - Y; });
+		R = ArrayA; R *= ArrayB; Compare(R, [](Type X, Type Y, Type) { return X * Y; });
+		R = ArrayA; R /= ArrayB; Compare(R, [](Type X, Type Y, Type) { return X / Y; });
+		R = ArrayA; R += V; Compare(R, [](Type X, Type, Type Z) { return X + Z; });
+		R = ArrayA; R -= V; Compare(R, [](Type X, Type, Type Z) { return X - Z; });
+		R = ArrayA; R *= V; Compare(R, [](Type X, Type, Type Z) { return X * Z; });
+		R = ArrayA; R *= Scalar; Compare(R, [Scalar](Type X, Type, Type) { return X * Scalar; });
+		R = ArrayA; R /= Scalar; Compare(R, [Scalar](Type X, Type, Type) { return X / Scalar; });
+		R = ArrayA; R.Min(ArrayB); Compare(R, [](Type X, Type Y, Type) { return TMath::Min(X, Y); });
+		R = ArrayA; R.Max(ArrayB); Compare(R, [](Type X, Type Y, Type) { return TMath::Max(X, Y); });
+		R = ArrayA; R.Min(V); Compare(R, [](Type X, Type, Type Z) { return TMath::Min(X, Z); });
+		R = ArrayA; R.Max(V); Compare(R, [](Type X, Type, Type Z) { return TMath::Max(X, Z); });
+
+		std::vector<Type> Dots(Count + 1, (Type)-1), VectorDots(Count + 1, (Type)-1);
+		ArrayA.DotProduct(ArrayB, Dots.data());
+		ArrayA.DotProduct(V, VectorDots.data());
+		CHECK(Dots[Count] == (Type)-1 && VectorDots[Count] == (Type)-1);
+		for (uint i = 0; i < Count; ++i)
+		{
+			Type Dot{ 0 }, VectorDot{ 0 }, Magnitude{ 0 }, VectorMagnitude{ 0 };
+			for (uint j = 0; j < Size; ++j)
+			{
+				Dot += A[i][j] * B[i][j];
+				VectorDot += A[i][j] * V[j];
+				Magnitude += std::fabs(A[i][j] * B[i][j]);
+				VectorMagnitude += std::fabs(A[i][j] * V[j]);
+			}
+			CHECK(std::fabs(Dots[i] - Dot) <= Magnitude * Epsilon);
+			CHECK(std::fabs(VectorDots[i] - VectorDot) <= VectorMagnitude * Epsilon);
+		}
+
+		if constexpr (Size == 3)
+		{
+			SArray Cross;
+			ArrayA.CrossProduct(ArrayB, Cross);
+			CHECK(Cross.Num() == Count);
+			for (uint i = 0; i < Count; ++i)
+			{
+				const SVector Got{ Cross[i] };
+				const Type Expected[3]{ (A[i][1] * B[i][2]) - (A[i][2] * B[i][1]), (A[i][2] * B[i][0]) - (A[i][0] * B[i][2]), (A[i][0] * B[i][1]) - (A[i][1] * B[i][0]) };
+				for (uint j = 0; j < 3; ++j) CHECK(std::fabs(Got[j] - Expected[j]) <= (Type)200 * Epsilon);
+			}
+		}
+
+		std::unique_ptr<bool[]> Equal{ new bool[Count + 1] };
+		std::fill(Equal.get(), Equal.get() + Count + 1, true);
+		SArray Near{ ArrayA };
+		for (uint i = 0; i < Count; i += 3) Near[i] = A[i] + SVector{ (Type)0.5 };
+		ArrayA.nearlyEqual(Near, Equal.get(), (Type)0.25);
+		for (uint i = 0; i < Count; ++i) CHECK(Equal[i] == (i % 3 != 0));
+		CHECK(Equal[Count]);
+	}
+}
+
+
+template <uint Size, typename Type>
+static void TestVectorArrayNormalize()
+{
+	typedef STVector<Size, Type> SVector;
+	typedef STVectorArray<Size, Type> SArray;
+	std::mt19937 Random{ 7 };
+	for (uint Count : ArrayLengths)
+	{
+		std::vector<SVector> Vectors{ RandomVectors<Size, Type>(Random, Count, (Type)-10, (Type)10) };
+		for (uint i = 0; i < Count; i += 5) Vectors[i] = SVector{ (Type)0 };
+		for (bool Fast : { false, true })
+		{
+			SArray Array{ Vectors.data(), Count };
+			if (Fast) Array.FastNormalize();
+			else Array.Normalize();
+			for (uint i = 0; i < Count; ++i)
+			{
+				const SVector Got{ Array[i] };
+				if (i % 5 == 0)
+				{
+					CHECK(Got == SVector{ (Type)0 });
+					continue;
+				}
+				Type Length{ 0 }, Dot{ 0 };
+				for (uint j = 0; j < Size; ++j)
+				{
+					Length += Got[j] * Got[j];
+					Dot += Got[j] * Vectors[i][j];
+				}
+				CHECK(std::fabs(std::sqrt(Length) - (Type)1) <= std::numeric_limits<Type>::epsilon() * 6);
+				CHECK(Dot > (Type)0);
+			}
+		}
+	}
+}
+
+
+
+// Registers the VectorArray tests.
+void AddVectorArrayTests()
+{
+	RegisterTest("VectorArray/Storage3", TestVectorArrayStorage<3, float>);
+	RegisterTest("VectorArray/Storage4Double", TestVectorArrayStorage<4, double>);
+	RegisterTest("VectorArray/MatchesScalar3", TestVectorArrayMatchesScalar<3, float>);
+	RegisterTest("VectorArray/MatchesScalar4", TestVectorArrayMatchesScalar<4, float>);
+	RegisterTest("VectorArray/MatchesScalar3Double", TestVectorArrayMatchesScalar<3, double>);
+	RegisterTest("VectorArray/Normalize3", TestVectorArrayNormalize<3, float>);
+	RegisterTest("VectorArray/Normalize4Double", TestVectorArrayNormalize<4, double>);
+}
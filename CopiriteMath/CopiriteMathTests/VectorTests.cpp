@@ -0,0 +1,82 @@
+// VectorTests.cpp : Tests for STVector, the SIMD backends against doing each component on its own.
+
+#include "Test.h"
+#include "CopiriteMath/Datatypes/Vector.h"
+#include <cmath>
+#include <limits>
+#include <random>
+
+
+
+template <uint Size, typename Type>
+static void TestVectorMatchesScalar()
+{
+	// Component-wise operations must be bit identical, the dot and cross products may round differently as the
+	// backends sum in another order or the scalar loop is contracted into fused multiply adds.
+	typedef STVector<Size, Type> SVector;
+	std::mt19937 Random{ 11 };
+	std::uniform_real_distribution<Type> Value{ (Type)-100, (Type)100 };
+	for (uint i = 0; i < 10000; ++i)
+	{
+		SVector A, B;
+		for (uint j = 0; j < Size; ++j)
+		{
+			A[j] = Value(Random);
+			B[j] = Value(Random);
+		}
+		const SVector Sum{ A + B }, Difference{ A - B }, Product{ A * B }, Quotient{ A / B }, Lowest{ A.Min(B) }, Highest{ A.Max(B) }, Negated{ -A };
+		Type Dot{ 0 }, Magnitude{ 0 };
+		for (uint j = 0; j < Size; ++j)
+		{
+			CHECK(BitEqual(Sum[j], (Type)(A[j] + B[j])));
+			CHECK(BitEqual(Difference[j], (Type)(A[j] - B[j])));
+			CHECK(BitEqual(Product[j], (Type)(A[j] * B[j])));
+			CHECK(BitEqual(Quotient[j], (Type)(A[j] / B[j])));
+			CHECK(BitEqual(Lowest[j], TMath::Min(A[j], B[j])));
+			CHECK(BitEqual(Highest[j], TMath::Max(A[j], B[j])));
+			CHECK(BitEqual(Negated[j], (Type)-A[j]));
+			Dot += A[j] * B[j];
+			Magnitude += std::fabs(A[j] * B[j]);
+		}
+		const Type Epsilon{ std::numeric_limits<Type>::epsilon() * 4 };
+		CHECK(std::fabs((A ^ B) - Dot) <= Magnitude * Epsilon);
+
+		const SVector Cross{ A | B };
+		const Type Expected[3]{ (A[1] * B[2]) - (A[2] * B[1]), (A[2] * B[0]) - (A[0] * B[2]), (A[0] * B[1]) - (A[1] * B[0]) };
+		const Type Scale{ (Type)2e4 * Epsilon };
+		for (uint j = 0; j < 3; ++j) CHECK(std::fabs(Cross[j] - Expected[j]) <= Scale);
+		if constexpr (Size == 4) CHECK(Cross[3] == (Type)0);
+	}
+}
+
+
+template <uint Size, typename Type>
+static void TestVectorContainsNaN()
+{
+	// The SIMD finiteness test must flag NaN and infinity in any component, including the last one.
+	typedef STVector<Size, Type> SVector;
+	for (uint j = 0; j < Size; ++j)
+	{
+		for (Type Bad : { std::numeric_limits<Type>::quiet_NaN(), std::numeric_limits<Type>::infinity(), -std::numeric_limits<Type>::infinity() })
+		{
+			SVector Vector{ (Type)1 };
+			Vector[j] = Bad;
+			CHECK(Vector.ContainsNaN());
+		}
+	}
+	CHECK(!SVector{ std::numeric_limits<Type>::max() }.ContainsNaN());
+	CHECK(!SVector{ std::numeric_limits<Type>::denorm_min() }.ContainsNaN());
+}
+
+
+
+// Registers the Vector tests.
+void AddVectorTests()
+{
+	RegisterTest("Vector/SIMDMatchesScalar3", TestVectorMatchesScalar<3, float>);
+	RegisterTest("Vector/SIMDMatchesScalar4", TestVectorMatchesScalar<4, float>);
+	RegisterTest("Vector/SIMDMatchesScalar4Double", TestVectorMatchesScalar<4, double>);
+	RegisterTest("Vector/ContainsNaN3", TestVectorContainsNaN<3, float>);
+	RegisterTest("Vector/ContainsNaN4", TestVectorContainsNaN<4, float>);
+	RegisterTest("Vector/ContainsNaN4Double", TestVectorContainsNaN<4, double>);
+}